@@ -136,6 +136,22 @@ Vector<String> ResourceLoader::list_directory(const String &p_directory) {
 	return ::ResourceLoader::list_directory(p_directory);
 }
 
+void ResourceLoader::set_pipelined_loading(bool p_enable) {
+	::ResourceLoader::set_pipelined_loading(p_enable);
+}
+
+bool ResourceLoader::is_pipelined_loading() const {
+	return ::ResourceLoader::is_pipelined_loading();
+}
+
+Dictionary ResourceLoader::get_pipeline_stats() const {
+	return ::ResourceLoader::get_pipeline_stats();
+}
+
+void ResourceLoader::reset_pipeline_stats() {
+	::ResourceLoader::reset_pipeline_stats();
+}
+
 void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads", "cache_mode"), &ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &ResourceLoader::load_threaded_get_status, DEFVAL_ARRAY);
@@ -152,6 +168,10 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("exists", "path", "type_hint"), &ResourceLoader::exists, DEFVAL(""));
 	ClassDB::bind_method(D_METHOD("get_resource_uid", "path"), &ResourceLoader::get_resource_uid);
 	ClassDB::bind_method(D_METHOD("list_directory", "directory_path"), &ResourceLoader::list_directory);
+	ClassDB::bind_method(D_METHOD("set_pipelined_loading", "enable"), &ResourceLoader::set_pipelined_loading);
+	ClassDB::bind_method(D_METHOD("is_pipelined_loading"), &ResourceLoader::is_pipelined_loading);
+	ClassDB::bind_method(D_METHOD("get_pipeline_stats"), &ResourceLoader::get_pipeline_stats);
+	ClassDB::bind_method(D_METHOD("reset_pipeline_stats"), &ResourceLoader::reset_pipeline_stats);
 
 	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
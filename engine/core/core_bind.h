@@ -85,6 +85,11 @@ public:
 
 	Vector<String> list_directory(const String &p_directory);
 
+	void set_pipelined_loading(bool p_enable);
+	bool is_pipelined_loading() const;
+	Dictionary get_pipeline_stats() const;
+	void reset_pipeline_stats();
+
 	ResourceLoader() { singleton = this; }
 };
 
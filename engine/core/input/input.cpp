@@ -751,6 +751,19 @@ void Input::_parse_input_event_impl(const Ref<InputEvent> &p_event, bool p_is_em
 	// - Emulated touch events are handed right to the main loop (i.e., the SceneTree) because they don't
 	//   require additional handling by this class.
 
+	if (!p_is_emulated) {
+		// Joypad timestamps are in the joypad driver's clock, so only key and mouse timestamps
+		// (converted to the ticks clock by the display servers) are trusted here.
+		uint64_t event_ticks = OS::get_singleton()->get_ticks_usec();
+		int64_t timestamp = p_event->get_timestamp_usec();
+		if (timestamp >= 0 && uint64_t(timestamp) <= event_ticks && (Object::cast_to<InputEventKey>(*p_event) || Object::cast_to<InputEventMouse>(*p_event))) {
+			event_ticks = timestamp;
+		}
+		if (frame_input_ticks_usec == 0 || event_ticks < frame_input_ticks_usec) {
+			frame_input_ticks_usec = event_ticks;
+		}
+	}
+
 	Ref<InputEventKey> k = p_event;
 	if (k.is_valid() && !k->is_echo() && k->get_keycode() != Key::NONE) {
 		if (k->is_pressed()) {
@@ -1278,6 +1291,14 @@ void Input::flush_frame_parsed_events() {
 }
 #endif
 
+uint64_t Input::take_frame_input_ticks_usec() {
+	DEV_ASSERT(Thread::get_caller_id() == Thread::get_main_id());
+
+	uint64_t ticks = frame_input_ticks_usec;
+	frame_input_ticks_usec = 0;
+	return ticks;
+}
+
 void Input::flush_buffered_events() {
 	_THREAD_SAFE_METHOD_
 
@@ -269,6 +269,9 @@ private:
 	void _parse_input_event_impl(const Ref<InputEvent> &p_event, bool p_is_emulated);
 
 	List<Ref<InputEvent>> buffered_events;
+	// Ticks of the oldest event delivered since the last call to take_frame_input_ticks_usec(), or zero.
+	// Only used on the main thread, where events are parsed and frames are drawn, so it isn't locked.
+	uint64_t frame_input_ticks_usec = 0;
 #ifdef DEBUG_ENABLED
 	HashSet<Ref<InputEvent>> frame_parsed_events;
 	uint64_t last_parsed_frame = UINT64_MAX;
@@ -404,6 +407,8 @@ public:
 	void flush_frame_parsed_events();
 #endif
 	void flush_buffered_events();
+	// Main thread only. Returns the ticks of the oldest event of the frame, and starts the next frame.
+	uint64_t take_frame_input_ticks_usec();
 	bool is_agile_input_event_flushing();
 	void set_agile_input_event_flushing(bool p_enable);
 	void set_use_accumulated_input(bool p_enable);
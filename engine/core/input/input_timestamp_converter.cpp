@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  input_timestamp_converter.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "input_timestamp_converter.h"
+
+int64_t InputTimestampConverter::_unwrap(uint32_t p_raw) const {
+	// Timestamps within half the counter range of the last sample are assumed to be the closest ones, before or after it.
+	return last_time_usec + int64_t(int32_t(p_raw - last_raw)) * int64_t(unit_usec);
+}
+
+void InputTimestampConverter::add_sample(uint32_t p_timestamp, uint64_t p_receive_ticks_usec) {
+	if (!synced) {
+		synced = true;
+		last_raw = p_timestamp;
+		last_time_usec = 0;
+		offset_usec = int64_t(p_receive_ticks_usec);
+		anchor_offset_usec = offset_usec;
+		anchor_time_usec = 0;
+		return;
+	}
+
+	const int64_t time_usec = _unwrap(p_timestamp);
+	if (time_usec > last_time_usec) {
+		last_raw = p_timestamp;
+		last_time_usec = time_usec;
+	}
+
+	const int64_t offset = int64_t(p_receive_ticks_usec) - time_usec;
+	const int64_t drifted = anchor_offset_usec + MAX(int64_t(0), time_usec - anchor_time_usec) * MAX_DRIFT_PPM / 1000000;
+	if (offset - offset_usec > RESYNC_THRESHOLD_USEC) {
+		// The source clock went back, count from this sample from now on.
+		last_raw = p_timestamp;
+		last_time_usec = time_usec;
+	}
+	if (offset <= drifted || offset - offset_usec > RESYNC_THRESHOLD_USEC) {
+		offset_usec = offset;
+		anchor_offset_usec = offset;
+		anchor_time_usec = time_usec;
+	} else {
+		offset_usec = MAX(offset_usec, drifted);
+	}
+}
+
+int64_t InputTimestampConverter::to_ticks_usec(uint32_t p_timestamp) const {
+	if (!synced) {
+		return -1;
+	}
+	return _unwrap(p_timestamp) + offset_usec;
+}
+
+void InputTimestampConverter::reset() {
+	synced = false;
+	last_raw = 0;
+	last_time_usec = 0;
+	offset_usec = 0;
+	anchor_offset_usec = 0;
+	anchor_time_usec = 0;
+}
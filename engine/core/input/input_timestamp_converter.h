@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*  input_timestamp_converter.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Converts the timestamps of a windowing server or device clock to the OS::get_ticks_usec() clock.
+//
+// The offset between both clocks is estimated from events as they're received: an event can't be
+// received before it happened, so the smallest difference between the receive time and the event
+// time is the closest to the real offset. The estimate follows the smallest difference right away,
+// and drifts up slowly to follow a source clock that runs slower than the ticks clock.
+class InputTimestampConverter {
+public:
+	// Clocks drift by less than this relative to each other (crystals are usually within 100 ppm).
+	static constexpr int64_t MAX_DRIFT_PPM = 200;
+	// A larger difference means the source clock jumped (server restart, suspend), the estimate starts over.
+	static constexpr int64_t RESYNC_THRESHOLD_USEC = 1000000;
+
+private:
+	uint64_t unit_usec = 1000;
+
+	bool synced = false;
+	uint32_t last_raw = 0;
+	int64_t last_time_usec = 0; // Unwrapped `last_raw`.
+	int64_t offset_usec = 0; // Ticks minus source time.
+	// Last sample that set the estimate, it drifts up from there.
+	int64_t anchor_offset_usec = 0;
+	int64_t anchor_time_usec = 0;
+
+	int64_t _unwrap(uint32_t p_raw) const;
+
+public:
+	// Source timestamps are 32-bit counters in units of `p_unit_usec` (milliseconds for X11 and Wayland) that wrap around.
+	explicit InputTimestampConverter(uint64_t p_unit_usec = 1000) :
+			unit_usec(p_unit_usec) {}
+
+	void add_sample(uint32_t p_timestamp, uint64_t p_receive_ticks_usec);
+	// Returns -1 before the first sample.
+	int64_t to_ticks_usec(uint32_t p_timestamp) const;
+
+	bool is_synced() const { return synced; }
+	int64_t get_offset_usec() const { return offset_usec; }
+	void reset();
+};
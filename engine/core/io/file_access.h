@@ -192,6 +192,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	// Maps the whole file read-only, or returns an empty span if this file can't be mapped.
+	// The memory stays valid until the file is closed, so keep a reference to it while the span is in use.
+	virtual Span<uint8_t> map_read_only() { return Span<uint8_t>(); }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
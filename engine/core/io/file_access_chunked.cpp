@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  file_access_chunked.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_chunked.h"
+
+#include "core/io/file_access_pack.h"
+
+Error FileAccessChunked::open_custom(const Ref<FileAccess> &p_list, uint64_t p_size) {
+	close();
+
+	ERR_FAIL_COND_V(p_list.is_null() || !p_list->is_open(), ERR_FILE_CANT_OPEN);
+
+	const PackChunks::ChunkMap &chunk_map = PackedData::get_singleton()->get_chunks();
+	uint32_t count = p_list->get_32();
+	// Only the last chunk can be smaller than the minimum size.
+	ERR_FAIL_COND_V_MSG((uint64_t)count * PackChunks::MIN_CHUNK_SIZE > p_size + PackChunks::MIN_CHUNK_SIZE, ERR_FILE_CORRUPT, "Invalid chunk list.");
+	chunks.resize(count);
+	chunk_ends.resize(count);
+	verified_chunks.resize_initialized(count);
+
+	uint64_t end = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		p_list->get_buffer(chunks[i].bytes, 32);
+		const PackChunks::Chunk *chunk = chunk_map.getptr(chunks[i]);
+		if (!chunk) {
+			close();
+			last_error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(last_error, "Chunk is not in any loaded pack. Load the base packs of a patch before the patch itself.");
+		}
+		end += chunk->size;
+		chunk_ends[i] = end;
+	}
+
+	if (end != p_size) {
+		close();
+		last_error = ERR_FILE_CORRUPT;
+		ERR_FAIL_V_MSG(last_error, "The chunks of the file don't add up to its size.");
+	}
+
+	length = p_size;
+	opened = true;
+	return OK;
+}
+
+bool FileAccessChunked::_load_chunk(int64_t p_chunk) const {
+	if (p_chunk == current_chunk) {
+		return true;
+	}
+
+	Error err = PackChunks::read_chunk(PackedData::get_singleton()->get_chunks(), chunks[p_chunk], pack_files, chunk_data);
+	if (err != OK) {
+		last_error = err;
+		current_chunk = -1;
+		chunk_data.clear();
+		return false;
+	}
+	// A chunk is addressed by the SHA-256 of its content, which is checked the first time it's read.
+	if (!verified_chunks[p_chunk]) {
+		if (PackChunks::hash_chunk(chunk_data.ptr(), chunk_data.size()) != chunks[p_chunk]) {
+			last_error = ERR_FILE_CORRUPT;
+			current_chunk = -1;
+			chunk_data.clear();
+			ERR_FAIL_V_MSG(false, "Chunk content doesn't match its hash, the pack is corrupt.");
+		}
+		verified_chunks[p_chunk] = true;
+	}
+	current_chunk = p_chunk;
+	return true;
+}
+
+bool FileAccessChunked::is_open() const {
+	return opened;
+}
+
+void FileAccessChunked::seek(uint64_t p_position) {
+	eof = p_position > length;
+	pos = p_position;
+}
+
+void FileAccessChunked::seek_end(int64_t p_position) {
+	seek(length + p_position);
+}
+
+uint64_t FileAccessChunked::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessChunked::get_length() const {
+	return length;
+}
+
+bool FileAccessChunked::eof_reached() const {
+	return eof;
+}
+
+Error FileAccessChunked::get_error() const {
+	if (last_error != OK) {
+		return last_error;
+	}
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+bool FileAccessChunked::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V(false);
+}
+
+uint64_t FileAccessChunked::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (eof || last_error != OK) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (pos + to_read > length) {
+		eof = true;
+		to_read = length - MIN(pos, length);
+	}
+
+	uint64_t done = 0;
+	while (done < to_read) {
+		// Chunks are sorted by end offset, the chunk containing `pos` is the first one ending after it.
+		int64_t chunk = current_chunk;
+		if (chunk < 0 || pos < (chunk > 0 ? chunk_ends[chunk - 1] : 0) || pos >= chunk_ends[chunk]) {
+			uint32_t lo = 0;
+			uint32_t hi = chunk_ends.size();
+			while (lo < hi) {
+				uint32_t mid = (lo + hi) / 2;
+				if (chunk_ends[mid] <= pos) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			chunk = lo;
+		}
+		if (!_load_chunk(chunk)) {
+			return done;
+		}
+
+		uint64_t chunk_start = chunk > 0 ? chunk_ends[chunk - 1] : 0;
+		uint64_t from = pos - chunk_start;
+		uint64_t n = MIN(to_read - done, (uint64_t)chunk_data.size() - from);
+		memcpy(p_dst + done, chunk_data.ptr() + from, n);
+		done += n;
+		pos += n;
+	}
+
+	return done;
+}
+
+void FileAccessChunked::flush() {
+	ERR_FAIL();
+}
+
+void FileAccessChunked::close() {
+	chunks.clear();
+	chunk_ends.clear();
+	verified_chunks.clear();
+	length = 0;
+	opened = false;
+	pos = 0;
+	eof = false;
+	last_error = OK;
+	current_chunk = -1;
+	chunk_data.clear();
+	pack_files.clear();
+}
+
+bool FileAccessChunked::file_exists(const String &p_name) {
+	return false;
+}
@@ -30,6 +30,8 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_chunked.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
 #include "core/object/script_language.h"
@@ -46,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, bool p_compressed, bool p_chunked) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -56,6 +58,8 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
 	pf.delta = p_delta;
+	pf.compressed = p_compressed;
+	pf.chunked = p_chunked;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -164,6 +168,10 @@ bool PackedData::has_delta_patches(const String &p_path) const {
 	return !E->value.is_empty();
 }
 
+void PackedData::add_chunk(const PackChunks::Hash &p_hash, const PackChunks::Chunk &p_chunk) {
+	chunks.insert(p_hash, p_chunk);
+}
+
 HashSet<String> PackedData::get_file_paths() const {
 	HashSet<String> file_paths;
 	_get_file_paths(root, root->name, file_paths);
@@ -183,8 +191,32 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 void PackedData::clear() {
 	files.clear();
 	delta_patches.clear();
+	chunks.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
+	release_mapped_packs();
+}
+
+void PackedData::release_mapped_packs() {
+	// Files still holding a span keep their pack mapped.
+	MutexLock lock(mapped_packs_mutex);
+	mapped_packs.clear();
+}
+
+Ref<FileAccess> PackedData::_get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+	HashMap<String, Ref<FileAccess>>::Iterator E = mapped_packs.find(p_pack);
+	if (E) {
+		return E->value;
+	}
+
+	// Remember failures too, so packs that can't be mapped aren't retried for every file.
+	Ref<FileAccess> f = FileAccess::open(p_pack, FileAccess::READ);
+	if (f.is_valid() && f->map_read_only().is_empty()) {
+		f = Ref<FileAccess>();
+	}
+	mapped_packs.insert(p_pack, f);
+	return f;
 }
 
 PackedData::PackedData() {
@@ -291,20 +323,36 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
+	bool chunked = (pack_flags & PACK_CHUNKED);
+	ERR_FAIL_COND_V_MSG(chunked != (version == PACK_FORMAT_VERSION_V4), false, "Invalid chunked pack header.");
+	ERR_FAIL_COND_V_MSG(chunked && (enc_directory || sparse_bundle), false, "Chunked packs can't be encrypted or sparse.");
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
+	if (version == PACK_FORMAT_VERSION_V4) {
+		// V4: Like V3, the first reserved field holds the chunk table offset.
+		uint64_t dir_offset = f->get_64() + pck_start_pos;
+		uint64_t chunk_table_offset = f->get_64() + pck_start_pos;
+
+		f->seek(chunk_table_offset);
+		PackChunks::ChunkMap pack_chunks;
+		Error err = PackChunks::read_chunk_table(f, p_path, file_base, pack_chunks);
+		ERR_FAIL_COND_V_MSG(err != OK, false, vformat("Can't read the chunk table of pack \"%s\".", p_path));
+		for (const KeyValue<PackChunks::Hash, PackChunks::Chunk> &E : pack_chunks) {
+			PackedData::get_singleton()->add_chunk(E.key, E.value);
+		}
+		f->seek(dir_offset);
+	} else if (version == PACK_FORMAT_VERSION_V3) {
 		// V3: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
@@ -350,7 +398,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA));
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), (flags & PACK_FILE_COMPRESSED), (flags & PACK_FILE_CHUNKED));
 		}
 	}
 
@@ -484,6 +532,31 @@ void FileAccessPack::set_big_endian(bool p_big_endian) {
 	f->set_big_endian(p_big_endian);
 }
 
+Span<uint8_t> FileAccessPack::map_read_only() {
+	ERR_FAIL_COND_V_MSG(f.is_null(), Span<uint8_t>(), "File must be opened before use.");
+
+	if (pf.encrypted || pf.compressed || pf.chunked) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> whole;
+	if (pf.bundle) {
+		whole = f->map_read_only();
+	} else {
+		if (mapped_pack.is_null()) {
+			mapped_pack = PackedData::get_singleton()->_get_mapped_pack(pf.pack);
+		}
+		if (mapped_pack.is_valid()) {
+			whole = mapped_pack->map_read_only();
+		}
+	}
+
+	if (whole.size() < off + pf.size) {
+		return Span<uint8_t>();
+	}
+	return Span<uint8_t>(whole.ptr() + off, pf.size);
+}
+
 Error FileAccessPack::get_error() const {
 	if (eof) {
 		return ERR_FILE_EOF;
@@ -505,6 +578,7 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
@@ -538,6 +612,24 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
+
+	if (pf.compressed) {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		Error err = fac->open_after_magic(f);
+		ERR_FAIL_COND_MSG(err, vformat(R"(Can't open compressed pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
+		f = fac;
+		off = 0;
+	}
+
+	if (pf.chunked) {
+		Ref<FileAccessChunked> fach;
+		fach.instantiate();
+		Error err = fach->open_custom(f, pf.size);
+		ERR_FAIL_COND_MSG(err, vformat(R"(Can't open chunked pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
+		f = fach;
+		off = 0;
+	}
 	pos = 0;
 	eof = false;
 }
@@ -32,6 +32,8 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/pack_chunks.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -41,6 +43,8 @@
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+// Same as V3 with a chunk table, see PackChunks. Only used by chunked packs so older engines reject them.
+#define PACK_FORMAT_VERSION_V4 4
 
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
@@ -49,12 +53,15 @@ enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
 	PACK_REL_FILEBASE = 1 << 1,
 	PACK_SPARSE_BUNDLE = 1 << 2,
+	PACK_CHUNKED = 1 << 3,
 };
 
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3,
+	PACK_FILE_CHUNKED = 1 << 4, // The file data is a list of chunk hashes.
 };
 
 class PackSource;
@@ -74,6 +81,8 @@ public:
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed = false;
+		bool chunked = false;
 	};
 
 private:
@@ -106,6 +115,8 @@ private:
 
 	HashMap<PathMD5, PackedFile, PathMD5> files;
 	HashMap<PathMD5, Vector<PackedFile>, PathMD5> delta_patches;
+	// Chunks of all the loaded chunked packs. Chunks with the same hash have the same contents, the last pack loaded is used.
+	PackChunks::ChunkMap chunks;
 
 	Vector<PackSource *> sources;
 
@@ -114,18 +125,26 @@ private:
 	static inline PackedData *singleton = nullptr;
 	bool disabled = false;
 
+	// Packs mapped in memory, shared by all the files read from them with FileAccess::map_read_only().
+	Mutex mapped_packs_mutex;
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
+	Ref<FileAccess> _get_mapped_pack(const String &p_pack);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, bool p_compressed = false, bool p_chunked = false); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
 	bool has_delta_patches(const String &p_path) const;
 	HashSet<String> get_file_paths() const;
 
+	void add_chunk(const PackChunks::Hash &p_hash, const PackChunks::Chunk &p_chunk);
+	const PackChunks::ChunkMap &get_chunks() const { return chunks; }
+
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
@@ -133,6 +152,7 @@ public:
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
 	void clear();
+	void release_mapped_packs();
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
@@ -177,6 +197,8 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	Ref<FileAccess> mapped_pack;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -203,6 +225,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> map_read_only() override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
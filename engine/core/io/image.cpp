@@ -32,9 +32,11 @@
 
 #include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
+#include "core/io/image_kernels.h"
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
 
@@ -491,6 +493,43 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Calls p_func(from_row, to_row) over [0, p_rows). Large images are split in strips
+// processed on the WorkerThreadPool; small ones, and calls made from pool threads
+// (which would block a worker waiting on the group), run inline.
+template <typename F>
+static void _for_each_row_strip(uint32_t p_rows, uint64_t p_row_bytes, const F &p_func) {
+	constexpr uint64_t MIN_BYTES_PER_STRIP = 256 * 1024;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t strips = 1;
+	if (pool && pool->get_thread_count() > 1 && p_rows > 1 && pool->get_thread_index() == -1) {
+		uint64_t by_size = p_rows * p_row_bytes / MIN_BYTES_PER_STRIP;
+		strips = MIN(MIN(uint64_t(pool->get_thread_count()), by_size), uint64_t(p_rows));
+	}
+
+	if (strips <= 1) {
+		p_func(0, p_rows);
+		return;
+	}
+
+	struct StripTask {
+		const F *func;
+		uint32_t rows;
+		uint32_t strips;
+
+		static void run(void *p_userdata, uint32_t p_index) {
+			const StripTask *task = (const StripTask *)p_userdata;
+			uint32_t from = uint64_t(task->rows) * p_index / task->strips;
+			uint32_t to = uint64_t(task->rows) * (p_index + 1) / task->strips;
+			(*task->func)(from, to);
+		}
+	};
+
+	StripTask task = { &p_func, p_rows, strips };
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(&StripTask::run, &task, strips, -1, true, String("ImageRowStrips"));
+	pool->wait_for_group_task_completion(group);
+}
+
 // Using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers.
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
 static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
@@ -566,6 +605,245 @@ static bool _are_formats_compatible(Image::Format p_format0, Image::Format p_for
 	return false;
 }
 
+static void _convert_rows(int p_conversion_type, int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	switch (p_conversion_type) {
+		case Image::FORMAT_L8 | (Image::FORMAT_LA8 << 8):
+			_convert<1, false, 1, true, true, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_L8 | (Image::FORMAT_R8 << 8):
+			_convert<1, false, 1, false, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_L8 | (Image::FORMAT_RG8 << 8):
+			_convert<1, false, 2, false, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_L8 | (Image::FORMAT_RGB8 << 8):
+			_convert<1, false, 3, false, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_L8 | (Image::FORMAT_RGBA8 << 8):
+			_convert<1, false, 3, true, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_LA8 | (Image::FORMAT_L8 << 8):
+			_convert<1, true, 1, false, true, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_LA8 | (Image::FORMAT_R8 << 8):
+			_convert<1, true, 1, false, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_LA8 | (Image::FORMAT_RG8 << 8):
+			_convert<1, true, 2, false, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_LA8 | (Image::FORMAT_RGB8 << 8):
+			_convert<1, true, 3, false, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_LA8 | (Image::FORMAT_RGBA8 << 8):
+			_convert<1, true, 3, true, true, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_R8 | (Image::FORMAT_L8 << 8):
+			_convert<1, false, 1, false, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_R8 | (Image::FORMAT_LA8 << 8):
+			_convert<1, false, 1, true, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_R8 | (Image::FORMAT_RG8 << 8):
+			_convert<1, false, 2, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_R8 | (Image::FORMAT_RGB8 << 8):
+			_convert<1, false, 3, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_R8 | (Image::FORMAT_RGBA8 << 8):
+			_convert<1, false, 3, true, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RG8 | (Image::FORMAT_L8 << 8):
+			_convert<2, false, 1, false, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RG8 | (Image::FORMAT_LA8 << 8):
+			_convert<2, false, 1, true, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RG8 | (Image::FORMAT_R8 << 8):
+			_convert<2, false, 1, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RG8 | (Image::FORMAT_RGB8 << 8):
+			_convert<2, false, 3, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RG8 | (Image::FORMAT_RGBA8 << 8):
+			_convert<2, false, 3, true, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGB8 | (Image::FORMAT_L8 << 8):
+			_convert<3, false, 1, false, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGB8 | (Image::FORMAT_LA8 << 8):
+			_convert<3, false, 1, true, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGB8 | (Image::FORMAT_R8 << 8):
+			_convert<3, false, 1, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGB8 | (Image::FORMAT_RG8 << 8):
+			_convert<3, false, 2, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGB8 | (Image::FORMAT_RGBA8 << 8):
+			_convert<3, false, 3, true, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGBA8 | (Image::FORMAT_L8 << 8):
+			_convert<3, true, 1, false, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGBA8 | (Image::FORMAT_LA8 << 8):
+			_convert<3, true, 1, true, false, true>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGBA8 | (Image::FORMAT_R8 << 8):
+			_convert<3, true, 1, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGBA8 | (Image::FORMAT_RG8 << 8):
+			_convert<3, true, 2, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RGBA8 | (Image::FORMAT_RGB8 << 8):
+			_convert<3, true, 3, false, false, false>(p_width, p_height, p_src, p_dst);
+			break;
+		case Image::FORMAT_RH | (Image::FORMAT_RGH << 8):
+			_convert_fast<uint16_t, 1, 2, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RH | (Image::FORMAT_RGBH << 8):
+			_convert_fast<uint16_t, 1, 3, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RH | (Image::FORMAT_RGBAH << 8):
+			_convert_fast<uint16_t, 1, 4, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGH | (Image::FORMAT_RH << 8):
+			_convert_fast<uint16_t, 2, 1, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGH | (Image::FORMAT_RGBH << 8):
+			_convert_fast<uint16_t, 2, 3, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGH | (Image::FORMAT_RGBAH << 8):
+			_convert_fast<uint16_t, 2, 4, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBH | (Image::FORMAT_RH << 8):
+			_convert_fast<uint16_t, 3, 1, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBH | (Image::FORMAT_RGH << 8):
+			_convert_fast<uint16_t, 3, 2, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBH | (Image::FORMAT_RGBAH << 8):
+			_convert_fast<uint16_t, 3, 4, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBAH | (Image::FORMAT_RH << 8):
+			_convert_fast<uint16_t, 4, 1, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBAH | (Image::FORMAT_RGH << 8):
+			_convert_fast<uint16_t, 4, 2, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBAH | (Image::FORMAT_RGBH << 8):
+			_convert_fast<uint16_t, 4, 3, 0x0000, 0x3C00>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RF | (Image::FORMAT_RGF << 8):
+			_convert_fast<uint32_t, 1, 2, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RF | (Image::FORMAT_RGBF << 8):
+			_convert_fast<uint32_t, 1, 3, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RF | (Image::FORMAT_RGBAF << 8):
+			_convert_fast<uint32_t, 1, 4, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGF | (Image::FORMAT_RF << 8):
+			_convert_fast<uint32_t, 2, 1, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGF | (Image::FORMAT_RGBF << 8):
+			_convert_fast<uint32_t, 2, 3, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGF | (Image::FORMAT_RGBAF << 8):
+			_convert_fast<uint32_t, 2, 4, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBF | (Image::FORMAT_RF << 8):
+			_convert_fast<uint32_t, 3, 1, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBF | (Image::FORMAT_RGF << 8):
+			_convert_fast<uint32_t, 3, 2, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBF | (Image::FORMAT_RGBAF << 8):
+			_convert_fast<uint32_t, 3, 4, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBAF | (Image::FORMAT_RF << 8):
+			_convert_fast<uint32_t, 4, 1, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBAF | (Image::FORMAT_RGF << 8):
+			_convert_fast<uint32_t, 4, 2, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBAF | (Image::FORMAT_RGBF << 8):
+			_convert_fast<uint32_t, 4, 3, 0x00000000, 0x3F800000>(p_width, p_height, (const uint32_t *)p_src, (uint32_t *)p_dst);
+			break;
+		case Image::FORMAT_R16 | (Image::FORMAT_RG16 << 8):
+			_convert_fast<uint16_t, 1, 2, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_R16 | (Image::FORMAT_RGB16 << 8):
+			_convert_fast<uint16_t, 1, 3, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_R16 | (Image::FORMAT_RGBA16 << 8):
+			_convert_fast<uint16_t, 1, 4, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RG16 | (Image::FORMAT_R16 << 8):
+			_convert_fast<uint16_t, 2, 1, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RG16 | (Image::FORMAT_RGB16 << 8):
+			_convert_fast<uint16_t, 2, 3, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RG16 | (Image::FORMAT_RGBA16 << 8):
+			_convert_fast<uint16_t, 2, 4, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGB16 | (Image::FORMAT_R16 << 8):
+			_convert_fast<uint16_t, 3, 1, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGB16 | (Image::FORMAT_RG16 << 8):
+			_convert_fast<uint16_t, 3, 2, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGB16 | (Image::FORMAT_RGBA16 << 8):
+			_convert_fast<uint16_t, 3, 4, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBA16 | (Image::FORMAT_R16 << 8):
+			_convert_fast<uint16_t, 4, 1, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBA16 | (Image::FORMAT_RG16 << 8):
+			_convert_fast<uint16_t, 4, 2, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBA16 | (Image::FORMAT_RGB16 << 8):
+			_convert_fast<uint16_t, 4, 3, 0x0000, 0xFFFF>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_R16I | (Image::FORMAT_RG16I << 8):
+			_convert_fast<uint16_t, 1, 2, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_R16I | (Image::FORMAT_RGB16I << 8):
+			_convert_fast<uint16_t, 1, 3, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_R16I | (Image::FORMAT_RGBA16I << 8):
+			_convert_fast<uint16_t, 1, 4, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RG16I | (Image::FORMAT_R16I << 8):
+			_convert_fast<uint16_t, 2, 1, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RG16I | (Image::FORMAT_RGB16I << 8):
+			_convert_fast<uint16_t, 2, 3, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RG16I | (Image::FORMAT_RGBA16I << 8):
+			_convert_fast<uint16_t, 2, 4, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGB16I | (Image::FORMAT_R16I << 8):
+			_convert_fast<uint16_t, 3, 1, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGB16I | (Image::FORMAT_RG16I << 8):
+			_convert_fast<uint16_t, 3, 2, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGB16I | (Image::FORMAT_RGBA16I << 8):
+			_convert_fast<uint16_t, 3, 4, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBA16I | (Image::FORMAT_R16I << 8):
+			_convert_fast<uint16_t, 4, 1, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBA16I | (Image::FORMAT_RG16I << 8):
+			_convert_fast<uint16_t, 4, 2, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+		case Image::FORMAT_RGBA16I | (Image::FORMAT_RGB16I << 8):
+			_convert_fast<uint16_t, 4, 3, 0x0000, 0x0001>(p_width, p_height, (const uint16_t *)p_src, (uint16_t *)p_dst);
+			break;
+	}
+}
+
 void Image::convert(Format p_new_format) {
 	ERR_FAIL_INDEX_MSG(p_new_format, FORMAT_MAX, vformat("The Image format specified (%d) is out of range. See Image's Format enum.", p_new_format));
 	ERR_FAIL_COND_MSG(Image::is_format_compressed(format) || Image::is_format_compressed(p_new_format),
@@ -607,6 +885,39 @@ void Image::convert(Format p_new_format) {
 	Image new_img(width, height, mipmaps, p_new_format);
 
 	const int conversion_type = format | p_new_format << 8;
+	const int src_pixel_size = get_format_pixel_size(format);
+	const int dst_pixel_size = get_format_pixel_size(p_new_format);
+
+	// Vectorized kernels for the most common 8-bit conversions.
+	void (*convert_kernel)(const uint8_t *, uint8_t *, uint32_t) = nullptr;
+	switch (conversion_type) {
+		case FORMAT_RGB8 | (FORMAT_RGBA8 << 8):
+			convert_kernel = ImageKernels::convert_rgb8_to_rgba8;
+			break;
+		case FORMAT_RGBA8 | (FORMAT_RGB8 << 8):
+			convert_kernel = ImageKernels::convert_rgba8_to_rgb8;
+			break;
+		case FORMAT_L8 | (FORMAT_RGBA8 << 8):
+			convert_kernel = ImageKernels::convert_l8_to_rgba8;
+			break;
+		case FORMAT_R8 | (FORMAT_RGBA8 << 8):
+			convert_kernel = ImageKernels::convert_r8_to_rgba8;
+			break;
+		case FORMAT_LA8 | (FORMAT_RGBA8 << 8):
+			convert_kernel = ImageKernels::convert_la8_to_rgba8;
+			break;
+		case FORMAT_RGBA8 | (FORMAT_R8 << 8):
+			convert_kernel = ImageKernels::convert_rgba8_to_r8;
+			break;
+		case FORMAT_RGBA8 | (FORMAT_L8 << 8):
+			convert_kernel = ImageKernels::convert_rgba8_to_l8;
+			break;
+		case FORMAT_RGBA8 | (FORMAT_LA8 << 8):
+			convert_kernel = ImageKernels::convert_rgba8_to_la8;
+			break;
+		default:
+			break;
+	}
 
 	for (int mip = 0; mip < mipmap_count; mip++) {
 		int64_t mip_offset = 0;
@@ -615,245 +926,21 @@ void Image::convert(Format p_new_format) {
 		int mip_height = 0;
 		get_mipmap_offset_size_and_dimensions(mip, mip_offset, mip_size, mip_width, mip_height);
 
-		const uint8_t *rptr = data.ptr() + mip_offset;
-		uint8_t *wptr = new_img.data.ptrw() + new_img.get_mipmap_offset(mip);
+		const uint8_t *mip_rptr = data.ptr() + mip_offset;
+		uint8_t *mip_wptr = new_img.data.ptrw() + new_img.get_mipmap_offset(mip);
 
-		switch (conversion_type) {
-			case FORMAT_L8 | (FORMAT_LA8 << 8):
-				_convert<1, false, 1, true, true, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_L8 | (FORMAT_R8 << 8):
-				_convert<1, false, 1, false, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_L8 | (FORMAT_RG8 << 8):
-				_convert<1, false, 2, false, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_L8 | (FORMAT_RGB8 << 8):
-				_convert<1, false, 3, false, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_L8 | (FORMAT_RGBA8 << 8):
-				_convert<1, false, 3, true, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_LA8 | (FORMAT_L8 << 8):
-				_convert<1, true, 1, false, true, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_LA8 | (FORMAT_R8 << 8):
-				_convert<1, true, 1, false, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_LA8 | (FORMAT_RG8 << 8):
-				_convert<1, true, 2, false, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_LA8 | (FORMAT_RGB8 << 8):
-				_convert<1, true, 3, false, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_LA8 | (FORMAT_RGBA8 << 8):
-				_convert<1, true, 3, true, true, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_R8 | (FORMAT_L8 << 8):
-				_convert<1, false, 1, false, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_R8 | (FORMAT_LA8 << 8):
-				_convert<1, false, 1, true, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_R8 | (FORMAT_RG8 << 8):
-				_convert<1, false, 2, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_R8 | (FORMAT_RGB8 << 8):
-				_convert<1, false, 3, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_R8 | (FORMAT_RGBA8 << 8):
-				_convert<1, false, 3, true, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RG8 | (FORMAT_L8 << 8):
-				_convert<2, false, 1, false, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RG8 | (FORMAT_LA8 << 8):
-				_convert<2, false, 1, true, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RG8 | (FORMAT_R8 << 8):
-				_convert<2, false, 1, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RG8 | (FORMAT_RGB8 << 8):
-				_convert<2, false, 3, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RG8 | (FORMAT_RGBA8 << 8):
-				_convert<2, false, 3, true, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGB8 | (FORMAT_L8 << 8):
-				_convert<3, false, 1, false, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGB8 | (FORMAT_LA8 << 8):
-				_convert<3, false, 1, true, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGB8 | (FORMAT_R8 << 8):
-				_convert<3, false, 1, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGB8 | (FORMAT_RG8 << 8):
-				_convert<3, false, 2, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGB8 | (FORMAT_RGBA8 << 8):
-				_convert<3, false, 3, true, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGBA8 | (FORMAT_L8 << 8):
-				_convert<3, true, 1, false, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGBA8 | (FORMAT_LA8 << 8):
-				_convert<3, true, 1, true, false, true>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGBA8 | (FORMAT_R8 << 8):
-				_convert<3, true, 1, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGBA8 | (FORMAT_RG8 << 8):
-				_convert<3, true, 2, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RGBA8 | (FORMAT_RGB8 << 8):
-				_convert<3, true, 3, false, false, false>(mip_width, mip_height, rptr, wptr);
-				break;
-			case FORMAT_RH | (FORMAT_RGH << 8):
-				_convert_fast<uint16_t, 1, 2, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RH | (FORMAT_RGBH << 8):
-				_convert_fast<uint16_t, 1, 3, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RH | (FORMAT_RGBAH << 8):
-				_convert_fast<uint16_t, 1, 4, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGH | (FORMAT_RH << 8):
-				_convert_fast<uint16_t, 2, 1, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGH | (FORMAT_RGBH << 8):
-				_convert_fast<uint16_t, 2, 3, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGH | (FORMAT_RGBAH << 8):
-				_convert_fast<uint16_t, 2, 4, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBH | (FORMAT_RH << 8):
-				_convert_fast<uint16_t, 3, 1, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBH | (FORMAT_RGH << 8):
-				_convert_fast<uint16_t, 3, 2, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBH | (FORMAT_RGBAH << 8):
-				_convert_fast<uint16_t, 3, 4, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBAH | (FORMAT_RH << 8):
-				_convert_fast<uint16_t, 4, 1, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBAH | (FORMAT_RGH << 8):
-				_convert_fast<uint16_t, 4, 2, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBAH | (FORMAT_RGBH << 8):
-				_convert_fast<uint16_t, 4, 3, 0x0000, 0x3C00>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RF | (FORMAT_RGF << 8):
-				_convert_fast<uint32_t, 1, 2, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RF | (FORMAT_RGBF << 8):
-				_convert_fast<uint32_t, 1, 3, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RF | (FORMAT_RGBAF << 8):
-				_convert_fast<uint32_t, 1, 4, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGF | (FORMAT_RF << 8):
-				_convert_fast<uint32_t, 2, 1, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGF | (FORMAT_RGBF << 8):
-				_convert_fast<uint32_t, 2, 3, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGF | (FORMAT_RGBAF << 8):
-				_convert_fast<uint32_t, 2, 4, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGBF | (FORMAT_RF << 8):
-				_convert_fast<uint32_t, 3, 1, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGBF | (FORMAT_RGF << 8):
-				_convert_fast<uint32_t, 3, 2, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGBF | (FORMAT_RGBAF << 8):
-				_convert_fast<uint32_t, 3, 4, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGBAF | (FORMAT_RF << 8):
-				_convert_fast<uint32_t, 4, 1, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGBAF | (FORMAT_RGF << 8):
-				_convert_fast<uint32_t, 4, 2, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_RGBAF | (FORMAT_RGBF << 8):
-				_convert_fast<uint32_t, 4, 3, 0x00000000, 0x3F800000>(mip_width, mip_height, (const uint32_t *)rptr, (uint32_t *)wptr);
-				break;
-			case FORMAT_R16 | (FORMAT_RG16 << 8):
-				_convert_fast<uint16_t, 1, 2, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_R16 | (FORMAT_RGB16 << 8):
-				_convert_fast<uint16_t, 1, 3, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_R16 | (FORMAT_RGBA16 << 8):
-				_convert_fast<uint16_t, 1, 4, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RG16 | (FORMAT_R16 << 8):
-				_convert_fast<uint16_t, 2, 1, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RG16 | (FORMAT_RGB16 << 8):
-				_convert_fast<uint16_t, 2, 3, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RG16 | (FORMAT_RGBA16 << 8):
-				_convert_fast<uint16_t, 2, 4, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGB16 | (FORMAT_R16 << 8):
-				_convert_fast<uint16_t, 3, 1, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGB16 | (FORMAT_RG16 << 8):
-				_convert_fast<uint16_t, 3, 2, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGB16 | (FORMAT_RGBA16 << 8):
-				_convert_fast<uint16_t, 3, 4, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBA16 | (FORMAT_R16 << 8):
-				_convert_fast<uint16_t, 4, 1, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBA16 | (FORMAT_RG16 << 8):
-				_convert_fast<uint16_t, 4, 2, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBA16 | (FORMAT_RGB16 << 8):
-				_convert_fast<uint16_t, 4, 3, 0x0000, 0xFFFF>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_R16I | (FORMAT_RG16I << 8):
-				_convert_fast<uint16_t, 1, 2, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_R16I | (FORMAT_RGB16I << 8):
-				_convert_fast<uint16_t, 1, 3, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_R16I | (FORMAT_RGBA16I << 8):
-				_convert_fast<uint16_t, 1, 4, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RG16I | (FORMAT_R16I << 8):
-				_convert_fast<uint16_t, 2, 1, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RG16I | (FORMAT_RGB16I << 8):
-				_convert_fast<uint16_t, 2, 3, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RG16I | (FORMAT_RGBA16I << 8):
-				_convert_fast<uint16_t, 2, 4, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGB16I | (FORMAT_R16I << 8):
-				_convert_fast<uint16_t, 3, 1, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGB16I | (FORMAT_RG16I << 8):
-				_convert_fast<uint16_t, 3, 2, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGB16I | (FORMAT_RGBA16I << 8):
-				_convert_fast<uint16_t, 3, 4, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBA16I | (FORMAT_R16I << 8):
-				_convert_fast<uint16_t, 4, 1, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBA16I | (FORMAT_RG16I << 8):
-				_convert_fast<uint16_t, 4, 2, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-			case FORMAT_RGBA16I | (FORMAT_RGB16I << 8):
-				_convert_fast<uint16_t, 4, 3, 0x0000, 0x0001>(mip_width, mip_height, (const uint16_t *)rptr, (uint16_t *)wptr);
-				break;
-		}
+		_for_each_row_strip(mip_height, uint64_t(mip_width) * (src_pixel_size + dst_pixel_size), [&](uint32_t p_from, uint32_t p_to) {
+			const uint8_t *rptr = mip_rptr + int64_t(p_from) * mip_width * src_pixel_size;
+			uint8_t *wptr = mip_wptr + int64_t(p_from) * mip_width * dst_pixel_size;
+			const int rows = p_to - p_from;
+
+			if (convert_kernel) {
+				convert_kernel(rptr, wptr, uint32_t(mip_width) * rows);
+				return;
+			}
+
+			_convert_rows(conversion_type, mip_width, rows, rptr, wptr);
+		});
 	}
 
 	_copy_internals_from(new_img);
@@ -889,85 +976,86 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int height = p_src_height;
 	double xfac = (double)width / p_dst_width;
 	double yfac = (double)height / p_dst_height;
-	// coordinates of source points and coefficients
-	double ox, oy, dx, dy;
-	int ox1, oy1, ox2, oy2;
-	// destination pixel values
 	// width and height decreased by 1
 	int ymax = height - 1;
 	int xmax = width - 1;
-	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
-		// Y coordinates
-		oy = (double)(y + 0.5) * yfac - 0.5;
-		oy1 = (int)oy;
-		dy = oy - (double)oy1;
+	_for_each_row_strip(p_dst_height, uint64_t(p_dst_width) * CC * sizeof(T) * 4, [&](uint32_t p_from, uint32_t p_to) {
+		// coordinates of source points and coefficients
+		double ox, oy, dx, dy;
+		int ox1, oy1, ox2, oy2;
 
-		for (uint32_t x = 0; x < p_dst_width; x++) {
-			// X coordinates
-			ox = (double)(x + 0.5) * xfac - 0.5;
-			ox1 = (int)ox;
-			dx = ox - (double)ox1;
+		for (uint32_t y = p_from; y < p_to; y++) {
+			// Y coordinates
+			oy = (double)(y + 0.5) * yfac - 0.5;
+			oy1 = (int)oy;
+			dy = oy - (double)oy1;
 
-			// initial pixel value
+			for (uint32_t x = 0; x < p_dst_width; x++) {
+				// X coordinates
+				ox = (double)(x + 0.5) * xfac - 0.5;
+				ox1 = (int)ox;
+				dx = ox - (double)ox1;
 
-			T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
+				// initial pixel value
 
-			double color[CC] = {};
+				T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
 
-			for (int n = -1; n < 3; n++) {
-				// get Y coefficient
-				[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
-
-				oy2 = oy1 + n;
-				if (oy2 < 0) {
-					oy2 = 0;
-				}
-				if (oy2 > ymax) {
-					oy2 = ymax;
-				}
+				double color[CC] = {};
 
-				for (int m = -1; m < 3; m++) {
-					// get X coefficient
-					[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
+				for (int n = -1; n < 3; n++) {
+					// get Y coefficient
+					[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
 
-					ox2 = ox1 + m;
-					if (ox2 < 0) {
-						ox2 = 0;
+					oy2 = oy1 + n;
+					if (oy2 < 0) {
+						oy2 = 0;
 					}
-					if (ox2 > xmax) {
-						ox2 = xmax;
+					if (oy2 > ymax) {
+						oy2 = ymax;
 					}
 
-					// get pixel of original image
-					const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+					for (int m = -1; m < 3; m++) {
+						// get X coefficient
+						[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
 
-					for (int i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
-							color[i] = Math::half_to_float(p[i]);
-						} else {
-							color[i] += p[i] * k2;
+						ox2 = ox1 + m;
+						if (ox2 < 0) {
+							ox2 = 0;
+						}
+						if (ox2 > xmax) {
+							ox2 = xmax;
+						}
+
+						// get pixel of original image
+						const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+
+						for (int i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
+								color[i] = Math::half_to_float(p[i]);
+							} else {
+								color[i] += p[i] * k2;
+							}
 						}
 					}
 				}
-			}
 
-			for (int i = 0; i < CC; i++) {
-				if constexpr (sizeof(T) == 1) { //byte
-					dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
-				} else if constexpr (sizeof(T) == 2) {
-					if constexpr (TYPE == IMAGE_SCALING_FLOAT) {
-						dst[i] = Math::make_half_float(color[i]); //half float
+				for (int i = 0; i < CC; i++) {
+					if constexpr (sizeof(T) == 1) { //byte
+						dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
+					} else if constexpr (sizeof(T) == 2) {
+						if constexpr (TYPE == IMAGE_SCALING_FLOAT) {
+							dst[i] = Math::make_half_float(color[i]); //half float
+						} else {
+							dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 65535); // uint16
+						}
 					} else {
-						dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 65535); // uint16
+						dst[i] = color[i];
 					}
-				} else {
-					dst[i] = color[i];
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T, ImageScaleType TYPE>
@@ -977,102 +1065,82 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 	constexpr uint32_t FRAC_HALF = (FRAC_LEN >> 1);
 	constexpr uint32_t FRAC_MASK = FRAC_LEN - 1;
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		// Add 0.5 in order to interpolate based on pixel center
-		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
-		// Calculate nearest src pixel center above current, and truncate to get y index
-		uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
-		uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
-		if (src_yofs_down >= p_src_height) {
-			src_yofs_down = p_src_height - 1;
+	// The horizontal sampling positions are the same for every row, compute them once.
+	LocalVector<ImageKernels::BilinearColumn> columns;
+	columns.resize(p_dst_width);
+	for (uint32_t j = 0; j < p_dst_width; j++) {
+		uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
+		uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
+		uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
+		if (src_xofs_right >= p_src_width) {
+			src_xofs_right = p_src_width - 1;
 		}
-		// Calculate distance to pixel center of src_yofs_up
-		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
-		src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
-
-		uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
-		uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
-
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
-			uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
-			uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
-			if (src_xofs_right >= p_src_width) {
-				src_xofs_right = p_src_width - 1;
+		uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
+		src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
+
+		columns[j].left = src_xofs_left * CC;
+		columns[j].right = src_xofs_right * CC;
+		columns[j].frac = src_xofs_frac;
+	}
+
+	_for_each_row_strip(p_dst_height, uint64_t(p_dst_width) * CC * sizeof(T), [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			// Add 0.5 in order to interpolate based on pixel center
+			uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
+			// Calculate nearest src pixel center above current, and truncate to get y index
+			uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
+			uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
+			if (src_yofs_down >= p_src_height) {
+				src_yofs_down = p_src_height - 1;
 			}
-			uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
-			src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
+			// Calculate distance to pixel center of src_yofs_up
+			uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
+			src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
 
-			src_xofs_left *= CC;
-			src_xofs_right *= CC;
+			uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
+			uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
 
-			for (uint32_t l = 0; l < CC; l++) {
-				if constexpr (sizeof(T) == 1) { //uint8
-					uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
-					uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
-
-					uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
-					interp >>= FRAC_BITS;
-					p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
-				} else if constexpr (sizeof(T) == 2) {
-					if constexpr (TYPE == IMAGE_SCALING_FLOAT) { //half float
-						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-						const T *src = ((const T *)p_src);
-						T *dst = ((T *)p_dst);
-
-						float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
-						float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
-						float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
-						float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
-
-						float interp_up = p00 + (p10 - p00) * xofs_frac;
-						float interp_down = p01 + (p11 - p01) * xofs_frac;
-						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+			if constexpr (sizeof(T) == 1) { //uint8
+				ImageKernels::bilinear_row_uint8<CC>(p_src + y_ofs_up, p_src + y_ofs_down, columns.ptr(), src_yofs_frac, p_dst + i * p_dst_width * CC, p_dst_width);
+			} else {
+				float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+				const T *src = ((const T *)p_src);
+				T *dst = ((T *)p_dst);
 
-						dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
-					} else { //uint16
-						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-						const T *src = ((const T *)p_src);
-						T *dst = ((T *)p_dst);
+				for (uint32_t j = 0; j < p_dst_width; j++) {
+					const ImageKernels::BilinearColumn &column = columns[j];
+					float xofs_frac = float(column.frac) / (1 << FRAC_BITS);
 
-						float p00 = src[y_ofs_up + src_xofs_left + l];
-						float p10 = src[y_ofs_up + src_xofs_right + l];
-						float p01 = src[y_ofs_down + src_xofs_left + l];
-						float p11 = src[y_ofs_down + src_xofs_right + l];
+					for (uint32_t l = 0; l < CC; l++) {
+						float p00, p10, p01, p11;
+						if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
+							p00 = Math::half_to_float(src[y_ofs_up + column.left + l]);
+							p10 = Math::half_to_float(src[y_ofs_up + column.right + l]);
+							p01 = Math::half_to_float(src[y_ofs_down + column.left + l]);
+							p11 = Math::half_to_float(src[y_ofs_down + column.right + l]);
+						} else { //uint16 and float
+							p00 = src[y_ofs_up + column.left + l];
+							p10 = src[y_ofs_up + column.right + l];
+							p01 = src[y_ofs_down + column.left + l];
+							p11 = src[y_ofs_down + column.right + l];
+						}
 
 						float interp_up = p00 + (p10 - p00) * xofs_frac;
 						float interp_down = p01 + (p11 - p01) * xofs_frac;
 						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
 
-						dst[i * p_dst_width * CC + j * CC + l] = uint16_t(interp);
+						if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) {
+							dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
+						} else if constexpr (sizeof(T) == 2) {
+							dst[i * p_dst_width * CC + j * CC + l] = uint16_t(interp);
+						} else {
+							dst[i * p_dst_width * CC + j * CC + l] = interp;
+						}
 					}
-				} else if constexpr (sizeof(T) == 4) { //float
-
-					float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-					float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-					const T *src = ((const T *)p_src);
-					T *dst = ((T *)p_dst);
-
-					float p00 = src[y_ofs_up + src_xofs_left + l];
-					float p10 = src[y_ofs_up + src_xofs_right + l];
-					float p01 = src[y_ofs_down + src_xofs_left + l];
-					float p11 = src[y_ofs_down + src_xofs_right + l];
-
-					float interp_up = p00 + (p10 - p00) * xofs_frac;
-					float interp_down = p01 + (p11 - p01) * xofs_frac;
-					float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
-
-					dst[i * p_dst_width * CC + j * CC + l] = interp;
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T>
@@ -1109,8 +1177,11 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 	int32_t dst_height = p_dst_height;
 	int32_t dst_width = p_dst_width;
 
-	uint32_t buffer_size = src_height * dst_width * CC;
-	float *buffer = memnew_arr(float, buffer_size); // Store the first pass in a buffer
+	// Both passes walk memory row by row so they can be split in strips; every output value
+	// still sums its samples in the same order as a column-by-column evaluation would.
+
+	LocalVector<float> buffer; // Store the first pass in a buffer
+	buffer.resize(src_height * dst_width * CC);
 
 	{ // FIRST PASS (horizontal)
 
@@ -1118,8 +1189,17 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
-
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		int32_t kernel_stride = half_kernel * 2;
+
+		// Create the kernels used by all the pixels of each column
+		LocalVector<float> kernels;
+		LocalVector<int32_t> starts;
+		LocalVector<int32_t> lengths;
+		LocalVector<float> weights;
+		kernels.resize(dst_width * kernel_stride);
+		starts.resize(dst_width);
+		lengths.resize(dst_width);
+		weights.resize(dst_width);
 
 		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
 			// The corresponding point on the source image
@@ -1127,39 +1207,50 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
 			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
 
-			// Create the kernel used by all the pixels of the column
+			float *kernel = kernels.ptr() + buffer_x * kernel_stride;
+			float weight = 0;
 			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
 				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+				weight += kernel[target_x - start_x];
 			}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+			starts[buffer_x] = start_x;
+			lengths[buffer_x] = end_x - start_x + 1;
+			weights[buffer_x] = weight;
+		}
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+		_for_each_row_strip(src_height, uint64_t(src_width) * CC * sizeof(T), [&](uint32_t p_from, uint32_t p_to) {
+			for (int32_t buffer_y = p_from; buffer_y < int32_t(p_to); buffer_y++) {
+				float *buffer_row = buffer.ptr() + buffer_y * dst_width * CC;
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+				if constexpr (CC == 4 && sizeof(T) == 1) {
+					ImageKernels::lanczos_row_rgba8(p_src + buffer_y * src_width * CC, buffer_row, starts.ptr(), lengths.ptr(), kernels.ptr(), kernel_stride, weights.ptr(), dst_width);
+					continue;
+				}
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
+				for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
+					const float *kernel = kernels.ptr() + buffer_x * kernel_stride;
+					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + starts[buffer_x]) * CC;
+					float pixel[CC] = { 0 };
+
+					for (int32_t k = 0; k < lengths[buffer_x]; k++) {
+						float lanczos_val = kernel[k];
+
+						for (uint32_t i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
+								pixel[i] += Math::half_to_float(src_data[k * CC + i]) * lanczos_val;
+							} else {
+								pixel[i] += src_data[k * CC + i] * lanczos_val;
+							}
 						}
 					}
-				}
-
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					for (uint32_t i = 0; i < CC; i++) {
+						buffer_row[buffer_x * CC + i] = pixel[i] / weights[buffer_x]; // Normalize the sum of all the samples
+					}
 				}
 			}
-		}
-
-		memdelete_arr(kernel);
+		});
 	} // End of first pass
 
 	{ // SECOND PASS (vertical + result)
@@ -1169,57 +1260,52 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(y_scale, 1);
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
-
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+		_for_each_row_strip(dst_height, uint64_t(dst_width) * CC * sizeof(float), [&](uint32_t p_from, uint32_t p_to) {
+			LocalVector<float> kernel;
+			kernel.resize(half_kernel * 2);
+			LocalVector<float> pixels; // Accumulated samples of a whole destination row.
+			pixels.resize(dst_width * CC);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+			for (int32_t dst_y = p_from; dst_y < int32_t(p_to); dst_y++) {
+				float buffer_y = (dst_y + 0.5f) * y_scale;
+				int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+				int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
 				float weight = 0;
+				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+					kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+					weight += kernel[target_y - start_y];
+				}
 
+				memset(pixels.ptr(), 0, pixels.size() * sizeof(float));
 				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+					ImageKernels::accumulate_f32(pixels.ptr(), buffer.ptr() + target_y * dst_width * CC, kernel[target_y - start_y], dst_width * CC);
+				}
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+				T *dst_data = ((T *)p_dst) + dst_y * dst_width * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
-					}
+				if constexpr (sizeof(T) == 1) { //byte
+					ImageKernels::normalize_f32_to_uint8(pixels.ptr(), weight, dst_data, dst_width * CC);
+					continue;
 				}
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+				for (int32_t i = 0; i < dst_width * CC; i++) {
+					float pixel = pixels[i] / weight;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
-
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) {
+					if constexpr (sizeof(T) == 2) {
 						if constexpr (TYPE == IMAGE_SCALING_FLOAT) { //half float
-							dst_data[i] = Math::make_half_float(pixel[i]);
+							dst_data[i] = Math::make_half_float(pixel);
 						} else { //uint16
-							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 65535);
+							dst_data[i] = CLAMP(Math::fast_ftoi(pixel), 0, 65535);
 						}
 
-					} else { // float
-						dst_data[i] = pixel[i];
+					} else if constexpr (sizeof(T) == 4) { // float
+						dst_data[i] = pixel;
 					}
 				}
 			}
-		}
-
-		memdelete_arr(kernel);
+		});
 	} // End of second pass
-
-	memdelete_arr(buffer);
 }
 
 static void _overlay(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, float p_alpha, uint32_t p_width, uint32_t p_height, uint32_t p_pixel_size) {
@@ -1955,27 +2041,36 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
-		const Component *rup_ptr = &p_src[i * 2 * down_step];
-		const Component *rdown_ptr = rup_ptr + down_step;
-		Component *dst_ptr = &p_dst[i * dst_w * CC];
-		uint32_t count = dst_w;
+	_for_each_row_strip(dst_h, uint64_t(p_width) * CC * sizeof(Component) * 2, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			const Component *rup_ptr = &p_src[i * 2 * down_step];
+			const Component *rdown_ptr = rup_ptr + down_step;
+			Component *dst_ptr = &p_dst[i * dst_w * CC];
 
-		while (count) {
-			count--;
-			for (int j = 0; j < CC; j++) {
-				average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+			// All 8-bit formats average with average_4_uint8, which the row kernel implements.
+			if constexpr (std::is_same_v<Component, uint8_t> && !renormalize) {
+				ImageKernels::mipmap_row_uint8<CC>(rup_ptr, rdown_ptr, dst_ptr, dst_w, right_step);
+				continue;
 			}
 
-			if constexpr (renormalize) {
-				renormalize_func(dst_ptr);
-			}
+			uint32_t count = dst_w;
+
+			while (count) {
+				count--;
+				for (int j = 0; j < CC; j++) {
+					average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+				}
 
-			dst_ptr += CC;
-			rup_ptr += right_step * 2;
-			rdown_ptr += right_step * 2;
+				if constexpr (renormalize) {
+					renormalize_func(dst_ptr);
+				}
+
+				dst_ptr += CC;
+				rup_ptr += right_step * 2;
+				rdown_ptr += right_step * 2;
+			}
 		}
-	}
+	});
 }
 
 void Image::_generate_mipmap_from_format(Image::Format p_format, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_height, bool p_renormalize) {
@@ -4228,15 +4323,9 @@ void Image::premultiply_alpha() {
 
 	uint8_t *data_ptr = data.ptrw();
 
-	for (int i = 0; i < height; i++) {
-		for (int j = 0; j < width; j++) {
-			uint8_t *ptr = &data_ptr[(i * width + j) * 4];
-
-			ptr[0] = (uint16_t(ptr[0]) * uint16_t(ptr[3]) + 255U) >> 8;
-			ptr[1] = (uint16_t(ptr[1]) * uint16_t(ptr[3]) + 255U) >> 8;
-			ptr[2] = (uint16_t(ptr[2]) * uint16_t(ptr[3]) + 255U) >> 8;
-		}
-	}
+	_for_each_row_strip(height, uint64_t(width) * 4, [&](uint32_t p_from, uint32_t p_to) {
+		ImageKernels::premultiply_rgba8(&data_ptr[int64_t(p_from) * width * 4], uint32_t(p_to - p_from) * width);
+	});
 }
 
 void Image::fix_alpha_edges() {
@@ -0,0 +1,421 @@
+/**************************************************************************/
+/*  image_kernels.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+// Row kernels for the hot 8-bit paths of Image (format conversion, premultiplication,
+// bilinear and Lanczos scaling, mipmap generation).
+// Every vector path produces exactly the same bytes as the scalar code next to it,
+// so results never depend on the CPU the image was processed on.
+namespace ImageKernels {
+
+#ifdef IMAGE_KERNELS_SSE2
+_FORCE_INLINE_ __m128i _load_u32(const uint8_t *p_src) {
+	int32_t v;
+	memcpy(&v, p_src, 4);
+	return _mm_cvtsi32_si128(v);
+}
+
+// REC.709 luminance of four RGBA8 pixels, one per 32-bit lane.
+_FORCE_INLINE_ __m128i _luminance_rgba8(__m128i p_pixels) {
+	const __m128i rb_weights = _mm_set1_epi32((4729 << 16) | 13938);
+	const __m128i g_weight = _mm_set1_epi32(46869);
+	const __m128i byte_mask = _mm_set1_epi32(0xff);
+
+	__m128i rb = _mm_madd_epi16(_mm_and_si128(p_pixels, _mm_set1_epi32(0x00ff00ff)), rb_weights);
+	// 46869 does not fit a signed 16-bit multiplier, so build the 32-bit product from both halves.
+	__m128i g = _mm_and_si128(_mm_srli_epi32(p_pixels, 8), byte_mask);
+	__m128i g_product = _mm_add_epi32(_mm_mullo_epi16(g, g_weight), _mm_slli_epi32(_mm_mulhi_epu16(g, g_weight), 16));
+	__m128i sum = _mm_add_epi32(_mm_add_epi32(rb, g_product), _mm_set1_epi32(32768));
+	return _mm_srli_epi32(sum, 16);
+}
+#endif
+
+_FORCE_INLINE_ uint8_t luminance(uint8_t p_r, uint8_t p_g, uint8_t p_b) {
+	return (13938U * p_r + 46869U * p_g + 4729U * p_b + 32768U) >> 16U;
+}
+
+/* Format conversion, `p_count` is in pixels. */
+
+inline void convert_rgb8_to_rgba8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	// Copy four bytes at a time, the extra byte read from the next pixel is replaced by the alpha.
+	for (; i + 1 < p_count; i++) {
+		memcpy(p_dst + i * 4, p_src + i * 3, 4);
+		p_dst[i * 4 + 3] = 255;
+	}
+	for (; i < p_count; i++) {
+		p_dst[i * 4 + 0] = p_src[i * 3 + 0];
+		p_dst[i * 4 + 1] = p_src[i * 3 + 1];
+		p_dst[i * 4 + 2] = p_src[i * 3 + 2];
+		p_dst[i * 4 + 3] = 255;
+	}
+}
+
+inline void convert_rgba8_to_rgb8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	// Write four bytes at a time, the extra byte is overwritten by the next pixel.
+	for (; i + 1 < p_count; i++) {
+		memcpy(p_dst + i * 3, p_src + i * 4, 4);
+	}
+	for (; i < p_count; i++) {
+		p_dst[i * 3 + 0] = p_src[i * 4 + 0];
+		p_dst[i * 3 + 1] = p_src[i * 4 + 1];
+		p_dst[i * 3 + 2] = p_src[i * 4 + 2];
+	}
+}
+
+inline void convert_l8_to_rgba8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	const __m128i alpha = _mm_set1_epi32(int32_t(0xff000000));
+	for (; i + 16 <= p_count; i += 16) {
+		__m128i l = _mm_loadu_si128((const __m128i *)(p_src + i));
+		__m128i l2_lo = _mm_unpacklo_epi8(l, l);
+		__m128i l2_hi = _mm_unpackhi_epi8(l, l);
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 0), _mm_or_si128(_mm_unpacklo_epi16(l2_lo, l2_lo), alpha));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 16), _mm_or_si128(_mm_unpackhi_epi16(l2_lo, l2_lo), alpha));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 32), _mm_or_si128(_mm_unpacklo_epi16(l2_hi, l2_hi), alpha));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 48), _mm_or_si128(_mm_unpackhi_epi16(l2_hi, l2_hi), alpha));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i * 4 + 0] = p_src[i];
+		p_dst[i * 4 + 1] = p_src[i];
+		p_dst[i * 4 + 2] = p_src[i];
+		p_dst[i * 4 + 3] = 255;
+	}
+}
+
+inline void convert_r8_to_rgba8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	const __m128i alpha = _mm_set1_epi32(int32_t(0xff000000));
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_count; i += 16) {
+		__m128i r = _mm_loadu_si128((const __m128i *)(p_src + i));
+		__m128i r16_lo = _mm_unpacklo_epi8(r, zero);
+		__m128i r16_hi = _mm_unpackhi_epi8(r, zero);
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 0), _mm_or_si128(_mm_unpacklo_epi16(r16_lo, zero), alpha));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 16), _mm_or_si128(_mm_unpackhi_epi16(r16_lo, zero), alpha));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 32), _mm_or_si128(_mm_unpacklo_epi16(r16_hi, zero), alpha));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 48), _mm_or_si128(_mm_unpackhi_epi16(r16_hi, zero), alpha));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i * 4 + 0] = p_src[i];
+		p_dst[i * 4 + 1] = 0;
+		p_dst[i * 4 + 2] = 0;
+		p_dst[i * 4 + 3] = 255;
+	}
+}
+
+inline void convert_la8_to_rgba8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	const __m128i keep_mask = _mm_set1_epi32(int32_t(0xffff00ff));
+	const __m128i byte_mask = _mm_set1_epi32(0xff);
+	for (; i + 8 <= p_count; i += 8) {
+		__m128i la = _mm_loadu_si128((const __m128i *)(p_src + i * 2));
+		// Each lane becomes L, A, L, A; then move the first L over the first A.
+		__m128i lo = _mm_unpacklo_epi16(la, la);
+		__m128i hi = _mm_unpackhi_epi16(la, la);
+		lo = _mm_or_si128(_mm_and_si128(lo, keep_mask), _mm_slli_epi32(_mm_and_si128(lo, byte_mask), 8));
+		hi = _mm_or_si128(_mm_and_si128(hi, keep_mask), _mm_slli_epi32(_mm_and_si128(hi, byte_mask), 8));
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 0), lo);
+		_mm_storeu_si128((__m128i *)(p_dst + i * 4 + 16), hi);
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i * 4 + 0] = p_src[i * 2];
+		p_dst[i * 4 + 1] = p_src[i * 2];
+		p_dst[i * 4 + 2] = p_src[i * 2];
+		p_dst[i * 4 + 3] = p_src[i * 2 + 1];
+	}
+}
+
+inline void convert_rgba8_to_r8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	const __m128i byte_mask = _mm_set1_epi32(0xff);
+	for (; i + 16 <= p_count; i += 16) {
+		__m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 0)), byte_mask);
+		__m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 16)), byte_mask);
+		__m128i c = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 32)), byte_mask);
+		__m128i d = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 48)), byte_mask);
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_src[i * 4];
+	}
+}
+
+inline void convert_rgba8_to_l8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	for (; i + 16 <= p_count; i += 16) {
+		__m128i a = _luminance_rgba8(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 0)));
+		__m128i b = _luminance_rgba8(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 16)));
+		__m128i c = _luminance_rgba8(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 32)));
+		__m128i d = _luminance_rgba8(_mm_loadu_si128((const __m128i *)(p_src + i * 4 + 48)));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = luminance(p_src[i * 4 + 0], p_src[i * 4 + 1], p_src[i * 4 + 2]);
+	}
+}
+
+inline void convert_rgba8_to_la8(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	for (; i + 8 <= p_count; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(p_src + i * 4 + 0));
+		__m128i b = _mm_loadu_si128((const __m128i *)(p_src + i * 4 + 16));
+		__m128i l = _mm_packs_epi32(_luminance_rgba8(a), _luminance_rgba8(b));
+		__m128i alpha = _mm_packs_epi32(_mm_srli_epi32(a, 24), _mm_srli_epi32(b, 24));
+		l = _mm_packus_epi16(l, l);
+		alpha = _mm_packus_epi16(alpha, alpha);
+		_mm_storeu_si128((__m128i *)(p_dst + i * 2), _mm_unpacklo_epi8(l, alpha));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i * 2 + 0] = luminance(p_src[i * 4 + 0], p_src[i * 4 + 1], p_src[i * 4 + 2]);
+		p_dst[i * 2 + 1] = p_src[i * 4 + 3];
+	}
+}
+
+/* Alpha premultiplication of RGBA8 pixels, in place. */
+
+inline void premultiply_rgba8(uint8_t *p_data, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i round = _mm_set1_epi16(255);
+	const __m128i alpha_mask = _mm_set1_epi32(int32_t(0xff000000));
+	for (; i + 4 <= p_count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p_data + i * 4));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		__m128i alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, alpha_lo), round), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, alpha_hi), round), 8);
+		__m128i result = _mm_packus_epi16(lo, hi);
+		result = _mm_or_si128(_mm_andnot_si128(alpha_mask, result), _mm_and_si128(alpha_mask, v));
+		_mm_storeu_si128((__m128i *)(p_data + i * 4), result);
+	}
+#endif
+	for (; i < p_count; i++) {
+		uint8_t *ptr = &p_data[i * 4];
+		ptr[0] = (uint16_t(ptr[0]) * uint16_t(ptr[3]) + 255U) >> 8;
+		ptr[1] = (uint16_t(ptr[1]) * uint16_t(ptr[3]) + 255U) >> 8;
+		ptr[2] = (uint16_t(ptr[2]) * uint16_t(ptr[3]) + 255U) >> 8;
+	}
+}
+
+/* Bilinear scaling, one destination row of 8-bit components. */
+
+// Horizontal sampling positions shared by every row: component offsets of the left and
+// right source pixels, and the 8-bit fixed point distance to the left one.
+struct BilinearColumn {
+	uint32_t left;
+	uint32_t right;
+	uint32_t frac;
+};
+
+template <int CC>
+inline void bilinear_row_uint8(const uint8_t *__restrict p_row_up, const uint8_t *__restrict p_row_down, const BilinearColumn *p_columns, uint32_t p_y_frac, uint8_t *__restrict p_dst, uint32_t p_dst_width) {
+	constexpr uint32_t FRAC_BITS = 8;
+
+	uint32_t x = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	if constexpr (CC == 4) {
+		// Same integer math as the scalar path, rearranged so it fits 16-bit lanes:
+		// up = p00 * 256 + (p10 - p00) * fx always lies in [0, 65280], and
+		// ((up * 256 + (down - up) * fy) >> 8) >> 8 == (up * (256 - fy) + down * fy) >> 16.
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i weight_up = _mm_set1_epi16(int16_t(256 - p_y_frac));
+		const __m128i weight_down = _mm_set1_epi16(int16_t(p_y_frac));
+		for (; x + 2 <= p_dst_width; x += 2) {
+			const BilinearColumn &c0 = p_columns[x];
+			const BilinearColumn &c1 = p_columns[x + 1];
+
+			__m128i p00 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_load_u32(p_row_up + c0.left), _load_u32(p_row_up + c1.left)), zero);
+			__m128i p10 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_load_u32(p_row_up + c0.right), _load_u32(p_row_up + c1.right)), zero);
+			__m128i p01 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_load_u32(p_row_down + c0.left), _load_u32(p_row_down + c1.left)), zero);
+			__m128i p11 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_load_u32(p_row_down + c0.right), _load_u32(p_row_down + c1.right)), zero);
+
+			__m128i fx = _mm_unpacklo_epi64(_mm_set1_epi16(int16_t(c0.frac)), _mm_set1_epi16(int16_t(c1.frac)));
+
+			__m128i up = _mm_add_epi16(_mm_slli_epi16(p00, FRAC_BITS), _mm_mullo_epi16(_mm_sub_epi16(p10, p00), fx));
+			__m128i down = _mm_add_epi16(_mm_slli_epi16(p01, FRAC_BITS), _mm_mullo_epi16(_mm_sub_epi16(p11, p01), fx));
+
+			__m128i up_lo = _mm_mullo_epi16(up, weight_up);
+			__m128i up_hi = _mm_mulhi_epu16(up, weight_up);
+			__m128i down_lo = _mm_mullo_epi16(down, weight_down);
+			__m128i down_hi = _mm_mulhi_epu16(down, weight_down);
+
+			__m128i sum0 = _mm_add_epi32(_mm_unpacklo_epi16(up_lo, up_hi), _mm_unpacklo_epi16(down_lo, down_hi));
+			__m128i sum1 = _mm_add_epi32(_mm_unpackhi_epi16(up_lo, up_hi), _mm_unpackhi_epi16(down_lo, down_hi));
+
+			__m128i result = _mm_packs_epi32(_mm_srli_epi32(sum0, 16), _mm_srli_epi32(sum1, 16));
+			_mm_storel_epi64((__m128i *)(p_dst + x * 4), _mm_packus_epi16(result, result));
+		}
+	}
+#endif
+	for (; x < p_dst_width; x++) {
+		const BilinearColumn &c = p_columns[x];
+		for (uint32_t l = 0; l < CC; l++) {
+			uint32_t p00 = p_row_up[c.left + l] << FRAC_BITS;
+			uint32_t p10 = p_row_up[c.right + l] << FRAC_BITS;
+			uint32_t p01 = p_row_down[c.left + l] << FRAC_BITS;
+			uint32_t p11 = p_row_down[c.right + l] << FRAC_BITS;
+
+			uint32_t interp_up = p00 + (((p10 - p00) * c.frac) >> FRAC_BITS);
+			uint32_t interp_down = p01 + (((p11 - p01) * c.frac) >> FRAC_BITS);
+			uint32_t interp = interp_up + (((interp_down - interp_up) * p_y_frac) >> FRAC_BITS);
+			interp >>= FRAC_BITS;
+			p_dst[x * CC + l] = uint8_t(interp);
+		}
+	}
+}
+
+/* Lanczos scaling helpers. */
+
+// Horizontal pass for one RGBA8 row: each destination column is the weighted sum of
+// `p_lengths[x]` source pixels starting at `p_starts[x]`, divided by `p_weights[x]`.
+inline void lanczos_row_rgba8(const uint8_t *__restrict p_src_row, float *__restrict p_dst_row, const int32_t *p_starts, const int32_t *p_lengths, const float *p_kernels, uint32_t p_kernel_stride, const float *p_weights, uint32_t p_dst_width) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		const uint8_t *src = p_src_row + p_starts[x] * 4;
+		const float *kernel = p_kernels + x * p_kernel_stride;
+		const int32_t length = p_lengths[x];
+#ifdef IMAGE_KERNELS_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		__m128 pixel = _mm_setzero_ps();
+		for (int32_t k = 0; k < length; k++) {
+			__m128 value = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_load_u32(src + k * 4), zero), zero));
+			pixel = _mm_add_ps(pixel, _mm_mul_ps(value, _mm_set1_ps(kernel[k])));
+		}
+		_mm_storeu_ps(p_dst_row + x * 4, _mm_div_ps(pixel, _mm_set1_ps(p_weights[x])));
+#else
+		float pixel[4] = { 0, 0, 0, 0 };
+		for (int32_t k = 0; k < length; k++) {
+			for (uint32_t i = 0; i < 4; i++) {
+				pixel[i] += src[k * 4 + i] * kernel[k];
+			}
+		}
+		for (uint32_t i = 0; i < 4; i++) {
+			p_dst_row[x * 4 + i] = pixel[i] / p_weights[x];
+		}
+#endif
+	}
+}
+
+// p_acc[i] += p_src[i] * p_weight
+inline void accumulate_f32(float *__restrict p_acc, const float *__restrict p_src, float p_weight, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	const __m128 weight = _mm_set1_ps(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(p_acc + i, _mm_add_ps(_mm_loadu_ps(p_acc + i), _mm_mul_ps(_mm_loadu_ps(p_src + i), weight)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_acc[i] += p_src[i] * p_weight;
+	}
+}
+
+// p_dst[i] = CLAMP(rint(p_src[i] / p_weight), 0, 255)
+inline void normalize_f32_to_uint8(const float *__restrict p_src, float p_weight, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	// cvtps rounds to nearest even like rint, and saturating packs clamp (out of range and NaN become 0).
+	const __m128 weight = _mm_set1_ps(p_weight);
+	for (; i + 8 <= p_count; i += 8) {
+		__m128i a = _mm_cvtps_epi32(_mm_div_ps(_mm_loadu_ps(p_src + i), weight));
+		__m128i b = _mm_cvtps_epi32(_mm_div_ps(_mm_loadu_ps(p_src + i + 4), weight));
+		__m128i packed = _mm_packs_epi32(a, b);
+		_mm_storel_epi64((__m128i *)(p_dst + i), _mm_packus_epi16(packed, packed));
+	}
+#endif
+	for (; i < p_count; i++) {
+		int value = std::rint(p_src[i] / p_weight);
+		p_dst[i] = CLAMP(value, 0, 255);
+	}
+}
+
+/* Mipmap generation, one destination row of 8-bit components. */
+
+template <int CC>
+inline void mipmap_row_uint8(const uint8_t *__restrict p_row_up, const uint8_t *__restrict p_row_down, uint8_t *__restrict p_dst, uint32_t p_dst_width, uint32_t p_right_step) {
+	uint32_t x = 0;
+#ifdef IMAGE_KERNELS_SSE2
+	if constexpr (CC == 4) {
+		if (p_right_step == CC) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i round = _mm_set1_epi16(2);
+			for (; x + 2 <= p_dst_width; x += 2) {
+				__m128i up = _mm_loadu_si128((const __m128i *)(p_row_up + x * 8));
+				__m128i down = _mm_loadu_si128((const __m128i *)(p_row_down + x * 8));
+				// Pixels 0 and 2 in the low half, 1 and 3 in the high half.
+				up = _mm_shuffle_epi32(up, _MM_SHUFFLE(3, 1, 2, 0));
+				down = _mm_shuffle_epi32(down, _MM_SHUFFLE(3, 1, 2, 0));
+				__m128i sum = _mm_add_epi16(_mm_unpacklo_epi8(up, zero), _mm_unpackhi_epi8(up, zero));
+				sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_unpacklo_epi8(down, zero), _mm_unpackhi_epi8(down, zero)));
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+				_mm_storel_epi64((__m128i *)(p_dst + x * 4), _mm_packus_epi16(sum, sum));
+			}
+		}
+	}
+#endif
+	const uint8_t *rup_ptr = p_row_up + x * p_right_step * 2;
+	const uint8_t *rdown_ptr = p_row_down + x * p_right_step * 2;
+	for (; x < p_dst_width; x++) {
+		for (int j = 0; j < CC; j++) {
+			p_dst[x * CC + j] = static_cast<uint8_t>((rup_ptr[j] + rup_ptr[j + p_right_step] + rdown_ptr[j] + rdown_ptr[j + p_right_step] + 2) >> 2);
+		}
+		rup_ptr += p_right_step * 2;
+		rdown_ptr += p_right_step * 2;
+	}
+}
+
+} // namespace ImageKernels
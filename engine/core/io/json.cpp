@@ -33,8 +33,18 @@
 #include "core/config/engine.h"
 #include "core/io/file_access.h"
 #include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/container_type_validate.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
 	"'}'",
@@ -559,6 +569,681 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 	return ERR_PARSE_ERROR;
 }
 
+// Parses UTF-8 bytes directly, without widening the whole document into a String first.
+// Tokens follow JSON::_get_token(), so values, error messages and lines match JSON::parse().
+// Strings and whitespace are scanned 16 bytes at a time where SSE2 is available.
+class JSONParserUTF8 {
+	friend class JSON;
+
+	enum {
+		KEY_CACHE_SIZE = 64,
+	};
+
+	struct Token {
+		JSON::TokenType type = JSON::TK_EOF;
+		const uint8_t *start = nullptr; // Contents of identifiers, numbers and strings.
+		uint32_t length = 0;
+		bool non_ascii = false;
+		bool integer = false;
+		double number = 0;
+	};
+
+	// Object keys repeat a lot (e.g. every note of a chart has the same ones),
+	// so reuse the String for keys already seen instead of allocating a new one.
+	struct KeyCacheEntry {
+		const uint8_t *bytes = nullptr;
+		uint32_t length = 0;
+		String key;
+	};
+
+	const uint8_t *ptr = nullptr;
+	const uint8_t *end = nullptr;
+	int line = 0;
+	bool typed_arrays = false;
+	String err_str;
+	LocalVector<uint8_t> unescaped;
+	KeyCacheEntry key_cache[KEY_CACHE_SIZE];
+
+	static _FORCE_INLINE_ uint32_t _ctz(uint32_t p_mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return index;
+#else
+		return __builtin_ctz(p_mask);
+#endif
+	}
+
+	_FORCE_INLINE_ void _count_lines(uint32_t p_newlines) {
+		while (p_newlines) {
+			p_newlines &= p_newlines - 1;
+			line++;
+		}
+	}
+
+	void _skip_whitespace();
+	void _scan_string(uint32_t &r_high_bits);
+	Error _get_escaped_string(Token &r_token, const uint8_t *p_start, bool p_non_ascii);
+	Error _get_token(Token &r_token);
+	String _make_string(const Token &p_token) const;
+	String _make_key(const Token &p_token);
+	Error _parse_value(Variant &r_value, Token &p_token, int p_depth);
+	Error _parse_array(Variant &r_value, int p_depth);
+	Error _parse_object(Dictionary &r_object, int p_depth);
+
+	static bool _parse_int64(const uint8_t *p_start, const uint8_t *p_end, int64_t &r_value);
+	static void _append_utf8(LocalVector<uint8_t> &r_buffer, char32_t p_char);
+	static bool _read_hex(const uint8_t *p_ptr, const uint8_t *p_end, char32_t &r_value, String &r_err_str);
+};
+
+void JSONParserUTF8::_skip_whitespace() {
+	// Like JSON::_get_token(), anything from 1 to 32 is whitespace and 0 ends the document.
+#ifdef JSON_SCAN_SSE2
+	const __m128i space = _mm_set1_epi8(32);
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i zero = _mm_setzero_si128();
+	while (end - ptr >= 16) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i *)ptr);
+		const uint32_t at_most_space = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(chunk, space), zero));
+		const uint32_t nul = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+		const uint32_t newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+		const uint32_t other = ~(at_most_space & ~nul) & 0xffff;
+		if (other) {
+			const uint32_t count = _ctz(other);
+			_count_lines(newlines & ((1u << count) - 1));
+			ptr += count;
+			return;
+		}
+		_count_lines(newlines);
+		ptr += 16;
+	}
+#endif
+	while (ptr < end && *ptr != 0 && *ptr <= 32) {
+		if (*ptr == '\n') {
+			line++;
+		}
+		ptr++;
+	}
+}
+
+void JSONParserUTF8::_scan_string(uint32_t &r_high_bits) {
+	// Stops at anything that needs attention: the closing quote, escapes, newlines (for line counting) and the end.
+#ifdef JSON_SCAN_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i zero = _mm_setzero_si128();
+	while (end - ptr >= 16) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i *)ptr);
+		const __m128i special = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, zero)));
+		const uint32_t stops = _mm_movemask_epi8(special);
+		const uint32_t high_bits = _mm_movemask_epi8(chunk);
+		if (stops) {
+			const uint32_t count = _ctz(stops);
+			r_high_bits |= high_bits & ((1u << count) - 1);
+			ptr += count;
+			return;
+		}
+		r_high_bits |= high_bits;
+		ptr += 16;
+	}
+#endif
+	while (ptr < end) {
+		const uint8_t c = *ptr;
+		if (c == '"' || c == '\\' || c == '\n' || c == 0) {
+			return;
+		}
+		r_high_bits |= c & 0x80;
+		ptr++;
+	}
+}
+
+bool JSONParserUTF8::_read_hex(const uint8_t *p_ptr, const uint8_t *p_end, char32_t &r_value, String &r_err_str) {
+	r_value = 0;
+	for (int j = 0; j < 4; j++) {
+		if (p_ptr + j >= p_end || p_ptr[j] == 0) {
+			r_err_str = "Unterminated string";
+			return false;
+		}
+		const char32_t c = p_ptr[j];
+		if (!is_hex_digit(c)) {
+			r_err_str = "Malformed hex constant in string";
+			return false;
+		}
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else {
+			v = c - 'A' + 10;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return true;
+}
+
+void JSONParserUTF8::_append_utf8(LocalVector<uint8_t> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(0xc0 | (p_char >> 6));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(0xe0 | (p_char >> 12));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		r_buffer.push_back(0xf0 | (p_char >> 18));
+		r_buffer.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	}
+}
+
+Error JSONParserUTF8::_get_escaped_string(Token &r_token, const uint8_t *p_start, bool p_non_ascii) {
+	// Slow path, strings with escapes are decoded into a scratch buffer.
+	unescaped.clear();
+	for (const uint8_t *c = p_start; c < ptr; c++) {
+		unescaped.push_back(*c);
+	}
+	bool non_ascii = p_non_ascii;
+
+	while (true) {
+		if (ptr >= end || *ptr == 0) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+		const uint8_t c = *ptr;
+		if (c == '"') {
+			ptr++;
+			break;
+		}
+		if (c != '\\') {
+			if (c == '\n') {
+				line++;
+			}
+			non_ascii = non_ascii || c >= 0x80;
+			unescaped.push_back(c);
+			ptr++;
+			continue;
+		}
+
+		ptr++;
+		if (ptr >= end || *ptr == 0) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+		char32_t res = 0;
+		switch (*ptr) {
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case 'u': {
+				if (!_read_hex(ptr + 1, end, res, err_str)) {
+					return ERR_PARSE_ERROR;
+				}
+				ptr += 4;
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (ptr + 2 >= end || ptr[1] != '\\' || ptr[2] != 'u') {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					ptr += 2;
+					char32_t trail;
+					if (!_read_hex(ptr + 1, end, trail, err_str)) {
+						return ERR_PARSE_ERROR;
+					}
+					if ((trail & 0xfffffc00) == 0xdc00) {
+						res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+						ptr += 4;
+					} else {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+					return ERR_PARSE_ERROR;
+				}
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				res = *ptr;
+			} break;
+			default: {
+				err_str = "Invalid escape sequence";
+				return ERR_PARSE_ERROR;
+			}
+		}
+		non_ascii = non_ascii || res >= 0x80;
+		_append_utf8(unescaped, res);
+		ptr++;
+	}
+
+	r_token.type = JSON::TK_STRING;
+	r_token.start = unescaped.ptr();
+	r_token.length = unescaped.size();
+	r_token.non_ascii = non_ascii;
+	return OK;
+}
+
+bool JSONParserUTF8::_parse_int64(const uint8_t *p_start, const uint8_t *p_end, int64_t &r_value) {
+	bool negative = false;
+	if (p_start < p_end && *p_start == '-') {
+		negative = true;
+		p_start++;
+	}
+	if (p_start == p_end) {
+		return false;
+	}
+	uint64_t value = 0;
+	for (; p_start < p_end; p_start++) {
+		if (!is_digit(*p_start)) {
+			return false;
+		}
+		const uint64_t digit = *p_start - '0';
+		if (value > (UINT64_MAX - digit) / 10) {
+			return false;
+		}
+		value = value * 10 + digit;
+	}
+	if (negative) {
+		if (value > uint64_t(INT64_MAX) + 1) {
+			return false;
+		}
+		r_value = int64_t(0 - value);
+	} else {
+		if (value > uint64_t(INT64_MAX)) {
+			return false;
+		}
+		r_value = int64_t(value);
+	}
+	return true;
+}
+
+Error JSONParserUTF8::_get_token(Token &r_token) {
+	_skip_whitespace();
+	if (ptr >= end || *ptr == 0) {
+		r_token.type = JSON::TK_EOF;
+		return OK;
+	}
+
+	switch (*ptr) {
+		case '{': {
+			r_token.type = JSON::TK_CURLY_BRACKET_OPEN;
+			ptr++;
+			return OK;
+		}
+		case '}': {
+			r_token.type = JSON::TK_CURLY_BRACKET_CLOSE;
+			ptr++;
+			return OK;
+		}
+		case '[': {
+			r_token.type = JSON::TK_BRACKET_OPEN;
+			ptr++;
+			return OK;
+		}
+		case ']': {
+			r_token.type = JSON::TK_BRACKET_CLOSE;
+			ptr++;
+			return OK;
+		}
+		case ':': {
+			r_token.type = JSON::TK_COLON;
+			ptr++;
+			return OK;
+		}
+		case ',': {
+			r_token.type = JSON::TK_COMMA;
+			ptr++;
+			return OK;
+		}
+		case '"': {
+			ptr++;
+			const uint8_t *start = ptr;
+			uint32_t high_bits = 0;
+			while (true) {
+				_scan_string(high_bits);
+				if (ptr >= end || *ptr == 0) {
+					err_str = "Unterminated string";
+					return ERR_PARSE_ERROR;
+				} else if (*ptr == '"') {
+					r_token.type = JSON::TK_STRING;
+					r_token.start = start;
+					r_token.length = ptr - start;
+					r_token.non_ascii = high_bits != 0;
+					ptr++;
+					return OK;
+				} else if (*ptr == '\n') {
+					line++;
+					ptr++;
+				} else {
+					return _get_escaped_string(r_token, start, high_bits != 0);
+				}
+			}
+		}
+		default: {
+			const uint8_t *start = ptr;
+			if (*ptr == '-' || is_digit(*ptr)) {
+				const uint8_t *run_end = ptr;
+				while (run_end < end && (is_digit(*run_end) || *run_end == '-' || *run_end == '+' || *run_end == '.' || *run_end == 'e' || *run_end == 'E')) {
+					run_end++;
+				}
+				const char *number_end = nullptr;
+				if (run_end < end) {
+					// The number is followed by something else, so the conversion stops inside the buffer.
+					r_token.number = String::to_float((const char *)start, &number_end);
+				} else {
+					// The buffer isn't NUL-terminated.
+					CharString terminated;
+					terminated.resize_uninitialized(run_end - start + 1);
+					memcpy(terminated.ptrw(), start, run_end - start);
+					terminated.ptrw()[run_end - start] = 0;
+					r_token.number = String::to_float(terminated.get_data(), &number_end);
+					number_end = (const char *)start + (number_end - terminated.get_data());
+				}
+				ptr = (const uint8_t *)number_end;
+
+				r_token.type = JSON::TK_NUMBER;
+				r_token.start = start;
+				r_token.length = ptr - start;
+				r_token.integer = true;
+				for (const uint8_t *c = start; c < ptr; c++) {
+					if (*c == '.' || *c == 'e' || *c == 'E') {
+						r_token.integer = false;
+						break;
+					}
+				}
+				return OK;
+			} else if (is_ascii_alphabet_char(*ptr)) {
+				while (ptr < end && is_ascii_alphabet_char(*ptr)) {
+					ptr++;
+				}
+				r_token.type = JSON::TK_IDENTIFIER;
+				r_token.start = start;
+				r_token.length = ptr - start;
+				return OK;
+			} else {
+				err_str = "Unexpected character";
+				return ERR_PARSE_ERROR;
+			}
+		}
+	}
+}
+
+String JSONParserUTF8::_make_string(const Token &p_token) const {
+	if (p_token.non_ascii) {
+		return String::utf8((const char *)p_token.start, p_token.length);
+	}
+	return String::latin1(Span<char>((const char *)p_token.start, p_token.length));
+}
+
+String JSONParserUTF8::_make_key(const Token &p_token) {
+	if (p_token.start == unescaped.ptr()) {
+		// Escaped keys live in the scratch buffer, which is reused.
+		return _make_string(p_token);
+	}
+	KeyCacheEntry &entry = key_cache[hash_murmur3_buffer(p_token.start, p_token.length) & (KEY_CACHE_SIZE - 1)];
+	if (entry.bytes && entry.length == p_token.length && memcmp(entry.bytes, p_token.start, p_token.length) == 0) {
+		return entry.key;
+	}
+	entry.bytes = p_token.start;
+	entry.length = p_token.length;
+	entry.key = _make_string(p_token);
+	return entry.key;
+}
+
+Error JSONParserUTF8::_parse_value(Variant &r_value, Token &p_token, int p_depth) {
+	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+		err_str = "JSON structure is too deep";
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	switch (p_token.type) {
+		case JSON::TK_CURLY_BRACKET_OPEN: {
+			Dictionary d;
+			Error err = _parse_object(d, p_depth + 1);
+			if (err) {
+				return err;
+			}
+			r_value = d;
+		} break;
+		case JSON::TK_BRACKET_OPEN: {
+			return _parse_array(r_value, p_depth + 1);
+		}
+		case JSON::TK_IDENTIFIER: {
+			const Span<char> id((const char *)p_token.start, p_token.length);
+			if (p_token.length == 4 && memcmp(p_token.start, "true", 4) == 0) {
+				r_value = true;
+			} else if (p_token.length == 5 && memcmp(p_token.start, "false", 5) == 0) {
+				r_value = false;
+			} else if (p_token.length == 4 && memcmp(p_token.start, "null", 4) == 0) {
+				r_value = Variant();
+			} else {
+				err_str = vformat("Expected 'true', 'false', or 'null', got '%s'", String::latin1(id));
+				return ERR_PARSE_ERROR;
+			}
+		} break;
+		case JSON::TK_NUMBER: {
+			r_value = p_token.number;
+		} break;
+		case JSON::TK_STRING: {
+			r_value = _make_string(p_token);
+		} break;
+		default: {
+			err_str = vformat("Expected value, got '%s'", String(JSON::tk_name[p_token.type]));
+			return ERR_PARSE_ERROR;
+		}
+	}
+
+	return OK;
+}
+
+Error JSONParserUTF8::_parse_array(Variant &r_value, int p_depth) {
+	Array array;
+	Token token;
+	bool need_comma = false;
+
+	// With typed arrays, numbers are gathered as they come, and only turned into
+	// Variants if something else than a number shows up.
+	bool numeric = typed_arrays;
+	bool integers = true;
+	LocalVector<double> floats;
+	LocalVector<int64_t> ints;
+
+	while (ptr < end) {
+		Error err = _get_token(token);
+		if (err != OK) {
+			return err;
+		}
+
+		if (token.type == JSON::TK_BRACKET_CLOSE) {
+			if (numeric && !floats.is_empty()) {
+				if (integers) {
+					PackedInt64Array packed;
+					packed.resize(ints.size());
+					memcpy(packed.ptrw(), ints.ptr(), ints.size() * sizeof(int64_t));
+					r_value = packed;
+				} else {
+					PackedFloat64Array packed;
+					packed.resize(floats.size());
+					memcpy(packed.ptrw(), floats.ptr(), floats.size() * sizeof(double));
+					r_value = packed;
+				}
+			} else {
+				r_value = array;
+			}
+			return OK;
+		}
+
+		if (need_comma) {
+			if (token.type != JSON::TK_COMMA) {
+				err_str = "Expected ','";
+				return ERR_PARSE_ERROR;
+			} else {
+				need_comma = false;
+				continue;
+			}
+		}
+
+		if (numeric) {
+			if (token.type == JSON::TK_NUMBER) {
+				floats.push_back(token.number);
+				if (integers) {
+					int64_t value;
+					if (token.integer && _parse_int64(token.start, token.start + token.length, value)) {
+						ints.push_back(value);
+					} else {
+						integers = false;
+						ints.clear();
+					}
+				}
+				need_comma = true;
+				continue;
+			}
+			numeric = false;
+			array.resize(floats.size());
+			for (uint32_t i = 0; i < floats.size(); i++) {
+				array[i] = floats[i];
+			}
+		}
+
+		Variant v;
+		err = _parse_value(v, token, p_depth);
+		if (err) {
+			return err;
+		}
+
+		array.push_back(v);
+		need_comma = true;
+	}
+
+	err_str = "Expected ']'";
+	return ERR_PARSE_ERROR;
+}
+
+Error JSONParserUTF8::_parse_object(Dictionary &r_object, int p_depth) {
+	bool at_key = true;
+	String key;
+	Token token;
+	bool need_comma = false;
+
+	while (ptr < end) {
+		if (at_key) {
+			Error err = _get_token(token);
+			if (err != OK) {
+				return err;
+			}
+
+			if (token.type == JSON::TK_CURLY_BRACKET_CLOSE) {
+				return OK;
+			}
+
+			if (need_comma) {
+				if (token.type != JSON::TK_COMMA) {
+					err_str = "Expected '}' or ','";
+					return ERR_PARSE_ERROR;
+				} else {
+					need_comma = false;
+					continue;
+				}
+			}
+
+			if (token.type != JSON::TK_STRING) {
+				err_str = "Expected key";
+				return ERR_PARSE_ERROR;
+			}
+
+			key = _make_key(token);
+			err = _get_token(token);
+			if (err != OK) {
+				return err;
+			}
+			if (token.type != JSON::TK_COLON) {
+				err_str = "Expected ':'";
+				return ERR_PARSE_ERROR;
+			}
+			at_key = false;
+		} else {
+			Error err = _get_token(token);
+			if (err != OK) {
+				return err;
+			}
+
+			Variant v;
+			err = _parse_value(v, token, p_depth);
+			if (err) {
+				return err;
+			}
+			r_object[key] = v;
+			need_comma = true;
+			at_key = true;
+		}
+	}
+
+	err_str = "Expected '}'";
+	return ERR_PARSE_ERROR;
+}
+
+Error JSON::_parse_utf8(const uint8_t *p_data, int64_t p_len, bool p_typed_arrays, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	r_err_line = 0;
+	if (p_len >= 3 && p_data[0] == 0xef && p_data[1] == 0xbb && p_data[2] == 0xbf) {
+		// Skip the BOM, like String::utf8() does.
+		p_data += 3;
+		p_len -= 3;
+	}
+	if (p_len <= 0) {
+		r_err_str = "Unknown error getting token";
+		return ERR_PARSE_ERROR;
+	}
+
+	JSONParserUTF8 parser;
+	parser.ptr = p_data;
+	parser.end = p_data + p_len;
+	parser.typed_arrays = p_typed_arrays;
+
+	JSONParserUTF8::Token token;
+	Error err = parser._get_token(token);
+	if (err == OK) {
+		err = parser._parse_value(r_ret, token, 0);
+
+		// Check if EOF is reached
+		// or it's a type of the next token.
+		if (err == OK && parser.ptr < parser.end) {
+			err = parser._get_token(token);
+			if (err || token.type != TK_EOF) {
+				parser.err_str = "Expected 'EOF'";
+				// Reset return value to empty `Variant`
+				r_ret = Variant();
+				err = ERR_PARSE_ERROR;
+			}
+		}
+	}
+
+	r_err_line = parser.line;
+	if (err != OK) {
+		r_err_str = parser.err_str;
+	}
+	return err;
+}
+
 void JSON::set_data(const Variant &p_data) {
 	data = p_data;
 	text.clear();
@@ -606,6 +1291,15 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+Error JSON::parse_utf8(const PackedByteArray &p_json_utf8, bool p_typed_arrays) {
+	text.clear();
+	Error err = _parse_utf8(p_json_utf8.ptr(), p_json_utf8.size(), p_typed_arrays, data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
@@ -629,6 +1323,7 @@ void JSON::_bind_methods() {
 	ClassDB::bind_static_method("JSON", D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_static_method("JSON", D_METHOD("parse_string", "json_string"), &JSON::parse_string);
 	ClassDB::bind_method(D_METHOD("parse", "json_text", "keep_text"), &JSON::parse, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("parse_utf8", "json_utf8", "typed_arrays"), &JSON::parse_utf8, DEFVAL(false));
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &JSON::set_data);
@@ -1563,7 +2258,13 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Error err;
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// The editor needs the text to be able to edit the file.
+		err = json->parse(FileAccess::get_file_as_string(p_path), true);
+	} else {
+		err = json->parse_utf8(FileAccess::get_file_as_bytes(p_path));
+	}
 	if (err != OK) {
 		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
 
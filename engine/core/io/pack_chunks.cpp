@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  pack_chunks.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "pack_chunks.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
+#include "core/io/delta_encoding.h"
+
+// Gear hash table used by the rolling hash. Generated with splitmix64 so it is the same on every platform.
+struct GearTable {
+	uint64_t values[256];
+
+	GearTable() {
+		uint64_t state = 0x50434b4348554e4bULL; // "PCKCHUNK".
+		for (int i = 0; i < 256; i++) {
+			state += 0x9e3779b97f4a7c15ULL;
+			uint64_t z = state;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			values[i] = z ^ (z >> 31);
+		}
+	}
+};
+
+static const uint64_t *_get_gear_table() {
+	static const GearTable table;
+	return table.values;
+}
+
+// Normalized chunking (FastCDC): a harder mask before the average size and an easier one after
+// keeps chunk sizes close to the average. The masks use the high bits, which mix the most bytes.
+static constexpr uint64_t MASK_BEFORE_AVG = 0xffffc00000000000ULL; // 18 bits.
+static constexpr uint64_t MASK_AFTER_AVG = 0xfffc000000000000ULL; // 14 bits.
+
+static uint64_t _find_cut(const uint8_t *p_data, uint64_t p_size, const uint64_t *p_gear) {
+	if (p_size <= PackChunks::MIN_CHUNK_SIZE) {
+		return p_size;
+	}
+	uint64_t end = MIN(p_size, (uint64_t)PackChunks::MAX_CHUNK_SIZE);
+	uint64_t normal = MIN(end, (uint64_t)PackChunks::AVG_CHUNK_SIZE);
+	uint64_t hash = 0;
+	uint64_t i = PackChunks::MIN_CHUNK_SIZE;
+	for (; i < normal; i++) {
+		hash = (hash << 1) + p_gear[p_data[i]];
+		if (!(hash & MASK_BEFORE_AVG)) {
+			return i + 1;
+		}
+	}
+	for (; i < end; i++) {
+		hash = (hash << 1) + p_gear[p_data[i]];
+		if (!(hash & MASK_AFTER_AVG)) {
+			return i + 1;
+		}
+	}
+	return end;
+}
+
+void PackChunks::split(const uint8_t *p_data, uint64_t p_size, LocalVector<uint64_t> &r_ends) {
+	const uint64_t *gear = _get_gear_table();
+	uint64_t pos = 0;
+	while (pos < p_size) {
+		pos += _find_cut(p_data + pos, p_size - pos, gear);
+		r_ends.push_back(pos);
+	}
+}
+
+PackChunks::Hash PackChunks::hash_chunk(const uint8_t *p_data, uint64_t p_size) {
+	Hash hash;
+	CryptoCore::sha256(p_data, p_size, hash.bytes);
+	return hash;
+}
+
+Error PackChunks::read_chunk_table(const Ref<FileAccess> &p_file, const String &p_pack_path, uint64_t p_file_base, ChunkMap &r_chunks) {
+	uint32_t count = p_file->get_32();
+	ERR_FAIL_COND_V_MSG(p_file->get_length() - p_file->get_position() < (uint64_t)count * CHUNK_ENTRY_SIZE, ERR_FILE_CORRUPT, vformat("Chunk table of pack \"%s\" is truncated.", p_pack_path));
+
+	for (uint32_t i = 0; i < count; i++) {
+		Hash hash;
+		p_file->get_buffer(hash.bytes, 32);
+		Chunk chunk;
+		chunk.pack = p_pack_path;
+		chunk.offset = p_file->get_64() + p_file_base;
+		chunk.stored_size = p_file->get_32();
+		chunk.size = p_file->get_32();
+		uint32_t encoding = p_file->get_32();
+		ERR_FAIL_COND_V_MSG(encoding > ENCODING_DELTA, ERR_FILE_CORRUPT, vformat("Unknown chunk encoding in pack \"%s\".", p_pack_path));
+		chunk.encoding = Encoding(encoding);
+		p_file->get_buffer(chunk.base.bytes, 32);
+		// Compressed and delta chunks are only stored when they're smaller than the chunk.
+		ERR_FAIL_COND_V_MSG(chunk.size > MAX_CHUNK_SIZE || chunk.stored_size > chunk.size || (chunk.encoding == ENCODING_RAW && chunk.stored_size != chunk.size), ERR_FILE_CORRUPT, vformat("Invalid chunk size in pack \"%s\".", p_pack_path));
+		ERR_FAIL_COND_V_MSG(chunk.offset > p_file->get_length() || p_file->get_length() - chunk.offset < chunk.stored_size, ERR_FILE_CORRUPT, vformat("Chunk data in pack \"%s\" is out of bounds.", p_pack_path));
+		r_chunks.insert(hash, chunk);
+	}
+	return OK;
+}
+
+int PackChunks::get_delta_depth(const ChunkMap &p_chunks, const Hash &p_hash) {
+	int depth = 0;
+	const Chunk *chunk = p_chunks.getptr(p_hash);
+	while (chunk && chunk->encoding == ENCODING_DELTA) {
+		depth++;
+		if (depth > MAX_DELTA_DEPTH) {
+			return -1;
+		}
+		chunk = p_chunks.getptr(chunk->base);
+	}
+	return chunk ? depth : -1;
+}
+
+Error PackChunks::read_chunk(const ChunkMap &p_chunks, const Hash &p_hash, PackFiles &r_packs, Vector<uint8_t> &r_data, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > MAX_DELTA_DEPTH, ERR_FILE_CORRUPT, "Chain of delta chunks is too deep.");
+	const Chunk *chunk = p_chunks.getptr(p_hash);
+	ERR_FAIL_NULL_V_MSG(chunk, ERR_FILE_MISSING_DEPENDENCIES, "Chunk is not in any loaded pack. Load the base packs of a patch before the patch itself.");
+
+	Ref<FileAccess> *cached = r_packs.getptr(chunk->pack);
+	Ref<FileAccess> f;
+	if (cached) {
+		f = *cached;
+	} else {
+		f = FileAccess::open(chunk->pack, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, vformat("Can't open pack \"%s\".", chunk->pack));
+		r_packs.insert(chunk->pack, f);
+	}
+
+	Vector<uint8_t> stored;
+	stored.resize(chunk->stored_size);
+	f->seek(chunk->offset);
+	ERR_FAIL_COND_V_MSG(f->get_buffer(stored.ptrw(), chunk->stored_size) != chunk->stored_size, ERR_FILE_CORRUPT, vformat("Chunk data in pack \"%s\" is truncated.", chunk->pack));
+
+	switch (chunk->encoding) {
+		case ENCODING_RAW: {
+			r_data = stored;
+		} break;
+		case ENCODING_ZSTD: {
+			r_data.resize(chunk->size);
+			int64_t size = Compression::decompress(r_data.ptrw(), chunk->size, stored.ptr(), chunk->stored_size, Compression::MODE_ZSTD);
+			ERR_FAIL_COND_V_MSG(size != chunk->size, ERR_FILE_CORRUPT, vformat("Failed to decompress chunk in pack \"%s\".", chunk->pack));
+		} break;
+		case ENCODING_DELTA: {
+			Vector<uint8_t> base;
+			Error err = read_chunk(p_chunks, chunk->base, r_packs, base, p_depth + 1);
+			ERR_FAIL_COND_V(err != OK, err);
+			err = DeltaEncoding::decode_delta(Span<uint8_t>(base.ptr(), base.size()), Span<uint8_t>(stored.ptr(), stored.size()), r_data);
+			ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta chunk in pack \"%s\".", chunk->pack));
+			ERR_FAIL_COND_V_MSG(r_data.size() != chunk->size, ERR_FILE_CORRUPT, vformat("Delta chunk in pack \"%s\" has the wrong size.", chunk->pack));
+		} break;
+	}
+	return OK;
+}
@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  pack_chunks.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Content-defined chunks of chunked PCKs (format version 4).
+// Files are cut where a rolling hash of the content matches, so an edit only changes
+// the chunks around it. Chunks are addressed by their SHA-256, which lets a pack reuse
+// the chunks of packs loaded before it: patches only carry the chunks that changed,
+// and packs sharing content only store it once.
+class PackChunks {
+public:
+	static constexpr uint32_t MIN_CHUNK_SIZE = 16 * 1024;
+	static constexpr uint32_t AVG_CHUNK_SIZE = 64 * 1024;
+	static constexpr uint32_t MAX_CHUNK_SIZE = 256 * 1024;
+
+	// Delta chunks can be based on other delta chunks, up to this depth.
+	static constexpr int MAX_DELTA_DEPTH = 8;
+
+	enum Encoding : uint32_t {
+		ENCODING_RAW,
+		ENCODING_ZSTD,
+		ENCODING_DELTA, // DeltaEncoding against the `base` chunk.
+	};
+
+	struct Hash {
+		uint8_t bytes[32] = {};
+
+		bool operator==(const Hash &p_other) const { return memcmp(bytes, p_other.bytes, 32) == 0; }
+		bool operator!=(const Hash &p_other) const { return !(*this == p_other); }
+		static uint32_t hash(const Hash &p_val) { return hash_murmur3_buffer(p_val.bytes, 32); }
+	};
+
+	struct Chunk {
+		String pack;
+		uint64_t offset = 0; // Absolute offset in the pack file.
+		uint32_t stored_size = 0;
+		uint32_t size = 0;
+		Encoding encoding = ENCODING_RAW;
+		Hash base;
+	};
+
+	// Size of a chunk table entry: hash, offset, stored size, size, encoding and base hash.
+	static constexpr uint32_t CHUNK_ENTRY_SIZE = 32 + 8 + 4 + 4 + 4 + 32;
+
+	typedef HashMap<Hash, Chunk, Hash> ChunkMap;
+	typedef HashMap<String, Ref<FileAccess>> PackFiles;
+
+	// Appends the end offset of every chunk of `p_data` to `r_ends`.
+	static void split(const uint8_t *p_data, uint64_t p_size, LocalVector<uint64_t> &r_ends);
+	static Hash hash_chunk(const uint8_t *p_data, uint64_t p_size);
+
+	// Reads the chunk table of a chunked pack. `p_file_base` is the absolute offset chunk offsets are relative to.
+	static Error read_chunk_table(const Ref<FileAccess> &p_file, const String &p_pack_path, uint64_t p_file_base, ChunkMap &r_chunks);
+	// Returns how many delta chunks lead from `p_hash` to a chunk stored in full, or -1 if the chain is broken or too deep.
+	static int get_delta_depth(const ChunkMap &p_chunks, const Hash &p_hash);
+	// Reads and decodes a chunk. Pack files are opened once and kept in `r_packs`.
+	static Error read_chunk(const ChunkMap &p_chunks, const Hash &p_hash, PackFiles &r_packs, Vector<uint8_t> &r_data, int p_depth = 0);
+};
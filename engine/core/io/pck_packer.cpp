@@ -31,11 +31,18 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
+#include "core/io/delta_encoding.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
+// Compressed files are split in blocks so reading them back doesn't need to decompress everything before the read position.
+static const uint32_t PACK_COMPRESSION_BLOCK_SIZE = 64 * 1024;
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -46,16 +53,205 @@ static int _get_pad(int p_alignment, int p_n) {
 	return pad;
 }
 
+// Formats that are compressed already, compressing them again only costs time.
+static bool _is_compressed_format(const Vector<uint8_t> &p_data) {
+	static const struct {
+		const char *signature;
+		int length;
+		int offset;
+	} signatures[] = {
+		{ "\x89PNG", 4, 0 },
+		{ "\xFF\xD8\xFF", 3, 0 }, // JPEG.
+		{ "WEBP", 4, 8 },
+		{ "OggS", 4, 0 },
+		{ "ID3", 3, 0 }, // MP3.
+		{ "PK\x03\x04", 4, 0 }, // ZIP.
+		{ "\x1F\x8B", 2, 0 }, // Gzip.
+		{ "\x28\xB5\x2F\xFD", 4, 0 }, // Zstandard.
+		{ "RSCC", 4, 0 }, // Compressed binary resource.
+		{ "GCMP", 4, 0 }, // FileAccessCompressed.
+	};
+
+	for (const auto &sig : signatures) {
+		if (p_data.size() >= sig.offset + sig.length && memcmp(p_data.ptr() + sig.offset, sig.signature, sig.length) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Same layout as FileAccessCompressed without the magic, so FileAccessPack reads it back with FileAccessCompressed::open_after_magic().
+static Vector<uint8_t> _compress_payload(const Vector<uint8_t> &p_data) {
+	const uint32_t block_size = PACK_COMPRESSION_BLOCK_SIZE;
+	const uint32_t total = p_data.size();
+	const uint32_t block_count = total / block_size + 1;
+	const int64_t max_block = Compression::get_max_compressed_buffer_size(MIN(total, block_size), Compression::MODE_ZSTD);
+
+	Vector<uint8_t> out;
+	out.resize(12 + block_count * 4 + block_count * max_block);
+	uint8_t *w = out.ptrw();
+	encode_uint32(Compression::MODE_ZSTD, w);
+	encode_uint32(block_size, w + 4);
+	encode_uint32(total, w + 8);
+
+	uint64_t ofs = 12 + block_count * 4;
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint32_t bl = i == block_count - 1 ? total % block_size : block_size;
+		const int64_t compressed_size = Compression::compress(w + ofs, p_data.ptr() + uint64_t(i) * block_size, bl, Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V(compressed_size < 0, Vector<uint8_t>());
+		encode_uint32(compressed_size, w + 12 + i * 4);
+		ofs += compressed_size;
+	}
+
+	out.resize(ofs);
+	return out;
+}
+
+// Same layout as FileAccessEncrypted without the magic.
+static Vector<uint8_t> _encrypt_payload(const Vector<uint8_t> &p_data, const Vector<uint8_t> &p_key, const Vector<uint8_t> &p_iv) {
+	uint64_t len = p_data.size();
+	if (len % 16) {
+		len += 16 - (len % 16);
+	}
+
+	Vector<uint8_t> out;
+	out.resize(40 + len);
+	uint8_t *w = out.ptrw();
+	ERR_FAIL_COND_V(CryptoCore::md5(p_data.ptr(), p_data.size(), w) != OK, Vector<uint8_t>());
+	encode_uint64(p_data.size(), w + 16);
+	memcpy(w + 24, p_iv.ptr(), 16);
+	memcpy(w + 40, p_data.ptr(), p_data.size());
+	memset(w + 40 + p_data.size(), 0, len - p_data.size());
+
+	uint8_t iv[16];
+	memcpy(iv, p_iv.ptr(), 16);
+	CryptoCore::AESContext ctx;
+	ctx.set_encode_key(p_key.ptr(), 256);
+	ctx.encrypt_cfb(len, iv, w + 40, w + 40);
+
+	return out;
+}
+
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_use_threads", "use_threads"), &PCKPacker::set_use_threads);
+	ClassDB::bind_method(D_METHOD("is_using_threads"), &PCKPacker::is_using_threads);
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_chunked", "chunked"), &PCKPacker::set_chunked);
+	ClassDB::bind_method(D_METHOD("is_chunked"), &PCKPacker::is_chunked);
+	ClassDB::bind_method(D_METHOD("add_base_pack", "pck_path"), &PCKPacker::add_base_pack);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compression_enabled"), "set_compression_enabled", "is_compression_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "chunked"), "set_chunked", "is_chunked");
+}
+
+void PCKPacker::set_use_threads(bool p_use_threads) {
+	use_threads = p_use_threads;
+}
+
+bool PCKPacker::is_using_threads() const {
+	return use_threads;
+}
+
+void PCKPacker::set_thread_pool(WorkerThreadPool *p_pool) {
+	thread_pool = p_pool;
+}
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
+
+void PCKPacker::set_chunked(bool p_chunked) {
+	ERR_FAIL_COND_MSG(file.is_valid(), "Chunked mode must be set before calling pck_start().");
+	chunked = p_chunked;
+}
+
+bool PCKPacker::is_chunked() const {
+	return chunked;
+}
+
+Error PCKPacker::add_base_pack(const String &p_pck_path) {
+	Ref<FileAccess> f = FileAccess::open(p_pck_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, vformat("Can't open base pack '%s'.", p_pck_path));
+
+	ERR_FAIL_COND_V_MSG(f->get_32() != PACK_HEADER_MAGIC, ERR_FILE_UNRECOGNIZED, vformat("'%s' is not a PCK file.", p_pck_path));
+	uint32_t version = f->get_32();
+	f->get_32(); // Engine version.
+	f->get_32();
+	f->get_32();
+	uint32_t pack_flags = f->get_32();
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 || !(pack_flags & PACK_CHUNKED), ERR_FILE_UNRECOGNIZED, vformat("Base pack '%s' isn't a chunked pack.", p_pck_path));
+
+	uint64_t base = f->get_64();
+	uint64_t dir_offset = f->get_64();
+	uint64_t chunk_table_offset = f->get_64();
+
+	f->seek(chunk_table_offset);
+	PackChunks::ChunkMap pack_chunks;
+	Error err = PackChunks::read_chunk_table(f, p_pck_path, base, pack_chunks);
+	ERR_FAIL_COND_V(err != OK, err);
+	for (const KeyValue<PackChunks::Hash, PackChunks::Chunk> &E : pack_chunks) {
+		if (!base_chunks.has(E.key)) {
+			base_chunks.insert(E.key, E.value);
+		}
+	}
+
+	// Chunk lists of the files, used to find the chunks to encode changed chunks against.
+	f->seek(dir_offset);
+	uint32_t file_count = f->get_32();
+	for (uint32_t i = 0; i < file_count; i++) {
+		uint32_t sl = f->get_32();
+		CharString cs;
+		cs.resize_uninitialized(sl + 1);
+		f->get_buffer((uint8_t *)cs.ptr(), sl);
+		cs[sl] = 0;
+		String path = String::utf8(cs.ptr(), sl);
+		uint64_t ofs = f->get_64();
+		f->get_64(); // Size.
+		uint8_t md5[16];
+		f->get_buffer(md5, 16);
+		uint32_t flags = f->get_32();
+		if (!(flags & PACK_FILE_CHUNKED)) {
+			continue;
+		}
+
+		uint64_t dir_pos = f->get_position();
+		f->seek(base + ofs);
+		BaseFile bf;
+		uint32_t chunk_count = f->get_32();
+		uint64_t end = 0;
+		for (uint32_t j = 0; j < chunk_count && !f->eof_reached(); j++) {
+			PackChunks::Hash hash;
+			f->get_buffer(hash.bytes, 32);
+			const PackChunks::Chunk *chunk = base_chunks.getptr(hash);
+			if (!chunk) {
+				break; // From a pack that wasn't added, the chunks after it can't be placed.
+			}
+			end += chunk->size;
+			bf.chunks.push_back(hash);
+			bf.chunk_ends.push_back(end);
+		}
+		base_files.insert(path.simplify_path().trim_prefix("res://"), bf);
+		f->seek(dir_pos);
+	}
+
+	return OK;
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
 	ERR_FAIL_COND_V_MSG((p_key.is_empty() || !p_key.is_valid_hex_number(false) || p_key.length() != 64), ERR_CANT_CREATE, "Invalid Encryption Key (must be 64 characters long).");
 	ERR_FAIL_COND_V_MSG(p_alignment <= 0, ERR_CANT_CREATE, "Invalid alignment, must be greater then 0.");
+	ERR_FAIL_COND_V_MSG(chunked && p_encrypt_directory, ERR_CANT_CREATE, "Chunked packs can't be encrypted.");
 
 	String _key = p_key.to_lower();
 	key.resize(32);
@@ -90,7 +286,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(chunked ? PACK_FORMAT_VERSION_V4 : PACK_FORMAT_VERSION);
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -99,6 +295,9 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	if (enc_dir) {
 		pack_flags |= PACK_DIR_ENCRYPTED;
 	}
+	if (chunked) {
+		pack_flags |= PACK_CHUNKED;
+	}
 	file->store_32(pack_flags); // flags
 
 	file_base_ofs = file->get_position();
@@ -107,6 +306,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	dir_base_ofs = file->get_position();
 	file->store_64(0); // Directory offset.
 
+	chunk_table_base_ofs = file->get_position(); // Chunk table offset, in the reserved part for V4.
 	for (int i = 0; i < 16; i++) {
 		file->store_32(0); // Reserved.
 	}
@@ -123,6 +323,9 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->seek(file_base);
 
 	files.clear();
+	pending_files.clear();
+	written_chunks.clear();
+	written_chunk_hashes.clear();
 
 	return OK;
 }
@@ -130,80 +333,257 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 Error PCKPacker::add_file_removal(const String &p_target_path) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
-	File pf;
+	PendingFile pf;
 	// Simplify path here and on every 'files' access so that paths that have extra '/'
 	// symbols or 'res://' in them still match the MD5 hash for the saved path.
-	pf.path = p_target_path.simplify_path().trim_prefix("res://");
-	pf.ofs = file->get_position();
-	pf.size = 0;
-	pf.removal = true;
+	pf.file.path = p_target_path.simplify_path().trim_prefix("res://");
+	pf.file.size = 0;
+	pf.file.removal = true;
 
-	pf.md5.resize_initialized(16);
+	pf.file.md5.resize_initialized(16);
 
-	files.push_back(pf);
+	pending_files.push_back(pf);
 
 	return OK;
 }
 
 Error PCKPacker::add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(chunked && p_encrypt, ERR_INVALID_PARAMETER, "Files of chunked packs can't be encrypted.");
 
-	Ref<FileAccess> f = FileAccess::open(p_source_path, FileAccess::READ);
-	if (f.is_null()) {
+	if (!FileAccess::exists(p_source_path)) {
 		return ERR_FILE_CANT_OPEN;
 	}
 
-	File pf;
+	PendingFile pf;
 	// Simplify path here and on every 'files' access so that paths that have extra '/'
 	// symbols or 'res://' in them still match the MD5 hash for the saved path.
-	pf.path = p_target_path.simplify_path().trim_prefix("res://");
-	pf.src_path = p_source_path;
-	pf.ofs = file->get_position();
-	pf.size = f->get_length();
-
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path);
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(data.ptr(), data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
+	pf.file.path = p_target_path.simplify_path().trim_prefix("res://");
+	pf.file.src_path = p_source_path;
+	pf.file.encrypted = p_encrypt;
+	pf.compress = compression_enabled;
+
+	pending_files.push_back(pf);
+
+	return OK;
+}
+
+void PCKPacker::_split_pending_file(PendingFile &p_file, const Vector<uint8_t> &p_data) {
+	LocalVector<uint64_t> ends;
+	PackChunks::split(p_data.ptr(), p_data.size(), ends);
+
+	const BaseFile *base_file = base_files.getptr(p_file.file.path);
+	const bool compress = !_is_compressed_format(p_data);
+	PackChunks::PackFiles base_packs;
+
+	p_file.file.chunked = true;
+	p_file.chunks.resize(ends.size());
+	p_file.payload.resize(4 + ends.size() * 32);
+	uint8_t *w = p_file.payload.ptrw();
+	encode_uint32(ends.size(), w);
+
+	uint64_t start = 0;
+	for (uint32_t i = 0; i < ends.size(); i++) {
+		ChunkData &chunk = p_file.chunks[i];
+		const uint8_t *src = p_data.ptr() + start;
+		chunk.size = ends[i] - start;
+		chunk.hash = PackChunks::hash_chunk(src, chunk.size);
+		memcpy(w + 4 + i * 32, chunk.hash.bytes, 32);
+		start = ends[i];
+
+		if (base_chunks.has(chunk.hash)) {
+			continue;
+		}
+
+		chunk.payload.resize(chunk.size);
+		memcpy(chunk.payload.ptrw(), src, chunk.size);
+
+		if (compress) {
+			Vector<uint8_t> compressed;
+			compressed.resize(Compression::get_max_compressed_buffer_size(chunk.size, Compression::MODE_ZSTD));
+			int64_t compressed_size = Compression::compress(compressed.ptrw(), src, chunk.size, Compression::MODE_ZSTD);
+			if (compressed_size > 0 && compressed_size < chunk.size - chunk.size / 16) {
+				compressed.resize(compressed_size);
+				chunk.payload = compressed;
+				chunk.encoding = PackChunks::ENCODING_ZSTD;
+			}
+		}
+
+		// Try a delta against the chunk at the same offset in the previous version of the file,
+		// unless reading it back would go through too many deltas.
+		if (base_file && !base_file->chunks.is_empty()) {
+			const uint64_t chunk_start = ends[i] - chunk.size;
+			uint32_t b = 0;
+			while (b < base_file->chunk_ends.size() - 1 && base_file->chunk_ends[b] <= chunk_start) {
+				b++;
+			}
+			const int base_depth = PackChunks::get_delta_depth(base_chunks, base_file->chunks[b]);
+			Vector<uint8_t> base_data;
+			Vector<uint8_t> delta;
+			if (base_depth >= 0 && base_depth + 1 <= PackChunks::MAX_DELTA_DEPTH &&
+					PackChunks::read_chunk(base_chunks, base_file->chunks[b], base_packs, base_data) == OK &&
+					DeltaEncoding::encode_delta(Span<uint8_t>(base_data.ptr(), base_data.size()), Span<uint8_t>(src, chunk.size), delta) == OK &&
+					delta.size() < chunk.payload.size()) {
+				chunk.payload = delta;
+				chunk.encoding = PackChunks::ENCODING_DELTA;
+				chunk.base = base_file->chunks[b];
+			}
 		}
 	}
-	pf.encrypted = p_encrypt;
+}
 
-	Ref<FileAccess> ftmp = file;
+void PCKPacker::_process_pending_file(uint32_t p_index, PendingFile *p_files) {
+	PendingFile &pf = p_files[p_index];
+	if (pf.file.removal) {
+		return;
+	}
 
-	Ref<FileAccessEncrypted> fae;
-	if (p_encrypt) {
-		fae.instantiate();
-		ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(pf.file.src_path, &pf.error);
+	if (pf.error != OK) {
+		return;
+	}
 
-		Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-		ftmp = fae;
+	pf.file.size = data.size();
+	pf.file.md5.resize(16);
+	CryptoCore::md5(data.ptr(), data.size(), pf.file.md5.ptrw());
+
+	if (chunked) {
+		_split_pending_file(pf, data);
+		return;
 	}
 
-	ftmp->store_buffer(data);
+	pf.payload = data;
+	if (pf.compress && data.size() > 0 && uint64_t(data.size()) < UINT32_MAX && !_is_compressed_format(data)) {
+		Vector<uint8_t> compressed = _compress_payload(data);
+		// Keep the original when compression barely helps, reading it back would be slower for nothing.
+		if (!compressed.is_empty() && compressed.size() < data.size() - data.size() / 16) {
+			pf.payload = compressed;
+			pf.file.compressed = true;
+		}
+	}
 
-	if (fae.is_valid()) {
-		ftmp.unref();
-		fae.unref();
+	if (pf.file.encrypted) {
+		pf.payload = _encrypt_payload(pf.payload, key, pf.iv);
+		if (pf.payload.is_empty()) {
+			pf.error = ERR_CANT_CREATE;
+		}
 	}
+}
 
-	int pad = _get_pad(alignment, file->get_position());
-	for (int j = 0; j < pad; j++) {
-		file->store_8(0);
+Error PCKPacker::_write_pending_files() {
+	if (pending_files.is_empty()) {
+		return OK;
+	}
+
+	// IVs are generated up front, the random generator isn't shared with the worker threads.
+	CryptoCore::RandomGenerator rng;
+	bool rng_ready = false;
+	for (PendingFile &pf : pending_files) {
+		if (!pf.file.encrypted) {
+			continue;
+		}
+		if (!rng_ready) {
+			ERR_FAIL_COND_V_MSG(rng.init() != OK, ERR_CANT_CREATE, "Failed to initialize random number generator.");
+			rng_ready = true;
+		}
+		pf.iv.resize(16);
+		ERR_FAIL_COND_V(rng.get_random_bytes(pf.iv.ptrw(), 16) != OK, ERR_CANT_CREATE);
 	}
 
-	files.push_back(pf);
+	WorkerThreadPool *pool = thread_pool ? thread_pool : WorkerThreadPool::get_singleton();
+	const bool threaded = use_threads && pool && pool->get_thread_count() > 1;
 
-	return OK;
+	// Files are processed in batches, the next batch is processed while the current one is written.
+	const uint32_t file_count = pending_files.size();
+	const uint32_t batch_size = threaded ? uint32_t(pool->get_thread_count()) * 4 : 1;
+	PendingFile *pf_ptr = pending_files.ptr();
+
+	WorkerThreadPool::GroupID group = -1;
+	if (threaded) {
+		group = pool->add_template_group_task(this, &PCKPacker::_process_pending_file, pf_ptr, MIN(batch_size, file_count), -1, false, SNAME("PCKPackerProcessFiles"));
+	}
+
+	Error ret = OK;
+	for (uint32_t batch_start = 0; batch_start < file_count; batch_start += batch_size) {
+		const uint32_t batch_end = MIN(batch_start + batch_size, file_count);
+		if (threaded) {
+			pool->wait_for_group_task_completion(group);
+			if (batch_end < file_count) {
+				group = pool->add_template_group_task(this, &PCKPacker::_process_pending_file, pf_ptr + batch_end, MIN(batch_size, file_count - batch_end), -1, false, SNAME("PCKPackerProcessFiles"));
+			}
+		} else {
+			for (uint32_t i = batch_start; i < batch_end; i++) {
+				_process_pending_file(i, pf_ptr);
+			}
+		}
+
+		for (uint32_t i = batch_start; i < batch_end; i++) {
+			PendingFile &pf = pf_ptr[i];
+			if (pf.error != OK) {
+				ERR_PRINT(vformat("Can't add file to PCK: '%s'.", pf.file.src_path));
+				ret = pf.error;
+				continue;
+			}
+
+			for (const ChunkData &chunk : pf.chunks) {
+				if (chunk.payload.is_empty() || written_chunk_hashes.has(chunk.hash)) {
+					continue;
+				}
+				WrittenChunk wc;
+				wc.hash = chunk.hash;
+				wc.ofs = file->get_position();
+				wc.stored_size = chunk.payload.size();
+				wc.size = chunk.size;
+				wc.encoding = chunk.encoding;
+				wc.base = chunk.base;
+				file->store_buffer(chunk.payload);
+				written_chunks.push_back(wc);
+				written_chunk_hashes.insert(chunk.hash);
+			}
+			pf.chunks.clear();
+
+			pf.file.ofs = file->get_position();
+			if (!pf.file.removal) {
+				file->store_buffer(pf.payload);
+				pf.payload.clear();
+
+				int pad = _get_pad(alignment, file->get_position());
+				for (int j = 0; j < pad; j++) {
+					file->store_8(0);
+				}
+			}
+			files.push_back(pf.file);
+		}
+	}
+
+	pending_files.clear();
+	return ret;
 }
 
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	Error files_err = _write_pending_files();
+
+	if (chunked) {
+		uint64_t chunk_table_offset = file->get_position();
+		file->seek(chunk_table_base_ofs);
+		file->store_64(chunk_table_offset);
+		file->seek(chunk_table_offset);
+
+		file->store_32(written_chunks.size());
+		for (const WrittenChunk &wc : written_chunks) {
+			file->store_buffer(wc.hash.bytes, 32);
+			file->store_64(wc.ofs - file_base);
+			file->store_32(wc.stored_size);
+			file->store_32(wc.size);
+			file->store_32(wc.encoding);
+			file->store_buffer(wc.base.bytes, 32);
+		}
+		written_chunks.clear();
+		written_chunk_hashes.clear();
+	}
+
 	int dir_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < dir_padding; i++) {
 		file->store_8(0);
@@ -253,6 +633,12 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
+		if (files[i].chunked) {
+			flags |= PACK_FILE_CHUNKED;
+		}
 		fhead->store_32(flags);
 
 		if (p_verbose) {
@@ -266,7 +652,7 @@ Error PCKPacker::flush(bool p_verbose) {
 	}
 
 	file.unref();
-	return OK;
+	return files_err;
 }
 
 PCKPacker::~PCKPacker() {
@@ -30,9 +30,12 @@
 
 #pragma once
 
+#include "core/io/pack_chunks.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 
-class FileAccess;
+class WorkerThreadPool;
 
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
@@ -46,6 +49,7 @@ class PCKPacker : public RefCounted {
 	uint64_t file_base = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
+	uint64_t chunk_table_base_ofs = 0;
 
 	static void _bind_methods();
 
@@ -55,12 +59,73 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		bool removal = false;
+		bool chunked = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	// Files added since the last flush. Their contents are read, hashed, compressed and encrypted
+	// on the WorkerThreadPool, then written by the calling thread in the order they were added,
+	// so the output doesn't depend on the number of threads.
+	struct ChunkData {
+		PackChunks::Hash hash;
+		uint32_t size = 0;
+		PackChunks::Encoding encoding = PackChunks::ENCODING_RAW;
+		PackChunks::Hash base;
+		Vector<uint8_t> payload; // Empty when a base pack has the chunk already.
+	};
+	struct PendingFile {
+		File file;
+		bool compress = false;
+		Vector<uint8_t> iv;
+		Vector<uint8_t> payload; // Contents as stored in the pack.
+		LocalVector<ChunkData> chunks;
+		Error error = OK;
+	};
+	LocalVector<PendingFile> pending_files;
+
+	bool use_threads = true;
+	WorkerThreadPool *thread_pool = nullptr; // The shared pool when null.
+	bool compression_enabled = false;
+
+	// Chunked packs (format version 4). Chunks found in the base packs or written already aren't stored again.
+	struct BaseFile {
+		LocalVector<PackChunks::Hash> chunks;
+		LocalVector<uint64_t> chunk_ends;
+	};
+	struct WrittenChunk {
+		PackChunks::Hash hash;
+		uint64_t ofs = 0;
+		uint32_t stored_size = 0;
+		uint32_t size = 0;
+		PackChunks::Encoding encoding = PackChunks::ENCODING_RAW;
+		PackChunks::Hash base;
+	};
+	bool chunked = false;
+	PackChunks::ChunkMap base_chunks;
+	HashMap<String, BaseFile> base_files;
+	LocalVector<WrittenChunk> written_chunks;
+	HashSet<PackChunks::Hash, PackChunks::Hash> written_chunk_hashes;
+
+	void _split_pending_file(PendingFile &p_file, const Vector<uint8_t> &p_data);
+
+	void _process_pending_file(uint32_t p_index, PendingFile *p_files);
+	Error _write_pending_files();
+
 public:
+	void set_use_threads(bool p_use_threads);
+	bool is_using_threads() const;
+	void set_thread_pool(WorkerThreadPool *p_pool);
+
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+
+	void set_chunked(bool p_chunked);
+	bool is_chunked() const;
+	Error add_base_pack(const String &p_pck_path);
+
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
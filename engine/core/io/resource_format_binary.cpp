@@ -696,6 +696,23 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	}
+
+	if (ResourceLoader::is_pipelined_loading()) {
+		// Read the dependencies ahead, so their I/O overlaps with loading the ones before them.
+		for (const ExtResource &er : external_resources) {
+			if (cache_mode_for_external == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(er.path)) {
+				continue;
+			}
+			String prefetched = ResourceLoader::prefetch(er.path, er.type);
+			if (!prefetched.is_empty()) {
+				prefetched_paths.push_back(prefetched);
+			}
+		}
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		const String &path = external_resources[i].path;
 		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
 		if (external_resources[i].load_token.is_null()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -903,6 +920,13 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+ResourceLoaderBinary::~ResourceLoaderBinary() {
+	// Drop whatever was read ahead but ended up not being loaded (e.g., already cached).
+	for (const String &path : prefetched_paths) {
+		ResourceLoader::cancel_prefetch(path);
+	}
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -1215,10 +1239,11 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	}
 
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f = ResourceLoader::open_pipelined(p_path, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
 
+	ResourceLoader::PipelineStageScope stage_scope(ResourceLoader::PIPELINE_STAGE_PARSE);
 	ResourceLoaderBinary loader;
 	switch (p_cache_mode) {
 		case CACHE_MODE_IGNORE:
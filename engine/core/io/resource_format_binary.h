@@ -33,6 +33,7 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 
 class ResourceLoaderBinary {
@@ -69,6 +70,7 @@ class ResourceLoaderBinary {
 	bool use_sub_threads = false;
 	float *progress = nullptr;
 	Vector<ExtResource> external_resources;
+	LocalVector<String> prefetched_paths;
 
 	struct IntResource {
 		String path;
@@ -104,6 +106,8 @@ public:
 	String recognize_script_class(Ref<FileAccess> p_f);
 	void get_dependencies(Ref<FileAccess> p_f, List<String> *p_dependencies, bool p_add_types);
 	void get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes);
+
+	~ResourceLoaderBinary();
 };
 
 class ResourceFormatLoaderBinary : public ResourceFormatLoader {
@@ -121,6 +125,7 @@ public:
 	virtual bool has_custom_uid_support() const override;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) override;
 	virtual Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) override;
+	virtual bool uses_pipelined_io() const override { return true; }
 };
 
 class ResourceFormatSaverBinaryInstance {
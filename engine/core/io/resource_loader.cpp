@@ -34,6 +34,7 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -513,6 +514,166 @@ String ResourceLoader::_validate_local_path(const String &p_path) {
 	}
 }
 
+ResourceLoader::PipelineStageScope::PipelineStageScope(PipelineStage p_stage) {
+	stage = p_stage;
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	parent = current;
+	if (parent) {
+		pipeline_stage_usec[parent->stage].add(begin_usec - parent->begin_usec);
+	}
+	current = this;
+}
+
+ResourceLoader::PipelineStageScope::~PipelineStageScope() {
+	uint64_t end_usec = OS::get_singleton()->get_ticks_usec();
+	pipeline_stage_usec[stage].add(end_usec - begin_usec);
+	current = parent;
+	if (parent) {
+		parent->begin_usec = end_usec;
+	}
+}
+
+// Keeps the prefetched bytes alive for as long as the file is open.
+class FileAccessPrefetched : public FileAccessMemory {
+	GDSOFTCLASS(FileAccessPrefetched, FileAccessMemory);
+
+	Vector<uint8_t> buffer;
+
+public:
+	Error open_buffer(const Vector<uint8_t> &p_buffer) {
+		buffer = p_buffer;
+		return open_custom(buffer.ptr(), buffer.size());
+	}
+};
+
+void ResourceLoader::_run_prefetch_task(void *p_userdata) {
+	PrefetchTask *task = (PrefetchTask *)p_userdata;
+	PipelineStageScope stage_scope(PIPELINE_STAGE_PREFETCH);
+	task->data = FileAccess::get_file_as_bytes(task->path, &task->error);
+}
+
+String ResourceLoader::prefetch(const String &p_path, const String &p_type_hint) {
+	if (!pipelined_loading) {
+		return String();
+	}
+
+	String local_path = _validate_local_path(p_path);
+	if (local_path.is_empty()) {
+		return String();
+	}
+	String file_path = import_remap(_path_remap(local_path));
+
+	// Only worth reading ahead if the file will be consumed through open_pipelined().
+	bool pipelined_io = false;
+	for (int i = 0; i < loader_count; i++) {
+		if (loader[i]->recognize_path(file_path, p_type_hint)) {
+			pipelined_io = loader[i]->uses_pipelined_io();
+			break;
+		}
+	}
+	if (!pipelined_io) {
+		return String();
+	}
+
+	MutexLock lock(prefetch_mutex);
+	if (prefetch_tasks.has(file_path) || prefetch_tasks.size() >= MAX_PREFETCH_TASKS) {
+		return String();
+	}
+	PrefetchTask *task = memnew(PrefetchTask);
+	task->path = file_path;
+	prefetch_tasks.insert(file_path, task);
+	task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_prefetch_task, task, true, "ResourcePrefetch");
+	return file_path;
+}
+
+ResourceLoader::PrefetchTask *ResourceLoader::_take_prefetch_task(const String &p_path) {
+	MutexLock lock(prefetch_mutex);
+	HashMap<String, PrefetchTask *>::Iterator E = prefetch_tasks.find(p_path);
+	if (!E) {
+		return nullptr;
+	}
+	PrefetchTask *task = E->value;
+	prefetch_tasks.remove(E);
+	return task;
+}
+
+Vector<uint8_t> ResourceLoader::_wait_prefetch_task(PrefetchTask *p_task, Error *r_error) {
+	{
+		// Waiting may run another load on this thread.
+		PREPARE_FOR_WTP_WAIT
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_task->task_id);
+		RESTORE_AFTER_WTP_WAIT
+	}
+	Vector<uint8_t> data = p_task->data;
+	if (r_error) {
+		*r_error = p_task->error;
+	}
+	memdelete(p_task);
+	return data;
+}
+
+void ResourceLoader::cancel_prefetch(const String &p_path) {
+	PrefetchTask *task = _take_prefetch_task(p_path);
+	if (task) {
+		_wait_prefetch_task(task, nullptr);
+		prefetch_dropped.increment();
+	}
+}
+
+Ref<FileAccess> ResourceLoader::open_pipelined(const String &p_path, Error *r_error) {
+	PrefetchTask *task = _take_prefetch_task(p_path);
+	if (!task && !pipelined_loading) {
+		// Not pipelined, reads stay interleaved with parsing.
+		return FileAccess::open(p_path, FileAccess::READ, r_error);
+	}
+
+	PipelineStageScope stage_scope(PIPELINE_STAGE_IO);
+	Error err = OK;
+	Vector<uint8_t> data;
+	if (task) {
+		data = _wait_prefetch_task(task, &err);
+		prefetch_hits.increment();
+	} else {
+		data = FileAccess::get_file_as_bytes(p_path, &err);
+		prefetch_misses.increment();
+	}
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		return Ref<FileAccess>();
+	}
+	pipeline_bytes_read.add(data.size());
+
+	Ref<FileAccessPrefetched> f;
+	f.instantiate();
+	f->open_buffer(data);
+	return f;
+}
+
+Dictionary ResourceLoader::get_pipeline_stats() {
+	Dictionary stats;
+	stats["io_usec"] = pipeline_stage_usec[PIPELINE_STAGE_IO].get();
+	stats["parse_usec"] = pipeline_stage_usec[PIPELINE_STAGE_PARSE].get();
+	stats["upload_usec"] = pipeline_stage_usec[PIPELINE_STAGE_UPLOAD].get();
+	stats["prefetch_usec"] = pipeline_stage_usec[PIPELINE_STAGE_PREFETCH].get();
+	stats["bytes_read"] = pipeline_bytes_read.get();
+	stats["prefetch_hits"] = prefetch_hits.get();
+	stats["prefetch_misses"] = prefetch_misses.get();
+	stats["prefetch_dropped"] = prefetch_dropped.get();
+	return stats;
+}
+
+void ResourceLoader::reset_pipeline_stats() {
+	for (int i = 0; i < PIPELINE_STAGE_MAX; i++) {
+		pipeline_stage_usec[i].set(0);
+	}
+	pipeline_bytes_read.set(0);
+	prefetch_hits.set(0);
+	prefetch_misses.set(0);
+	prefetch_dropped.set(0);
+}
+
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
 	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true);
 	return token.is_valid() ? OK : FAILED;
@@ -1420,6 +1581,20 @@ void ResourceLoader::clear_thread_load_tasks() {
 	thread_load_tasks.clear();
 
 	cleaning_tasks = false;
+
+	thread_load_lock.temp_unlock();
+	while (true) {
+		String path;
+		{
+			MutexLock lock(prefetch_mutex);
+			if (!prefetch_tasks.begin()) {
+				break;
+			}
+			path = prefetch_tasks.begin()->key;
+		}
+		cancel_prefetch(path);
+	}
+	thread_load_lock.temp_relock();
 }
 
 void ResourceLoader::set_load_callback(ResourceLoadedCallback p_callback) {
@@ -1566,6 +1741,16 @@ bool ResourceLoader::create_missing_resources_if_class_unavailable = false;
 bool ResourceLoader::abort_on_missing_resource = true;
 bool ResourceLoader::timestamp_on_load = false;
 
+bool ResourceLoader::pipelined_loading = false;
+Mutex ResourceLoader::prefetch_mutex;
+HashMap<String, ResourceLoader::PrefetchTask *> ResourceLoader::prefetch_tasks;
+SafeNumeric<uint64_t> ResourceLoader::pipeline_stage_usec[ResourceLoader::PIPELINE_STAGE_MAX];
+SafeNumeric<uint64_t> ResourceLoader::pipeline_bytes_read;
+SafeNumeric<uint64_t> ResourceLoader::prefetch_hits;
+SafeNumeric<uint64_t> ResourceLoader::prefetch_misses;
+SafeNumeric<uint64_t> ResourceLoader::prefetch_dropped;
+thread_local ResourceLoader::PipelineStageScope *ResourceLoader::PipelineStageScope::current = nullptr;
+
 thread_local bool ResourceLoader::import_thread = false;
 thread_local int ResourceLoader::load_nesting = 0;
 thread_local Vector<String> ResourceLoader::load_paths_stack;
@@ -34,12 +34,14 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 namespace CoreBind {
 class ResourceLoader;
 }
 
 class ConditionVariable;
+class FileAccess;
 
 template <int Tag>
 class SafeBinaryMutex;
@@ -90,6 +92,7 @@ public:
 	virtual bool is_imported(const String &p_path) const { return false; }
 	virtual int get_import_order(const String &p_path) const { return 0; }
 	virtual String get_import_group_file(const String &p_path) const { return ""; } //no group
+	virtual bool uses_pipelined_io() const { return false; } // Reads files through ResourceLoader::open_pipelined(), so they can be prefetched.
 
 	virtual ~ResourceFormatLoader() {}
 };
@@ -107,10 +110,12 @@ class ResourceLoader {
 	friend class CoreBind::ResourceLoader;
 
 	enum {
-		MAX_LOADERS = 64
+		MAX_LOADERS = 64,
+		MAX_PREFETCH_TASKS = 64,
 	};
 
 	struct ThreadLoadTask;
+	struct PrefetchTask;
 
 public:
 	enum ThreadLoadStatus {
@@ -126,6 +131,28 @@ public:
 		LOAD_THREAD_DISTRIBUTE,
 	};
 
+	enum PipelineStage {
+		PIPELINE_STAGE_IO, // Loader threads blocked reading files or waiting for a prefetch.
+		PIPELINE_STAGE_PARSE, // Decoding files and building resources.
+		PIPELINE_STAGE_UPLOAD, // Handing data over to servers (e.g. texture creation).
+		PIPELINE_STAGE_PREFETCH, // Background reads, overlapping the other stages.
+		PIPELINE_STAGE_MAX
+	};
+
+	// Attributes the time spent while in scope to a pipeline stage.
+	// Nested scopes pause the enclosing one, so stage times don't overlap on a thread.
+	class PipelineStageScope {
+		PipelineStage stage;
+		uint64_t begin_usec = 0;
+		PipelineStageScope *parent = nullptr;
+
+		static thread_local PipelineStageScope *current;
+
+	public:
+		PipelineStageScope(PipelineStage p_stage);
+		~PipelineStageScope();
+	};
+
 	struct LoadToken : public RefCounted {
 		String local_path;
 		String user_path;
@@ -224,6 +251,25 @@ private:
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
+	struct PrefetchTask {
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		String path;
+		Vector<uint8_t> data;
+		Error error = OK;
+	};
+	static void _run_prefetch_task(void *p_userdata);
+	static PrefetchTask *_take_prefetch_task(const String &p_path);
+	static Vector<uint8_t> _wait_prefetch_task(PrefetchTask *p_task, Error *r_error);
+
+	static bool pipelined_loading;
+	static Mutex prefetch_mutex;
+	static HashMap<String, PrefetchTask *> prefetch_tasks;
+	static SafeNumeric<uint64_t> pipeline_stage_usec[PIPELINE_STAGE_MAX];
+	static SafeNumeric<uint64_t> pipeline_bytes_read;
+	static SafeNumeric<uint64_t> prefetch_hits;
+	static SafeNumeric<uint64_t> prefetch_misses;
+	static SafeNumeric<uint64_t> prefetch_dropped;
+
 	static float _dependency_get_progress(const String &p_path);
 
 	static bool _ensure_load_progress();
@@ -237,6 +283,16 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; }
 
+	// Pipelined loading: files are read whole on the WorkerThreadPool ahead of
+	// being parsed, and loaders prefetch sibling dependencies before loading them.
+	static void set_pipelined_loading(bool p_enable) { pipelined_loading = p_enable; }
+	static bool is_pipelined_loading() { return pipelined_loading; }
+	static String prefetch(const String &p_path, const String &p_type_hint = "");
+	static void cancel_prefetch(const String &p_path);
+	static Ref<FileAccess> open_pipelined(const String &p_path, Error *r_error = nullptr);
+	static Dictionary get_pipeline_stats();
+	static void reset_pipeline_stats();
+
 	static void resource_changed_connect(Resource *p_source, const Callable &p_callable, uint32_t p_flags);
 	static void resource_changed_disconnect(Resource *p_source, const Callable &p_callable);
 	static void resource_changed_emit(Resource *p_source);
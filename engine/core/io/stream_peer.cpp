@@ -616,17 +616,30 @@ void StreamPeerBuffer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("resize", "size"), &StreamPeerBuffer::resize);
 	ClassDB::bind_method(D_METHOD("set_data_array", "data"), &StreamPeerBuffer::set_data_array);
 	ClassDB::bind_method(D_METHOD("get_data_array"), &StreamPeerBuffer::get_data_array);
+	ClassDB::bind_method(D_METHOD("set_data_file", "file"), &StreamPeerBuffer::set_data_file);
 	ClassDB::bind_method(D_METHOD("clear"), &StreamPeerBuffer::clear);
 	ClassDB::bind_method(D_METHOD("duplicate"), &StreamPeerBuffer::duplicate);
 
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "data_array"), "set_data_array", "get_data_array");
 }
 
+void StreamPeerBuffer::_copy_mapped_data() {
+	if (mapped_file.is_null()) {
+		return;
+	}
+
+	data.resize(mapped.size());
+	memcpy(data.ptrw(), mapped.ptr(), mapped.size());
+	mapped_file = Ref<FileAccess>();
+	mapped = Span<uint8_t>();
+}
+
 Error StreamPeerBuffer::put_data(const uint8_t *p_data, int p_bytes) {
 	if (p_bytes <= 0 || !p_data) {
 		return OK;
 	}
 
+	_copy_mapped_data();
 	if (pointer + p_bytes > data.size()) {
 		data.resize(pointer + p_bytes);
 	}
@@ -659,8 +672,9 @@ Error StreamPeerBuffer::get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_
 		return OK;
 	}
 
-	if (pointer + p_bytes > data.size()) {
-		r_received = data.size() - pointer;
+	const int size = _get_read_size();
+	if (pointer + p_bytes > size) {
+		r_received = size - pointer;
 		if (r_received <= 0) {
 			r_received = 0;
 			return OK; //you got 0
@@ -669,7 +683,7 @@ Error StreamPeerBuffer::get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_
 		r_received = p_bytes;
 	}
 
-	const uint8_t *r = data.ptr();
+	const uint8_t *r = _get_read_ptr();
 	memcpy(p_buffer, r + pointer, r_received);
 
 	pointer += r_received;
@@ -679,17 +693,17 @@ Error StreamPeerBuffer::get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_
 }
 
 int StreamPeerBuffer::get_available_bytes() const {
-	return data.size() - pointer;
+	return _get_read_size() - pointer;
 }
 
 void StreamPeerBuffer::seek(int p_pos) {
 	ERR_FAIL_COND(p_pos < 0);
-	ERR_FAIL_COND(p_pos > data.size());
+	ERR_FAIL_COND(p_pos > _get_read_size());
 	pointer = p_pos;
 }
 
 int StreamPeerBuffer::get_size() const {
-	return data.size();
+	return _get_read_size();
 }
 
 int StreamPeerBuffer::get_position() const {
@@ -697,19 +711,66 @@ int StreamPeerBuffer::get_position() const {
 }
 
 void StreamPeerBuffer::resize(int p_size) {
+	_copy_mapped_data();
 	data.resize(p_size);
 }
 
 void StreamPeerBuffer::set_data_array(const Vector<uint8_t> &p_data) {
+	mapped_file = Ref<FileAccess>();
+	mapped = Span<uint8_t>();
 	data = p_data;
 	pointer = 0;
 }
 
 Vector<uint8_t> StreamPeerBuffer::get_data_array() const {
+	if (mapped_file.is_valid()) {
+		Vector<uint8_t> copy;
+		copy.resize(mapped.size());
+		memcpy(copy.ptrw(), mapped.ptr(), mapped.size());
+		return copy;
+	}
 	return data;
 }
 
+Error StreamPeerBuffer::set_data_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	const uint64_t length = p_file->get_length();
+	ERR_FAIL_COND_V_MSG(length > (uint64_t)INT32_MAX, ERR_INVALID_PARAMETER, "The file is too large for a StreamPeerBuffer.");
+
+	mapped_file = Ref<FileAccess>();
+	mapped = Span<uint8_t>();
+	data.clear();
+	pointer = 0;
+
+	// Map a file of our own, since closing `p_file` unmaps its contents. Only files that can be
+	// mapped themselves are reopened, so encrypted or compressed files are read through `p_file`.
+	const String path = p_file->get_path();
+	if (length > 0 && !path.is_empty() && p_file->map_read_only().size() == length) {
+		Ref<FileAccess> own_file = FileAccess::open(path, FileAccess::READ);
+		if (own_file.is_valid() && own_file->get_length() == length) {
+			const Span<uint8_t> span = own_file->map_read_only();
+			if (span.size() == length) {
+				mapped_file = own_file;
+				mapped = span;
+				return OK;
+			}
+		}
+	}
+
+	// Not mappable, read it the usual way.
+	data.resize(length);
+	p_file->seek(0);
+	const uint64_t read = p_file->get_buffer(data.ptrw(), length);
+	if (read != length) {
+		data.clear();
+		ERR_FAIL_V_MSG(ERR_FILE_CANT_READ, vformat("Can't read the contents of \"%s\".", p_file->get_path()));
+	}
+	return OK;
+}
+
 void StreamPeerBuffer::clear() {
+	mapped_file = Ref<FileAccess>();
+	mapped = Span<uint8_t>();
 	data.clear();
 	pointer = 0;
 }
@@ -718,5 +779,7 @@ Ref<StreamPeerBuffer> StreamPeerBuffer::duplicate() const {
 	Ref<StreamPeerBuffer> spb;
 	spb.instantiate();
 	spb->data = data;
+	spb->mapped_file = mapped_file;
+	spb->mapped = mapped;
 	return spb;
 }
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/object/ref_counted.h"
 
 #include "core/extension/ext_wrappers.gen.inc"
@@ -127,6 +128,14 @@ class StreamPeerBuffer : public StreamPeer {
 	Vector<uint8_t> data;
 	int pointer = 0;
 
+	// Read-only contents mapped from a file, used instead of `data` until something is written.
+	Ref<FileAccess> mapped_file;
+	Span<uint8_t> mapped;
+
+	_FORCE_INLINE_ const uint8_t *_get_read_ptr() const { return mapped_file.is_valid() ? mapped.ptr() : data.ptr(); }
+	_FORCE_INLINE_ int _get_read_size() const { return mapped_file.is_valid() ? int(mapped.size()) : data.size(); }
+	void _copy_mapped_data();
+
 protected:
 	static void _bind_methods();
 
@@ -146,6 +155,7 @@ public:
 
 	void set_data_array(const Vector<uint8_t> &p_data);
 	Vector<uint8_t> get_data_array() const;
+	Error set_data_file(const Ref<FileAccess> &p_file);
 
 	void clear();
 
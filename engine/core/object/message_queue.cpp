@@ -58,13 +58,156 @@
 		mutex.unlock();                           \
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+SafeNumeric<uint64_t> CallQueue::last_queue_id;
+thread_local CallQueue::ThreadBufferCacheEntry CallQueue::thread_buffer_cache[CallQueue::THREAD_BUFFER_CACHE_SIZE];
+thread_local CallQueue::ThreadBufferOwner CallQueue::thread_buffer_owner;
+
+CallQueue::ThreadBufferOwner::~ThreadBufferOwner() {
+	for (ThreadBuffer *buffer : buffers) {
+		buffer->thread_exited.set();
+		_unref_thread_buffer(buffer);
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+}
+
+void CallQueue::_unref_thread_buffer(ThreadBuffer *p_buffer) {
+	if (p_buffer->refcount.unref()) {
+		memdelete(p_buffer);
+	}
+}
+
+CallQueue::ThreadBuffer *CallQueue::_register_thread_buffer() {
+	// Threads not created through Thread all share the unassigned ID, so key buffers by
+	// the address of the thread local cache instead, which is unique among live threads.
+	uintptr_t thread_key = uintptr_t(&thread_buffer_cache[0]);
+
+	MutexLock lock(mutex);
+
+	// A buffer of an exited thread can still be waiting to be flushed, a new thread
+	// with the same key gets a buffer of its own.
+	ThreadBuffer **existing = thread_buffer_map.getptr(thread_key);
+	if (existing && !(*existing)->thread_exited.is_set()) {
+		return *existing;
+	}
+
+	// Let go of the buffers of queues that were destroyed since, only this thread still references them.
+	LocalVector<ThreadBuffer *> &owned = thread_buffer_owner.buffers;
+	for (uint32_t i = 0; i < owned.size(); i++) {
+		if (owned[i]->refcount.get() == 1) {
+			_unref_thread_buffer(owned[i]);
+			owned.remove_at_unordered(i);
+			i--;
+		}
+	}
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->thread_key = thread_key;
+	buffer->refcount.init(2); // The queue and the thread.
+	thread_buffer_owner.buffers.push_back(buffer);
+	buffer->write_page = allocator->alloc();
+	buffer->read_page = buffer->write_page;
+	pages_high_water_mark.exchange_if_greater(pages_allocated.increment());
+
+	// The list is only changed with the mutex held, the consumer can walk it without it.
+	buffer->next_buffer = thread_buffers.load(std::memory_order_relaxed);
+	thread_buffers.store(buffer, std::memory_order_release);
+	thread_buffer_map.insert(thread_key, buffer);
+
+	return buffer;
+}
+
+void CallQueue::_reclaim_thread_buffers() {
+	MutexLock lock(mutex);
+
+	ThreadBuffer *previous = nullptr;
+	ThreadBuffer *buffer = thread_buffers.load(std::memory_order_acquire);
+	while (buffer) {
+		ThreadBuffer *next = buffer->next_buffer;
+		// The thread is gone, so once the buffer is empty nothing can be written to it anymore.
+		if (!buffer->thread_exited.is_set() || _peek_message(buffer)) {
+			previous = buffer;
+			buffer = next;
+			continue;
+		}
+
+		if (previous) {
+			previous->next_buffer = next;
+		} else {
+			thread_buffers.store(next, std::memory_order_release);
+		}
+		ThreadBuffer **mapped = thread_buffer_map.getptr(buffer->thread_key);
+		if (mapped && *mapped == buffer) {
+			thread_buffer_map.erase(buffer->thread_key);
+		}
+
+		allocator->free(buffer->read_page);
+		pages_allocated.decrement();
+		_unref_thread_buffer(buffer);
+		buffer = next;
+	}
+}
+
+CallQueue::Message *CallQueue::_alloc_message(ThreadBuffer *p_buffer, uint32_t p_room_needed) {
+	Page *page = p_buffer->write_page;
+	uint32_t used = page->committed.get();
+
+	if ((used + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_allocated.get() >= max_pages) {
+			return nullptr;
+		}
+		Page *new_page = allocator->alloc();
+		pages_high_water_mark.exchange_if_greater(pages_allocated.increment());
+
+		// From here on the consumer owns the old page and frees it once read.
+		page->next.store(new_page, std::memory_order_release);
+		p_buffer->write_page = new_page;
+		page = new_page;
+		used = 0;
+	}
+
+	return memnew_placement(&page->data[used], Message);
+}
+
+CallQueue::Message *CallQueue::_peek_message(ThreadBuffer *p_buffer) {
+	while (true) {
+		Page *page = p_buffer->read_page;
+		if (p_buffer->read_offset < page->committed.get()) {
+			return (Message *)&page->data[p_buffer->read_offset];
+		}
+
+		Page *next = page->next.load(std::memory_order_acquire);
+		if (!next) {
+			return nullptr;
+		}
+
+		// The producer publishes `next` after its last commit on this page, check again.
+		if (p_buffer->read_offset < page->committed.get()) {
+			return (Message *)&page->data[p_buffer->read_offset];
+		}
+
+		p_buffer->read_page = next;
+		p_buffer->read_offset = 0;
+		allocator->free(page);
+		pages_allocated.decrement();
+	}
+}
+
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,25 +231,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadBuffer *buffer = _get_thread_buffer();
+	Message *msg = _alloc_message(buffer, room_needed);
+	if (!msg) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -118,7 +250,7 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		msg->type |= FLAG_NULL_IS_OK;
 	}
 
-	buffer_end += sizeof(Message);
+	uint8_t *buffer_end = (uint8_t *)(msg + 1);
 
 	for (int i = 0; i < p_argcount; i++) {
 		Variant *v = memnew_placement(buffer_end, Variant);
@@ -126,82 +258,55 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_commit_message(buffer, msg, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	ThreadBuffer *buffer = _get_thread_buffer();
+	Message *msg = _alloc_message(buffer, room_needed);
+	if (!msg) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(buffer_end, Variant);
+	Variant *v = memnew_placement(msg + 1, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit_message(buffer, msg, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadBuffer *buffer = _get_thread_buffer();
+	Message *msg = _alloc_message(buffer, room_needed);
+	if (!msg) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
-
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
-	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit_message(buffer, msg, room_needed);
 
 	return OK;
 }
@@ -226,7 +331,7 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
+	if (!thread_buffers.load(std::memory_order_acquire)) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -238,24 +343,48 @@ Error CallQueue::flush() {
 	}
 
 	flushing = true;
+	flush_count++;
+
+	// Buffer holding the oldest pending message, and the sequence of the oldest message
+	// pending in any other buffer. Messages are taken from `source` until that limit is
+	// passed, so the merge only rescans all buffers when the posting thread changes.
+	ThreadBuffer *source = nullptr;
+	uint64_t source_limit = 0;
+
+	while (true) {
+		Message *message = source ? _peek_message(source) : nullptr;
+
+		if (!message || message->sequence > source_limit) {
+			message = nullptr;
+			source = nullptr;
+			// Anything pushed from now on, even to the buffer we are about to drain, may
+			// have been caused by a message we run, so it must wait for the next rescan.
+			source_limit = push_sequence.get();
+
+			for (ThreadBuffer *buffer = thread_buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next_buffer) {
+				Message *candidate = _peek_message(buffer);
+				if (!candidate) {
+					continue;
+				}
+				if (!message || candidate->sequence < message->sequence) {
+					if (message) {
+						source_limit = MIN(source_limit, message->sequence);
+					}
+					message = candidate;
+					source = buffer;
+				} else {
+					source_limit = MIN(source_limit, candidate->sequence);
+				}
+			}
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
-
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
-
-		//lock on each iteration, so a call can re-add itself to the message queue
-
-		Message *message = (Message *)&page->data[offset];
-
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+			if (!message) {
+				break;
+			}
 		}
 
 		//pre-advance so this function is reentrant
-		offset += advance;
+		source->read_offset += _get_message_size(message);
+		consume_count.increment();
 
 		Object *target = message->callable.get_object();
 
@@ -281,24 +410,13 @@ Error CallQueue::flush() {
 			} break;
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_destroy_message(message);
 
+		//lock on each iteration, so a call can re-add itself to the message queue
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	_reclaim_thread_buffers();
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -308,41 +426,16 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+	for (ThreadBuffer *buffer = thread_buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next_buffer) {
+		Message *message = _peek_message(buffer);
+		while (message) {
+			buffer->read_offset += _get_message_size(message);
+			consume_count.increment();
+			_destroy_message(message);
+			message = _peek_message(buffer);
 		}
 	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
-
 	UNLOCK_MUTEX;
 }
 
@@ -353,77 +446,69 @@ void CallQueue::statistics() {
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+	for (ThreadBuffer *buffer = thread_buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next_buffer) {
+		Page *page = buffer->read_page;
+		uint32_t offset = buffer->read_offset;
 
-			//lock on each iteration, so a call can re-add itself to the message queue
+		while (page) {
+			uint32_t committed = page->committed.get();
+			while (offset < committed) {
+				const Message *message = (const Message *)&page->data[offset];
+				offset += _get_message_size(message);
 
-			Message *message = (Message *)&page->data[offset];
+				Object *target = message->callable.get_object();
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-			Object *target = message->callable.get_object();
-
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
 			}
 
-			message->~Message();
+			page = page->next.load(std::memory_order_acquire);
+			offset = 0;
 		}
 	}
 
+	uint32_t pages_used = pages_allocated.get();
 	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "PAGE HIGH WATER MARK: %d.\n", pages_high_water_mark.get());
+	fprintf(stdout, "PUSHES: %s, FLUSHES: %s.\n", itos(push_sequence.get()).utf8().get_data(), itos(flush_count).utf8().get_data());
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -446,18 +531,12 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
-	}
-
-	return true;
+	// The read side of the buffers is only safe to walk with the mutex held, the counters can be read from any thread.
+	return consume_count.get() != push_sequence.get();
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return pages_high_water_mark.get() * PAGE_SIZE_BYTES;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -468,6 +547,8 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 		allocator = memnew(Allocator(16)); // 16 elements per allocator page, 64kb per allocator page. Anything small will do, though.
 		allocator_is_custom = false;
 	}
+	// Ids are never reused, so stale entries in the thread local caches of destroyed queues can't match.
+	queue_id = last_queue_id.increment();
 	max_pages = p_max_pages;
 	error_text = p_error_text;
 }
@@ -475,8 +556,17 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	ThreadBuffer *buffer = thread_buffers.load(std::memory_order_acquire);
+	while (buffer) {
+		Page *page = buffer->read_page;
+		while (page) {
+			Page *next = page->next.load(std::memory_order_acquire);
+			allocator->free(page);
+			page = next;
+		}
+		ThreadBuffer *next_buffer = buffer->next_buffer;
+		_unref_thread_buffer(buffer);
+		buffer = next_buffer;
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
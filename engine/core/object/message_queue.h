@@ -32,8 +32,10 @@
 
 #include "core/object/object_id.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -48,6 +50,10 @@ public:
 
 	struct Page {
 		uint8_t data[PAGE_SIZE_BYTES];
+		// Bytes of `data` holding fully written messages. Only the producer thread writes it.
+		SafeNumeric<uint32_t> committed;
+		// Set by the producer once it moved on to a new page; `committed` is final from then on.
+		std::atomic<Page *> next = nullptr;
 	};
 
 	// Needs to be public to be able to define it outside the class.
@@ -65,15 +71,60 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	// Every producer thread writes into its own chain of pages, so pushing never takes a lock.
+	// The single consumer (flush) merges the chains back into posting order using the
+	// per-queue sequence number stored in each message.
+	// A buffer is referenced by the queue and by its thread, and the queue unlinks it
+	// once the thread has exited and its messages were flushed.
+	struct ThreadBuffer {
+		ThreadBuffer *next_buffer = nullptr; // Only changed with the mutex held.
+		uintptr_t thread_key = 0;
+		SafeFlag thread_exited;
+		SafeRefCount refcount;
+
+		// Producer side, only touched by the owning thread.
+		Page *write_page = nullptr;
+
+		// Consumer side, only touched with the mutex held.
+		Page *read_page = nullptr;
+		uint32_t read_offset = 0;
+	};
+
+	struct ThreadBufferCacheEntry {
+		uint64_t queue_id = 0;
+		ThreadBuffer *buffer = nullptr;
+	};
+
+	enum {
+		THREAD_BUFFER_CACHE_SIZE = 8, // Must be a power of two.
+	};
+
+	// Releases the buffers of a thread, of all queues, when it exits.
+	struct ThreadBufferOwner {
+		LocalVector<ThreadBuffer *> buffers;
+		~ThreadBufferOwner();
+	};
+
+	static SafeNumeric<uint64_t> last_queue_id;
+	static thread_local ThreadBufferCacheEntry thread_buffer_cache[THREAD_BUFFER_CACHE_SIZE];
+	static thread_local ThreadBufferOwner thread_buffer_owner;
+
+	// Guards the consumer side (flush, clear, statistics) and thread buffer registration.
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	uint64_t queue_id = 0;
+	std::atomic<ThreadBuffer *> thread_buffers = nullptr;
+	HashMap<uintptr_t, ThreadBuffer *> thread_buffer_map;
+
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+	SafeNumeric<uint32_t> pages_allocated;
+	SafeNumeric<uint32_t> pages_high_water_mark;
+	SafeNumeric<uint64_t> push_sequence; // Doubles as the push counter.
+	SafeNumeric<uint64_t> consume_count; // Messages flushed or cleared, the rest of the pushed ones are pending.
+	uint64_t flush_count = 0;
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -81,6 +132,7 @@ private:
 #endif
 
 	struct Message {
+		uint64_t sequence;
 		Callable callable;
 		int16_t type;
 		union {
@@ -89,15 +141,30 @@ private:
 		};
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	ThreadBuffer *_register_thread_buffer();
+	void _reclaim_thread_buffers();
+	static void _unref_thread_buffer(ThreadBuffer *p_buffer);
+	_FORCE_INLINE_ ThreadBuffer *_get_thread_buffer() {
+		ThreadBufferCacheEntry &entry = thread_buffer_cache[queue_id & (THREAD_BUFFER_CACHE_SIZE - 1)];
+		if (likely(entry.queue_id == queue_id)) {
+			return entry.buffer;
 		}
+		ThreadBuffer *buffer = _register_thread_buffer();
+		entry.queue_id = queue_id;
+		entry.buffer = buffer;
+		return buffer;
 	}
 
-	void _add_page();
+	Message *_alloc_message(ThreadBuffer *p_buffer, uint32_t p_room_needed);
+	_FORCE_INLINE_ void _commit_message(ThreadBuffer *p_buffer, Message *p_message, uint32_t p_room_needed) {
+		p_message->sequence = push_sequence.increment();
+		Page *page = p_buffer->write_page;
+		page->committed.set(page->committed.get() + p_room_needed);
+	}
+
+	Message *_peek_message(ThreadBuffer *p_buffer);
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -152,6 +219,11 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	uint64_t get_push_count() const { return push_sequence.get(); }
+	uint64_t get_flush_count() const { return flush_count; }
+	uint32_t get_page_high_water_mark() const { return pages_high_water_mark.get(); }
+	uint32_t get_page_count() const { return pages_allocated.get(); }
+
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
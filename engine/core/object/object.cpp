@@ -931,6 +931,32 @@ Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_
 	return ret;
 }
 
+Variant Object::callp_resolved(const StringName &p_method, MethodBind *p_method_bind, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (unlikely(p_method == CoreStringName(free_))) {
+		return Object::callp(p_method, p_args, p_argcount, r_error);
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	Variant ret;
+	OBJ_DEBUG_LOCK
+
+	if (script_instance) {
+		ret = script_instance->callp(p_method, p_args, p_argcount, r_error);
+		if (r_error.error != Callable::CallError::CALL_ERROR_INVALID_METHOD && r_error.error != Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL) {
+			return ret;
+		}
+	}
+
+	if (p_method_bind) {
+		ret = p_method_bind->call(this, p_args, p_argcount, r_error);
+	} else {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+	}
+
+	return ret;
+}
+
 Variant Object::call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	r_error.error = Callable::CallError::CALL_OK;
 
@@ -1276,14 +1302,10 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// Ensure that disconnecting the signal or even deleting the object
+	// will not affect the signal calling. Holding the shared snapshot
+	// avoids copying the callables on every emission.
+	Vector<SignalData::SnapshotSlot> snapshot;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1299,32 +1321,33 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
+		if (s->snapshot.is_empty() && !s->slot_map.is_empty()) {
+			s->snapshot.resize(s->slot_map.size());
+			SignalData::SnapshotSlot *w = s->snapshot.ptrw();
+			s->snapshot_has_one_shot = false;
+			for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+				w->callable = slot_kv.value.conn.callable;
+				w->flags = slot_kv.value.conn.flags;
+				s->snapshot_has_one_shot = s->snapshot_has_one_shot || (w->flags & CONNECT_ONE_SHOT);
+				++w;
+			}
 		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		snapshot = s->snapshot;
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		if (s->snapshot_has_one_shot) {
+			for (int i = 0; i < snapshot.size(); ++i) {
+				const SignalData::SnapshotSlot &slot = snapshot[i];
+				bool disconnect = slot.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-				disconnect = false;
-			}
+				if (disconnect && (slot.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+					// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+					disconnect = false;
+				}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				if (disconnect) {
+					_disconnect(p_name, slot.callable);
+				}
 			}
 		}
 	}
@@ -1343,9 +1366,10 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Vector<const Variant *> append_source_mem;
 	Variant source = this;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	const SignalData::SnapshotSlot *slots = snapshot.ptr();
+	for (int i = 0; i < snapshot.size(); ++i) {
+		const Callable &callable = slots[i].callable;
+		const uint32_t &flags = slots[i].flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1410,15 +1434,6 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
-
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
 		// because it would do the init ref logic, which is something this function
@@ -1669,6 +1684,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->snapshot.clear();
 
 	return OK;
 }
@@ -1749,6 +1765,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->snapshot.clear();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
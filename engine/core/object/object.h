@@ -634,8 +634,17 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct SnapshotSlot {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		// Immutable copy of slot_map for emission, rebuilt after the connections change.
+		// Emissions keep a reference to it, so connecting or disconnecting during emission doesn't affect them.
+		Vector<SnapshotSlot> snapshot;
+		bool snapshot_has_one_shot = false;
 		bool removable = false;
 	};
 	friend struct _ObjectSignalLock;
@@ -905,6 +914,9 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	// Same as the base callp(), with the method of the class resolved ahead with ClassDB::get_method() (null if it doesn't exist).
+	// Used to call the same method on many objects of the same class, doesn't go through callp() overrides.
+	Variant callp_resolved(const StringName &p_method, MethodBind *p_method_bind, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	virtual Variant call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	template <typename... VarArgs>
@@ -60,6 +60,7 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
+static SafeNumeric<uint64_t> _alloc_count;
 #endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -123,6 +124,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
 		_max_mem_usage.exchange_if_greater(new_mem_usage);
+		_alloc_count.increment();
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -154,6 +156,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		if (p_bytes > *s) {
 			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - *s);
 			_max_mem_usage.exchange_if_greater(new_mem_usage);
+			_alloc_count.increment();
 		} else {
 			_current_mem_usage.sub(*s - p_bytes);
 		}
@@ -235,6 +238,14 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_alloc_count() {
+#ifdef DEBUG_ENABLED
+	return _alloc_count.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
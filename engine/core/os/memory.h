@@ -96,6 +96,8 @@ void free_aligned_static(void *p_memory);
 uint64_t get_mem_available();
 uint64_t get_mem_usage();
 uint64_t get_mem_max_usage();
+// Number of allocations and growing reallocations so far. Only tracked in debug builds.
+uint64_t get_alloc_count();
 }; //namespace Memory
 
 class DefaultAllocator {
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  chrome_trace_recorder.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "chrome_trace_recorder.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+SpinLock ChromeTraceRecorder::lock;
+LocalVector<ChromeTraceRecorder::Event> ChromeTraceRecorder::events;
+uint32_t ChromeTraceRecorder::max_events = ChromeTraceRecorder::DEFAULT_MAX_EVENTS;
+uint64_t ChromeTraceRecorder::dropped_events = 0;
+String ChromeTraceRecorder::output_path;
+
+uint64_t ChromeTraceRecorder::_get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void ChromeTraceRecorder::_add_event(const char *p_name, uint64_t p_begin_usec) {
+	Event event;
+	event.name = p_name;
+	event.begin_usec = p_begin_usec;
+	event.duration_usec = _get_ticks_usec() - p_begin_usec;
+	event.thread_id = Thread::get_caller_id();
+
+	lock.lock();
+	// The buffer is reserved up front, so recording never allocates. Zones that end after stop()
+	// are left out, the buffer was handed over.
+	if (recording.is_set()) {
+		if (events.size() < max_events) {
+			events.push_back(event);
+		} else {
+			dropped_events++;
+		}
+	}
+	lock.unlock();
+}
+
+void ChromeTraceRecorder::start(const String &p_output_path, uint32_t p_max_events) {
+	ERR_FAIL_COND_MSG(recording.is_set(), "A Chrome trace is already being recorded.");
+	ERR_FAIL_COND(p_max_events == 0);
+
+	lock.lock();
+	output_path = p_output_path;
+	max_events = p_max_events;
+	dropped_events = 0;
+	events.clear();
+	events.reserve(max_events);
+	lock.unlock();
+
+	recording.set();
+}
+
+Error ChromeTraceRecorder::stop() {
+	ERR_FAIL_COND_V(!recording.is_set(), ERR_UNCONFIGURED);
+	recording.clear();
+
+	// Take the buffer without copying it, so zones ending meanwhile on other threads don't wait
+	// for the events to be copied or written.
+	lock.lock();
+	LocalVector<Event> recorded = std::move(events);
+	const uint64_t dropped = dropped_events;
+	lock.unlock();
+
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_WRITE, vformat("Can't write Chrome trace to \"%s\".", output_path));
+
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	f->store_string(vformat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Main Thread\"}}", (int64_t)Thread::get_main_id()));
+	for (const Event &event : recorded) {
+		f->store_string(vformat(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%d,\"dur\":%d}", String(event.name).json_escape(), (int64_t)event.thread_id, (int64_t)event.begin_usec, (int64_t)event.duration_usec));
+	}
+	f->store_string("\n]}\n");
+
+	if (dropped > 0) {
+		WARN_PRINT(vformat("Chrome trace buffer was full, %d zones were not recorded.", dropped));
+	}
+	print_verbose(vformat("Saved %d zones to Chrome trace \"%s\".", recorded.size(), output_path));
+	return OK;
+}
+
+uint64_t ChromeTraceRecorder::get_dropped_event_count() {
+	lock.lock();
+	uint64_t dropped = dropped_events;
+	lock.unlock();
+	return dropped;
+}
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  chrome_trace_recorder.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/spin_lock.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Records profile zones in memory and saves them in the Chrome trace event format, which can be
+// opened in https://ui.perfetto.dev or chrome://tracing. It is the fallback for
+// GodotModuleProfileZone when no profiler backend is compiled in, so it is cheap when idle:
+// a zone only checks a flag unless a recording was started with start() or `--trace-file`.
+
+class ChromeTraceRecorder {
+public:
+	static constexpr uint32_t DEFAULT_MAX_EVENTS = 1 << 20;
+
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ explicit Zone(const char *p_name) {
+			if (recording.is_set()) {
+				name = p_name;
+				begin_usec = _get_ticks_usec();
+			}
+		}
+		_FORCE_INLINE_ ~Zone() {
+			if (name) {
+				_add_event(name, begin_usec);
+			}
+		}
+	};
+
+private:
+	struct Event {
+		const char *name = nullptr; // Zone names are string literals.
+		uint64_t begin_usec = 0;
+		uint64_t duration_usec = 0;
+		uint64_t thread_id = 0;
+	};
+
+	static inline SafeFlag recording{ false };
+	static SpinLock lock;
+	static LocalVector<Event> events;
+	static uint32_t max_events;
+	static uint64_t dropped_events;
+	static String output_path;
+
+	static uint64_t _get_ticks_usec();
+	static void _add_event(const char *p_name, uint64_t p_begin_usec);
+
+public:
+	static void start(const String &p_output_path, uint32_t p_max_events = DEFAULT_MAX_EVENTS);
+	static Error stop();
+	static bool is_recording() { return recording.is_set(); }
+	static uint64_t get_dropped_event_count();
+};
@@ -226,3 +226,18 @@ void godot_cleanup_profiler();
 #define GodotProfileZoneScriptSystemCall(m_ptr, m_file, m_function, m_name, m_line)
 
 #endif
+
+// Profile zones for the hot paths of the custom modules, compiled in with `module_profiling=yes`.
+// They are regular profile zones when a profiler backend is selected. Otherwise they are
+// recorded by ChromeTraceRecorder (see `--trace-file`), so production builds can be profiled too.
+#if defined(GODOT_MODULE_PROFILING_ENABLED)
+#if defined(GODOT_USE_TRACY) || defined(GODOT_USE_PERFETTO) || defined(GODOT_USE_INSTRUMENTS)
+#define GodotModuleProfileZone(m_zone_name) GodotProfileZone(m_zone_name)
+#else
+#define GODOT_USE_CHROME_TRACE
+#include "core/profiling/chrome_trace_recorder.h"
+#define GodotModuleProfileZone(m_zone_name) ChromeTraceRecorder::Zone GD_UNIQUE_NAME(__godot_chrome_trace_zone_)(m_zone_name)
+#endif
+#else
+#define GodotModuleProfileZone(m_zone_name)
+#endif
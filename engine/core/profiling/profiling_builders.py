@@ -17,3 +17,5 @@ def profiler_gen_builder(target, source, env):
             file.write("#define GODOT_USE_INSTRUMENTS\n")
             if env["profiler_sample_callstack"]:
                 file.write("#define INSTRUMENTS_SAMPLE_CALLSTACKS\n")
+        if env["module_profiling"]:
+            file.write("#define GODOT_MODULE_PROFILING_ENABLED\n")
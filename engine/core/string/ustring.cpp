@@ -45,6 +45,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, Object);
 #include "core/string/string_name.h"
 #include "core/string/translation_server.h"
 #include "core/string/ucaps.h"
+#include "core/string/utf8_kernels.h"
 #include "core/variant/variant.h"
 #include "core/version_generated.gen.h"
 
@@ -1765,8 +1766,17 @@ Error String::append_utf8(const char *p_utf8, int p_len) {
 
 	const uint8_t *ptrtmp = (uint8_t *)p_utf8;
 	const uint8_t *ptr_limit = (uint8_t *)p_utf8 + p_len;
+	const uint8_t *next_bulk = ptrtmp;
 
 	while (ptrtmp < ptr_limit && *ptrtmp) {
+		if (ptrtmp >= next_bulk) {
+			// Decode well-formed input in bulk, anything else goes through the checks below.
+			// After an error, give those a few bytes before trying again.
+			ptrtmp = UTF8Kernels::decode_valid(ptrtmp, ptr_limit, dst);
+			next_bulk = ptrtmp + 16;
+			continue;
+		}
+
 		uint8_t c = *ptrtmp;
 		uint32_t unicode = _replacement_char;
 		uint32_t size = 1;
@@ -1919,6 +1929,12 @@ CharString String::utf8(Vector<uint8_t> *r_ch_length_map) const {
 	const char32_t *d = &operator[](0);
 	int fl = 0;
 	for (int i = 0; i < l; i++) {
+		// Code points up to U+1FFFFF are measured in bulk, the rest need an error printed.
+		i += UTF8Kernels::measure(d + i, l - i, fl, map_ptr ? map_ptr + i : nullptr);
+		if (i == l) {
+			break;
+		}
+
 		uint32_t c = d[i];
 		int ch_w = 1;
 		if (c <= 0x7f) { // 7 bits.
@@ -1952,10 +1968,16 @@ CharString String::utf8(Vector<uint8_t> *r_ch_length_map) const {
 
 	utf8s.resize_uninitialized(fl + 1);
 	uint8_t *cdst = (uint8_t *)utf8s.get_data();
+	const uint8_t *cdst_end = cdst + fl;
 
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
 	for (int i = 0; i < l; i++) {
+		i = UTF8Kernels::encode(d + i, d + l, cdst, cdst_end) - d;
+		if (i == l) {
+			break;
+		}
+
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
@@ -2572,8 +2594,8 @@ done:
 #define READING_EXP 3
 #define READING_DONE 4
 
-double String::to_float(const char *p_str) {
-	return built_in_strtod<char>(p_str);
+double String::to_float(const char *p_str, const char **r_end) {
+	return built_in_strtod<char>(p_str, (char **)r_end);
 }
 
 double String::to_float(const char32_t *p_str, const char32_t **r_end) {
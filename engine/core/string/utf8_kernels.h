@@ -0,0 +1,531 @@
+/**************************************************************************/
+/*  utf8_kernels.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTF8_KERNELS_SSE2
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+// x86_64 builds are compiled with SSE4.2 enabled, 32-bit ones only assume SSE2 and check for SSSE3 when starting.
+#if defined(__SSSE3__) || defined(__AVX__) || (defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64))
+#define UTF8_KERNELS_SSSE3_BASELINE
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define UTF8_KERNELS_SSSE3_TARGET
+#else
+#define UTF8_KERNELS_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+#endif
+
+// Bulk UTF-8 <-> UTF-32 transcoding used by String::append_utf8() and String::utf8().
+// The kernels only ever consume input that converts without errors and stop at the first
+// sequence (or code point) that doesn't, leaving it to the scalar code in ustring.cpp
+// so error messages and replacement characters are the same on every CPU.
+namespace UTF8Kernels {
+
+_FORCE_INLINE_ uint32_t _ctz(uint32_t p_mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward(&index, p_mask);
+	return index;
+#else
+	return __builtin_ctz(p_mask);
+#endif
+}
+
+// Length of a sequence starting with the given (valid) leading byte.
+_FORCE_INLINE_ uint32_t _sequence_length(uint8_t p_lead) {
+	return p_lead < 0x80 ? 1 : (p_lead < 0xE0 ? 2 : (p_lead < 0xF0 ? 3 : 4));
+}
+
+// Decodes one well-formed sequence, `p_src` is known to hold all of it.
+_FORCE_INLINE_ char32_t _decode_trusted(const uint8_t *p_src, uint32_t p_length) {
+	switch (p_length) {
+		case 1:
+			return p_src[0];
+		case 2:
+			return ((p_src[0] & 0x1F) << 6) | (p_src[1] & 0x3F);
+		case 3:
+			return ((p_src[0] & 0x0F) << 12) | ((p_src[1] & 0x3F) << 6) | (p_src[2] & 0x3F);
+		default:
+			return ((p_src[0] & 0x07) << 18) | ((p_src[1] & 0x3F) << 12) | ((p_src[2] & 0x3F) << 6) | (p_src[3] & 0x3F);
+	}
+}
+
+#ifdef UTF8_KERNELS_SSE2
+inline bool has_ssse3() {
+#ifdef UTF8_KERNELS_SSSE3_BASELINE
+	return true;
+#else
+	static const bool supported = []() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 9)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("ssse3") != 0;
+#endif
+	}();
+	return supported;
+#endif
+}
+
+// Widens 16 bytes to 16 code points.
+_FORCE_INLINE_ void _widen_16(__m128i p_bytes, char32_t *p_dst) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i lo = _mm_unpacklo_epi8(p_bytes, zero);
+	const __m128i hi = _mm_unpackhi_epi8(p_bytes, zero);
+	_mm_storeu_si128((__m128i *)(p_dst + 0), _mm_unpacklo_epi16(lo, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 4), _mm_unpackhi_epi16(lo, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 8), _mm_unpacklo_epi16(hi, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 12), _mm_unpackhi_epi16(hi, zero));
+}
+
+// Returns where the well-formed input checked so far ends, always on a sequence boundary.
+// Blocks of 16 bytes are validated with the nibble lookup tables from Keiser & Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte" (2021), NUL counts as an error.
+UTF8_KERNELS_SSSE3_TARGET inline const uint8_t *_validate_ssse3(const uint8_t *p_src, const uint8_t *p_end) {
+	// Error classes, a pair of bytes is invalid if the three lookups share a bit.
+	constexpr int8_t TOO_SHORT = 1 << 0; // Leading byte (or ASCII) followed by a leading byte or ASCII.
+	constexpr int8_t TOO_LONG = 1 << 1; // ASCII followed by a continuation byte.
+	constexpr int8_t OVERLONG_3 = 1 << 2;
+	constexpr int8_t TOO_LARGE = 1 << 3;
+	constexpr int8_t SURROGATE = 1 << 4;
+	constexpr int8_t OVERLONG_2 = 1 << 5;
+	constexpr int8_t TOO_LARGE_1000 = 1 << 6;
+	constexpr int8_t OVERLONG_4 = 1 << 6;
+	constexpr int8_t TWO_CONTS = int8_t(1 << 7); // Two continuation bytes, only valid inside longer sequences.
+	constexpr int8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+	const __m128i byte_1_high_table = _mm_setr_epi8(
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT | OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT | OVERLONG_3 | SURROGATE,
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+	const __m128i byte_1_low_table = _mm_setr_epi8(
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+			CARRY | OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY | TOO_LARGE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000);
+	const __m128i byte_2_high_table = _mm_setr_epi8(
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+
+	const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+	const __m128i zero = _mm_setzero_si128();
+
+	const uint8_t *src = p_src;
+	const uint8_t *valid_end = p_src;
+	__m128i prev_input = zero;
+
+	while (p_end - src >= 16) {
+		const __m128i input = _mm_loadu_si128((const __m128i *)src);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(input, zero))) {
+			break;
+		}
+
+		if (_mm_movemask_epi8(input) == 0) {
+			// Plain ASCII is fine unless the previous block ended in the middle of a sequence.
+			if (valid_end != src) {
+				break;
+			}
+			src += 16;
+			valid_end = src;
+			prev_input = input;
+			continue;
+		}
+
+		const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+		const __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble_mask));
+		const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, nibble_mask));
+		const __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+		const __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+		// Third and fourth bytes of a sequence must be continuation bytes, and only those may follow another continuation byte.
+		const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+		const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+		const __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(int8_t(0xE0 - 0x80)));
+		const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(int8_t(0xF0 - 0x80)));
+		const __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(int8_t(0x80)));
+		const __m128i error = _mm_xor_si128(must_be_continuation, special_cases);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, zero)) != 0xFFFF) {
+			break;
+		}
+
+		src += 16;
+		valid_end = src;
+		prev_input = input;
+		// Leave out a sequence cut by the end of the block, the next block decides whether it's complete.
+		for (int i = 1; i <= 3; i++) {
+			const uint8_t c = src[-i];
+			if (c >= 0xC0) {
+				if (_sequence_length(c) > uint32_t(i)) {
+					valid_end = src - i;
+				}
+				break;
+			} else if (c < 0x80) {
+				break;
+			}
+		}
+	}
+
+	return valid_end;
+}
+
+// Transcodes input already checked by _validate_ssse3(), recognizing runs of ASCII,
+// two-byte and three-byte sequences (Latin, Cyrillic, Greek... and CJK text).
+UTF8_KERNELS_SSSE3_TARGET inline const uint8_t *_transcode_ssse3(const uint8_t *p_src, const uint8_t *p_end, char32_t *&r_dst) {
+	const __m128i three_byte_shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+	const __m128i two_byte_shuffle = _mm_setr_epi8(1, 0, -1, -1, 3, 2, -1, -1, 5, 4, -1, -1, 7, 6, -1, -1);
+	const __m128i continuation_limit = _mm_set1_epi8(int8_t(0xC0));
+
+	const uint8_t *src = p_src;
+	char32_t *dst = r_dst;
+
+	while (p_end - src >= 16) {
+		const __m128i input = _mm_loadu_si128((const __m128i *)src);
+		const uint32_t non_ascii = _mm_movemask_epi8(input);
+		if (non_ascii == 0) {
+			_widen_16(input, dst);
+			src += 16;
+			dst += 16;
+			continue;
+		}
+
+		const uint32_t ascii_prefix = _ctz(non_ascii);
+		if (ascii_prefix) {
+			// Output never outruns input, so there is room for all 16 even if fewer are kept.
+			_widen_16(input, dst);
+			src += ascii_prefix;
+			dst += ascii_prefix;
+			continue;
+		}
+
+		const uint32_t continuation = _mm_movemask_epi8(_mm_cmplt_epi8(input, continuation_limit));
+		if ((continuation & 0x1FFF) == 0x0DB6) {
+			// Four three-byte sequences.
+			const __m128i x = _mm_shuffle_epi8(input, three_byte_shuffle);
+			const __m128i cp = _mm_or_si128(_mm_or_si128(
+													_mm_and_si128(x, _mm_set1_epi32(0x3F)),
+													_mm_and_si128(_mm_srli_epi32(x, 2), _mm_set1_epi32(0x0FC0))),
+					_mm_and_si128(_mm_srli_epi32(x, 4), _mm_set1_epi32(0xF000)));
+			_mm_storeu_si128((__m128i *)dst, cp);
+			src += 12;
+			dst += 4;
+		} else if ((continuation & 0x1FF) == 0x0AA) {
+			// Four two-byte sequences.
+			const __m128i x = _mm_shuffle_epi8(input, two_byte_shuffle);
+			const __m128i cp = _mm_or_si128(
+					_mm_and_si128(x, _mm_set1_epi32(0x3F)),
+					_mm_and_si128(_mm_srli_epi32(x, 2), _mm_set1_epi32(0x07C0)));
+			_mm_storeu_si128((__m128i *)dst, cp);
+			src += 8;
+			dst += 4;
+		} else {
+			const uint32_t length = _sequence_length(*src);
+			*dst++ = _decode_trusted(src, length);
+			src += length;
+		}
+	}
+
+	while (src < p_end) {
+		const uint32_t length = _sequence_length(*src);
+		*dst++ = _decode_trusted(src, length);
+		src += length;
+	}
+
+	r_dst = dst;
+	return src;
+}
+
+// Encodes runs of four code points that all take two or three bytes.
+UTF8_KERNELS_SSSE3_TARGET inline const char32_t *_encode_ssse3(const char32_t *p_src, const char32_t *p_end, uint8_t *&r_dst, const uint8_t *p_dst_end) {
+	const __m128i three_byte_compact = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	const __m128i two_byte_compact = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+
+	const char32_t *src = p_src;
+	uint8_t *dst = r_dst;
+
+	while (p_end - src >= 4 && p_dst_end - dst >= 16) {
+		const __m128i c = _mm_loadu_si128((const __m128i *)src);
+		const __m128i above_7f = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7F));
+		const __m128i above_7ff = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7FF));
+		const __m128i below_10000 = _mm_cmplt_epi32(c, _mm_set1_epi32(0x10000));
+
+		if (_mm_movemask_epi8(_mm_and_si128(above_7ff, below_10000)) == 0xFFFF) {
+			const __m128i x = _mm_or_si128(_mm_or_si128(
+												   _mm_srli_epi32(c, 12),
+												   _mm_and_si128(_mm_slli_epi32(c, 2), _mm_set1_epi32(0x3F00))),
+					_mm_or_si128(_mm_and_si128(_mm_slli_epi32(c, 16), _mm_set1_epi32(0x3F0000)), _mm_set1_epi32(0x8080E0)));
+			_mm_storeu_si128((__m128i *)dst, _mm_shuffle_epi8(x, three_byte_compact));
+			src += 4;
+			dst += 12;
+		} else if (_mm_movemask_epi8(_mm_andnot_si128(above_7ff, above_7f)) == 0xFFFF) {
+			const __m128i x = _mm_or_si128(_mm_or_si128(
+												   _mm_srli_epi32(c, 6),
+												   _mm_and_si128(_mm_slli_epi32(c, 8), _mm_set1_epi32(0x3F00))),
+					_mm_set1_epi32(0x80C0));
+			_mm_storel_epi64((__m128i *)dst, _mm_shuffle_epi8(x, two_byte_compact));
+			src += 4;
+			dst += 8;
+		} else {
+			break;
+		}
+	}
+
+	r_dst = dst;
+	return src;
+}
+#endif
+
+// Checked scalar decoding, with a fast path for runs of ASCII.
+inline const uint8_t *_decode_scalar(const uint8_t *p_src, const uint8_t *p_end, char32_t *&r_dst) {
+	const uint8_t *src = p_src;
+	char32_t *dst = r_dst;
+
+	while (src < p_end) {
+		const uint8_t c = *src;
+		if (c < 0x80) {
+#ifdef UTF8_KERNELS_SSE2
+			if (p_end - src >= 16) {
+				const __m128i input = _mm_loadu_si128((const __m128i *)src);
+				const uint32_t stop = _mm_movemask_epi8(input) | _mm_movemask_epi8(_mm_cmpeq_epi8(input, _mm_setzero_si128()));
+				const uint32_t count = stop ? _ctz(stop) : 16;
+				if (count) {
+					// Output never outruns input, so there is room for all 16 even if fewer are kept.
+					_widen_16(input, dst);
+					src += count;
+					dst += count;
+					continue;
+				}
+			}
+#else
+			if (p_end - src >= 8) {
+				uint64_t word;
+				memcpy(&word, src, 8);
+				const uint64_t has_zero = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+				if (((word & 0x8080808080808080ULL) | has_zero) == 0) {
+					for (int i = 0; i < 8; i++) {
+						dst[i] = src[i];
+					}
+					src += 8;
+					dst += 8;
+					continue;
+				}
+			}
+#endif
+			if (c == 0) {
+				break;
+			}
+			*dst++ = c;
+			src++;
+			continue;
+		}
+
+		uint32_t length;
+		uint8_t range_min = 0x80;
+		uint8_t range_max = 0xBF;
+		if (c < 0xC2) {
+			break; // Continuation byte or overlong two-byte sequence.
+		} else if (c < 0xE0) {
+			length = 2;
+		} else if (c < 0xF0) {
+			length = 3;
+			range_min = (c == 0xE0) ? 0xA0 : 0x80;
+			range_max = (c == 0xED) ? 0x9F : 0xBF;
+		} else if (c < 0xF5) {
+			length = 4;
+			range_min = (c == 0xF0) ? 0x90 : 0x80;
+			range_max = (c == 0xF4) ? 0x8F : 0xBF;
+		} else {
+			break;
+		}
+
+		if (p_end - src < int64_t(length) || src[1] < range_min || src[1] > range_max) {
+			break;
+		}
+		if (length > 2 && (src[2] & 0xC0) != 0x80) {
+			break;
+		}
+		if (length > 3 && (src[3] & 0xC0) != 0x80) {
+			break;
+		}
+
+		*dst++ = _decode_trusted(src, length);
+		src += length;
+	}
+
+	r_dst = dst;
+	return src;
+}
+
+// Decodes the longest run of well-formed sequences at the start of [p_src, p_end), stopping before
+// the first NUL or ill-formed sequence. Returns where decoding stopped.
+inline const uint8_t *decode_valid(const uint8_t *p_src, const uint8_t *p_end, char32_t *&r_dst) {
+	const uint8_t *src = p_src;
+#ifdef UTF8_KERNELS_SSE2
+	if (has_ssse3()) {
+		src = _transcode_ssse3(src, _validate_ssse3(src, p_end), r_dst);
+	}
+#endif
+	return _decode_scalar(src, p_end, r_dst);
+}
+
+// Adds up the UTF-8 length of the leading code points that encode without errors (up to U+1FFFFF),
+// optionally storing each one's length in `r_map`. Returns how many code points were measured.
+inline int measure(const char32_t *p_src, int p_len, int &r_bytes, uint8_t *r_map) {
+	int i = 0;
+	int bytes = 0;
+#ifdef UTF8_KERNELS_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	__m128i total = zero;
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i c = _mm_loadu_si128((const __m128i *)(p_src + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(c, 21), zero)) != 0xFFFF) {
+			break;
+		}
+		// Comparisons give -1 for true, so one byte plus one more for each threshold passed.
+		__m128i width = _mm_sub_epi32(_mm_set1_epi32(1), _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7F)));
+		width = _mm_sub_epi32(width, _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7FF)));
+		width = _mm_sub_epi32(width, _mm_cmpgt_epi32(c, _mm_set1_epi32(0xFFFF)));
+		total = _mm_add_epi32(total, width);
+		if (r_map) {
+			const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(width, zero), zero);
+			const int32_t widths = _mm_cvtsi128_si32(packed);
+			memcpy(r_map + i, &widths, 4);
+		}
+	}
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+	bytes = _mm_cvtsi128_si32(total);
+#endif
+	for (; i < p_len; i++) {
+		const uint32_t c = p_src[i];
+		if (c > 0x1FFFFF) {
+			break;
+		}
+		const int width = 1 + (c > 0x7F) + (c > 0x7FF) + (c > 0xFFFF);
+		bytes += width;
+		if (r_map) {
+			r_map[i] = width;
+		}
+	}
+	r_bytes += bytes;
+	return i;
+}
+
+// Encodes the leading code points that encode without errors (up to U+1FFFFF) into `r_dst`,
+// which must have room for them. Returns where encoding stopped.
+inline const char32_t *encode(const char32_t *p_src, const char32_t *p_end, uint8_t *&r_dst, const uint8_t *p_dst_end) {
+	const char32_t *src = p_src;
+	uint8_t *dst = r_dst;
+#ifdef UTF8_KERNELS_SSE2
+	const bool ssse3 = has_ssse3();
+	const __m128i not_ascii = _mm_set1_epi32(~0x7F);
+	const __m128i zero = _mm_setzero_si128();
+#endif
+
+	while (src < p_end) {
+#ifdef UTF8_KERNELS_SSE2
+		if (p_end - src >= 16) {
+			const __m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+			const __m128i b = _mm_loadu_si128((const __m128i *)(src + 4));
+			const __m128i c = _mm_loadu_si128((const __m128i *)(src + 8));
+			const __m128i d = _mm_loadu_si128((const __m128i *)(src + 12));
+			const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, not_ascii), zero)) == 0xFFFF) {
+				// All below 0x80, so signed saturation leaves them as they are.
+				_mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+				src += 16;
+				dst += 16;
+				continue;
+			}
+		}
+		if (ssse3 && *src > 0x7F) {
+			const char32_t *from = src;
+			src = _encode_ssse3(src, p_end, dst, p_dst_end);
+			if (src != from) {
+				continue;
+			}
+		}
+#endif
+		const uint32_t c = *src;
+		if (c <= 0x7F) {
+			*dst++ = c;
+		} else if (c <= 0x7FF) {
+			*dst++ = 0xC0 | (c >> 6);
+			*dst++ = 0x80 | (c & 0x3F);
+		} else if (c <= 0xFFFF) {
+			*dst++ = 0xE0 | (c >> 12);
+			*dst++ = 0x80 | ((c >> 6) & 0x3F);
+			*dst++ = 0x80 | (c & 0x3F);
+		} else if (c <= 0x1FFFFF) {
+			*dst++ = 0xF0 | (c >> 18);
+			*dst++ = 0x80 | ((c >> 12) & 0x3F);
+			*dst++ = 0x80 | ((c >> 6) & 0x3F);
+			*dst++ = 0x80 | (c & 0x3F);
+		} else {
+			break;
+		}
+		src++;
+	}
+
+	r_dst = dst;
+	return src;
+}
+
+} // namespace UTF8Kernels
@@ -32,7 +32,9 @@
 
 #ifdef SDL_ENABLED
 
+#include "core/config/project_settings.h"
 #include "core/input/default_controller_mappings.h"
+#include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/variant/dictionary.h"
 
@@ -48,9 +50,9 @@ JoypadSDL *JoypadSDL::singleton = nullptr;
 
 // Macro to skip the SDL joystick event handling if the device is an SDL gamepad, because
 // there are separate events for SDL gamepads
-#define SKIP_EVENT_FOR_GAMEPAD                    \
-	if (SDL_IsGamepad(sdl_event.jdevice.which)) { \
-		continue;                                 \
+#define SKIP_EVENT_FOR_GAMEPAD                  \
+	if (SDL_IsGamepad(p_event.jdevice.which)) { \
+		return;                                 \
 	}
 
 JoypadSDL::JoypadSDL() {
@@ -58,6 +60,7 @@ JoypadSDL::JoypadSDL() {
 }
 
 JoypadSDL::~JoypadSDL() {
+	stop_polling_thread();
 	// Process any remaining input events
 	process_events();
 	for (int i = 0; i < Input::JOYPADS_MAX; i++) {
@@ -66,6 +69,9 @@ JoypadSDL::~JoypadSDL() {
 		}
 	}
 	SDL_Quit();
+	if (event_queue) {
+		memdelete_arr(event_queue);
+	}
 	singleton = nullptr;
 }
 
@@ -87,9 +93,16 @@ Error JoypadSDL::initialize() {
 		SDL_AddGamepadMappingsFromIO(rw, 1);
 	}
 
+	latency_probe_event_type = SDL_RegisterEvents(1);
+
 	// Make sure that we handle already connected joypads when the driver is initialized.
 	process_events();
 
+	const int polling_rate = GLOBAL_DEF(PropertyInfo(Variant::INT, "input_devices/joypads/polling_thread_rate", PROPERTY_HINT_RANGE, "0,8000,1,suffix:Hz"), 0);
+	if (polling_rate > 0 && start_polling_thread(polling_rate) != OK) {
+		WARN_PRINT("SDL: Couldn't start the joypad polling thread, polling once per frame instead.");
+	}
+
 	print_verbose("SDL: Init OK!");
 	return OK;
 }
@@ -98,6 +111,223 @@ uint64_t nsec_to_usec(uint64_t p_nsec) {
 	return p_nsec / 1000;
 }
 
+static float _get_joystick_axis_value(int16_t p_value) {
+	return ((p_value - SDL_JOYSTICK_AXIS_MIN) / (float)(SDL_JOYSTICK_AXIS_MAX - SDL_JOYSTICK_AXIS_MIN) - 0.5f) * 2.0f;
+}
+
+static float _get_gamepad_axis_value(uint8_t p_axis, int16_t p_value) {
+	if (p_axis == SDL_GAMEPAD_AXIS_LEFT_TRIGGER || p_axis == SDL_GAMEPAD_AXIS_RIGHT_TRIGGER) {
+		// Gamepad triggers go from 0 to SDL_JOYSTICK_AXIS_MAX
+		return p_value / (float)SDL_JOYSTICK_AXIS_MAX;
+	}
+	// Other axis go from SDL_JOYSTICK_AXIS_MIN to SDL_JOYSTICK_AXIS_MAX
+	return _get_joystick_axis_value(p_value);
+}
+
+void JoypadSDL::LatencyStat::add(uint64_t p_usec) {
+	count.increment();
+	total_usec.add(p_usec);
+	max_usec.exchange_if_greater(p_usec);
+}
+
+Error JoypadSDL::start_polling_thread(int p_rate_hz) {
+#ifdef MACOS_ENABLED
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "The SDL joypad polling thread isn't supported on macOS.");
+#else
+	ERR_FAIL_COND_V(p_rate_hz <= 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(polling_thread.is_started(), ERR_ALREADY_IN_USE);
+
+	polling_rate_hz = p_rate_hz;
+	polling_period_usec = MAX(1, 1000000 / p_rate_hz);
+	if (!event_queue) {
+		event_queue = memnew_arr(SDL_Event, EVENT_QUEUE_SIZE);
+	}
+	polling_thread_exit.clear();
+
+	Thread::Settings settings;
+	settings.priority = Thread::PRIORITY_HIGH;
+	polling_thread.start(_polling_thread_func, this, settings);
+	print_verbose(vformat("SDL: Polling joypads on a thread at %d Hz.", p_rate_hz));
+	return OK;
+#endif
+}
+
+void JoypadSDL::stop_polling_thread() {
+	if (!polling_thread.is_started()) {
+		return;
+	}
+	polling_thread_exit.set();
+	polling_thread.wait_to_finish();
+	_drain_event_queue();
+}
+
+bool JoypadSDL::is_polling_thread_running() const {
+	return polling_thread.is_started();
+}
+
+void JoypadSDL::set_event_callback(EventCallback p_callback, void *p_userdata) {
+	// The polling thread reads the callback without locking, so it's stopped while the callback changes.
+	const bool was_polling = polling_thread.is_started();
+	stop_polling_thread();
+	event_callback = p_callback;
+	event_callback_userdata = p_userdata;
+	if (was_polling) {
+		start_polling_thread(polling_rate_hz);
+	}
+}
+
+void JoypadSDL::_polling_thread_func(void *p_userdata) {
+	Thread::set_name("SDL Joypad Polling");
+	JoypadSDL *joypad_sdl = static_cast<JoypadSDL *>(p_userdata);
+
+	SDL_Event events[32];
+	while (!joypad_sdl->polling_thread_exit.is_set()) {
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+
+		// Pumping timestamps the events, so they're at most one polling period late.
+		SDL_PumpEvents();
+		int count;
+		while ((count = SDL_PeepEvents(events, 32, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST)) > 0) {
+			for (int i = 0; i < count; i++) {
+				const SDL_Event &event = events[i];
+				joypad_sdl->_notify_event(event);
+
+				// Only joypad events are handled on the main thread.
+				const bool is_probe = joypad_sdl->latency_probe_event_type != 0 && event.type == joypad_sdl->latency_probe_event_type;
+				if (!is_probe && (event.type < SDL_EVENT_JOYSTICK_AXIS_MOTION || event.type >= SDL_EVENT_FINGER_DOWN)) {
+					continue;
+				}
+
+				const uint32_t write = joypad_sdl->event_queue_write.load(std::memory_order_relaxed);
+				if (write - joypad_sdl->event_queue_read.load(std::memory_order_acquire) >= EVENT_QUEUE_SIZE) {
+					joypad_sdl->dropped_events.increment();
+					continue;
+				}
+				joypad_sdl->event_queue[write % EVENT_QUEUE_SIZE] = event;
+				joypad_sdl->event_queue_write.store(write + 1, std::memory_order_release);
+			}
+		}
+
+		const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		if (elapsed_usec < joypad_sdl->polling_period_usec) {
+			OS::get_singleton()->delay_usec(joypad_sdl->polling_period_usec - elapsed_usec);
+		}
+	}
+}
+
+void JoypadSDL::_drain_event_queue() {
+	if (!event_queue) {
+		return;
+	}
+
+	uint32_t read = event_queue_read.load(std::memory_order_relaxed);
+	const uint32_t write = event_queue_write.load(std::memory_order_acquire);
+	while (read != write) {
+		_process_event(event_queue[read % EVENT_QUEUE_SIZE]);
+		read++;
+		// Free the slot right away, so the polling thread doesn't drop events while Input handles this one.
+		event_queue_read.store(read, std::memory_order_release);
+	}
+
+	const uint64_t dropped = dropped_events.get();
+	if (dropped > 0) {
+		dropped_events.sub(dropped);
+		WARN_PRINT(vformat("SDL: %d joypad events were dropped because the main thread didn't handle them in time.", dropped));
+	}
+}
+
+void JoypadSDL::_notify_event(const SDL_Event &p_event) {
+	if (latency_probe_event_type != 0 && p_event.type == latency_probe_event_type) {
+		callback_latency.add(nsec_to_usec(SDL_GetTicksNS() - p_event.common.timestamp));
+		return;
+	}
+	if (!event_callback) {
+		return;
+	}
+
+	JoypadEvent event;
+	switch (p_event.type) {
+		case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+			if (SDL_IsGamepad(p_event.jaxis.which)) {
+				return;
+			}
+			event.type = JoypadEvent::TYPE_AXIS;
+			event.index = p_event.jaxis.axis;
+			event.value = _get_joystick_axis_value(p_event.jaxis.value);
+			break;
+		case SDL_EVENT_JOYSTICK_BUTTON_UP:
+		case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+			if (SDL_IsGamepad(p_event.jbutton.which) || p_event.jbutton.button >= (int)JoyButton::MAX) {
+				return;
+			}
+			event.type = JoypadEvent::TYPE_BUTTON;
+			event.index = p_event.jbutton.button;
+			event.pressed = p_event.jbutton.down;
+			break;
+		case SDL_EVENT_JOYSTICK_HAT_MOTION:
+			if (SDL_IsGamepad(p_event.jhat.which)) {
+				return;
+			}
+			event.type = JoypadEvent::TYPE_HAT;
+			event.value = p_event.jhat.value;
+			break;
+		case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+			event.type = JoypadEvent::TYPE_AXIS;
+			event.index = p_event.gaxis.axis;
+			event.value = _get_gamepad_axis_value(p_event.gaxis.axis, p_event.gaxis.value);
+			break;
+		case SDL_EVENT_GAMEPAD_BUTTON_UP:
+		case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+			event.type = JoypadEvent::TYPE_BUTTON;
+			event.index = p_event.gbutton.button;
+			event.pressed = p_event.gbutton.down;
+			break;
+		default:
+			return;
+	}
+
+	event.timestamp_usec = nsec_to_usec(p_event.common.timestamp);
+	for (int i = 0; i < Input::JOYPADS_MAX; i++) {
+		if (joypad_instance_ids[i].load(std::memory_order_relaxed) == p_event.jdevice.which) {
+			event.device = i;
+			break;
+		}
+	}
+
+	event_callback(event, event_callback_userdata);
+}
+
+void JoypadSDL::inject_latency_probe() {
+	ERR_FAIL_COND_MSG(latency_probe_event_type == 0, "SDL couldn't register the latency probe event.");
+
+	SDL_Event event;
+	SDL_zero(event);
+	event.type = latency_probe_event_type;
+	event.common.timestamp = SDL_GetTicksNS();
+	ERR_FAIL_COND_MSG(!SDL_PushEvent(&event), SDL_GetError());
+}
+
+Dictionary JoypadSDL::get_latency_stats() const {
+	Dictionary stats;
+	const uint64_t callback_count = callback_latency.count.get();
+	const uint64_t input_count = input_latency.count.get();
+	stats["probes"] = input_count;
+	stats["callback_average_usec"] = callback_count ? double(callback_latency.total_usec.get()) / callback_count : 0.0;
+	stats["callback_max_usec"] = callback_latency.max_usec.get();
+	stats["input_average_usec"] = input_count ? double(input_latency.total_usec.get()) / input_count : 0.0;
+	stats["input_max_usec"] = input_latency.max_usec.get();
+	stats["polling_thread"] = polling_thread.is_started();
+	return stats;
+}
+
+void JoypadSDL::reset_latency_stats() {
+	for (LatencyStat *stat : { &callback_latency, &input_latency }) {
+		stat->count.set(0);
+		stat->total_usec.set(0);
+		stat->max_usec.set(0);
+	}
+}
+
 void JoypadSDL::process_events() {
 	// Update rumble first for it to be applied when we handle SDL events
 	for (int i = 0; i < Input::JOYPADS_MAX; i++) {
@@ -130,153 +360,158 @@ void JoypadSDL::process_events() {
 		}
 	}
 
+	if (polling_thread.is_started()) {
+		_drain_event_queue();
+		return;
+	}
+
 	SDL_Event sdl_event;
 	while (SDL_PollEvent(&sdl_event)) {
-		// A new joypad was attached
-		if (sdl_event.type == SDL_EVENT_JOYSTICK_ADDED) {
-			int joy_id = Input::get_singleton()->get_unused_joy_id();
-			if (joy_id == -1) {
-				// There is no space for more joypads...
-				print_error("A new joypad was attached but couldn't allocate a new id for it because joypad limit was reached.");
+		_notify_event(sdl_event);
+		_process_event(sdl_event);
+	}
+}
+
+void JoypadSDL::_process_event(const SDL_Event &p_event) {
+	if (latency_probe_event_type != 0 && p_event.type == latency_probe_event_type) {
+		input_latency.add(nsec_to_usec(SDL_GetTicksNS() - p_event.common.timestamp));
+		return;
+	}
+
+	// A new joypad was attached
+	if (p_event.type == SDL_EVENT_JOYSTICK_ADDED) {
+		int joy_id = Input::get_singleton()->get_unused_joy_id();
+		if (joy_id == -1) {
+			// There is no space for more joypads...
+			print_error("A new joypad was attached but couldn't allocate a new id for it because joypad limit was reached.");
+		} else {
+			SDL_Joystick *joy = nullptr;
+			SDL_Gamepad *gamepad = nullptr;
+			String device_name;
+
+			// Gamepads must be opened with SDL_OpenGamepad to get their special remapped events
+			if (SDL_IsGamepad(p_event.jdevice.which)) {
+				gamepad = SDL_OpenGamepad(p_event.jdevice.which);
+
+				ERR_FAIL_COND_MSG(!gamepad,
+						vformat("Error opening gamepad at index %d: %s", p_event.jdevice.which, SDL_GetError()));
+
+				device_name = SDL_GetGamepadName(gamepad);
+				joy = SDL_GetGamepadJoystick(gamepad);
+
+				print_verbose(vformat("SDL: Gamepad %s connected", SDL_GetGamepadName(gamepad)));
 			} else {
-				SDL_Joystick *joy = nullptr;
-				SDL_Gamepad *gamepad = nullptr;
-				String device_name;
+				joy = SDL_OpenJoystick(p_event.jdevice.which);
+				ERR_FAIL_COND_MSG(!joy,
+						vformat("Error opening joystick at index %d: %s", p_event.jdevice.which, SDL_GetError()));
 
-				// Gamepads must be opened with SDL_OpenGamepad to get their special remapped events
-				if (SDL_IsGamepad(sdl_event.jdevice.which)) {
-					gamepad = SDL_OpenGamepad(sdl_event.jdevice.which);
+				device_name = SDL_GetJoystickName(joy);
 
-					ERR_CONTINUE_MSG(!gamepad,
-							vformat("Error opening gamepad at index %d: %s", sdl_event.jdevice.which, SDL_GetError()));
+				print_verbose(vformat("SDL: Joystick %s connected", SDL_GetJoystickName(joy)));
+			}
 
-					device_name = SDL_GetGamepadName(gamepad);
-					joy = SDL_GetGamepadJoystick(gamepad);
+			const int MAX_GUID_SIZE = 64;
+			char guid[MAX_GUID_SIZE] = {};
 
-					print_verbose(vformat("SDL: Gamepad %s connected", SDL_GetGamepadName(gamepad)));
-				} else {
-					joy = SDL_OpenJoystick(sdl_event.jdevice.which);
-					ERR_CONTINUE_MSG(!joy,
-							vformat("Error opening joystick at index %d: %s", sdl_event.jdevice.which, SDL_GetError()));
+			SDL_GUIDToString(SDL_GetJoystickGUID(joy), guid, MAX_GUID_SIZE);
+			SDL_PropertiesID propertiesID = SDL_GetJoystickProperties(joy);
 
-					device_name = SDL_GetJoystickName(joy);
+			joypads[joy_id].attached = true;
+			joypads[joy_id].sdl_instance_idx = p_event.jdevice.which;
+			joypads[joy_id].supports_force_feedback = SDL_GetBooleanProperty(propertiesID, SDL_PROP_JOYSTICK_CAP_RUMBLE_BOOLEAN, false);
+			joypads[joy_id].guid = StringName(String(guid));
 
-					print_verbose(vformat("SDL: Joystick %s connected", SDL_GetJoystickName(joy)));
-				}
+			sdl_instance_id_to_joypad_id.insert(p_event.jdevice.which, joy_id);
+			joypad_instance_ids[joy_id].store(p_event.jdevice.which, std::memory_order_relaxed);
+
+			Dictionary joypad_info;
+			// Skip Godot's mapping system if SDL already handles the joypad's mapping.
+			joypad_info["mapping_handled"] = SDL_IsGamepad(p_event.jdevice.which);
+			joypad_info["raw_name"] = String(SDL_GetJoystickName(joy));
+			joypad_info["vendor_id"] = itos(SDL_GetJoystickVendor(joy));
+			joypad_info["product_id"] = itos(SDL_GetJoystickProduct(joy));
+
+			const uint64_t steam_handle = SDL_GetGamepadSteamHandle(gamepad);
+			if (steam_handle != 0) {
+				joypad_info["steam_input_index"] = itos(steam_handle);
+			}
 
-				const int MAX_GUID_SIZE = 64;
-				char guid[MAX_GUID_SIZE] = {};
+			const int player_index = SDL_GetJoystickPlayerIndex(joy);
+			if (player_index >= 0) {
+				// For XInput controllers SDL_GetJoystickPlayerIndex returns the XInput user index.
+				joypad_info["xinput_index"] = itos(player_index);
+			}
 
-				SDL_GUIDToString(SDL_GetJoystickGUID(joy), guid, MAX_GUID_SIZE);
-				SDL_PropertiesID propertiesID = SDL_GetJoystickProperties(joy);
+			Input::get_singleton()->joy_connection_changed(
+					joy_id,
+					true,
+					device_name,
+					joypads[joy_id].guid,
+					joypad_info);
 
-				joypads[joy_id].attached = true;
-				joypads[joy_id].sdl_instance_idx = sdl_event.jdevice.which;
-				joypads[joy_id].supports_force_feedback = SDL_GetBooleanProperty(propertiesID, SDL_PROP_JOYSTICK_CAP_RUMBLE_BOOLEAN, false);
-				joypads[joy_id].guid = StringName(String(guid));
+			Input::get_singleton()->set_joy_features(joy_id, &joypads[joy_id]);
+		}
+		// An event for an attached joypad
+	} else if (p_event.type >= SDL_EVENT_JOYSTICK_AXIS_MOTION && p_event.type < SDL_EVENT_FINGER_DOWN && sdl_instance_id_to_joypad_id.has(p_event.jdevice.which)) {
+		int joy_id = sdl_instance_id_to_joypad_id.get(p_event.jdevice.which);
 
-				sdl_instance_id_to_joypad_id.insert(sdl_event.jdevice.which, joy_id);
+		switch (p_event.type) {
+			case SDL_EVENT_JOYSTICK_REMOVED:
+				Input::get_singleton()->joy_connection_changed(joy_id, false, "");
+				close_joypad(joy_id);
+				break;
 
-				Dictionary joypad_info;
-				// Skip Godot's mapping system if SDL already handles the joypad's mapping.
-				joypad_info["mapping_handled"] = SDL_IsGamepad(sdl_event.jdevice.which);
-				joypad_info["raw_name"] = String(SDL_GetJoystickName(joy));
-				joypad_info["vendor_id"] = itos(SDL_GetJoystickVendor(joy));
-				joypad_info["product_id"] = itos(SDL_GetJoystickProduct(joy));
+			case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+				SKIP_EVENT_FOR_GAMEPAD;
 
-				const uint64_t steam_handle = SDL_GetGamepadSteamHandle(gamepad);
-				if (steam_handle != 0) {
-					joypad_info["steam_input_index"] = itos(steam_handle);
+				Input::get_singleton()->joy_axis(
+						joy_id,
+						static_cast<JoyAxis>(p_event.jaxis.axis), // Godot joy axis constants are already intentionally the same as SDL's
+						_get_joystick_axis_value(p_event.jaxis.value), nsec_to_usec(p_event.jaxis.timestamp));
+				break;
+
+			case SDL_EVENT_JOYSTICK_BUTTON_UP:
+			case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+				SKIP_EVENT_FOR_GAMEPAD;
+
+				// Some devices report pressing buttons with indices like 232+, 241+, etc. that are not valid,
+				// so we ignore them here.
+				if (p_event.jbutton.button >= (int)JoyButton::MAX) {
+					return;
 				}
 
-				const int player_index = SDL_GetJoystickPlayerIndex(joy);
-				if (player_index >= 0) {
-					// For XInput controllers SDL_GetJoystickPlayerIndex returns the XInput user index.
-					joypad_info["xinput_index"] = itos(player_index);
-				}
+				Input::get_singleton()->joy_button(
+						joy_id,
+						static_cast<JoyButton>(p_event.jbutton.button), // Godot button constants are intentionally the same as SDL's, so we can just straight up use them
+						p_event.jbutton.down, nsec_to_usec(p_event.common.timestamp));
+				break;
 
-				Input::get_singleton()->joy_connection_changed(
+			case SDL_EVENT_JOYSTICK_HAT_MOTION:
+				SKIP_EVENT_FOR_GAMEPAD;
+
+				Input::get_singleton()->joy_hat(
 						joy_id,
-						true,
-						device_name,
-						joypads[joy_id].guid,
-						joypad_info);
+						(HatMask)p_event.jhat.value, // Godot hat masks are identical to SDL hat masks, so we can just use them as-is.
+						nsec_to_usec(p_event.common.timestamp));
+				break;
 
-				Input::get_singleton()->set_joy_features(joy_id, &joypads[joy_id]);
-			}
-			// An event for an attached joypad
-		} else if (sdl_event.type >= SDL_EVENT_JOYSTICK_AXIS_MOTION && sdl_event.type < SDL_EVENT_FINGER_DOWN && sdl_instance_id_to_joypad_id.has(sdl_event.jdevice.which)) {
-			int joy_id = sdl_instance_id_to_joypad_id.get(sdl_event.jdevice.which);
-
-			switch (sdl_event.type) {
-				case SDL_EVENT_JOYSTICK_REMOVED:
-					Input::get_singleton()->joy_connection_changed(joy_id, false, "");
-					close_joypad(joy_id);
-					break;
-
-				case SDL_EVENT_JOYSTICK_AXIS_MOTION:
-					SKIP_EVENT_FOR_GAMEPAD;
-
-					Input::get_singleton()->joy_axis(
-							joy_id,
-							static_cast<JoyAxis>(sdl_event.jaxis.axis), // Godot joy axis constants are already intentionally the same as SDL's
-							((sdl_event.jaxis.value - SDL_JOYSTICK_AXIS_MIN) / (float)(SDL_JOYSTICK_AXIS_MAX - SDL_JOYSTICK_AXIS_MIN) - 0.5f) * 2.0f, nsec_to_usec(sdl_event.jaxis.timestamp));
-					break;
-
-				case SDL_EVENT_JOYSTICK_BUTTON_UP:
-				case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
-					SKIP_EVENT_FOR_GAMEPAD;
-
-					// Some devices report pressing buttons with indices like 232+, 241+, etc. that are not valid,
-					// so we ignore them here.
-					if (sdl_event.jbutton.button >= (int)JoyButton::MAX) {
-						continue;
-					}
-
-					Input::get_singleton()->joy_button(
-							joy_id,
-							static_cast<JoyButton>(sdl_event.jbutton.button), // Godot button constants are intentionally the same as SDL's, so we can just straight up use them
-							sdl_event.jbutton.down, nsec_to_usec(sdl_event.common.timestamp));
-					break;
-
-				case SDL_EVENT_JOYSTICK_HAT_MOTION:
-					SKIP_EVENT_FOR_GAMEPAD;
-
-					Input::get_singleton()->joy_hat(
-							joy_id,
-							(HatMask)sdl_event.jhat.value, // Godot hat masks are identical to SDL hat masks, so we can just use them as-is.
-							nsec_to_usec(sdl_event.common.timestamp));
-					break;
-
-				case SDL_EVENT_GAMEPAD_AXIS_MOTION: {
-					float axis_value;
-
-					if (sdl_event.gaxis.axis == SDL_GAMEPAD_AXIS_LEFT_TRIGGER || sdl_event.gaxis.axis == SDL_GAMEPAD_AXIS_RIGHT_TRIGGER) {
-						// Gamepad triggers go from 0 to SDL_JOYSTICK_AXIS_MAX
-						axis_value = sdl_event.gaxis.value / (float)SDL_JOYSTICK_AXIS_MAX;
-					} else {
-						// Other axis go from SDL_JOYSTICK_AXIS_MIN to SDL_JOYSTICK_AXIS_MAX
-						axis_value =
-								((sdl_event.gaxis.value - SDL_JOYSTICK_AXIS_MIN) / (float)(SDL_JOYSTICK_AXIS_MAX - SDL_JOYSTICK_AXIS_MIN) - 0.5f) * 2.0f;
-					}
-
-					Input::get_singleton()->joy_axis(
-							joy_id,
-							static_cast<JoyAxis>(sdl_event.gaxis.axis), // Godot joy axis constants are already intentionally the same as SDL's
-							axis_value,
-							nsec_to_usec(sdl_event.common.timestamp));
-				} break;
-
-				// Do note SDL gamepads do not have separate events for the dpad
-				case SDL_EVENT_GAMEPAD_BUTTON_UP:
-				case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
-					Input::get_singleton()->joy_button(
-							joy_id,
-							static_cast<JoyButton>(sdl_event.gbutton.button), // Godot button constants are intentionally the same as SDL's, so we can just straight up use them
-							sdl_event.gbutton.down,
-							nsec_to_usec(sdl_event.common.timestamp));
-					break;
-			}
+			case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+				Input::get_singleton()->joy_axis(
+						joy_id,
+						static_cast<JoyAxis>(p_event.gaxis.axis), // Godot joy axis constants are already intentionally the same as SDL's
+						_get_gamepad_axis_value(p_event.gaxis.axis, p_event.gaxis.value),
+						nsec_to_usec(p_event.common.timestamp));
+				break;
+
+			// Do note SDL gamepads do not have separate events for the dpad
+			case SDL_EVENT_GAMEPAD_BUTTON_UP:
+			case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+				Input::get_singleton()->joy_button(
+						joy_id,
+						static_cast<JoyButton>(p_event.gbutton.button), // Godot button constants are intentionally the same as SDL's, so we can just straight up use them
+						p_event.gbutton.down,
+						nsec_to_usec(p_event.common.timestamp));
+				break;
 		}
 	}
 }
@@ -302,6 +537,7 @@ void JoypadSDL::close_joypad(int p_pad_idx) {
 
 	joypads[p_pad_idx].attached = false;
 	sdl_instance_id_to_joypad_id.erase(sdl_instance_idx);
+	joypad_instance_ids[p_pad_idx].store(0, std::memory_order_relaxed);
 
 	if (SDL_IsGamepad(sdl_instance_idx)) {
 		SDL_Gamepad *gamepad = SDL_GetGamepadFromID(sdl_instance_idx);
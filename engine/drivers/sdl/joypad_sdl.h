@@ -32,13 +32,36 @@
 
 #include "core/input/input.h"
 #include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 typedef uint32_t SDL_JoystickID;
 typedef struct SDL_Joystick SDL_Joystick;
 typedef struct SDL_Gamepad SDL_Gamepad;
+typedef union SDL_Event SDL_Event;
 
 class JoypadSDL {
 public:
+	// Input event as seen by the event callback.
+	struct JoypadEvent {
+		enum Type {
+			TYPE_BUTTON,
+			TYPE_AXIS,
+			TYPE_HAT,
+		};
+
+		Type type = TYPE_BUTTON;
+		int device = -1; // -1 until the main thread handled the connection of the joypad.
+		int index = 0; // JoyButton or JoyAxis.
+		float value = 0.0; // Axis value, or HatMask for hats.
+		bool pressed = false;
+		uint64_t timestamp_usec = 0; // SDL clock, see get_sdl_time_nsec().
+	};
+
+	// Called for every joypad button, axis and hat event as soon as it's polled, before Input sees it.
+	// With the polling thread, it's called on that thread and must not block. Changing it while the thread
+	// runs restarts the thread.
+	typedef void (*EventCallback)(const JoypadEvent &p_event, void *p_userdata);
+
 	JoypadSDL();
 	~JoypadSDL();
 
@@ -51,6 +74,21 @@ public:
 	StringName get_device_guid(int p_device_idx) const;
 	uint64_t get_sdl_time_nsec() const;
 
+	// Polls SDL on a dedicated thread, so events get accurate timestamps and reach the
+	// event callback without waiting for the next frame. Not available on macOS, where SDL
+	// only receives joypad events on the main thread.
+	Error start_polling_thread(int p_rate_hz);
+	void stop_polling_thread();
+	bool is_polling_thread_running() const;
+
+	void set_event_callback(EventCallback p_callback, void *p_userdata);
+
+	// Pushes a synthetic event through SDL to measure how long events take to reach the event
+	// callback and Input. See get_latency_stats().
+	void inject_latency_probe();
+	Dictionary get_latency_stats() const;
+	void reset_latency_stats();
+
 private:
 	class Joypad : public Input::JoypadFeatures {
 	public:
@@ -73,6 +111,39 @@ private:
 
 	Joypad joypads[Input::JOYPADS_MAX];
 	HashMap<SDL_JoystickID, int> sdl_instance_id_to_joypad_id;
+	// Copy of the joypad instance IDs the polling thread can read, 0 for unused joypads.
+	std::atomic<SDL_JoystickID> joypad_instance_ids[Input::JOYPADS_MAX] = {};
+
+	// Events polled by the polling thread, waiting for process_events(). Single producer, single consumer.
+	static constexpr uint32_t EVENT_QUEUE_SIZE = 1024;
+	SDL_Event *event_queue = nullptr;
+	std::atomic<uint32_t> event_queue_read = 0;
+	std::atomic<uint32_t> event_queue_write = 0;
+	SafeNumeric<uint64_t> dropped_events;
+
+	Thread polling_thread;
+	SafeFlag polling_thread_exit;
+	int polling_rate_hz = 0;
+	uint64_t polling_period_usec = 1000;
+
+	EventCallback event_callback = nullptr;
+	void *event_callback_userdata = nullptr;
+
+	uint32_t latency_probe_event_type = 0;
+	struct LatencyStat {
+		SafeNumeric<uint64_t> count;
+		SafeNumeric<uint64_t> total_usec;
+		SafeNumeric<uint64_t> max_usec;
+
+		void add(uint64_t p_usec);
+	};
+	LatencyStat callback_latency;
+	LatencyStat input_latency;
+
+	static void _polling_thread_func(void *p_userdata);
+	void _drain_event_queue();
+	void _notify_event(const SDL_Event &p_event);
+	void _process_event(const SDL_Event &p_event);
 
 	void close_joypad(int p_pad_idx);
 	static uint64_t get_time();
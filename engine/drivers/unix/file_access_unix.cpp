@@ -36,6 +36,7 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -204,6 +205,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_length);
+		mapped = nullptr;
+		mapped_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -309,6 +316,37 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+Span<uint8_t> FileAccessUnix::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, Span<uint8_t>(), "File must be opened before use.");
+
+#if defined(WEB_ENABLED)
+	// Mapping a file on the web copies it anyway.
+	return Span<uint8_t>();
+#else
+	if (mapped) {
+		return Span<uint8_t>(mapped, mapped_length);
+	}
+	// The mapping of a file that is being written to could go stale.
+	if (flags != READ) {
+		return Span<uint8_t>();
+	}
+
+	const uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		return Span<uint8_t>();
+	}
+
+	void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (address == MAP_FAILED) {
+		return Span<uint8_t>();
+	}
+
+	mapped = (uint8_t *)address;
+	mapped_length = length;
+	return Span<uint8_t>(mapped, mapped_length);
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -46,6 +46,8 @@ class FileAccessUnix : public FileAccess {
 	String save_path;
 	String path;
 	String path_src;
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
 
 	void _close();
 
@@ -71,6 +73,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> map_read_only() override;
 
 	virtual Error get_error() const override; ///< get last error
 
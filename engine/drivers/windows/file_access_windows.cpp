@@ -238,6 +238,14 @@ void FileAccessWindows::_close() {
 		return;
 	}
 
+	if (mapped) {
+		UnmapViewOfFile(mapped);
+		CloseHandle((HANDLE)mapping);
+		mapped = nullptr;
+		mapping = nullptr;
+		mapped_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -349,6 +357,39 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 }
 
+Span<uint8_t> FileAccessWindows::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, Span<uint8_t>(), "File must be opened before use.");
+
+	if (mapped) {
+		return Span<uint8_t>(mapped, mapped_length);
+	}
+	// The mapping of a file that is being written to could go stale.
+	if (flags != READ) {
+		return Span<uint8_t>();
+	}
+
+	const uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		return Span<uint8_t>();
+	}
+
+	HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(f));
+	HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_handle) {
+		return Span<uint8_t>();
+	}
+	void *address = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+	if (!address) {
+		CloseHandle(mapping_handle);
+		return Span<uint8_t>();
+	}
+
+	mapping = mapping_handle;
+	mapped = (uint8_t *)address;
+	mapped_length = length;
+	return Span<uint8_t>(mapped, mapped_length);
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
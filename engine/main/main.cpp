@@ -59,6 +59,7 @@
 #include "main/app_icon.gen.h"
 #include "main/main_timer_sync.h"
 #include "main/performance.h"
+#include "main/simulation_harness.h"
 #include "main/splash.gen.h"
 #include "modules/register_module_types.h"
 #include "platform/register_platform_apis.h"
@@ -164,6 +165,7 @@ static Input *input = nullptr;
 static InputMap *input_map = nullptr;
 static TranslationServer *translation_server = nullptr;
 static Performance *performance = nullptr;
+static SimulationHarness *simulation_harness = nullptr;
 static PackedData *packed_data = nullptr;
 #ifdef MINIZIP_ENABLED
 static ZipArchive *zip_packed_data = nullptr;
@@ -674,6 +676,12 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--disable-render-loop", "Disable render loop so rendering only occurs when called explicitly from script.\n");
 	print_help_option("--disable-crash-handler", "Disable crash handler when supported by the platform code.\n");
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
+	print_help_option("--simulate <file>", "Run headless on a simulated clock, injecting input from the given JSON timeline, then quit.\n");
+	print_help_option("", "--fixed-fps is forced when enabled (60 by default).\n");
+	print_help_option("--simulate-report <file>", "Write the simulation report to the given JSON file instead of stdout.\n");
+#ifdef GODOT_USE_CHROME_TRACE
+	print_help_option("--trace-file <file>", "Record the module profile zones and save them as a Chrome trace (JSON) on exit.\n");
+#endif
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
 #ifdef TOOLS_ENABLED
@@ -723,6 +731,9 @@ void Main::print_help(const char *p_binary) {
 #endif // TOOLS_ENABLED
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n");
+	print_help_option("--test --benchmark", "Run the benchmarks instead of the unit tests. Options: --benchmark-filter <text>, --benchmark-list,\n");
+	print_help_option("", "--benchmark-repetitions <n>, --benchmark-warmup <n>, --benchmark-min-time <ms>, --benchmark-output <file>,\n");
+	print_help_option("", "--benchmark-baseline <file> and --benchmark-threshold <percent> (fails on regressions, 10 by default).\n");
 #endif // TESTS_ENABLED
 	OS::get_singleton()->print("\n");
 }
@@ -1035,6 +1046,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	performance = memnew(Performance);
 	GDREGISTER_CLASS(Performance);
 	engine->add_singleton(Engine::Singleton("Performance", performance));
+	simulation_harness = memnew(SimulationHarness);
+	GDREGISTER_CLASS(SimulationHarness);
+	engine->add_singleton(Engine::Singleton("SimulationHarness", simulation_harness));
 
 	// Only flush stdout in debug builds by default, as spamming `print()` will
 	// decrease performance if this is enabled.
@@ -1895,6 +1909,37 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing write-movie argument, aborting.\n");
 				goto error;
 			}
+		} else if (arg == "--simulate") {
+			if (N) {
+				simulation_harness->set_timeline_path(N->get());
+				N = N->next();
+				if (fixed_fps == -1) {
+					fixed_fps = 60;
+				}
+				audio_driver = NULL_AUDIO_DRIVER;
+				display_driver = NULL_DISPLAY_DRIVER;
+			} else {
+				OS::get_singleton()->print("Missing simulation timeline argument, aborting.\n");
+				goto error;
+			}
+		} else if (arg == "--simulate-report") {
+			if (N) {
+				simulation_harness->set_report_path(N->get());
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing simulation report argument, aborting.\n");
+				goto error;
+			}
+#ifdef GODOT_USE_CHROME_TRACE
+		} else if (arg == "--trace-file") {
+			if (N) {
+				ChromeTraceRecorder::start(N->get());
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing trace file argument, aborting.\n");
+				goto error;
+			}
+#endif
 		} else if (arg == "--disable-vsync") {
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
@@ -2892,6 +2937,9 @@ error:
 	if (performance) {
 		memdelete(performance);
 	}
+	if (simulation_harness) {
+		memdelete(simulation_harness);
+	}
 	if (input_map) {
 		memdelete(input_map);
 	}
@@ -4731,6 +4779,10 @@ int Main::start() {
 		movie_writer->begin(movie_size, fixed_fps, Engine::get_singleton()->get_write_movie_path());
 	}
 
+	if (simulation_harness->is_enabled() && simulation_harness->start(fixed_fps) != OK) {
+		return EXIT_FAILURE;
+	}
+
 	GDExtensionManager::get_singleton()->startup();
 
 #ifdef MACOS_ENABLED
@@ -4828,6 +4880,11 @@ bool Main::iteration() {
 
 	last_ticks = ticks;
 
+	if (simulation_harness->is_active()) {
+		GodotProfileZoneGrouped(_profile_zone, "simulation_harness->begin_frame");
+		simulation_harness->begin_frame();
+	}
+
 	const int max_physics_steps = Engine::get_singleton()->get_user_max_physics_steps_per_frame();
 	if (fixed_fps == -1 && advance.physics_steps > max_physics_steps) {
 		process_step -= (advance.physics_steps - max_physics_steps) * physics_step;
@@ -5027,6 +5084,10 @@ bool Main::iteration() {
 		movie_writer->add_frame();
 	}
 
+	if (simulation_harness->is_active() && simulation_harness->end_frame(frame_time)) {
+		exit = true;
+	}
+
 #ifdef TOOLS_ENABLED
 	bool quit_after_timeout = false;
 #endif
@@ -5112,6 +5173,16 @@ void Main::cleanup(bool p_force) {
 		movie_writer->end();
 	}
 
+	if (simulation_harness) {
+		simulation_harness->write_report();
+	}
+
+#ifdef GODOT_USE_CHROME_TRACE
+	if (ChromeTraceRecorder::is_recording()) {
+		ChromeTraceRecorder::stop();
+	}
+#endif
+
 	ResourceLoader::clear_thread_load_tasks();
 
 	ResourceLoader::remove_custom_loaders();
@@ -5218,6 +5289,9 @@ void Main::cleanup(bool p_force) {
 	if (performance) {
 		memdelete(performance);
 	}
+	if (simulation_harness) {
+		memdelete(simulation_harness);
+	}
 	if (input_map) {
 		memdelete(input_map);
 	}
@@ -133,6 +133,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(TIME_INPUT_TO_PRESENT);
+	BIND_ENUM_CONSTANT(TIME_LATE_LATCH_TO_PRESENT);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -228,6 +230,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("time/input_to_present"),
+		PNAME("time/late_latch_to_present"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -452,6 +456,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case TIME_INPUT_TO_PRESENT:
+			return RS::get_singleton()->get_input_to_present_time() / 1000.0;
+		case TIME_LATE_LATCH_TO_PRESENT:
+			return RS::get_singleton()->get_late_latch_to_present_time() / 1000.0;
 
 		default: {
 		}
@@ -525,7 +533,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
-
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
 
@@ -121,6 +121,8 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		TIME_INPUT_TO_PRESENT,
+		TIME_LATE_LATCH_TO_PRESENT,
 		MONITOR_MAX
 	};
 
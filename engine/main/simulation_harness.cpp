@@ -0,0 +1,353 @@
+/**************************************************************************/
+/*  simulation_harness.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "simulation_harness.h"
+
+#include "core/input/input.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/keyboard.h"
+#include "core/os/os.h"
+#include "scene/main/scene_tree.h"
+
+SimulationHarness *SimulationHarness::singleton = nullptr;
+
+void SimulationHarness::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("is_active"), &SimulationHarness::is_active);
+	ClassDB::bind_method(D_METHOD("get_time"), &SimulationHarness::get_time);
+	ClassDB::bind_method(D_METHOD("get_time_usec"), &SimulationHarness::get_time_usec);
+	ClassDB::bind_method(D_METHOD("record_judgement", "judgement", "offset_msec"), &SimulationHarness::record_judgement);
+	ClassDB::bind_method(D_METHOD("record_result", "key", "value"), &SimulationHarness::record_result);
+	ClassDB::bind_method(D_METHOD("finish"), &SimulationHarness::finish);
+	ClassDB::bind_method(D_METHOD("get_report"), &SimulationHarness::make_report);
+}
+
+SimulationHarness *SimulationHarness::get_singleton() {
+	return singleton;
+}
+
+void SimulationHarness::set_timeline_path(const String &p_path) {
+	timeline_path = p_path;
+}
+
+void SimulationHarness::set_report_path(const String &p_path) {
+	report_path = p_path;
+}
+
+void SimulationHarness::add_step_callback(StepCallback p_callback) {
+	ERR_FAIL_NULL(p_callback);
+	ERR_FAIL_COND(step_callbacks.has(p_callback));
+	step_callbacks.push_back(p_callback);
+}
+
+void SimulationHarness::remove_step_callback(StepCallback p_callback) {
+	step_callbacks.erase(p_callback);
+}
+
+Ref<InputEvent> SimulationHarness::_parse_event(const Dictionary &p_event) const {
+	const bool pressed = p_event.get("pressed", true);
+
+	if (p_event.has("action")) {
+		Ref<InputEventAction> action;
+		action.instantiate();
+		action->set_action(p_event["action"]);
+		action->set_pressed(pressed);
+		action->set_strength(p_event.get("strength", pressed ? 1.0 : 0.0));
+		return action;
+	}
+
+	if (p_event.has("key")) {
+		Key keycode = find_keycode(p_event["key"]);
+		ERR_FAIL_COND_V_MSG(keycode == Key::NONE, Ref<InputEvent>(), vformat("Unknown key \"%s\".", p_event["key"]));
+		Ref<InputEventKey> key;
+		key.instantiate();
+		key->set_keycode(keycode);
+		key->set_physical_keycode(keycode);
+		key->set_pressed(pressed);
+		return key;
+	}
+
+	if (p_event.has("joy_button")) {
+		Ref<InputEventJoypadButton> button;
+		button.instantiate();
+		button->set_device(p_event.get("device", 0));
+		button->set_button_index(JoyButton(int(p_event["joy_button"])));
+		button->set_pressed(pressed);
+		return button;
+	}
+
+	ERR_FAIL_V_MSG(Ref<InputEvent>(), "Timeline events need an \"action\", \"key\" or \"joy_button\" entry.");
+}
+
+Error SimulationHarness::_load_timeline() {
+	Ref<FileAccess> f = FileAccess::open(timeline_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, vformat("Can't open simulation timeline \"%s\".", timeline_path));
+
+	Ref<JSON> json;
+	json.instantiate();
+	Error err = json->parse(f->get_as_utf8_string());
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't parse simulation timeline \"%s\" at line %d: %s", timeline_path, json->get_error_line(), json->get_error_message()));
+	ERR_FAIL_COND_V_MSG(json->get_data().get_type() != Variant::DICTIONARY, ERR_PARSE_ERROR, vformat("Simulation timeline \"%s\" must be a JSON object.", timeline_path));
+
+	const Dictionary data = json->get_data();
+	const Array events = data.get("events", Array());
+
+	timeline.clear();
+	timeline.reserve(events.size());
+	for (int i = 0; i < events.size(); i++) {
+		ERR_FAIL_COND_V_MSG(events[i].get_type() != Variant::DICTIONARY, ERR_PARSE_ERROR, vformat("Timeline event %d is not a JSON object.", i));
+		const Dictionary event = events[i];
+		const double time = event.get("time", -1.0);
+		ERR_FAIL_COND_V_MSG(time < 0.0, ERR_PARSE_ERROR, vformat("Timeline event %d has no valid \"time\".", i));
+
+		TimelineEvent timeline_event;
+		timeline_event.time_usec = uint64_t(time * 1000000.0);
+		ERR_FAIL_COND_V_MSG(!timeline.is_empty() && timeline_event.time_usec < timeline[timeline.size() - 1].time_usec, ERR_PARSE_ERROR, vformat("Timeline event %d is not sorted by time.", i));
+		timeline_event.event = _parse_event(event);
+		ERR_FAIL_COND_V(timeline_event.event.is_null(), ERR_PARSE_ERROR);
+		timeline.push_back(timeline_event);
+	}
+
+	// Without an explicit duration, give the scene a moment to react to the last event.
+	const double duration = data.get("duration", 0.0);
+	if (duration > 0.0) {
+		end_time_usec = uint64_t(duration * 1000000.0);
+	} else {
+		end_time_usec = (timeline.is_empty() ? 0 : timeline[timeline.size() - 1].time_usec) + 2000000;
+	}
+
+	return OK;
+}
+
+Error SimulationHarness::start(int p_fixed_fps) {
+	ERR_FAIL_COND_V_MSG(p_fixed_fps <= 0, ERR_INVALID_PARAMETER, "Simulation requires a fixed FPS.");
+	Error err = _load_timeline();
+	if (err != OK) {
+		return err;
+	}
+
+	fixed_fps = p_fixed_fps;
+	frames = 0;
+	time_usec = 0;
+	next_event = 0;
+	finish_requested = false;
+	frame_times_usec.clear();
+	frame_times_usec.reserve(uint32_t(end_time_usec * fixed_fps / 1000000) + 1);
+
+	SceneTree *tree = SceneTree::get_singleton();
+	if (tree) {
+		tree->get_process_sampler().clear();
+		tree->get_process_sampler().set_enabled(true);
+	}
+
+	start_ticks_usec = OS::get_singleton()->get_ticks_usec();
+	active = true;
+	print_line(vformat("Simulating \"%s\": %d events over %.2f s at %d FPS.", timeline_path, timeline.size(), end_time_usec / 1000000.0, fixed_fps));
+	return OK;
+}
+
+void SimulationHarness::begin_frame() {
+	// Derive the time from the frame count, so it doesn't accumulate rounding errors over a long run.
+	time_usec = frames * 1000000 / fixed_fps;
+	frame_ticks_usec = OS::get_singleton()->get_ticks_usec();
+
+	for (StepCallback callback : step_callbacks) {
+		callback(time_usec);
+	}
+
+	bool injected = false;
+	while (next_event < timeline.size() && timeline[next_event].time_usec <= time_usec) {
+		// Stamped in the ticks clock like the display servers' events, so Input's latency monitor
+		// measures from the frame that received them.
+		Ref<InputEvent> event = timeline[next_event].event;
+		event->set_timestamp_usec(frame_ticks_usec);
+		Input::get_singleton()->parse_input_event(event);
+		next_event++;
+		injected = true;
+	}
+
+	if (injected) {
+		Input::get_singleton()->flush_buffered_events();
+	}
+}
+
+bool SimulationHarness::end_frame(uint64_t p_frame_time_usec) {
+	frame_times_usec.push_back(uint32_t(MIN(p_frame_time_usec, uint64_t(UINT32_MAX))));
+	frames++;
+	// Stop before the frame that would start at the end of the timeline.
+	return finish_requested || frames * 1000000 / fixed_fps >= end_time_usec;
+}
+
+Dictionary SimulationHarness::_make_frame_time_report() const {
+	Dictionary report;
+	if (frame_times_usec.is_empty()) {
+		return report;
+	}
+
+	LocalVector<uint32_t> sorted = frame_times_usec;
+	sorted.sort();
+
+	uint64_t total_usec = 0;
+	for (uint32_t frame_time : sorted) {
+		total_usec += frame_time;
+	}
+
+	report["mean_msec"] = total_usec / 1000.0 / sorted.size();
+	report["p50_msec"] = sorted[sorted.size() / 2] / 1000.0;
+	report["p99_msec"] = sorted[MIN(sorted.size() - 1, sorted.size() * 99 / 100)] / 1000.0;
+	report["max_msec"] = sorted[sorted.size() - 1] / 1000.0;
+
+	static const uint32_t bucket_limits_usec[] = { 1000, 2000, 4000, 8000, 16667, 33333, 50000, 100000 };
+	static const char *bucket_names[] = { "0-1", "1-2", "2-4", "4-8", "8-16.7", "16.7-33.3", "33.3-50", "50-100", "100+" };
+	uint64_t counts[std_size(bucket_names)] = {};
+	for (uint32_t frame_time : sorted) {
+		uint32_t bucket = 0;
+		while (bucket < std_size(bucket_limits_usec) && frame_time >= bucket_limits_usec[bucket]) {
+			bucket++;
+		}
+		counts[bucket]++;
+	}
+
+	Dictionary histogram;
+	for (uint32_t i = 0; i < std_size(bucket_names); i++) {
+		histogram[bucket_names[i]] = counts[i];
+	}
+	report["histogram_msec"] = histogram;
+	return report;
+}
+
+Dictionary SimulationHarness::_make_judgement_report() const {
+	Dictionary counts;
+	Array events;
+	double offset_sum = 0.0;
+	double offset_squared_sum = 0.0;
+
+	for (const Judgement &judgement : judgements) {
+		counts[judgement.judgement] = int64_t(counts.get(judgement.judgement, 0)) + 1;
+		offset_sum += judgement.offset_msec;
+		offset_squared_sum += judgement.offset_msec * judgement.offset_msec;
+
+		Dictionary event;
+		event["time"] = judgement.time_usec / 1000000.0;
+		event["judgement"] = judgement.judgement;
+		event["offset_msec"] = judgement.offset_msec;
+		events.push_back(event);
+	}
+
+	Dictionary report;
+	report["counts"] = counts;
+	if (!judgements.is_empty()) {
+		const double mean = offset_sum / judgements.size();
+		report["offset_mean_msec"] = mean;
+		report["offset_stddev_msec"] = Math::sqrt(MAX(0.0, offset_squared_sum / judgements.size() - mean * mean));
+	}
+	report["events"] = events;
+	return report;
+}
+
+Dictionary SimulationHarness::make_report() const {
+	const double simulated_time = time_usec / 1000000.0;
+	const double wall_time = (OS::get_singleton()->get_ticks_usec() - start_ticks_usec) / 1000000.0;
+
+	Dictionary report;
+	report["timeline"] = timeline_path;
+	report["fps"] = fixed_fps;
+	report["frames"] = frames;
+	report["simulated_time"] = simulated_time;
+	report["wall_time"] = wall_time;
+	report["realtime_factor"] = wall_time > 0.0 ? simulated_time / wall_time : 0.0;
+	report["injected_events"] = next_event;
+	report["frame_time"] = _make_frame_time_report();
+	SceneTree *tree = SceneTree::get_singleton();
+	if (tree) {
+		const Dictionary process_report = tree->get_process_sampling_report();
+		report["nodes"] = process_report["nodes"];
+		report["scripts"] = process_report["scripts"];
+	}
+	report["judgements"] = _make_judgement_report();
+	report["results"] = results;
+	return report;
+}
+
+void SimulationHarness::write_report() {
+	if (!active || report_written) {
+		return;
+	}
+	report_written = true;
+
+	const String json = JSON::stringify(make_report(), "\t", false);
+	if (report_path.is_empty()) {
+		print_line(json);
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(report_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), vformat("Can't write simulation report to \"%s\".", report_path));
+	f->store_string(json);
+}
+
+bool SimulationHarness::is_active() const {
+	return active;
+}
+
+double SimulationHarness::get_time() const {
+	return time_usec / 1000000.0;
+}
+
+int64_t SimulationHarness::get_time_usec() const {
+	return time_usec;
+}
+
+void SimulationHarness::record_judgement(const StringName &p_judgement, double p_offset_msec) {
+	ERR_FAIL_COND(!active);
+	Judgement judgement;
+	judgement.time_usec = time_usec;
+	judgement.judgement = p_judgement;
+	judgement.offset_msec = p_offset_msec;
+	judgements.push_back(judgement);
+}
+
+void SimulationHarness::record_result(const String &p_key, const Variant &p_value) {
+	ERR_FAIL_COND(!active);
+	results[p_key] = p_value;
+}
+
+void SimulationHarness::finish() {
+	ERR_FAIL_COND(!active);
+	finish_requested = true;
+}
+
+SimulationHarness::SimulationHarness() {
+	singleton = this;
+}
+
+SimulationHarness::~SimulationHarness() {
+	singleton = nullptr;
+}
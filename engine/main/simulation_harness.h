@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  simulation_harness.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/input/input_event.h"
+#include "core/object/class_db.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Runs the main loop on a fixed-step simulated clock and injects input from a recorded
+// timeline, so scene logic can be replayed headless and faster than real time.
+// Enabled with `--simulate <timeline>`, see Main::setup().
+class SimulationHarness : public Object {
+	GDCLASS(SimulationHarness, Object);
+
+public:
+	// Advances a server that runs on its own clock, such as audio, to the simulated time of the frame.
+	typedef void (*StepCallback)(uint64_t p_time_usec);
+
+private:
+	static SimulationHarness *singleton;
+
+	struct TimelineEvent {
+		uint64_t time_usec = 0;
+		Ref<InputEvent> event;
+	};
+
+	struct Judgement {
+		uint64_t time_usec = 0;
+		StringName judgement;
+		double offset_msec = 0.0;
+	};
+
+	String timeline_path;
+	String report_path;
+	bool active = false;
+	bool finish_requested = false;
+	bool report_written = false;
+
+	LocalVector<TimelineEvent> timeline;
+	uint32_t next_event = 0;
+	uint64_t end_time_usec = 0;
+	int fixed_fps = 0;
+	uint64_t time_usec = 0;
+	uint64_t frames = 0;
+	uint64_t start_ticks_usec = 0;
+	uint64_t frame_ticks_usec = 0;
+
+	LocalVector<StepCallback> step_callbacks;
+
+	LocalVector<uint32_t> frame_times_usec;
+	LocalVector<Judgement> judgements;
+	Dictionary results;
+
+	Error _load_timeline();
+	Ref<InputEvent> _parse_event(const Dictionary &p_event) const;
+	Dictionary _make_frame_time_report() const;
+	Dictionary _make_judgement_report() const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static SimulationHarness *get_singleton();
+
+	void set_timeline_path(const String &p_path);
+	void set_report_path(const String &p_path);
+	bool is_enabled() const { return !timeline_path.is_empty(); }
+
+	void add_step_callback(StepCallback p_callback);
+	void remove_step_callback(StepCallback p_callback);
+
+	Error start(int p_fixed_fps);
+	void begin_frame();
+	bool end_frame(uint64_t p_frame_time_usec);
+	void write_report();
+
+	bool is_active() const;
+	double get_time() const;
+	int64_t get_time_usec() const;
+	uint64_t get_frame_count() const { return frames; }
+	// Ticks at the start of the current frame, the timestamp of the events injected in it.
+	uint64_t get_frame_ticks_usec() const { return frame_ticks_usec; }
+	void record_judgement(const StringName &p_judgement, double p_offset_msec);
+	void record_result(const String &p_key, const Variant &p_value);
+	void finish();
+
+	Dictionary make_report() const;
+
+	SimulationHarness();
+	~SimulationHarness();
+};
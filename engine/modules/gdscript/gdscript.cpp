@@ -2180,6 +2180,18 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (GDScriptFunction::is_opcode_pair_histogram_enabled()) {
+		GDScriptFunction::set_opcode_pair_histogram_enabled(false);
+		Ref<FileAccess> f = FileAccess::open(opcode_pair_histogram_path, FileAccess::WRITE);
+		if (f.is_valid()) {
+			f->store_string(GDScriptFunction::get_opcode_pair_histogram_csv());
+		} else {
+			ERR_PRINT(vformat("Could not write GDScript opcode pair histogram to \"%s\".", opcode_pair_histogram_path));
+		}
+	}
+#endif
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2821,11 +2833,15 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	fuse_superinstructions = GLOBAL_DEF_RST("debug/settings/gdscript/fuse_superinstructions", true);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
 	track_locals = track_locals || EngineDebugger::is_active();
 
+	opcode_pair_histogram_path = GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "debug/settings/gdscript/opcode_pair_histogram_path", PROPERTY_HINT_SAVE_FILE, "*.csv"), "");
+	GDScriptFunction::set_opcode_pair_histogram_enabled(!opcode_pair_histogram_path.is_empty());
+
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 
 	GLOBAL_DEF(PropertyInfo(Variant::DICTIONARY,
@@ -440,6 +440,10 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool fuse_superinstructions = true;
+#ifdef DEBUG_ENABLED
+	String opcode_pair_histogram_path;
+#endif
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -449,6 +453,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	String _get_global_class_name(const String &p_path, String *r_base_type, String *r_icon_path, bool *r_is_abstract, bool *r_is_tool, LocalVector<String> &r_visited) const;
 
 	friend class GDScriptInstance;
+	friend class GDScriptSampler;
 
 	Mutex mutex;
 
@@ -572,6 +577,7 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool should_fuse_superinstructions() const { return fuse_superinstructions; }
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
@@ -150,6 +150,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		clear_fusable_producer();
 	}
 }
 
@@ -556,11 +557,13 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		int position = opcodes.size();
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
 		append(p_target);
 		append(op_func);
+		set_fusable_producer(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, position, p_target);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -613,11 +616,15 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
-		append(p_left_operand);
-		append(p_right_operand);
-		append(p_target);
-		append(op_func);
+		if (!try_fuse_operator(p_target, p_left_operand, p_right_operand, op_func)) {
+			int position = opcodes.size();
+			append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			append(op_func);
+			set_fusable_producer(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, position, p_target);
+		}
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -638,6 +645,44 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 }
 
+bool GDScriptByteCodeGenerator::try_fuse_operator(const Address &p_target, const Address &p_left_operand, const Address &p_right_operand, Variant::ValidatedOperatorEvaluator p_operator_func) {
+	if (fusable_producer.position < 0 || fusable_producer.end != opcodes.size()) {
+		return false;
+	}
+
+	// Only fuse when this operator consumes the value produced by the previous instruction,
+	// both instructions are still executed in full so the producer temporary stays valid.
+	bool consumes_target = (p_left_operand.mode == Address::TEMPORARY && p_left_operand.address == fusable_producer.target) ||
+			(p_right_operand.mode == Address::TEMPORARY && p_right_operand.address == fusable_producer.target);
+	if (!consumes_target) {
+		return false;
+	}
+
+	GDScriptFunction::Opcode fused_opcode;
+	switch (fusable_producer.opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			fused_opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_PAIR;
+			break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+			fused_opcode = GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED_OPERATOR;
+			break;
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+			fused_opcode = GDScriptFunction::OPCODE_GET_NAMED_VALIDATED_OPERATOR;
+			break;
+		default:
+			clear_fusable_producer();
+			return false;
+	}
+
+	opcodes.write[fusable_producer.position] = fused_opcode;
+	append(p_left_operand);
+	append(p_right_operand);
+	append(p_target);
+	append(p_operator_func);
+	clear_fusable_producer();
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
 	switch (p_type.kind) {
 		case GDScriptDataType::BUILTIN: {
@@ -820,11 +865,13 @@ void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
+			int position = opcodes.size();
 			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED);
 			append(p_source);
 			append(p_index);
 			append(p_target);
 			append(getter);
+			set_fusable_producer(GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED, position, p_target);
 			return;
 		} else if (Variant::get_member_validated_keyed_getter(p_source.type.builtin_type)) {
 			Variant::ValidatedKeyedGetter getter = Variant::get_member_validated_keyed_getter(p_source.type.builtin_type);
@@ -864,10 +911,12 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source) && Variant::get_member_validated_getter(p_source.type.builtin_type, p_name)) {
 		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(p_source.type.builtin_type, p_name);
+		int position = opcodes.size();
 		append_opcode(GDScriptFunction::OPCODE_GET_NAMED_VALIDATED);
 		append(p_source);
 		append(p_target);
 		append(getter);
+		set_fusable_producer(GDScriptFunction::OPCODE_GET_NAMED_VALIDATED, position, p_target);
 #ifdef DEBUG_ENABLED
 		add_debug_name(getter_names, get_getter_pos(getter), p_name);
 #endif
@@ -1021,6 +1070,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	clear_fusable_producer();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1780,6 +1830,7 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	clear_fusable_producer();
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
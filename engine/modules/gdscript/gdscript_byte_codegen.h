@@ -100,6 +100,15 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 
+	// Last emitted instruction that a following validated operator can be fused with
+	// into a superinstruction. Only valid while nothing else has been emitted after it.
+	struct FusableProducer {
+		GDScriptFunction::Opcode opcode = GDScriptFunction::OPCODE_END;
+		int position = -1;
+		int end = -1;
+		uint32_t target = 0; // Temporary written by the producer.
+	} fusable_producer;
+
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
 #endif
@@ -453,8 +462,27 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		// Something jumps here, the previous instruction can't be merged with the next one.
+		clear_fusable_producer();
+	}
+
+	void set_fusable_producer(GDScriptFunction::Opcode p_opcode, int p_position, const Address &p_target) {
+		if (p_target.mode != Address::TEMPORARY || !GDScriptLanguage::get_singleton()->should_fuse_superinstructions()) {
+			clear_fusable_producer();
+			return;
+		}
+		fusable_producer.opcode = p_opcode;
+		fusable_producer.position = p_position;
+		fusable_producer.end = opcodes.size();
+		fusable_producer.target = p_target.address;
 	}
 
+	void clear_fusable_producer() {
+		fusable_producer.position = -1;
+	}
+
+	bool try_fuse_operator(const Address &p_target, const Address &p_left_operand, const Address &p_right_operand, Variant::ValidatedOperatorEvaluator p_operator_func);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -141,6 +141,27 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_PAIR: {
+				text += "validated operator pair ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; ";
+				text += DADDR(7);
+				text += " = ";
+				text += DADDR(5);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 8]];
+				text += " ";
+				text += DADDR(6);
+
+				incr += 9;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -300,6 +321,24 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_GET_INDEXED_VALIDATED_OPERATOR: {
+				text += "get indexed validated operator ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]; ";
+				text += DADDR(7);
+				text += " = ";
+				text += DADDR(5);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 8]];
+				text += " ";
+				text += DADDR(6);
+
+				incr += 9;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -342,6 +381,24 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 4;
 			} break;
+			case OPCODE_GET_NAMED_VALIDATED_OPERATOR: {
+				text += "get_named validated operator ";
+				text += DADDR(2);
+				text += " = ";
+				text += DADDR(1);
+				text += "[\"";
+				text += getter_names[_code_ptr[ip + 3]];
+				text += "\"]; ";
+				text += DADDR(6);
+				text += " = ";
+				text += DADDR(4);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 7]];
+				text += " ";
+				text += DADDR(5);
+
+				incr += 8;
+			} break;
 			case OPCODE_SET_MEMBER: {
 				text += "set_member ";
 				text += "[\"";
@@ -42,6 +42,224 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+#ifdef DEBUG_ENABLED
+bool GDScriptFunction::_opcode_pair_histogram_enabled = false;
+SafeNumeric<uint64_t> GDScriptFunction::_opcode_pair_histogram[OPCODE_END + 1][OPCODE_END + 1];
+
+static const char *opcode_names[] = {
+	"OPERATOR",
+	"OPERATOR_VALIDATED",
+	"OPERATOR_VALIDATED_PAIR",
+	"TYPE_TEST_BUILTIN",
+	"TYPE_TEST_ARRAY",
+	"TYPE_TEST_DICTIONARY",
+	"TYPE_TEST_NATIVE",
+	"TYPE_TEST_SCRIPT",
+	"SET_KEYED",
+	"SET_KEYED_VALIDATED",
+	"SET_INDEXED_VALIDATED",
+	"GET_KEYED",
+	"GET_KEYED_VALIDATED",
+	"GET_INDEXED_VALIDATED",
+	"GET_INDEXED_VALIDATED_OPERATOR",
+	"SET_NAMED",
+	"SET_NAMED_VALIDATED",
+	"GET_NAMED",
+	"GET_NAMED_VALIDATED",
+	"GET_NAMED_VALIDATED_OPERATOR",
+	"SET_MEMBER",
+	"GET_MEMBER",
+	"SET_STATIC_VARIABLE",
+	"GET_STATIC_VARIABLE",
+	"ASSIGN",
+	"ASSIGN_NULL",
+	"ASSIGN_TRUE",
+	"ASSIGN_FALSE",
+	"ASSIGN_TYPED_BUILTIN",
+	"ASSIGN_TYPED_ARRAY",
+	"ASSIGN_TYPED_DICTIONARY",
+	"ASSIGN_TYPED_NATIVE",
+	"ASSIGN_TYPED_SCRIPT",
+	"CAST_TO_BUILTIN",
+	"CAST_TO_NATIVE",
+	"CAST_TO_SCRIPT",
+	"CONSTRUCT",
+	"CONSTRUCT_VALIDATED",
+	"CONSTRUCT_ARRAY",
+	"CONSTRUCT_TYPED_ARRAY",
+	"CONSTRUCT_DICTIONARY",
+	"CONSTRUCT_TYPED_DICTIONARY",
+	"CALL",
+	"CALL_RETURN",
+	"CALL_ASYNC",
+	"CALL_UTILITY",
+	"CALL_UTILITY_VALIDATED",
+	"CALL_GDSCRIPT_UTILITY",
+	"CALL_BUILTIN_TYPE_VALIDATED",
+	"CALL_SELF_BASE",
+	"CALL_METHOD_BIND",
+	"CALL_METHOD_BIND_RET",
+	"CALL_BUILTIN_STATIC",
+	"CALL_NATIVE_STATIC",
+	"CALL_NATIVE_STATIC_VALIDATED_RETURN",
+	"CALL_NATIVE_STATIC_VALIDATED_NO_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_NO_RETURN",
+	"AWAIT",
+	"AWAIT_RESUME",
+	"CREATE_LAMBDA",
+	"CREATE_SELF_LAMBDA",
+	"JUMP",
+	"JUMP_IF",
+	"JUMP_IF_NOT",
+	"JUMP_TO_DEF_ARGUMENT",
+	"JUMP_IF_SHARED",
+	"RETURN",
+	"RETURN_TYPED_BUILTIN",
+	"RETURN_TYPED_ARRAY",
+	"RETURN_TYPED_DICTIONARY",
+	"RETURN_TYPED_NATIVE",
+	"RETURN_TYPED_SCRIPT",
+	"ITERATE_BEGIN",
+	"ITERATE_BEGIN_INT",
+	"ITERATE_BEGIN_FLOAT",
+	"ITERATE_BEGIN_VECTOR2",
+	"ITERATE_BEGIN_VECTOR2I",
+	"ITERATE_BEGIN_VECTOR3",
+	"ITERATE_BEGIN_VECTOR3I",
+	"ITERATE_BEGIN_STRING",
+	"ITERATE_BEGIN_DICTIONARY",
+	"ITERATE_BEGIN_ARRAY",
+	"ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_STRING_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+	"ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR4_ARRAY",
+	"ITERATE_BEGIN_OBJECT",
+	"ITERATE_BEGIN_RANGE",
+	"ITERATE",
+	"ITERATE_INT",
+	"ITERATE_FLOAT",
+	"ITERATE_VECTOR2",
+	"ITERATE_VECTOR2I",
+	"ITERATE_VECTOR3",
+	"ITERATE_VECTOR3I",
+	"ITERATE_STRING",
+	"ITERATE_DICTIONARY",
+	"ITERATE_ARRAY",
+	"ITERATE_PACKED_BYTE_ARRAY",
+	"ITERATE_PACKED_INT32_ARRAY",
+	"ITERATE_PACKED_INT64_ARRAY",
+	"ITERATE_PACKED_FLOAT32_ARRAY",
+	"ITERATE_PACKED_FLOAT64_ARRAY",
+	"ITERATE_PACKED_STRING_ARRAY",
+	"ITERATE_PACKED_VECTOR2_ARRAY",
+	"ITERATE_PACKED_VECTOR3_ARRAY",
+	"ITERATE_PACKED_COLOR_ARRAY",
+	"ITERATE_PACKED_VECTOR4_ARRAY",
+	"ITERATE_OBJECT",
+	"ITERATE_RANGE",
+	"STORE_GLOBAL",
+	"STORE_NAMED_GLOBAL",
+	"TYPE_ADJUST_BOOL",
+	"TYPE_ADJUST_INT",
+	"TYPE_ADJUST_FLOAT",
+	"TYPE_ADJUST_STRING",
+	"TYPE_ADJUST_VECTOR2",
+	"TYPE_ADJUST_VECTOR2I",
+	"TYPE_ADJUST_RECT2",
+	"TYPE_ADJUST_RECT2I",
+	"TYPE_ADJUST_VECTOR3",
+	"TYPE_ADJUST_VECTOR3I",
+	"TYPE_ADJUST_TRANSFORM2D",
+	"TYPE_ADJUST_VECTOR4",
+	"TYPE_ADJUST_VECTOR4I",
+	"TYPE_ADJUST_PLANE",
+	"TYPE_ADJUST_QUATERNION",
+	"TYPE_ADJUST_AABB",
+	"TYPE_ADJUST_BASIS",
+	"TYPE_ADJUST_TRANSFORM3D",
+	"TYPE_ADJUST_PROJECTION",
+	"TYPE_ADJUST_COLOR",
+	"TYPE_ADJUST_STRING_NAME",
+	"TYPE_ADJUST_NODE_PATH",
+	"TYPE_ADJUST_RID",
+	"TYPE_ADJUST_OBJECT",
+	"TYPE_ADJUST_CALLABLE",
+	"TYPE_ADJUST_SIGNAL",
+	"TYPE_ADJUST_DICTIONARY",
+	"TYPE_ADJUST_ARRAY",
+	"TYPE_ADJUST_PACKED_BYTE_ARRAY",
+	"TYPE_ADJUST_PACKED_INT32_ARRAY",
+	"TYPE_ADJUST_PACKED_INT64_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+	"TYPE_ADJUST_PACKED_STRING_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+	"TYPE_ADJUST_PACKED_COLOR_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR4_ARRAY",
+	"ASSERT",
+	"BREAKPOINT",
+	"LINE",
+	"END",
+};
+
+static_assert(std_size(opcode_names) == (GDScriptFunction::OPCODE_END + 1), "Opcode names aren't the same as opcodes in enum.");
+
+const char *GDScriptFunction::get_opcode_name(int p_opcode) {
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_END + 1, "<invalid>");
+	return opcode_names[p_opcode];
+}
+
+void GDScriptFunction::set_opcode_pair_histogram_enabled(bool p_enabled) {
+	_opcode_pair_histogram_enabled = p_enabled;
+}
+
+void GDScriptFunction::clear_opcode_pair_histogram() {
+	for (int i = 0; i <= OPCODE_END; i++) {
+		for (int j = 0; j <= OPCODE_END; j++) {
+			_opcode_pair_histogram[i][j].set(0);
+		}
+	}
+}
+
+String GDScriptFunction::get_opcode_pair_histogram_csv(int p_max_pairs) {
+	struct PairCount {
+		uint64_t count = 0;
+		int first = 0;
+		int second = 0;
+
+		bool operator<(const PairCount &p_other) const {
+			return count > p_other.count;
+		}
+	};
+
+	LocalVector<PairCount> pairs;
+	for (int i = 0; i <= OPCODE_END; i++) {
+		for (int j = 0; j <= OPCODE_END; j++) {
+			uint64_t count = _opcode_pair_histogram[i][j].get();
+			if (count > 0) {
+				pairs.push_back({ count, i, j });
+			}
+		}
+	}
+	pairs.sort();
+
+	String csv = "count,first,second\n";
+	uint32_t max_pairs = p_max_pairs > 0 ? MIN((uint32_t)p_max_pairs, pairs.size()) : pairs.size();
+	for (uint32_t i = 0; i < max_pairs; i++) {
+		csv += vformat("%d,%s,%s\n", pairs[i].count, opcode_names[pairs[i].first], opcode_names[pairs[i].second]);
+	}
+	return csv;
+}
+#endif // DEBUG_ENABLED
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
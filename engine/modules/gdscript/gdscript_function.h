@@ -265,6 +265,7 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_PAIR, // Superinstruction: validated operator feeding another one.
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -276,10 +277,12 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_VALIDATED_OPERATOR, // Superinstruction: indexed get feeding a validated operator.
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
 		OPCODE_GET_NAMED_VALIDATED,
+		OPCODE_GET_NAMED_VALIDATED_OPERATOR, // Superinstruction: named get feeding a validated operator.
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
 		OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.
@@ -563,6 +566,12 @@ private:
 	} profile;
 #endif
 
+#ifdef DEBUG_ENABLED
+	// Counts of consecutively dispatched opcode pairs, used to pick superinstruction candidates.
+	static bool _opcode_pair_histogram_enabled;
+	static SafeNumeric<uint64_t> _opcode_pair_histogram[OPCODE_END + 1][OPCODE_END + 1];
+#endif
+
 	String _get_call_error(const String &p_where, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
@@ -605,6 +614,13 @@ public:
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+
+	static const char *get_opcode_name(int p_opcode);
+	static void set_opcode_pair_histogram_enabled(bool p_enabled);
+	static bool is_opcode_pair_histogram_enabled() { return _opcode_pair_histogram_enabled; }
+	static void clear_opcode_pair_histogram();
+	// Returns "count,first,second" CSV lines sorted by descending count.
+	static String get_opcode_pair_histogram_csv(int p_max_pairs = 0);
 #endif
 
 	GDScriptFunction();
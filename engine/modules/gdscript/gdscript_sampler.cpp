@@ -0,0 +1,279 @@
+/**************************************************************************/
+/*  gdscript_sampler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
+
+GDScriptSampler *GDScriptSampler::singleton = nullptr;
+SafeNumeric<uint32_t> GDScriptSampler::tick;
+thread_local uint32_t GDScriptSampler::thread_tick = 0;
+
+void GDScriptSampler::_timer_thread_func(void *p_userdata) {
+	GDScriptSampler *sampler = static_cast<GDScriptSampler *>(p_userdata);
+	while (sampler->running.is_set()) {
+		OS::get_singleton()->delay_usec(sampler->interval_usec);
+		tick.increment();
+	}
+}
+
+void GDScriptSampler::_take_sample() {
+	GDScriptLanguage::CallLevel *level = GDScriptLanguage::_call_stack;
+	if (!level) {
+		return;
+	}
+
+	// Register as a writer before checking the flag, so `stop()` waits for us.
+	active_writers.increment();
+	if (!running.is_set()) {
+		active_writers.decrement();
+		return;
+	}
+
+	uint32_t index = write_index.postincrement();
+	Sample &sample = samples[index % capacity];
+	sample.sequence.set(0);
+
+	sample.thread_id = Thread::get_caller_id();
+	sample.time_usec = OS::get_singleton()->get_ticks_usec();
+	sample.ip = level->ip ? *level->ip : 0;
+	int frame_count = 0;
+	while (level && frame_count < MAX_FRAMES) {
+		Frame &frame = sample.frames[frame_count++];
+		frame.source = level->function->get_source();
+		frame.function = level->function->get_name();
+		frame.line = level->line ? *level->line : 0;
+		level = level->prev;
+	}
+	sample.frame_count = frame_count;
+
+	sample.sequence.set(index + 1);
+	active_writers.decrement();
+}
+
+void GDScriptSampler::_collect_samples(LocalVector<const Sample *> &r_samples) const {
+	if (!samples) {
+		return;
+	}
+	uint32_t written = write_index.get();
+	uint32_t first = written > capacity ? written - capacity : 0;
+	for (uint32_t i = first; i < written; i++) {
+		const Sample &sample = samples[i % capacity];
+		if (sample.sequence.get() == i + 1) {
+			r_samples.push_back(&sample);
+		}
+	}
+}
+
+String GDScriptSampler::_format_frame(const Frame &p_frame) {
+	String source = p_frame.source;
+	if (source.is_empty()) {
+		source = "<built-in>";
+	}
+	return vformat("%s (%s:%d)", p_frame.function, source, p_frame.line);
+}
+
+Error GDScriptSampler::start(int p_frequency_hz, int p_max_samples) {
+	ERR_FAIL_COND_V_MSG(running.is_set(), ERR_ALREADY_IN_USE, "GDScript sampler is already running.");
+	ERR_FAIL_COND_V(p_frequency_hz <= 0 || p_frequency_hz > 100000, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_max_samples <= 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!GDScriptLanguage::get_singleton()->should_track_call_stack(), ERR_UNAVAILABLE, "GDScript sampler requires call stack tracking, enable \"debug/settings/gdscript/always_track_call_stacks\".");
+
+	if (capacity != (uint32_t)p_max_samples) {
+		if (samples) {
+			memdelete_arr(samples);
+		}
+		capacity = p_max_samples;
+		samples = memnew_arr(Sample, capacity);
+	}
+	clear();
+
+	interval_usec = 1000000 / p_frequency_hz;
+	start_time_usec = OS::get_singleton()->get_ticks_usec();
+	running.set();
+	timer_thread.start(_timer_thread_func, this);
+	return OK;
+}
+
+void GDScriptSampler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	running.clear();
+	timer_thread.wait_to_finish();
+	sampled_time_usec += OS::get_singleton()->get_ticks_usec() - start_time_usec;
+
+	// Let threads that already started recording a sample finish it.
+	while (active_writers.get() > 0) {
+		OS::get_singleton()->delay_usec(1);
+	}
+}
+
+void GDScriptSampler::clear() {
+	ERR_FAIL_COND_MSG(running.is_set(), "Can't clear samples while the GDScript sampler is running.");
+	for (uint32_t i = 0; i < capacity; i++) {
+		samples[i].sequence.set(0);
+	}
+	write_index.set(0);
+	sampled_time_usec = 0;
+}
+
+int GDScriptSampler::get_sample_count() const {
+	return MIN(write_index.get(), capacity);
+}
+
+double GDScriptSampler::get_sampled_time() const {
+	uint64_t time = sampled_time_usec;
+	if (running.is_set()) {
+		time += OS::get_singleton()->get_ticks_usec() - start_time_usec;
+	}
+	return time / 1000000.0;
+}
+
+String GDScriptSampler::get_collapsed_stacks() const {
+	ERR_FAIL_COND_V_MSG(running.is_set(), String(), "Stop the GDScript sampler before exporting samples.");
+
+	LocalVector<const Sample *> collected;
+	_collect_samples(collected);
+
+	HashMap<String, uint64_t> stacks;
+	for (const Sample *sample : collected) {
+		String stack;
+		for (int i = sample->frame_count - 1; i >= 0; i--) {
+			if (!stack.is_empty()) {
+				stack += ";";
+			}
+			stack += _format_frame(sample->frames[i]);
+		}
+		stacks[stack]++;
+	}
+
+	String result;
+	for (const KeyValue<String, uint64_t> &E : stacks) {
+		result += E.key + " " + itos(E.value) + "\n";
+	}
+	return result;
+}
+
+Error GDScriptSampler::save_collapsed_stacks(const String &p_path) const {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Can't open \"%s\" for writing.", p_path));
+	f->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+TypedArray<Dictionary> GDScriptSampler::get_line_breakdown() const {
+	ERR_FAIL_COND_V_MSG(running.is_set(), TypedArray<Dictionary>(), "Stop the GDScript sampler before exporting samples.");
+
+	struct LineStats {
+		StringName source;
+		StringName function;
+		int line = 0;
+		uint64_t self_samples = 0;
+		uint64_t total_samples = 0;
+		uint64_t last_sample = UINT64_MAX; // Avoids counting recursive frames twice.
+	};
+
+	LocalVector<const Sample *> collected;
+	_collect_samples(collected);
+
+	HashMap<String, LineStats> lines;
+	for (uint32_t i = 0; i < collected.size(); i++) {
+		const Sample *sample = collected[i];
+		for (int j = 0; j < sample->frame_count; j++) {
+			const Frame &frame = sample->frames[j];
+			LineStats &stats = lines[_format_frame(frame)];
+			stats.source = frame.source;
+			stats.function = frame.function;
+			stats.line = frame.line;
+			if (j == 0) {
+				stats.self_samples++;
+			}
+			if (stats.last_sample != i) {
+				stats.total_samples++;
+				stats.last_sample = i;
+			}
+		}
+	}
+
+	struct SelfSamplesSort {
+		bool operator()(const LineStats *p_a, const LineStats *p_b) const {
+			return p_a->self_samples > p_b->self_samples;
+		}
+	};
+
+	LocalVector<const LineStats *> sorted;
+	for (const KeyValue<String, LineStats> &E : lines) {
+		sorted.push_back(&E.value);
+	}
+	sorted.sort_custom<SelfSamplesSort>();
+
+	TypedArray<Dictionary> result;
+	for (const LineStats *stats : sorted) {
+		Dictionary entry;
+		entry["source"] = stats->source;
+		entry["function"] = stats->function;
+		entry["line"] = stats->line;
+		entry["self_samples"] = stats->self_samples;
+		entry["total_samples"] = stats->total_samples;
+		result.push_back(entry);
+	}
+	return result;
+}
+
+void GDScriptSampler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start", "frequency_hz", "max_samples"), &GDScriptSampler::start, DEFVAL(1000), DEFVAL(65536));
+	ClassDB::bind_method(D_METHOD("stop"), &GDScriptSampler::stop);
+	ClassDB::bind_method(D_METHOD("is_running"), &GDScriptSampler::is_running);
+	ClassDB::bind_method(D_METHOD("clear"), &GDScriptSampler::clear);
+	ClassDB::bind_method(D_METHOD("get_sample_count"), &GDScriptSampler::get_sample_count);
+	ClassDB::bind_method(D_METHOD("get_sampled_time"), &GDScriptSampler::get_sampled_time);
+	ClassDB::bind_method(D_METHOD("get_collapsed_stacks"), &GDScriptSampler::get_collapsed_stacks);
+	ClassDB::bind_method(D_METHOD("save_collapsed_stacks", "path"), &GDScriptSampler::save_collapsed_stacks);
+	ClassDB::bind_method(D_METHOD("get_line_breakdown"), &GDScriptSampler::get_line_breakdown);
+}
+
+GDScriptSampler::GDScriptSampler() {
+	ERR_FAIL_COND(singleton);
+	singleton = this;
+}
+
+GDScriptSampler::~GDScriptSampler() {
+	stop();
+	if (samples) {
+		memdelete_arr(samples);
+	}
+	singleton = nullptr;
+}
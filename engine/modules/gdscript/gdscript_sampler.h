@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  gdscript_sampler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Low-overhead sampling profiler for GDScript.
+// A timer thread bumps a global tick, and every thread running GDScript records
+// its own call stack the next time it executes a line after the tick changed.
+// Requires call stack tracking (always on in debug builds, see
+// `debug/settings/gdscript/always_track_call_stacks` for release builds).
+class GDScriptSampler : public Object {
+	GDCLASS(GDScriptSampler, Object);
+
+public:
+	static constexpr int MAX_FRAMES = 32;
+
+private:
+	struct Frame {
+		StringName source;
+		StringName function;
+		int line = 0;
+	};
+
+	struct Sample {
+		SafeNumeric<uint32_t> sequence; // 0 while being written, otherwise the sample index + 1.
+		uint64_t thread_id = 0;
+		uint64_t time_usec = 0;
+		int ip = 0;
+		int frame_count = 0;
+		Frame frames[MAX_FRAMES]; // Innermost first.
+	};
+
+	static GDScriptSampler *singleton;
+
+	static SafeNumeric<uint32_t> tick;
+	static thread_local uint32_t thread_tick;
+
+	Thread timer_thread;
+	SafeFlag running;
+	uint64_t interval_usec = 1000;
+	uint64_t start_time_usec = 0;
+	uint64_t sampled_time_usec = 0;
+
+	Sample *samples = nullptr;
+	uint32_t capacity = 0;
+	SafeNumeric<uint32_t> write_index;
+	SafeNumeric<uint32_t> active_writers;
+
+	static void _timer_thread_func(void *p_userdata);
+	void _take_sample();
+	void _collect_samples(LocalVector<const Sample *> &r_samples) const;
+	static String _format_frame(const Frame &p_frame);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static GDScriptSampler *get_singleton() { return singleton; }
+
+	// Called by the VM on every executed line, must stay as cheap as possible.
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(thread_tick != tick.get())) {
+			thread_tick = tick.get();
+			singleton->_take_sample();
+		}
+	}
+
+	Error start(int p_frequency_hz = 1000, int p_max_samples = 65536);
+	void stop();
+	bool is_running() const { return running.is_set(); }
+	void clear();
+
+	int get_sample_count() const;
+	double get_sampled_time() const;
+
+	// One line per unique stack, root frame first, followed by the sample count.
+	// This is the format used by `flamegraph.pl`, inferno and speedscope.
+	String get_collapsed_stacks() const;
+	Error save_collapsed_stacks(const String &p_path) const;
+	// Self and total samples for every sampled script line, sorted by self samples.
+	TypedArray<Dictionary> get_line_breakdown() const;
+
+	GDScriptSampler();
+	~GDScriptSampler();
+};
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampler.h"
 
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
@@ -255,6 +256,7 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_PAIR,                \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -266,10 +268,12 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                              \
 		&&OPCODE_GET_KEYED_VALIDATED,                    \
 		&&OPCODE_GET_INDEXED_VALIDATED,                  \
+		&&OPCODE_GET_INDEXED_VALIDATED_OPERATOR,         \
 		&&OPCODE_SET_NAMED,                              \
 		&&OPCODE_SET_NAMED_VALIDATED,                    \
 		&&OPCODE_GET_NAMED,                              \
 		&&OPCODE_GET_NAMED_VALIDATED,                    \
+		&&OPCODE_GET_NAMED_VALIDATED_OPERATOR,           \
 		&&OPCODE_SET_MEMBER,                             \
 		&&OPCODE_GET_MEMBER,                             \
 		&&OPCODE_SET_STATIC_VARIABLE,                    \
@@ -424,8 +428,11 @@ void (*type_init_function_table[])(Variant *) = {
 #define OPCODE_SWITCH(m_test) goto *switch_table_ops[m_test];
 
 #ifdef DEBUG_ENABLED
-#define DISPATCH_OPCODE          \
-	last_opcode = _code_ptr[ip]; \
+#define DISPATCH_OPCODE                                                    \
+	if (unlikely(_opcode_pair_histogram_enabled)) {                        \
+		_opcode_pair_histogram[last_opcode][_code_ptr[ip]].increment();    \
+	}                                                                      \
+	last_opcode = _code_ptr[ip];                                           \
 	goto *switch_table_ops[last_opcode]
 #else // !DEBUG_ENABLED
 #define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
@@ -852,6 +859,34 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_PAIR) {
+				CHECK_SPACE(9);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// Second operator, one of its operands is the result of the first.
+				int operator2_idx = _code_ptr[ip + 8];
+				GD_ERR_BREAK(operator2_idx < 0 || operator2_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator2_func = _operator_funcs_ptr[operator2_idx];
+
+				GET_VARIANT_PTR(a2, 4);
+				GET_VARIANT_PTR(b2, 5);
+				GET_VARIANT_PTR(dst2, 6);
+
+				operator2_func(a2, b2, dst2);
+
+				ip += 9;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1195,6 +1230,48 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_INDEXED_VALIDATED_OPERATOR) {
+				CHECK_SPACE(9);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				int index_getter = _code_ptr[ip + 4];
+				GD_ERR_BREAK(index_getter < 0 || index_getter >= _indexed_getters_count);
+				const Variant::ValidatedIndexedGetter getter = _indexed_getters_ptr[index_getter];
+
+				int64_t int_index = *VariantInternal::get_int(index);
+
+				bool oob;
+				getter(src, int_index, dst, &oob);
+
+#ifdef DEBUG_ENABLED
+				if (oob) {
+					String v = index->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(index) + "'";
+					}
+					err_text = "Out of bounds get index " + v + " (on base: '" + _get_var_type(src) + "')";
+					OPCODE_BREAK;
+				}
+#endif
+
+				int operator_idx = _code_ptr[ip + 8];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 4);
+				GET_VARIANT_PTR(b, 5);
+				GET_VARIANT_PTR(op_dst, 6);
+
+				operator_func(a, b, op_dst);
+				ip += 9;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -1292,6 +1369,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_NAMED_VALIDATED_OPERATOR) {
+				CHECK_SPACE(8);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(dst, 1);
+
+				int index_getter = _code_ptr[ip + 3];
+				GD_ERR_BREAK(index_getter < 0 || index_getter >= _getters_count);
+				const Variant::ValidatedGetter getter = _getters_ptr[index_getter];
+
+				getter(src, dst);
+
+				int operator_idx = _code_ptr[ip + 7];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 3);
+				GET_VARIANT_PTR(b, 4);
+				GET_VARIANT_PTR(op_dst, 5);
+
+				operator_func(a, b, op_dst);
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_MEMBER) {
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(src, 0);
@@ -3903,6 +4005,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptSampler::poll();
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -33,6 +33,7 @@
 #include "gdscript.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
+#include "gdscript_sampler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
@@ -49,6 +50,7 @@
 #include "tests/test_gdscript.h"
 #endif
 
+#include "core/config/engine.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 
@@ -56,10 +58,6 @@
 #include "editor/editor_node.h"
 #include "editor/export/editor_export.h"
 #include "editor/translations/editor_translation_parser.h"
-
-#ifndef GDSCRIPT_NO_LSP
-#include "core/config/engine.h"
-#endif
 #endif // TOOLS_ENABLED
 
 #ifdef TESTS_ENABLED
@@ -70,6 +68,7 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+GDScriptSampler *gdscript_sampler = nullptr;
 
 #ifdef TOOLS_ENABLED
 
@@ -151,6 +150,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		gdscript_cache = memnew(GDScriptCache);
 
+		GDREGISTER_CLASS(GDScriptSampler);
+		gdscript_sampler = memnew(GDScriptSampler);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("GDScriptSampler", GDScriptSampler::get_singleton()));
+
 		GDScriptUtilityFunctions::register_functions();
 	}
 
@@ -170,6 +173,11 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		ScriptServer::unregister_language(script_language_gd);
 
+		if (gdscript_sampler) {
+			Engine::get_singleton()->remove_singleton("GDScriptSampler");
+			memdelete(gdscript_sampler);
+		}
+
 		if (gdscript_cache) {
 			memdelete(gdscript_cache);
 		}
@@ -0,0 +1,81 @@
+# Numeric GDScript micro-benchmarks for the bytecode VM.
+#
+# Run with:
+#   godot --headless --script modules/gdscript/tests/benchmarks/numeric_loops.gd
+#
+# Compare runs with `debug/settings/gdscript/fuse_superinstructions` enabled and
+# disabled (e.g. through an `override.cfg` next to the binary) to measure the
+# speedup from superinstructions. Set `debug/settings/gdscript/opcode_pair_histogram_path`
+# to also dump the executed opcode pairs.
+extends SceneTree
+
+const ITERATIONS = 1_000_000
+const REPETITIONS = 7
+
+
+func bench_float_multiply_add() -> float:
+	var a := 1.0001
+	var b := 0.5
+	var x := 0.0
+	for i in ITERATIONS:
+		x += a * b
+	return x
+
+
+func bench_int_polynomial() -> int:
+	var acc := 0
+	for i in ITERATIONS:
+		acc = (i * i + 3) * 2 - acc
+	return acc
+
+
+func bench_typed_array_sum() -> float:
+	var values: Array[float] = []
+	values.resize(1024)
+	values.fill(0.25)
+	var total := 0.0
+	for i in ITERATIONS:
+		total += values[i & 1023] * 2.0
+	return total
+
+
+func bench_packed_array_sum() -> float:
+	var values := PackedFloat64Array()
+	values.resize(1024)
+	values.fill(0.25)
+	var total := 0.0
+	for i in ITERATIONS:
+		total = values[i & 1023] + total
+	return total
+
+
+func bench_vector_member_compare() -> int:
+	var pos := Vector2(0.0, 0.0)
+	var step := Vector2(0.001, 0.002)
+	var count := 0
+	for i in ITERATIONS:
+		pos += step
+		if pos.x > 500.0:
+			count += 1
+	return count
+
+
+func _measure(p_name: String, p_callable: Callable) -> void:
+	var times: Array[int] = []
+	for i in REPETITIONS:
+		var start := Time.get_ticks_usec()
+		p_callable.call()
+		times.push_back(Time.get_ticks_usec() - start)
+	times.sort()
+	var median := times[REPETITIONS / 2]
+	print("%-28s median %8d usec  (%.1f ns/iteration)" % [p_name, median, median * 1000.0 / ITERATIONS])
+
+
+func _initialize() -> void:
+	print("fuse_superinstructions = %s" % ProjectSettings.get_setting("debug/settings/gdscript/fuse_superinstructions"))
+	_measure("float_multiply_add", bench_float_multiply_add)
+	_measure("int_polynomial", bench_int_polynomial)
+	_measure("typed_array_sum", bench_typed_array_sum)
+	_measure("packed_array_sum", bench_packed_array_sum)
+	_measure("vector_member_compare", bench_vector_member_compare)
+	quit()
@@ -0,0 +1,55 @@
+# Measures the overhead of GDScriptSampler on a script-bound workload.
+#
+# Run with:
+#   godot --headless --script modules/gdscript/tests/benchmarks/sampler_overhead.gd
+#
+# Release builds need `debug/settings/gdscript/always_track_call_stacks` enabled.
+# Exits with a non-zero code if the overhead at 1 kHz exceeds OVERHEAD_BUDGET.
+extends SceneTree
+
+const ITERATIONS = 2_000_000
+const REPETITIONS = 5
+const FREQUENCY_HZ = 1000
+const OVERHEAD_BUDGET = 0.02
+
+
+func _leaf(p_value: float) -> float:
+	return p_value * 0.5 + 1.0
+
+
+func _workload() -> float:
+	var x := 0.0
+	for i in ITERATIONS:
+		x = _leaf(x) - 1.0
+		if i % 3 == 0:
+			x += 0.25
+	return x
+
+
+func _median_usec() -> int:
+	var times: Array[int] = []
+	for i in REPETITIONS:
+		var start := Time.get_ticks_usec()
+		_workload()
+		times.push_back(Time.get_ticks_usec() - start)
+	times.sort()
+	return times[REPETITIONS / 2]
+
+
+func _initialize() -> void:
+	var baseline := _median_usec()
+
+	if GDScriptSampler.start(FREQUENCY_HZ) != OK:
+		printerr("Could not start GDScriptSampler.")
+		quit(1)
+		return
+	var sampled := _median_usec()
+	GDScriptSampler.stop()
+
+	var overhead := float(sampled - baseline) / baseline
+	print("baseline %d usec, sampled %d usec, overhead %.2f%% (budget %.2f%%)" % [baseline, sampled, overhead * 100.0, OVERHEAD_BUDGET * 100.0])
+	print("%d samples collected in %.2f s" % [GDScriptSampler.get_sample_count(), GDScriptSampler.get_sampled_time()])
+	for entry in GDScriptSampler.get_line_breakdown().slice(0, 5):
+		print("  %5d self %5d total  %s:%d (%s)" % [entry.self_samples, entry.total_samples, entry.source, entry.line, entry.function])
+
+	quit(0 if overhead <= OVERHEAD_BUDGET else 1)
@@ -0,0 +1,34 @@
+# Typed operator sequences that the compiler fuses into superinstructions.
+
+func test():
+	var a := 1.5
+	var b := 2.0
+	var x := 0.25
+	for i in 4:
+		x += a * b
+	print(x)
+
+	var n := 3
+	var m := (n * n + 1) * 2 - n
+	print(m)
+
+	var values: Array[float] = [0.5, 1.0, 2.0]
+	var total := 0.0
+	for i in values.size():
+		total += values[i] * 2.0
+	print(total)
+
+	var packed := PackedInt64Array([3, 5, 7])
+	var sum := 0
+	for i in packed.size():
+		sum = packed[i] + sum
+	print(sum)
+
+	var pos := Vector2(3.0, -1.0)
+	print(pos.x > 2.0)
+	print(pos.y + 1.0 == 0.0)
+	pos.x -= pos.y * 2.0
+	print(pos)
+
+	var neg := -a * b
+	print(neg)
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  benchmark_glyph_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "core/math/random_pcg.h"
+
+#include "tests/benchmark_runner.h"
+// Shares the text server and cache directory helpers with the tests.
+#include "test_glyph_cache.h"
+
+namespace BenchmarkGlyphCache {
+
+static const int TITLE_COUNT = 500;
+static const int VISIBLE_ROWS = 16;
+static const int FONT_SIZE = 24;
+
+// Song titles mixing Latin, kana and kanji, as in a song list.
+static Vector<String> create_titles() {
+	RandomPCG rng(42);
+	Vector<String> titles;
+	for (int i = 0; i < TITLE_COUNT; i++) {
+		String title;
+		int length = 8 + rng.rand() % 16;
+		for (int j = 0; j < length; j++) {
+			switch (rng.rand() % 4) {
+				case 0:
+					title += char32_t(U'a' + rng.rand() % 26);
+					break;
+				case 1:
+					title += char32_t(U'ぁ' + rng.rand() % 86);
+					break;
+				default:
+					title += char32_t(U'一' + rng.rand() % 3000);
+					break;
+			}
+		}
+		titles.push_back(title);
+	}
+	return titles;
+}
+
+// Scrolls one row per frame through a list showing 16 rows with a newly loaded font,
+// shaping each row as it appears and looking up the glyphs of every visible row.
+static void scroll(TextServerAdvanced *p_ts, const Vector<String> &p_titles) {
+	// The defaulted arguments are declared on TextServer.
+	TextServer *text_server = p_ts;
+	RID font = p_ts->create_font();
+	p_ts->font_set_data_ptr(font, _font_DroidSansFallback, _font_DroidSansFallback_size);
+	const Array fonts = { font };
+	Vector<RID> rows;
+	for (int frame = 0; frame + VISIBLE_ROWS <= p_titles.size(); frame++) {
+		while (rows.size() < frame + VISIBLE_ROWS) {
+			RID row = text_server->create_shaped_text();
+			text_server->shaped_text_add_string(row, p_titles[rows.size()], fonts, FONT_SIZE);
+			text_server->shaped_text_shape(row);
+			rows.push_back(row);
+		}
+		for (int i = frame; i < frame + VISIBLE_ROWS; i++) {
+			const Glyph *glyphs = p_ts->shaped_text_get_glyphs(rows[i]);
+			for (int j = 0; j < p_ts->shaped_text_get_glyph_count(rows[i]); j++) {
+				(void)p_ts->font_get_glyph_uv_rect(glyphs[j].font_rid, Vector2i(FONT_SIZE, 0), glyphs[j].index);
+			}
+		}
+	}
+	for (const RID &row : rows) {
+		p_ts->free_rid(row);
+	}
+	p_ts->free_rid(font);
+}
+
+static void measure_scroll(BenchmarkContext &p_context, bool p_use_cache) {
+	Ref<TextServerAdvanced> ts = TestGlyphCache::_get_text_server_advanced();
+	if (ts.is_null()) {
+		p_context.skip("TextServerAdvanced isn't available.");
+		return;
+	}
+	const Vector<String> titles = create_titles();
+
+	const String cache_path = TestUtils::get_temp_path("glyph_cache_benchmark");
+	TestGlyphCache::_clear_glyph_cache_dir(cache_path);
+	const String old_cache_path = ts->get_glyph_cache_path();
+	ts->set_glyph_cache_path(p_use_cache ? cache_path : String());
+	if (p_use_cache) {
+		// Rasterize once, so every measured scroll loads the glyphs from the cache.
+		scroll(ts.ptr(), titles);
+	}
+
+	p_context.measure([&]() {
+		scroll(ts.ptr(), titles);
+	});
+
+	ts->set_glyph_cache_path(old_cache_path);
+	TestGlyphCache::_clear_glyph_cache_dir(cache_path);
+}
+
+static void benchmark_first_scroll_rasterized(BenchmarkContext &p_context) {
+	measure_scroll(p_context, false);
+}
+
+static void benchmark_first_scroll_cached(BenchmarkContext &p_context) {
+	measure_scroll(p_context, true);
+}
+
+REGISTER_BENCHMARK("text_server_adv/glyph_cache/first_scroll_rasterized", &benchmark_first_scroll_rasterized);
+REGISTER_BENCHMARK("text_server_adv/glyph_cache/first_scroll_cached", &benchmark_first_scroll_cached);
+
+} // namespace BenchmarkGlyphCache
+
+#endif // TOOLS_ENABLED
@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  benchmark_shaped_run_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "core/math/random_pcg.h"
+
+#include "tests/benchmark_runner.h"
+// Shares the text server helper with the tests.
+#include "test_shaped_run_cache.h"
+
+namespace BenchmarkShapedRunCache {
+
+static const int TITLE_COUNT = 500;
+static const int VISIBLE_ROWS = 16;
+
+static Vector<String> create_titles() {
+	RandomPCG rng(42);
+	Vector<String> titles;
+	for (int i = 0; i < TITLE_COUNT; i++) {
+		String title;
+		int length = 8 + rng.rand() % 24;
+		for (int j = 0; j < length; j++) {
+			switch (rng.rand() % 4) {
+				case 0:
+					title += char32_t(U'a' + rng.rand() % 26);
+					break;
+				case 1:
+					title += ' ';
+					break;
+				default:
+					title += char32_t(U'ぁ' + rng.rand() % 86);
+					break;
+			}
+		}
+		titles.push_back(title);
+	}
+	return titles;
+}
+
+// Scrolls back and forth through the list, recycling 16 rows. Each iteration reshapes the row
+// of the title that scrolls into view.
+static void measure_reshape(BenchmarkContext &p_context, int64_t p_budget) {
+	Ref<TextServerAdvanced> ts = TestShapedRunCache::_get_text_server_advanced();
+	if (ts.is_null()) {
+		p_context.skip("TextServerAdvanced isn't available.");
+		return;
+	}
+	// The defaulted arguments are declared on TextServer.
+	TextServer *text_server = ts.ptr();
+	const Vector<String> titles = create_titles();
+
+	RID font = ts->create_font();
+	ts->font_set_data_ptr(font, _font_DroidSansFallback, _font_DroidSansFallback_size);
+	const Array fonts = { font };
+	const int64_t old_budget = ts->get_shaped_run_cache_budget();
+	ts->set_shaped_run_cache_budget(p_budget);
+	ts->clear_shaped_run_cache();
+
+	Vector<RID> rows;
+	for (int i = 0; i < VISIBLE_ROWS; i++) {
+		rows.push_back(text_server->create_shaped_text());
+	}
+
+	int step = 0;
+	p_context.measure([&]() {
+		const int i = step % TITLE_COUNT;
+		const bool backwards = (step / TITLE_COUNT) % 2;
+		const RID &row = rows[i % VISIBLE_ROWS];
+		text_server->shaped_text_clear(row);
+		text_server->shaped_text_add_string(row, titles[backwards ? TITLE_COUNT - 1 - i : i], fonts, 16);
+		text_server->shaped_text_shape(row);
+		step++;
+	});
+
+	for (const RID &row : rows) {
+		ts->free_rid(row);
+	}
+	ts->free_rid(font);
+	ts->set_shaped_run_cache_budget(old_budget);
+	ts->clear_shaped_run_cache();
+	ts->reset_shaped_run_cache_stats();
+}
+
+static void benchmark_reshape_uncached(BenchmarkContext &p_context) {
+	measure_reshape(p_context, 0);
+}
+
+static void benchmark_reshape_cached(BenchmarkContext &p_context) {
+	measure_reshape(p_context, 4096 * 1024);
+}
+
+REGISTER_BENCHMARK("text_server_adv/shaped_run_cache/reshape_row_uncached", &benchmark_reshape_uncached);
+REGISTER_BENCHMARK("text_server_adv/shaped_run_cache/reshape_row_cached", &benchmark_reshape_cached);
+
+} // namespace BenchmarkShapedRunCache
+
+#endif // TOOLS_ENABLED
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  test_glyph_cache.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "../text_server_adv.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "editor/themes/builtin_fonts.gen.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGlyphCache {
+
+static Ref<TextServerAdvanced> _get_text_server_advanced() {
+	for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+		Ref<TextServerAdvanced> ts = TextServerManager::get_singleton()->get_interface(i);
+		if (ts.is_valid() && ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC)) {
+			return ts;
+		}
+	}
+	return Ref<TextServerAdvanced>();
+}
+
+static void _clear_glyph_cache_dir(const String &p_path) {
+	Ref<DirAccess> da = DirAccess::open(p_path);
+	if (da.is_null()) {
+		return;
+	}
+	for (const String &file : da->get_files()) {
+		da->remove(file);
+	}
+	DirAccess::remove_absolute(p_path);
+}
+
+TEST_CASE("[TextServerAdvanced] Persistent glyph cache") {
+	Ref<TextServerAdvanced> ts = _get_text_server_advanced();
+	if (ts.is_null()) {
+		return;
+	}
+
+	const String cache_path = TestUtils::get_temp_path("glyph_cache");
+	_clear_glyph_cache_dir(cache_path);
+	const String old_cache_path = ts->get_glyph_cache_path();
+	ts->set_glyph_cache_path(cache_path);
+
+	const Vector2i size = Vector2i(16, 0);
+	RID font = ts->create_font();
+	ts->font_set_data_ptr(font, _font_DroidSansFallback, _font_DroidSansFallback_size);
+	int64_t task = ts->font_prewarm_glyphs(font, 16, U"Glyph cache キャッシュ 字形");
+	ts->font_wait_for_prewarm(task);
+	CHECK(ts->font_is_prewarm_completed(task));
+
+	const PackedInt32Array glyphs = ts->font_get_glyph_list(font, size);
+	const int64_t texture_count = ts->font_get_texture_count(font, size);
+	REQUIRE(glyphs.size() > 0);
+	REQUIRE(texture_count > 0);
+	const Vector<uint8_t> page = ts->font_get_texture_image(font, size, 0)->get_data();
+	const Rect2 uv_rect = ts->font_get_glyph_uv_rect(font, size, glyphs[glyphs.size() - 1]);
+	const Vector2 advance = ts->font_get_glyph_advance(font, 16, glyphs[glyphs.size() - 1]);
+
+	// Freeing the font saves its glyphs.
+	ts->free_rid(font);
+	CHECK(DirAccess::get_files_at(cache_path).size() == 1);
+
+	SUBCASE("Glyphs are loaded on the next launch") {
+		font = ts->create_font();
+		ts->font_set_data_ptr(font, _font_DroidSansFallback, _font_DroidSansFallback_size);
+		CHECK(ts->font_get_texture_count(font, size) == texture_count);
+		CHECK(ts->font_get_glyph_list(font, size) == glyphs);
+		CHECK(ts->font_get_texture_image(font, size, 0)->get_data() == page);
+		CHECK(ts->font_get_glyph_uv_rect(font, size, glyphs[glyphs.size() - 1]) == uv_rect);
+		CHECK(ts->font_get_glyph_advance(font, 16, glyphs[glyphs.size() - 1]) == advance);
+
+		// Other sizes and render settings use their own cache.
+		CHECK(ts->font_get_texture_count(font, Vector2i(17, 0)) == 0);
+		ts->font_set_antialiasing(font, TextServer::FONT_ANTIALIASING_NONE);
+		CHECK(ts->font_get_texture_count(font, size) == 0);
+		ts->free_rid(font);
+	}
+
+	SUBCASE("Invalid cache files are ignored") {
+		const String file = cache_path.path_join(DirAccess::get_files_at(cache_path)[0]);
+		Ref<FileAccess> f = FileAccess::open(file, FileAccess::WRITE);
+		f->store_string("GDGC, but not a glyph cache.");
+		f->close();
+
+		font = ts->create_font();
+		ts->font_set_data_ptr(font, _font_DroidSansFallback, _font_DroidSansFallback_size);
+		CHECK(ts->font_get_texture_count(font, size) == 0);
+		CHECK(ts->font_get_glyph_list(font, size).is_empty());
+		ts->free_rid(font);
+	}
+
+	ts->set_glyph_cache_path(old_cache_path);
+	_clear_glyph_cache_dir(cache_path);
+}
+
+} // namespace TestGlyphCache
+
+#endif // TOOLS_ENABLED
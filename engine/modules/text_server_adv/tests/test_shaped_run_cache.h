@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*  test_shaped_run_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "../text_server_adv.h"
+
+#include "editor/themes/builtin_fonts.gen.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShapedRunCache {
+
+static Ref<TextServerAdvanced> _get_text_server_advanced() {
+	for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+		Ref<TextServerAdvanced> ts = TextServerManager::get_singleton()->get_interface(i);
+		if (ts.is_valid() && ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC)) {
+			return ts;
+		}
+	}
+	return Ref<TextServerAdvanced>();
+}
+
+static RID _shape(const Ref<TextServer> &p_ts, const String &p_text, const Array &p_fonts, int64_t p_size = 16) {
+	RID ctx = p_ts->create_shaped_text();
+	p_ts->shaped_text_add_string(ctx, p_text, p_fonts, p_size);
+	p_ts->shaped_text_shape(ctx);
+	return ctx;
+}
+
+static bool _glyphs_equal(const Ref<TextServerAdvanced> &p_ts, const RID &p_a, const RID &p_b) {
+	const Glyph *a = p_ts->shaped_text_get_glyphs(p_a);
+	const Glyph *b = p_ts->shaped_text_get_glyphs(p_b);
+	int64_t count = p_ts->shaped_text_get_glyph_count(p_a);
+	if (count != p_ts->shaped_text_get_glyph_count(p_b)) {
+		return false;
+	}
+	for (int64_t i = 0; i < count; i++) {
+		if (a[i].start != b[i].start || a[i].end != b[i].end || a[i].count != b[i].count || a[i].flags != b[i].flags || a[i].index != b[i].index || a[i].advance != b[i].advance || a[i].x_off != b[i].x_off || a[i].y_off != b[i].y_off || a[i].font_rid != b[i].font_rid || a[i].font_size != b[i].font_size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[TextServerAdvanced] Shaped run cache") {
+	Ref<TextServerAdvanced> ts = _get_text_server_advanced();
+	if (ts.is_null()) {
+		return;
+	}
+	Ref<TextServer> text_server = ts;
+
+	const int64_t old_budget = ts->get_shaped_run_cache_budget();
+	ts->set_shaped_run_cache_budget(1024 * 1024);
+	ts->clear_shaped_run_cache();
+	ts->reset_shaped_run_cache_stats();
+
+	RID font = ts->create_font();
+	ts->font_set_data_ptr(font, _font_DroidSansFallback, _font_DroidSansFallback_size);
+	const Array fonts = { font };
+	const String text = U"Song title ソングタイトル";
+
+	RID first = _shape(text_server, text, fonts);
+	Dictionary stats = ts->get_shaped_run_cache_stats();
+	CHECK(int64_t(stats["hits"]) == 0);
+	CHECK(int64_t(stats["misses"]) > 0);
+	CHECK(int64_t(stats["entries"]) == int64_t(stats["misses"]));
+	CHECK(int64_t(stats["memory_usage"]) > 0);
+
+	SUBCASE("Identical text reuses the shaped runs") {
+		RID second = _shape(text_server, text, fonts);
+		stats = ts->get_shaped_run_cache_stats();
+		CHECK(int64_t(stats["hits"]) == int64_t(stats["misses"]));
+		CHECK(double(stats["hit_rate"]) == doctest::Approx(0.5));
+		CHECK(_glyphs_equal(ts, first, second));
+		CHECK(ts->shaped_text_get_width(first) == ts->shaped_text_get_width(second));
+		CHECK(ts->shaped_text_get_ascent(first) == ts->shaped_text_get_ascent(second));
+		CHECK(ts->shaped_text_get_descent(first) == ts->shaped_text_get_descent(second));
+		ts->free_rid(second);
+
+		// Runs with the same context are shared between strings, glyph offsets are rebased.
+		const String prefixed_text = U"A title ソングタイトル";
+		RID prefixed = _shape(text_server, prefixed_text, fonts);
+		CHECK(int64_t(ts->get_shaped_run_cache_stats()["hits"]) > int64_t(stats["hits"]));
+		CHECK(ts->shaped_text_get_glyphs(prefixed)[ts->shaped_text_get_glyph_count(prefixed) - 1].end == prefixed_text.length());
+		ts->free_rid(prefixed);
+	}
+
+	SUBCASE("Different size or features are shaped again") {
+		RID other_size = _shape(text_server, text, fonts, 24);
+		CHECK(int64_t(ts->get_shaped_run_cache_stats()["hits"]) == 0);
+		ts->free_rid(other_size);
+
+		RID features = text_server->create_shaped_text();
+		text_server->shaped_text_add_string(features, text, fonts, 16, Dictionary({ { "liga", 0 } }));
+		text_server->shaped_text_shape(features);
+		CHECK(int64_t(ts->get_shaped_run_cache_stats()["hits"]) == 0);
+		ts->free_rid(features);
+	}
+
+	SUBCASE("Font changes invalidate the cache") {
+		ts->font_set_spacing(font, TextServer::SPACING_GLYPH, 4);
+		RID spaced = _shape(text_server, text, fonts);
+		CHECK(int64_t(ts->get_shaped_run_cache_stats()["hits"]) == 0);
+		CHECK(ts->shaped_text_get_width(spaced) > ts->shaped_text_get_width(first));
+		ts->free_rid(spaced);
+	}
+
+	SUBCASE("Least recently used runs are evicted") {
+		ts->set_shaped_run_cache_budget(int64_t(stats["memory_usage"]));
+		RID other = _shape(text_server, U"Another title", fonts);
+		stats = ts->get_shaped_run_cache_stats();
+		CHECK(int64_t(stats["evictions"]) > 0);
+		CHECK(int64_t(stats["memory_usage"]) <= int64_t(stats["budget"]));
+		ts->free_rid(other);
+
+		ts->set_shaped_run_cache_budget(0);
+		stats = ts->get_shaped_run_cache_stats();
+		CHECK(int64_t(stats["entries"]) == 0);
+		CHECK(int64_t(stats["memory_usage"]) == 0);
+	}
+
+	ts->free_rid(first);
+	ts->free_rid(font);
+	ts->set_shaped_run_cache_budget(old_budget);
+	ts->reset_shaped_run_cache_stats();
+}
+
+} // namespace TestShapedRunCache
+
+#endif // TOOLS_ENABLED
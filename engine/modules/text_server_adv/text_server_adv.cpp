@@ -49,7 +49,9 @@ using namespace godot;
 
 #include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/string/translation_server.h"
 #include "scene/resources/image_texture.h"
@@ -402,6 +404,8 @@ int64_t TextServerAdvanced::_get_features() const {
 void TextServerAdvanced::_free_rid(const RID &p_rid) {
 	_THREAD_SAFE_METHOD_
 	if (font_owner.owns(p_rid)) {
+		_font_wait_for_prewarm_font(p_rid);
+
 		MutexLock ftlock(ft_mutex);
 
 		FontAdvanced *fd = font_owner.get_or_null(p_rid);
@@ -413,9 +417,11 @@ void TextServerAdvanced::_free_rid(const RID &p_rid) {
 		}
 		{
 			MutexLock lock(fd->mutex);
+			_glyph_cache_store_font(fd);
 			font_owner.free(p_rid);
 		}
 		memdelete(fd);
+		_shaped_run_cache_invalidate();
 	} else if (font_var_owner.owns(p_rid)) {
 		MutexLock ftlock(ft_mutex);
 
@@ -424,6 +430,7 @@ void TextServerAdvanced::_free_rid(const RID &p_rid) {
 			font_var_owner.free(p_rid);
 		}
 		memdelete(fdv);
+		_shaped_run_cache_invalidate();
 	} else if (shaped_owner.owns(p_rid)) {
 		ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_rid);
 		{
@@ -1256,6 +1263,7 @@ bool TextServerAdvanced::_ensure_glyph(FontAdvanced *p_font_data, const Vector2i
 #endif
 		}
 	}
+	fd->glyph_cache_dirty = true;
 
 	if (glyph_index == 0) { // Non graphical or invalid glyph, do not render.
 		E = fd->glyph_map.insert(p_glyph, FontGlyph());
@@ -1949,6 +1957,8 @@ bool TextServerAdvanced::_ensure_cache_for_size(FontAdvanced *p_font_data, const
 			hb_font_set_variations(fd->hb_handle, hb_vars.is_empty() ? nullptr : &hb_vars[0], hb_vars.size());
 			FT_Done_MM_Var(ft_library, amaster);
 		}
+
+		_glyph_cache_load(p_font_data, fd);
 #else
 		memdelete(fd);
 		if (p_silent) {
@@ -2000,6 +2010,7 @@ void TextServerAdvanced::_unreference_oversampling_level(double p_oversampling)
 		if (ol->refcount == 0) {
 			for (FontForSizeAdvanced *fd : ol->fonts) {
 				fd->owner->cache.erase(fd->size);
+				_glyph_cache_store(fd);
 				memdelete(fd);
 			}
 			ol->fonts.clear();
@@ -2021,6 +2032,9 @@ _FORCE_INLINE_ bool TextServerAdvanced::_font_validate(const RID &p_font_rid) co
 _FORCE_INLINE_ void TextServerAdvanced::_font_clear_cache(FontAdvanced *p_font_data) {
 	MutexLock ftlock(ft_mutex);
 
+	_glyph_cache_store_font(p_font_data);
+	_shaped_run_cache_invalidate();
+
 	for (const KeyValue<Vector2i, FontForSizeAdvanced *> &E : p_font_data->cache) {
 		if (E.value->viewport_oversampling != 0) {
 			OversamplingLevel *ol = oversampling_levels.getptr(E.value->viewport_oversampling);
@@ -2104,6 +2118,7 @@ void TextServerAdvanced::_font_set_data(const RID &p_font_rid, const PackedByteA
 	fd->data = p_data;
 	fd->data_ptr = fd->data.ptr();
 	fd->data_size = fd->data.size();
+	fd->data_hash = 0;
 }
 
 void TextServerAdvanced::_font_set_data_ptr(const RID &p_font_rid, const uint8_t *p_data_ptr, int64_t p_data_size) {
@@ -2115,6 +2130,7 @@ void TextServerAdvanced::_font_set_data_ptr(const RID &p_font_rid, const uint8_t
 	fd->data.resize(0);
 	fd->data_ptr = p_data_ptr;
 	fd->data_size = p_data_size;
+	fd->data_hash = 0;
 }
 
 void TextServerAdvanced::_font_set_face_index(const RID &p_font_rid, int64_t p_face_index) {
@@ -2194,6 +2210,7 @@ void TextServerAdvanced::_font_set_style(const RID &p_font_rid, BitField<FontSty
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	fd->style_flags = p_style;
+	_shaped_run_cache_invalidate();
 }
 
 BitField<TextServer::FontStyle> TextServerAdvanced::_font_get_style(const RID &p_font_rid) const {
@@ -2238,6 +2255,7 @@ void TextServerAdvanced::_font_set_weight(const RID &p_font_rid, int64_t p_weigh
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	fd->weight = CLAMP(p_weight, 100, 999);
+	_shaped_run_cache_invalidate();
 }
 
 int64_t TextServerAdvanced::_font_get_weight(const RID &p_font_rid) const {
@@ -2260,6 +2278,7 @@ void TextServerAdvanced::_font_set_stretch(const RID &p_font_rid, int64_t p_stre
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	fd->stretch = CLAMP(p_stretch, 50, 200);
+	_shaped_run_cache_invalidate();
 }
 
 int64_t TextServerAdvanced::_font_get_stretch(const RID &p_font_rid) const {
@@ -2535,6 +2554,7 @@ void TextServerAdvanced::_font_set_fixed_size(const RID &p_font_rid, int64_t p_f
 
 	MutexLock lock(fd->mutex);
 	fd->fixed_size = p_fixed_size;
+	_shaped_run_cache_invalidate();
 }
 
 int64_t TextServerAdvanced::_font_get_fixed_size(const RID &p_font_rid) const {
@@ -2551,6 +2571,7 @@ void TextServerAdvanced::_font_set_fixed_size_scale_mode(const RID &p_font_rid,
 
 	MutexLock lock(fd->mutex);
 	fd->fixed_size_scale_mode = p_fixed_size_scale_mode;
+	_shaped_run_cache_invalidate();
 }
 
 TextServer::FixedSizeScaleMode TextServerAdvanced::_font_get_fixed_size_scale_mode(const RID &p_font_rid) const {
@@ -2567,6 +2588,7 @@ void TextServerAdvanced::_font_set_allow_system_fallback(const RID &p_font_rid,
 
 	MutexLock lock(fd->mutex);
 	fd->allow_system_fallback = p_allow_system_fallback;
+	_shaped_run_cache_invalidate();
 }
 
 bool TextServerAdvanced::_font_is_allow_system_fallback(const RID &p_font_rid) const {
@@ -2639,6 +2661,7 @@ void TextServerAdvanced::_font_set_subpixel_positioning(const RID &p_font_rid, T
 
 	MutexLock lock(fd->mutex);
 	fd->subpixel_positioning = p_subpixel;
+	_shaped_run_cache_invalidate();
 }
 
 TextServer::SubpixelPositioning TextServerAdvanced::_font_get_subpixel_positioning(const RID &p_font_rid) const {
@@ -2655,6 +2678,7 @@ void TextServerAdvanced::_font_set_keep_rounding_remainders(const RID &p_font_ri
 
 	MutexLock lock(fd->mutex);
 	fd->keep_rounding_remainders = p_keep_rounding_remainders;
+	_shaped_run_cache_invalidate();
 }
 
 bool TextServerAdvanced::_font_get_keep_rounding_remainders(const RID &p_font_rid) const {
@@ -2690,6 +2714,7 @@ void TextServerAdvanced::_font_set_spacing(const RID &p_font_rid, SpacingType p_
 	if (fdv) {
 		if (fdv->extra_spacing[p_spacing] != p_value) {
 			fdv->extra_spacing[p_spacing] = p_value;
+			_shaped_run_cache_invalidate();
 		}
 	} else {
 		FontAdvanced *fd = font_owner.get_or_null(p_font_rid);
@@ -2698,6 +2723,7 @@ void TextServerAdvanced::_font_set_spacing(const RID &p_font_rid, SpacingType p_
 		MutexLock lock(fd->mutex);
 		if (fd->extra_spacing[p_spacing] != p_value) {
 			fd->extra_spacing[p_spacing] = p_value;
+			_shaped_run_cache_invalidate();
 		}
 	}
 }
@@ -2721,6 +2747,7 @@ void TextServerAdvanced::_font_set_baseline_offset(const RID &p_font_rid, double
 	if (fdv) {
 		if (fdv->baseline_offset != p_baseline_offset) {
 			fdv->baseline_offset = p_baseline_offset;
+			_shaped_run_cache_invalidate();
 		}
 	} else {
 		FontAdvanced *fd = font_owner.get_or_null(p_font_rid);
@@ -2859,6 +2886,7 @@ void TextServerAdvanced::_font_clear_size_cache(const RID &p_font_rid) {
 		memdelete(E.value);
 	}
 	fd->cache.clear();
+	_shaped_run_cache_invalidate();
 }
 
 void TextServerAdvanced::_font_remove_size_cache(const RID &p_font_rid, const Vector2i &p_size) {
@@ -2878,6 +2906,7 @@ void TextServerAdvanced::_font_remove_size_cache(const RID &p_font_rid, const Ve
 		memdelete(fd->cache[size]);
 		fd->cache.erase(size);
 	}
+	_shaped_run_cache_invalidate();
 }
 
 void TextServerAdvanced::_font_set_ascent(const RID &p_font_rid, int64_t p_size, double p_ascent) {
@@ -2890,6 +2919,7 @@ void TextServerAdvanced::_font_set_ascent(const RID &p_font_rid, int64_t p_size,
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->ascent = p_ascent;
+	_shaped_run_cache_invalidate();
 }
 
 double TextServerAdvanced::_font_get_ascent(const RID &p_font_rid, int64_t p_size) const {
@@ -2924,6 +2954,7 @@ void TextServerAdvanced::_font_set_descent(const RID &p_font_rid, int64_t p_size
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->descent = p_descent;
+	_shaped_run_cache_invalidate();
 }
 
 double TextServerAdvanced::_font_get_descent(const RID &p_font_rid, int64_t p_size) const {
@@ -2959,6 +2990,7 @@ void TextServerAdvanced::_font_set_underline_position(const RID &p_font_rid, int
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->underline_position = p_underline_position;
+	_shaped_run_cache_invalidate();
 }
 
 double TextServerAdvanced::_font_get_underline_position(const RID &p_font_rid, int64_t p_size) const {
@@ -2994,6 +3026,7 @@ void TextServerAdvanced::_font_set_underline_thickness(const RID &p_font_rid, in
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->underline_thickness = p_underline_thickness;
+	_shaped_run_cache_invalidate();
 }
 
 double TextServerAdvanced::_font_get_underline_thickness(const RID &p_font_rid, int64_t p_size) const {
@@ -3035,6 +3068,7 @@ void TextServerAdvanced::_font_set_scale(const RID &p_font_rid, int64_t p_size,
 	}
 #endif
 	ffsd->scale = p_scale;
+	_shaped_run_cache_invalidate();
 }
 
 double TextServerAdvanced::_font_get_scale(const RID &p_font_rid, int64_t p_size) const {
@@ -3107,6 +3141,13 @@ void TextServerAdvanced::_font_set_texture_image(const RID &p_font_rid, const Ve
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ERR_FAIL_COND(p_texture_index < 0);
+	if (ffsd->glyph_cache_key != 0) {
+		// Pre-rendered font data takes precedence over the persistent glyph cache.
+		ffsd->glyph_cache_key = 0;
+		ffsd->glyph_cache_dirty = false;
+		ffsd->textures.clear();
+		ffsd->glyph_map.clear();
+	}
 	if (p_texture_index >= ffsd->textures.size()) {
 		ffsd->textures.resize(p_texture_index + 1);
 	}
@@ -3150,6 +3191,13 @@ void TextServerAdvanced::_font_set_texture_offsets(const RID &p_font_rid, const
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ERR_FAIL_COND(p_texture_index < 0);
+	if (ffsd->glyph_cache_key != 0) {
+		// Pre-rendered font data takes precedence over the persistent glyph cache.
+		ffsd->glyph_cache_key = 0;
+		ffsd->glyph_cache_dirty = false;
+		ffsd->textures.clear();
+		ffsd->glyph_map.clear();
+	}
 	if (p_texture_index >= ffsd->textures.size()) {
 		ffsd->textures.resize(p_texture_index + 1);
 	}
@@ -3214,6 +3262,7 @@ void TextServerAdvanced::_font_clear_glyphs(const RID &p_font_rid, const Vector2
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 
 	ffsd->glyph_map.clear();
+	_shaped_run_cache_invalidate();
 }
 
 void TextServerAdvanced::_font_remove_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_glyph) {
@@ -3226,6 +3275,7 @@ void TextServerAdvanced::_font_remove_glyph(const RID &p_font_rid, const Vector2
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 
 	ffsd->glyph_map.erase(p_glyph);
+	_shaped_run_cache_invalidate();
 }
 
 double TextServerAdvanced::_get_extra_advance(RID p_font_rid, int p_font_size) const {
@@ -3300,6 +3350,7 @@ void TextServerAdvanced::_font_set_glyph_advance(const RID &p_font_rid, int64_t
 
 	fgl.advance = p_advance;
 	fgl.found = true;
+	_shaped_run_cache_invalidate();
 }
 
 Vector2 TextServerAdvanced::_font_get_glyph_offset(const RID &p_font_rid, const Vector2i &p_size, int64_t p_glyph) const {
@@ -3352,6 +3403,7 @@ void TextServerAdvanced::_font_set_glyph_offset(const RID &p_font_rid, const Vec
 
 	fgl.rect.position = p_offset;
 	fgl.found = true;
+	_shaped_run_cache_invalidate();
 }
 
 Vector2 TextServerAdvanced::_font_get_glyph_size(const RID &p_font_rid, const Vector2i &p_size, int64_t p_glyph) const {
@@ -3404,6 +3456,7 @@ void TextServerAdvanced::_font_set_glyph_size(const RID &p_font_rid, const Vecto
 
 	fgl.rect.size = p_gl_size;
 	fgl.found = true;
+	_shaped_run_cache_invalidate();
 }
 
 Rect2 TextServerAdvanced::_font_get_glyph_uv_rect(const RID &p_font_rid, const Vector2i &p_size, int64_t p_glyph) const {
@@ -3678,6 +3731,7 @@ void TextServerAdvanced::_font_clear_kerning_map(const RID &p_font_rid, int64_t
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->kerning_map.clear();
+	_shaped_run_cache_invalidate();
 }
 
 void TextServerAdvanced::_font_remove_kerning(const RID &p_font_rid, int64_t p_size, const Vector2i &p_glyph_pair) {
@@ -3690,6 +3744,7 @@ void TextServerAdvanced::_font_remove_kerning(const RID &p_font_rid, int64_t p_s
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->kerning_map.erase(p_glyph_pair);
+	_shaped_run_cache_invalidate();
 }
 
 void TextServerAdvanced::_font_set_kerning(const RID &p_font_rid, int64_t p_size, const Vector2i &p_glyph_pair, const Vector2 &p_kerning) {
@@ -3702,6 +3757,7 @@ void TextServerAdvanced::_font_set_kerning(const RID &p_font_rid, int64_t p_size
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->kerning_map[p_glyph_pair] = p_kerning;
+	_shaped_run_cache_invalidate();
 }
 
 Vector2 TextServerAdvanced::_font_get_kerning(const RID &p_font_rid, int64_t p_size, const Vector2i &p_glyph_pair) const {
@@ -3911,24 +3967,7 @@ void TextServerAdvanced::_font_render_range(const RID &p_font_rid, const Vector2
 #ifdef MODULE_FREETYPE_ENABLED
 		int32_t idx = FT_Get_Char_Index(ffsd->face, i);
 		if (ffsd->face) {
-			FontGlyph fgl;
-			if (fd->msdf) {
-				_ensure_glyph(fd, size, (int32_t)idx, fgl);
-			} else {
-				for (int aa = 0; aa < ((fd->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
-					if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE * 64)) {
-						_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (2 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (3 << 27) | (aa << 24), fgl);
-					} else if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE * 64)) {
-						_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-					} else {
-						_ensure_glyph(fd, size, (int32_t)idx | (aa << 24), fgl);
-					}
-				}
-			}
+			_render_glyph_variants(fd, size, idx);
 		}
 #endif
 	}
@@ -3945,26 +3984,30 @@ void TextServerAdvanced::_font_render_glyph(const RID &p_font_rid, const Vector2
 #ifdef MODULE_FREETYPE_ENABLED
 	int32_t idx = p_index & 0xffffff; // Remove subpixel shifts.
 	if (ffsd->face) {
-		FontGlyph fgl;
-		if (fd->msdf) {
-			_ensure_glyph(fd, size, (int32_t)idx, fgl);
-		} else {
-			for (int aa = 0; aa < ((fd->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
-				if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE * 64)) {
-					_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (2 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (3 << 27) | (aa << 24), fgl);
-				} else if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE * 64)) {
-					_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-				} else {
-					_ensure_glyph(fd, size, (int32_t)idx | (aa << 24), fgl);
-				}
+		_render_glyph_variants(fd, size, idx);
+	}
+#endif
+}
+
+void TextServerAdvanced::_render_glyph_variants(FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_index, uint32_t p_oversampling) const {
+	FontGlyph fgl;
+	if (p_font_data->msdf) {
+		_ensure_glyph(p_font_data, p_size, p_index, fgl, p_oversampling);
+	} else {
+		for (int aa = 0; aa < ((p_font_data->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
+			if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE * 64)) {
+				_ensure_glyph(p_font_data, p_size, p_index | (0 << 27) | (aa << 24), fgl, p_oversampling);
+				_ensure_glyph(p_font_data, p_size, p_index | (1 << 27) | (aa << 24), fgl, p_oversampling);
+				_ensure_glyph(p_font_data, p_size, p_index | (2 << 27) | (aa << 24), fgl, p_oversampling);
+				_ensure_glyph(p_font_data, p_size, p_index | (3 << 27) | (aa << 24), fgl, p_oversampling);
+			} else if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE * 64)) {
+				_ensure_glyph(p_font_data, p_size, p_index | (1 << 27) | (aa << 24), fgl, p_oversampling);
+				_ensure_glyph(p_font_data, p_size, p_index | (0 << 27) | (aa << 24), fgl, p_oversampling);
+			} else {
+				_ensure_glyph(p_font_data, p_size, p_index | (aa << 24), fgl, p_oversampling);
 			}
 		}
 	}
-#endif
 }
 
 void TextServerAdvanced::_font_draw_glyph(const RID &p_font_rid, const RID &p_canvas, int64_t p_size, const Vector2 &p_pos, int64_t p_index, const Color &p_color, float p_oversampling) const {
@@ -4276,6 +4319,7 @@ void TextServerAdvanced::_font_set_language_support_override(const RID &p_font_r
 
 	MutexLock lock(fd->mutex);
 	fd->language_support_overrides[p_language] = p_supported;
+	_shaped_run_cache_invalidate();
 }
 
 bool TextServerAdvanced::_font_get_language_support_override(const RID &p_font_rid, const String &p_language) {
@@ -4292,6 +4336,7 @@ void TextServerAdvanced::_font_remove_language_support_override(const RID &p_fon
 
 	MutexLock lock(fd->mutex);
 	fd->language_support_overrides.erase(p_language);
+	_shaped_run_cache_invalidate();
 }
 
 PackedStringArray TextServerAdvanced::_font_get_language_support_overrides(const RID &p_font_rid) {
@@ -4336,6 +4381,7 @@ void TextServerAdvanced::_font_set_script_support_override(const RID &p_font_rid
 
 	MutexLock lock(fd->mutex);
 	fd->script_support_overrides[p_script] = p_supported;
+	_shaped_run_cache_invalidate();
 }
 
 bool TextServerAdvanced::_font_get_script_support_override(const RID &p_font_rid, const String &p_script) {
@@ -4352,6 +4398,7 @@ void TextServerAdvanced::_font_remove_script_support_override(const RID &p_font_
 
 	MutexLock lock(fd->mutex);
 	fd->script_support_overrides.erase(p_script);
+	_shaped_run_cache_invalidate();
 }
 
 PackedStringArray TextServerAdvanced::_font_get_script_support_overrides(const RID &p_font_rid) {
@@ -4375,6 +4422,7 @@ void TextServerAdvanced::_font_set_opentype_feature_overrides(const RID &p_font_
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	fd->feature_overrides = p_overrides;
+	_shaped_run_cache_invalidate();
 }
 
 Dictionary TextServerAdvanced::_font_get_opentype_feature_overrides(const RID &p_font_rid) const {
@@ -7172,6 +7220,113 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 	}
 }
 
+void TextServerAdvanced::_shape_run_cached(ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_end, const String &p_language, hb_script_t p_script, hb_direction_t p_direction, FontPriorityList &p_fonts, int64_t p_span) {
+	if (shaped_run_cache_budget == 0 || p_start >= p_end) {
+		_shape_run(p_sd, p_start, p_end, p_language, p_script, p_direction, p_fonts, p_span, 0, 0, 0, RID());
+		return;
+	}
+
+	// Cached runs are dropped when any font changes, shaped glyphs refer to font RIDs and depend on most font settings.
+	uint64_t epoch = font_epoch.get();
+	if (shaped_run_cache_epoch != epoch) {
+		_shaped_run_cache_trim(0, false);
+		shaped_run_cache_epoch = epoch;
+	}
+
+	const ShapedTextDataAdvanced::Span &span = p_sd->spans[p_span];
+	int64_t from = MAX(0, p_start - SHAPED_RUN_CONTEXT);
+	int64_t to = MIN(p_sd->text.length(), p_end + SHAPED_RUN_CONTEXT);
+
+	ShapedRunKey key;
+	key.text = p_sd->text.substr(from, to - from);
+	key.context_before = p_start - from;
+	key.context_after = to - p_end;
+	key.fonts = span.fonts;
+	key.font_size = span.font_size;
+	key.features = span.features;
+	key.language = p_language;
+	key.script = p_script;
+	key.direction = p_direction;
+	key.orientation = p_sd->orientation;
+	key.last_run = (p_sd->end == p_end);
+	key.preserve_invalid = p_sd->preserve_invalid;
+	key.preserve_control = p_sd->preserve_control;
+	key.extra_spacing[0] = p_sd->extra_spacing[SPACING_SPACE];
+	key.extra_spacing[1] = p_sd->extra_spacing[SPACING_GLYPH];
+	key.update_hash();
+
+	int64_t offset = p_sd->start + p_start;
+
+	List<ShapedRunCacheEntry>::Element **E = shaped_run_cache.getptr(key);
+	if (E) {
+		shaped_run_lru.move_to_front(*E);
+		const ShapedRunCacheEntry &entry = (*E)->get();
+		p_sd->glyphs.reserve(p_sd->glyphs.size() + entry.glyphs.size());
+		for (const Glyph &cached : entry.glyphs) {
+			Glyph gl = cached;
+			gl.span_index = p_span;
+			gl.start += offset;
+			gl.end += offset;
+			p_sd->width += gl.advance;
+			p_sd->glyphs.push_back(gl);
+		}
+		p_sd->ascent = MAX(p_sd->ascent, entry.ascent);
+		p_sd->descent = MAX(p_sd->descent, entry.descent);
+		p_sd->upos = MAX(p_sd->upos, entry.upos);
+		p_sd->uthk = MAX(p_sd->uthk, entry.uthk);
+		shaped_run_cache_hits++;
+		return;
+	}
+	shaped_run_cache_misses++;
+
+	// Shape the run with cleared metrics to capture its own contribution.
+	uint32_t glyph_from = p_sd->glyphs.size();
+	double ascent = p_sd->ascent;
+	double descent = p_sd->descent;
+	double upos = p_sd->upos;
+	double uthk = p_sd->uthk;
+	p_sd->ascent = 0.0;
+	p_sd->descent = 0.0;
+	p_sd->upos = 0.0;
+	p_sd->uthk = 0.0;
+
+	_shape_run(p_sd, p_start, p_end, p_language, p_script, p_direction, p_fonts, p_span, 0, 0, 0, RID());
+
+	ShapedRunCacheEntry entry;
+	entry.ascent = p_sd->ascent;
+	entry.descent = p_sd->descent;
+	entry.upos = p_sd->upos;
+	entry.uthk = p_sd->uthk;
+	p_sd->ascent = MAX(ascent, p_sd->ascent);
+	p_sd->descent = MAX(descent, p_sd->descent);
+	p_sd->upos = MAX(upos, p_sd->upos);
+	p_sd->uthk = MAX(uthk, p_sd->uthk);
+
+	if (font_epoch.get() != epoch) {
+		return; // A font was changed while shaping.
+	}
+
+	entry.glyphs.resize(p_sd->glyphs.size() - glyph_from);
+	for (uint32_t i = 0; i < entry.glyphs.size(); i++) {
+		Glyph &gl = entry.glyphs[i];
+		gl = p_sd->glyphs[glyph_from + i];
+		gl.start -= offset;
+		gl.end -= offset;
+	}
+	entry.size = sizeof(ShapedRunCacheEntry) + sizeof(KeyValue<ShapedRunKey, List<ShapedRunCacheEntry>::Element *>) + entry.glyphs.size() * sizeof(Glyph) + (key.text.length() + key.language.length()) * sizeof(char32_t) + (key.fonts.size() + key.features.size() * 2) * sizeof(Variant);
+	if (entry.size > shaped_run_cache_budget) {
+		return;
+	}
+
+	// Span arrays and dictionaries are shared with the caller, keep a copy that can't be modified.
+	key.fonts = key.fonts.duplicate();
+	key.features = key.features.duplicate();
+	entry.key = key;
+	shaped_run_cache_usage += entry.size;
+	shaped_run_cache.insert(key, shaped_run_lru.push_front(entry));
+	_shaped_run_cache_trim(shaped_run_cache_budget, true);
+}
+
 bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
@@ -7376,7 +7531,7 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 								}
 							}
 							FontPriorityList fonts(this, span.fonts, language.left(3).remove_char('_'), script_code, sd->script_iter->script_ranges[j].script == HB_TAG('Z', 's', 'y', 'e'));
-							_shape_run(sd, MAX(span.start - sd->start, script_run_start), MIN(span.end - sd->start, script_run_end), language, sd->script_iter->script_ranges[j].script, bidi_run_direction, fonts, k, 0, 0, 0, RID());
+							_shape_run_cached(sd, MAX(span.start - sd->start, script_run_start), MIN(span.end - sd->start, script_run_end), language, sd->script_iter->script_ranges[j].script, bidi_run_direction, fonts, k);
 						}
 					}
 				}
@@ -8120,6 +8275,498 @@ bool TextServerAdvanced::_is_valid_letter(uint64_t p_unicode) const {
 	return u_isalpha(p_unicode);
 }
 
+/*************************************************************************/
+/* Persistent Glyph Cache                                                */
+/*************************************************************************/
+
+#ifdef GODOT_MODULE
+
+// Cache file layout, all values are little-endian:
+//   header:  "GDGC", version, key (u64), size.x, size.y, texture count, glyph count,
+//   texture: width, height, format, shelf count, data offset (u64), data size (u64), shelves (x, y, w, h),
+//   glyph:   glyph key, texture index, found, from_svg, padding (u16), rect, uv_rect and advance (floats),
+// followed by the raw atlas pages, each aligned to GLYPH_CACHE_ALIGN bytes so they can be copied straight out of a memory mapping.
+static constexpr uint32_t GLYPH_CACHE_VERSION = 1;
+static constexpr uint64_t GLYPH_CACHE_ALIGN = 64;
+static constexpr uint64_t GLYPH_CACHE_HEADER_SIZE = 32;
+static constexpr uint64_t GLYPH_CACHE_TEXTURE_SIZE = 32;
+static constexpr uint64_t GLYPH_CACHE_SHELF_SIZE = 16;
+static constexpr uint64_t GLYPH_CACHE_GLYPH_SIZE = 52;
+
+static _FORCE_INLINE_ uint64_t _glyph_cache_align(uint64_t p_offset) {
+	return (p_offset + GLYPH_CACHE_ALIGN - 1) & ~(GLYPH_CACHE_ALIGN - 1);
+}
+
+uint64_t TextServerAdvanced::_glyph_cache_get_key(FontAdvanced *p_font_data, const Vector2i &p_size) const {
+	if (p_font_data->data_size > (size_t)INT32_MAX) {
+		return 0;
+	}
+	if (p_font_data->data_hash == 0) {
+		p_font_data->data_hash = MAX(hash_murmur3_buffer(p_font_data->data_ptr, p_font_data->data_size), 1u);
+	}
+
+	// Everything that changes the rasterized glyphs, the size already includes the oversampling factor.
+	uint32_t h = hash_murmur3_one_32(GLYPH_CACHE_VERSION);
+	h = hash_murmur3_one_64(p_font_data->data_size, h);
+	h = hash_murmur3_one_32(p_font_data->face_index, h);
+	h = hash_murmur3_one_32(p_font_data->antialiasing, h);
+	h = hash_murmur3_one_32(p_font_data->disable_embedded_bitmaps, h);
+	h = hash_murmur3_one_32(p_font_data->msdf, h);
+	h = hash_murmur3_one_32(p_font_data->msdf_range, h);
+	h = hash_murmur3_one_32(p_font_data->msdf_source_size, h);
+	h = hash_murmur3_one_32(p_font_data->fixed_size, h);
+	h = hash_murmur3_one_32(p_font_data->force_autohinter, h);
+	h = hash_murmur3_one_32(p_font_data->hinting, h);
+	h = hash_murmur3_one_32(p_font_data->subpixel_positioning, h);
+	h = hash_murmur3_one_double(p_font_data->embolden, h);
+	for (int i = 0; i < 3; i++) {
+		h = hash_murmur3_one_real(p_font_data->transform[i].x, h);
+		h = hash_murmur3_one_real(p_font_data->transform[i].y, h);
+	}
+	h = hash_murmur3_one_32(p_font_data->variation_coordinates.hash(), h);
+	h = hash_murmur3_one_32(p_size.x, h);
+	h = hash_murmur3_one_32(p_size.y, h);
+	h = hash_fmix32(h);
+
+	return (uint64_t(p_font_data->data_hash) << 32) | h;
+}
+
+String TextServerAdvanced::_glyph_cache_get_file(uint64_t p_key) const {
+	return glyph_cache_path.path_join(String::num_uint64(p_key, 16).lpad(16, "0") + ".glyphs");
+}
+
+bool TextServerAdvanced::_glyph_cache_parse(FontForSizeAdvanced *p_data, const Span<uint8_t> &p_file) const {
+	const uint8_t *ptr = p_file.ptr();
+	const uint64_t len = p_file.size();
+
+	if (len < GLYPH_CACHE_HEADER_SIZE || memcmp(ptr, "GDGC", 4) != 0 || decode_uint32(ptr + 4) != GLYPH_CACHE_VERSION) {
+		return false;
+	}
+	if (decode_uint64(ptr + 8) != p_data->glyph_cache_key || (int32_t)decode_uint32(ptr + 16) != p_data->size.x || (int32_t)decode_uint32(ptr + 20) != p_data->size.y) {
+		return false;
+	}
+	uint32_t texture_count = decode_uint32(ptr + 24);
+	uint32_t glyph_count = decode_uint32(ptr + 28);
+	uint64_t ofs = GLYPH_CACHE_HEADER_SIZE;
+
+	Vector<ShelfPackTexture> textures;
+	for (uint32_t i = 0; i < texture_count; i++) {
+		if (len - ofs < GLYPH_CACHE_TEXTURE_SIZE) {
+			return false;
+		}
+		int32_t w = decode_uint32(ptr + ofs);
+		int32_t h = decode_uint32(ptr + ofs + 4);
+		uint32_t format = decode_uint32(ptr + ofs + 8);
+		uint32_t shelf_count = decode_uint32(ptr + ofs + 12);
+		uint64_t data_ofs = decode_uint64(ptr + ofs + 16);
+		uint64_t data_size = decode_uint64(ptr + ofs + 24);
+		ofs += GLYPH_CACHE_TEXTURE_SIZE;
+
+		if (w <= 0 || h <= 0 || w > Image::MAX_WIDTH || h > Image::MAX_HEIGHT || format >= Image::FORMAT_MAX) {
+			return false;
+		}
+		if (data_size != (uint64_t)Image::get_image_data_size(w, h, (Image::Format)format) || data_ofs > len || data_size > len - data_ofs) {
+			return false;
+		}
+		if (shelf_count > (len - ofs) / GLYPH_CACHE_SHELF_SIZE) {
+			return false;
+		}
+
+		ShelfPackTexture tex(w, h);
+		for (uint32_t j = 0; j < shelf_count; j++) {
+			tex.shelves.push_back(Shelf(decode_uint32(ptr + ofs), decode_uint32(ptr + ofs + 4), decode_uint32(ptr + ofs + 8), decode_uint32(ptr + ofs + 12)));
+			ofs += GLYPH_CACHE_SHELF_SIZE;
+		}
+
+		Vector<uint8_t> pixels;
+		pixels.resize_uninitialized(data_size);
+		memcpy(pixels.ptrw(), ptr + data_ofs, data_size);
+		tex.image = Image::create_from_data(w, h, false, (Image::Format)format, pixels);
+		textures.push_back(tex);
+	}
+
+	if (glyph_count > (len - ofs) / GLYPH_CACHE_GLYPH_SIZE) {
+		return false;
+	}
+	HashMap<int32_t, FontGlyph> glyph_map;
+	glyph_map.reserve(glyph_count);
+	for (uint32_t i = 0; i < glyph_count; i++) {
+		FontGlyph gl;
+		int32_t glyph = decode_uint32(ptr + ofs);
+		gl.texture_idx = (int32_t)decode_uint32(ptr + ofs + 4);
+		gl.found = ptr[ofs + 8];
+		gl.from_svg = ptr[ofs + 9];
+		gl.rect = Rect2(decode_float(ptr + ofs + 12), decode_float(ptr + ofs + 16), decode_float(ptr + ofs + 20), decode_float(ptr + ofs + 24));
+		gl.uv_rect = Rect2(decode_float(ptr + ofs + 28), decode_float(ptr + ofs + 32), decode_float(ptr + ofs + 36), decode_float(ptr + ofs + 40));
+		gl.advance = Vector2(decode_float(ptr + ofs + 44), decode_float(ptr + ofs + 48));
+		ofs += GLYPH_CACHE_GLYPH_SIZE;
+
+		if (gl.texture_idx < -1 || gl.texture_idx >= (int32_t)texture_count) {
+			return false;
+		}
+		glyph_map.insert(glyph, gl);
+	}
+
+	p_data->textures = textures;
+	p_data->glyph_map = glyph_map;
+	return true;
+}
+
+#endif // GODOT_MODULE
+
+void TextServerAdvanced::_glyph_cache_load(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data) const {
+#ifdef GODOT_MODULE
+	if (glyph_cache_path.is_empty() || !p_font_data->data_ptr || p_font_data->data_size == 0) {
+		return;
+	}
+	p_data->glyph_cache_key = _glyph_cache_get_key(p_font_data, p_data->size);
+	if (p_data->glyph_cache_key == 0) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(_glyph_cache_get_file(p_data->glyph_cache_key), FileAccess::READ);
+	if (f.is_null()) {
+		return;
+	}
+	Span<uint8_t> file = f->map_read_only();
+	Vector<uint8_t> buffer;
+	if (file.is_empty()) {
+		buffer = f->get_buffer(f->get_length());
+		file = Span<uint8_t>(buffer.ptr(), buffer.size());
+	}
+	if (!_glyph_cache_parse(p_data, file)) {
+		print_verbose(vformat("Discarding invalid glyph cache \"%s\".", f->get_path()));
+		p_data->glyph_cache_dirty = true; // Overwrite it on the next save.
+	}
+#endif
+}
+
+void TextServerAdvanced::_glyph_cache_store(FontForSizeAdvanced *p_data) const {
+#ifdef GODOT_MODULE
+	if (p_data->glyph_cache_key == 0 || !p_data->glyph_cache_dirty || glyph_cache_path.is_empty()) {
+		return;
+	}
+	p_data->glyph_cache_dirty = false;
+
+	uint64_t shelf_count = 0;
+	for (const ShelfPackTexture &tex : p_data->textures) {
+		if (tex.image.is_null() || tex.image->has_mipmaps()) {
+			return;
+		}
+		shelf_count += tex.shelves.size();
+	}
+
+	const uint64_t table_size = GLYPH_CACHE_HEADER_SIZE + p_data->textures.size() * GLYPH_CACHE_TEXTURE_SIZE + shelf_count * GLYPH_CACHE_SHELF_SIZE + p_data->glyph_map.size() * GLYPH_CACHE_GLYPH_SIZE;
+	Vector<uint8_t> table;
+	table.resize_initialized(table_size);
+	uint8_t *w = table.ptrw();
+
+	memcpy(w, "GDGC", 4);
+	encode_uint32(GLYPH_CACHE_VERSION, w + 4);
+	encode_uint64(p_data->glyph_cache_key, w + 8);
+	encode_uint32(p_data->size.x, w + 16);
+	encode_uint32(p_data->size.y, w + 20);
+	encode_uint32(p_data->textures.size(), w + 24);
+	encode_uint32(p_data->glyph_map.size(), w + 28);
+	uint64_t ofs = GLYPH_CACHE_HEADER_SIZE;
+
+	uint64_t data_ofs = _glyph_cache_align(table_size);
+	for (const ShelfPackTexture &tex : p_data->textures) {
+		encode_uint32(tex.image->get_width(), w + ofs);
+		encode_uint32(tex.image->get_height(), w + ofs + 4);
+		encode_uint32(tex.image->get_format(), w + ofs + 8);
+		encode_uint32(tex.shelves.size(), w + ofs + 12);
+		encode_uint64(data_ofs, w + ofs + 16);
+		encode_uint64(tex.image->get_data_size(), w + ofs + 24);
+		ofs += GLYPH_CACHE_TEXTURE_SIZE;
+		for (const Shelf &shelf : tex.shelves) {
+			encode_uint32(shelf.x, w + ofs);
+			encode_uint32(shelf.y, w + ofs + 4);
+			encode_uint32(shelf.w, w + ofs + 8);
+			encode_uint32(shelf.h, w + ofs + 12);
+			ofs += GLYPH_CACHE_SHELF_SIZE;
+		}
+		data_ofs = _glyph_cache_align(data_ofs + tex.image->get_data_size());
+	}
+	for (const KeyValue<int32_t, FontGlyph> &E : p_data->glyph_map) {
+		encode_uint32(E.key, w + ofs);
+		encode_uint32(E.value.texture_idx, w + ofs + 4);
+		w[ofs + 8] = E.value.found;
+		w[ofs + 9] = E.value.from_svg;
+		encode_float(E.value.rect.position.x, w + ofs + 12);
+		encode_float(E.value.rect.position.y, w + ofs + 16);
+		encode_float(E.value.rect.size.x, w + ofs + 20);
+		encode_float(E.value.rect.size.y, w + ofs + 24);
+		encode_float(E.value.uv_rect.position.x, w + ofs + 28);
+		encode_float(E.value.uv_rect.position.y, w + ofs + 32);
+		encode_float(E.value.uv_rect.size.x, w + ofs + 36);
+		encode_float(E.value.uv_rect.size.y, w + ofs + 40);
+		encode_float(E.value.advance.x, w + ofs + 44);
+		encode_float(E.value.advance.y, w + ofs + 48);
+		ofs += GLYPH_CACHE_GLYPH_SIZE;
+	}
+
+	Error err = DirAccess::make_dir_recursive_absolute(glyph_cache_path);
+	if (err != OK && err != ERR_ALREADY_EXISTS) {
+		print_verbose(vformat("Can't create glyph cache directory \"%s\".", glyph_cache_path));
+		return;
+	}
+
+	// Write to a temporary file first, so an interrupted save never leaves a truncated cache behind.
+	const String path = _glyph_cache_get_file(p_data->glyph_cache_key);
+	const String tmp_path = path + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(tmp_path, FileAccess::WRITE);
+	if (f.is_null()) {
+		print_verbose(vformat("Can't write glyph cache \"%s\".", tmp_path));
+		return;
+	}
+	static const uint8_t padding[GLYPH_CACHE_ALIGN] = {};
+	f->store_buffer(table.ptr(), table.size());
+	for (const ShelfPackTexture &tex : p_data->textures) {
+		f->store_buffer(padding, _glyph_cache_align(f->get_position()) - f->get_position());
+		const Vector<uint8_t> pixels = tex.image->get_data();
+		f->store_buffer(pixels.ptr(), pixels.size());
+	}
+	bool failed = f->get_error() != OK;
+	f->close();
+
+	Ref<DirAccess> da = DirAccess::create_for_path(path);
+	if (failed || da->rename(tmp_path, path) != OK) {
+		print_verbose(vformat("Can't write glyph cache \"%s\".", path));
+		da->remove(tmp_path);
+	}
+#endif
+}
+
+void TextServerAdvanced::_glyph_cache_store_font(FontAdvanced *p_font_data) const {
+	for (const KeyValue<Vector2i, FontForSizeAdvanced *> &E : p_font_data->cache) {
+		_glyph_cache_store(E.value);
+	}
+}
+
+void TextServerAdvanced::set_glyph_cache_path(const String &p_path) {
+	glyph_cache_path = p_path;
+}
+
+String TextServerAdvanced::get_glyph_cache_path() const {
+	return glyph_cache_path;
+}
+
+void TextServerAdvanced::save_glyph_cache() {
+#ifdef GODOT_MODULE
+	for (const RID &E : font_owner.get_owned_list()) {
+		FontAdvanced *fd = font_owner.get_or_null(E);
+		MutexLock lock(fd->mutex);
+		_glyph_cache_store_font(fd);
+	}
+#endif
+}
+
+/*************************************************************************/
+/* Glyph Prewarming                                                      */
+/*************************************************************************/
+
+void TextServerAdvanced::_font_prewarm_glyphs_threaded(void *p_td, uint32_t p_chunk) {
+	GlyphPrewarmTask *td = static_cast<GlyphPrewarmTask *>(p_td);
+	FontAdvanced *fd = td->server->_get_font_data(td->font_rid);
+	if (fd == nullptr) {
+		return;
+	}
+
+	// The font is locked per chunk, so drawing from other threads can interleave with prewarming.
+	// The size cache is created by `font_prewarm_glyphs`. If it was freed since, there is nothing to warm.
+	MutexLock lock(fd->mutex);
+	FontForSizeAdvanced **ffsd = fd->cache.getptr(td->size);
+	if (ffsd == nullptr) {
+		return;
+	}
+#ifdef MODULE_FREETYPE_ENABLED
+	if ((*ffsd)->face) {
+		// Pass the level the cache is registered with, so the oversampling levels are left untouched.
+		uint32_t oversampling = (*ffsd)->viewport_oversampling;
+		int from = p_chunk * GLYPH_PREWARM_CHUNK;
+		int to = MIN(from + GLYPH_PREWARM_CHUNK, td->chars.length());
+		for (int i = from; i < to; i++) {
+			td->server->_render_glyph_variants(fd, td->size, FT_Get_Char_Index((*ffsd)->face, td->chars[i]), oversampling);
+		}
+	}
+#endif
+}
+
+int64_t TextServerAdvanced::font_prewarm_glyphs(const RID &p_font_rid, int64_t p_size, const String &p_chars, int64_t p_outline_size, double p_oversampling) {
+	ERR_FAIL_COND_V(p_size <= 0, -1);
+	FontAdvanced *fd = _get_font_data(p_font_rid);
+	ERR_FAIL_NULL_V(fd, -1);
+
+	GlyphPrewarmTask *td = memnew(GlyphPrewarmTask);
+	td->server = this;
+	td->font_rid = p_font_rid;
+	FontAdvancedLinkedVariation *fdv = font_var_owner.get_or_null(p_font_rid);
+	if (fdv) {
+		td->font_rid = fdv->base_font;
+	}
+	td->chars = p_chars;
+
+	{
+		// Use the same cache size as the glyphs drawn by `font_draw_glyph` and `font_draw_glyph_outline`.
+		MutexLock lock(fd->mutex);
+		uint32_t viewport_oversampling_level = 0;
+		if (fd->msdf || fd->fixed_size > 0) {
+			td->size = _get_size_outline(fd, Vector2i(p_size, p_outline_size));
+		} else {
+			bool viewport_oversampling = false;
+			double oversampling_factor = p_oversampling;
+			if (oversampling_factor <= 0.0) {
+				if (fd->oversampling_override > 0.0) {
+					oversampling_factor = fd->oversampling_override;
+				} else if (vp_oversampling > 0.0) {
+					oversampling_factor = vp_oversampling;
+					viewport_oversampling = true;
+				} else {
+					oversampling_factor = 1.0;
+				}
+			}
+			uint64_t oversampling_level = CLAMP(oversampling_factor, 0.1, 100.0) * 64;
+			oversampling_factor = double(oversampling_level) / 64.0;
+			td->size = Vector2i(p_size * 64 * oversampling_factor, p_outline_size * oversampling_factor);
+			if (viewport_oversampling) {
+				viewport_oversampling_level = oversampling_level;
+			}
+		}
+
+		// Create the size cache here, the oversampling levels are not safe to touch from the workers.
+		FontForSizeAdvanced *ffsd = nullptr;
+		if (!_ensure_cache_for_size(fd, td->size, ffsd, false, viewport_oversampling_level)) {
+			memdelete(td);
+			return -1;
+		}
+	}
+
+	// All chunks share the font lock, run them on a single low priority worker.
+	int chunks = MAX(1, Math::division_round_up(td->chars.length(), GLYPH_PREWARM_CHUNK));
+	td->group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&TextServerAdvanced::_font_prewarm_glyphs_threaded, td, chunks, 1, false, String("TextServerPrewarmGlyphs"));
+
+	MutexLock lock(prewarm_mutex);
+	prewarm_tasks.insert(td->group_id, td);
+	return td->group_id;
+}
+
+bool TextServerAdvanced::font_is_prewarm_completed(int64_t p_task_id) {
+	MutexLock lock(prewarm_mutex);
+	HashMap<int64_t, GlyphPrewarmTask *>::Iterator E = prewarm_tasks.find(p_task_id);
+	if (!E) {
+		return true;
+	}
+	if (!WorkerThreadPool::get_singleton()->is_group_task_completed(p_task_id)) {
+		return false;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_task_id);
+	memdelete(E->value);
+	prewarm_tasks.remove(E);
+	return true;
+}
+
+void TextServerAdvanced::font_wait_for_prewarm(int64_t p_task_id) {
+	GlyphPrewarmTask *td = nullptr;
+	{
+		MutexLock lock(prewarm_mutex);
+		HashMap<int64_t, GlyphPrewarmTask *>::Iterator E = prewarm_tasks.find(p_task_id);
+		if (!E) {
+			return;
+		}
+		td = E->value;
+		prewarm_tasks.remove(E);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_task_id);
+	memdelete(td);
+}
+
+void TextServerAdvanced::_font_wait_for_prewarm_font(const RID &p_font_rid) {
+	Vector<int64_t> tasks;
+	{
+		MutexLock lock(prewarm_mutex);
+		for (const KeyValue<int64_t, GlyphPrewarmTask *> &E : prewarm_tasks) {
+			if (!p_font_rid.is_valid() || E.value->font_rid == p_font_rid) {
+				tasks.push_back(E.key);
+			}
+		}
+	}
+	for (int64_t task_id : tasks) {
+		font_wait_for_prewarm(task_id);
+	}
+}
+
+/*************************************************************************/
+/* Shaped Run Cache                                                      */
+/*************************************************************************/
+
+void TextServerAdvanced::_shaped_run_cache_trim(uint64_t p_budget, bool p_count_evictions) {
+	while (shaped_run_cache_usage > p_budget && shaped_run_lru.back()) {
+		List<ShapedRunCacheEntry>::Element *E = shaped_run_lru.back();
+		shaped_run_cache_usage -= E->get().size;
+		shaped_run_cache.erase(E->get().key);
+		shaped_run_lru.erase(E);
+		if (p_count_evictions) {
+			shaped_run_cache_evictions++;
+		}
+	}
+}
+
+void TextServerAdvanced::set_shaped_run_cache_budget(int64_t p_bytes) {
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_COND(p_bytes < 0);
+	shaped_run_cache_budget = p_bytes;
+	_shaped_run_cache_trim(shaped_run_cache_budget, true);
+}
+
+int64_t TextServerAdvanced::get_shaped_run_cache_budget() const {
+	return shaped_run_cache_budget;
+}
+
+void TextServerAdvanced::clear_shaped_run_cache() {
+	_THREAD_SAFE_METHOD_
+	_shaped_run_cache_trim(0, false);
+}
+
+Dictionary TextServerAdvanced::get_shaped_run_cache_stats() const {
+	_THREAD_SAFE_METHOD_
+	Dictionary stats;
+	stats["hits"] = shaped_run_cache_hits;
+	stats["misses"] = shaped_run_cache_misses;
+	stats["hit_rate"] = (shaped_run_cache_hits + shaped_run_cache_misses > 0) ? (double)shaped_run_cache_hits / (shaped_run_cache_hits + shaped_run_cache_misses) : 0.0;
+	stats["evictions"] = shaped_run_cache_evictions;
+	stats["entries"] = shaped_run_cache.size();
+	stats["memory_usage"] = shaped_run_cache_usage;
+	stats["budget"] = shaped_run_cache_budget;
+	return stats;
+}
+
+void TextServerAdvanced::reset_shaped_run_cache_stats() {
+	_THREAD_SAFE_METHOD_
+	shaped_run_cache_hits = 0;
+	shaped_run_cache_misses = 0;
+	shaped_run_cache_evictions = 0;
+}
+
+void TextServerAdvanced::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_glyph_cache_path", "path"), &TextServerAdvanced::set_glyph_cache_path);
+	ClassDB::bind_method(D_METHOD("get_glyph_cache_path"), &TextServerAdvanced::get_glyph_cache_path);
+	ClassDB::bind_method(D_METHOD("save_glyph_cache"), &TextServerAdvanced::save_glyph_cache);
+
+	ClassDB::bind_method(D_METHOD("font_prewarm_glyphs", "font_rid", "size", "chars", "outline_size", "oversampling"), &TextServerAdvanced::font_prewarm_glyphs, DEFVAL(0), DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("font_is_prewarm_completed", "task_id"), &TextServerAdvanced::font_is_prewarm_completed);
+	ClassDB::bind_method(D_METHOD("font_wait_for_prewarm", "task_id"), &TextServerAdvanced::font_wait_for_prewarm);
+
+	ClassDB::bind_method(D_METHOD("set_shaped_run_cache_budget", "bytes"), &TextServerAdvanced::set_shaped_run_cache_budget);
+	ClassDB::bind_method(D_METHOD("get_shaped_run_cache_budget"), &TextServerAdvanced::get_shaped_run_cache_budget);
+	ClassDB::bind_method(D_METHOD("clear_shaped_run_cache"), &TextServerAdvanced::clear_shaped_run_cache);
+	ClassDB::bind_method(D_METHOD("get_shaped_run_cache_stats"), &TextServerAdvanced::get_shaped_run_cache_stats);
+	ClassDB::bind_method(D_METHOD("reset_shaped_run_cache_stats"), &TextServerAdvanced::reset_shaped_run_cache_stats);
+
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "glyph_cache_path"), "set_glyph_cache_path", "get_glyph_cache_path");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "shaped_run_cache_budget"), "set_shaped_run_cache_budget", "get_shaped_run_cache_budget");
+}
+
 void TextServerAdvanced::_update_settings() {
 	lcd_subpixel_layout.set((TextServer::FontLCDSubpixelLayout)(int)GLOBAL_GET("gui/theme/lcd_subpixel_layout"));
 	lb_strictness = (LineBreakStrictness)(int)GLOBAL_GET("internationalization/locale/line_breaking_strictness");
@@ -8132,6 +8779,9 @@ TextServerAdvanced::TextServerAdvanced() {
 	_bmp_create_font_funcs();
 	_update_settings();
 	ProjectSettings::get_singleton()->connect("settings_changed", callable_mp(this, &TextServerAdvanced::_update_settings));
+
+	glyph_cache_path = GLOBAL_GET("gui/theme/glyph_cache_path");
+	shaped_run_cache_budget = (int64_t)GLOBAL_GET("gui/theme/shaped_run_cache_size_kb") * 1024;
 }
 
 void TextServerAdvanced::_font_clear_system_fallback_cache() {
@@ -8147,6 +8797,8 @@ void TextServerAdvanced::_font_clear_system_fallback_cache() {
 }
 
 void TextServerAdvanced::_cleanup() {
+	_font_wait_for_prewarm_font(RID());
+	save_glyph_cache();
 	font_clear_system_fallback_cache();
 }
 
@@ -72,6 +72,7 @@
 
 #include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/list.hpp>
 #include <godot_cpp/templates/rid_owner.hpp>
 #include <godot_cpp/templates/safe_refcount.hpp>
 #include <godot_cpp/templates/vector.hpp>
@@ -82,7 +83,9 @@ using namespace godot;
 // Headers for building as built-in module.
 
 #include "core/extension/ext_wrappers.gen.inc"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/list.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/safe_refcount.h"
 #include "scene/resources/image_texture.h"
@@ -289,6 +292,10 @@ class TextServerAdvanced : public TextServerExtension {
 
 		Vector2i size;
 
+		// Persistent glyph cache file key, zero if this size is not persisted.
+		uint64_t glyph_cache_key = 0;
+		bool glyph_cache_dirty = false;
+
 		Vector<ShelfPackTexture> textures;
 		HashMap<int64_t, int64_t> inv_glyph_map;
 		HashMap<int32_t, FontGlyph> glyph_map;
@@ -370,6 +377,7 @@ class TextServerAdvanced : public TextServerExtension {
 		PackedByteArray data;
 		const uint8_t *data_ptr = nullptr;
 		size_t data_size;
+		uint32_t data_hash = 0; // Lazily computed, zero if not computed yet.
 		int face_index = 0;
 
 		~FontAdvanced() {
@@ -392,6 +400,38 @@ class TextServerAdvanced : public TextServerExtension {
 	_FORCE_INLINE_ bool _font_validate(const RID &p_font_rid) const;
 	_FORCE_INLINE_ void _font_clear_cache(FontAdvanced *p_font_data);
 	static void _generateMTSDF_threaded(void *p_td, uint32_t p_y);
+	void _render_glyph_variants(FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_index, uint32_t p_oversampling = 0) const;
+
+	// Persistent glyph cache.
+
+	String glyph_cache_path;
+
+#ifdef GODOT_MODULE
+	uint64_t _glyph_cache_get_key(FontAdvanced *p_font_data, const Vector2i &p_size) const;
+	String _glyph_cache_get_file(uint64_t p_key) const;
+	bool _glyph_cache_parse(FontForSizeAdvanced *p_data, const Span<uint8_t> &p_file) const;
+#endif
+	void _glyph_cache_load(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data) const;
+	void _glyph_cache_store(FontForSizeAdvanced *p_data) const;
+	void _glyph_cache_store_font(FontAdvanced *p_font_data) const;
+
+	// Glyph prewarming.
+
+	struct GlyphPrewarmTask {
+		const TextServerAdvanced *server = nullptr;
+		RID font_rid;
+		Vector2i size;
+		String chars;
+		WorkerThreadPool::GroupID group_id = -1;
+	};
+
+	static constexpr int GLYPH_PREWARM_CHUNK = 32;
+
+	Mutex prewarm_mutex;
+	HashMap<int64_t, GlyphPrewarmTask *> prewarm_tasks;
+
+	static void _font_prewarm_glyphs_threaded(void *p_td, uint32_t p_chunk);
+	void _font_wait_for_prewarm_font(const RID &p_font_rid); // Waits for all the tasks if the RID is invalid.
 
 	_FORCE_INLINE_ Vector2i _get_size(const FontAdvanced *p_font_data, int p_size) const {
 		if (p_font_data->msdf) {
@@ -687,6 +727,74 @@ class TextServerAdvanced : public TextServerExtension {
 	mutable HashMap<SystemFontKey, SystemFontCache, SystemFontKeyHasher> system_fonts;
 	mutable HashMap<String, PackedByteArray> system_font_data;
 
+	// Shaped run cache.
+
+	static constexpr int SHAPED_RUN_CONTEXT = 5; // HarfBuzz looks at up to 5 characters around the run.
+
+	struct ShapedRunKey {
+		String text; // Run text, with up to SHAPED_RUN_CONTEXT characters of context on each side.
+		int context_before = 0;
+		int context_after = 0;
+		Array fonts;
+		int font_size = 0;
+		Dictionary features;
+		String language;
+		hb_script_t script = HB_SCRIPT_INVALID;
+		hb_direction_t direction = HB_DIRECTION_INVALID;
+		TextServer::Orientation orientation = ORIENTATION_HORIZONTAL;
+		bool last_run = false;
+		bool preserve_invalid = true;
+		bool preserve_control = false;
+		int extra_spacing[2] = { 0, 0 }; // Space and glyph spacing.
+		uint32_t hash = 0;
+
+		bool operator==(const ShapedRunKey &p_b) const {
+			return (hash == p_b.hash) && (context_before == p_b.context_before) && (context_after == p_b.context_after) && (font_size == p_b.font_size) && (script == p_b.script) && (direction == p_b.direction) && (orientation == p_b.orientation) && (last_run == p_b.last_run) && (preserve_invalid == p_b.preserve_invalid) && (preserve_control == p_b.preserve_control) && (extra_spacing[0] == p_b.extra_spacing[0]) && (extra_spacing[1] == p_b.extra_spacing[1]) && (text == p_b.text) && (language == p_b.language) && (fonts == p_b.fonts) && (features == p_b.features);
+		}
+
+		void update_hash() {
+			uint32_t h = text.hash();
+			h = hash_murmur3_one_32(fonts.hash(), h);
+			h = hash_murmur3_one_32(features.hash(), h);
+			h = hash_murmur3_one_32(language.hash(), h);
+			h = hash_murmur3_one_32(font_size, h);
+			h = hash_murmur3_one_32(script, h);
+			h = hash_murmur3_one_32(extra_spacing[0], h);
+			h = hash_murmur3_one_32(extra_spacing[1], h);
+			h = hash_murmur3_one_32(context_before | (context_after << 8), h);
+			hash = hash_fmix32(hash_murmur3_one_32(((int)direction) | ((int)orientation << 8) | ((int)last_run << 9) | ((int)preserve_invalid << 10) | ((int)preserve_control << 11), h));
+		}
+	};
+
+	struct ShapedRunKeyHasher {
+		_FORCE_INLINE_ static uint32_t hash(const ShapedRunKey &p_a) {
+			return p_a.hash;
+		}
+	};
+
+	struct ShapedRunCacheEntry {
+		ShapedRunKey key;
+		LocalVector<Glyph> glyphs; // Glyph start and end are relative to the run start.
+		double ascent = 0.0;
+		double descent = 0.0;
+		double upos = 0.0;
+		double uthk = 0.0;
+		uint64_t size = 0;
+	};
+
+	List<ShapedRunCacheEntry> shaped_run_lru; // Most recently used first.
+	HashMap<ShapedRunKey, List<ShapedRunCacheEntry>::Element *, ShapedRunKeyHasher> shaped_run_cache;
+	uint64_t shaped_run_cache_budget = 0;
+	uint64_t shaped_run_cache_usage = 0;
+	uint64_t shaped_run_cache_hits = 0;
+	uint64_t shaped_run_cache_misses = 0;
+	uint64_t shaped_run_cache_evictions = 0;
+	uint64_t shaped_run_cache_epoch = 0;
+	SafeNumeric<uint64_t> font_epoch; // Incremented on every font change that can affect shaping results.
+
+	_FORCE_INLINE_ void _shaped_run_cache_invalidate() { font_epoch.increment(); }
+	void _shaped_run_cache_trim(uint64_t p_budget, bool p_count_evictions);
+
 	void _update_chars(ShapedTextDataAdvanced *p_sd) const;
 	void _generate_runs(ShapedTextDataAdvanced *p_sd) const;
 	void _realign(ShapedTextDataAdvanced *p_sd) const;
@@ -768,6 +876,7 @@ class TextServerAdvanced : public TextServerExtension {
 		}
 	};
 	void _shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_end, const String &p_language, hb_script_t p_script, hb_direction_t p_direction, FontPriorityList &p_fonts, int64_t p_span, int64_t p_fb_index, int64_t p_prev_start, int64_t p_prev_end, RID p_prev_font);
+	void _shape_run_cached(ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_end, const String &p_language, hb_script_t p_script, hb_direction_t p_direction, FontPriorityList &p_fonts, int64_t p_span);
 	Glyph _shape_single_glyph(ShapedTextDataAdvanced *p_sd, char32_t p_char, hb_script_t p_script, hb_direction_t p_direction, const RID &p_font, int64_t p_font_size);
 	_FORCE_INLINE_ RID _find_sys_font_for_text(const RID &p_fdef, const String &p_script_code, const String &p_language, const String &p_text);
 
@@ -817,7 +926,7 @@ class TextServerAdvanced : public TextServerExtension {
 	};
 
 protected:
-	static void _bind_methods() {}
+	static void _bind_methods();
 
 	void full_copy(ShapedTextDataAdvanced *p_shaped);
 	void invalidate(ShapedTextDataAdvanced *p_shaped, bool p_text = false);
@@ -1135,6 +1244,20 @@ public:
 
 	MODBIND0(cleanup);
 
+	void set_glyph_cache_path(const String &p_path);
+	String get_glyph_cache_path() const;
+	void save_glyph_cache();
+
+	int64_t font_prewarm_glyphs(const RID &p_font_rid, int64_t p_size, const String &p_chars, int64_t p_outline_size = 0, double p_oversampling = 0.0);
+	bool font_is_prewarm_completed(int64_t p_task_id);
+	void font_wait_for_prewarm(int64_t p_task_id);
+
+	void set_shaped_run_cache_budget(int64_t p_bytes);
+	int64_t get_shaped_run_cache_budget() const;
+	void clear_shaped_run_cache();
+	Dictionary get_shaped_run_cache_stats() const;
+	void reset_shaped_run_cache_stats();
+
 	TextServerAdvanced();
 	~TextServerAdvanced();
 };
@@ -302,7 +302,7 @@ Ref<InputEventKey> WaylandThread::_seat_state_get_unstuck_key_event(SeatState *p
 	return event;
 }
 
-void WaylandThread::_seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_t p_xkb_keycode, bool p_pressed, bool p_echo) {
+void WaylandThread::_seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_t p_xkb_keycode, bool p_pressed, bool p_echo, int64_t p_timestamp_usec) {
 	ERR_FAIL_NULL(p_ss);
 
 	WaylandThread *wayland_thread = p_ss->wayland_thread;
@@ -331,6 +331,7 @@ void WaylandThread::_seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_
 
 				k->set_unicode(decoded_str[i]);
 				k->set_echo(p_echo);
+				k->set_timestamp_usec(p_timestamp_usec);
 
 				Ref<InputEventMessage> msg;
 				msg.instantiate();
@@ -348,6 +349,7 @@ void WaylandThread::_seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_
 		Ref<InputEventKey> k = _seat_state_get_key_event(p_ss, p_xkb_keycode, p_pressed);
 		if (k.is_valid()) {
 			k->set_echo(p_echo);
+			k->set_timestamp_usec(p_timestamp_usec);
 
 			Ref<InputEventMessage> msg;
 			msg.instantiate();
@@ -361,6 +363,8 @@ void WaylandThread::_seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_
 	if (last_key != Key::NONE) {
 		Ref<InputEventKey> uk = _seat_state_get_unstuck_key_event(p_ss, p_xkb_keycode, p_pressed, last_key);
 		if (uk.is_valid()) {
+			uk->set_timestamp_usec(p_timestamp_usec);
+
 			Ref<InputEventMessage> u_msg;
 			u_msg.instantiate();
 			u_msg->event = uk;
@@ -1834,6 +1838,7 @@ void WaylandThread::_wl_pointer_on_motion(void *data, struct wl_pointer *wl_poin
 	pd.position.y = wl_fixed_to_double(surface_y);
 
 	pd.motion_time = time;
+	ss->input_clock.add_sample(time, OS::get_singleton()->get_ticks_usec());
 
 	if (wl_pointer_get_version(wl_pointer) < WL_POINTER_FRAME_SINCE_VERSION) {
 		_wl_pointer_on_frame(data, wl_pointer);
@@ -1885,6 +1890,7 @@ void WaylandThread::_wl_pointer_on_button(void *data, struct wl_pointer *wl_poin
 
 	pd.button_time = time;
 	pd.button_serial = serial;
+	ss->input_clock.add_sample(time, OS::get_singleton()->get_ticks_usec());
 
 	if (wl_pointer_get_version(wl_pointer) < WL_POINTER_FRAME_SINCE_VERSION) {
 		_wl_pointer_on_frame(data, wl_pointer);
@@ -1908,6 +1914,7 @@ void WaylandThread::_wl_pointer_on_axis(void *data, struct wl_pointer *wl_pointe
 	}
 
 	pd.button_time = time;
+	ss->input_clock.add_sample(time, OS::get_singleton()->get_ticks_usec());
 
 	if (wl_pointer_get_version(wl_pointer) < WL_POINTER_FRAME_SINCE_VERSION) {
 		_wl_pointer_on_frame(data, wl_pointer);
@@ -1982,6 +1989,12 @@ void WaylandThread::_wl_pointer_on_frame(void *data, struct wl_pointer *wl_point
 
 		mm->set_window_id(ws->id);
 
+		if (old_pd.relative_motion_time != pd.relative_motion_time) {
+			mm->set_timestamp_usec(ss->relative_motion_clock.to_ticks_usec(pd.relative_motion_time));
+		} else {
+			mm->set_timestamp_usec(ss->input_clock.to_ticks_usec(pd.motion_time));
+		}
+
 		mm->set_button_mask(pd.pressed_button_mask);
 
 		mm->set_position(pd.position * scale);
@@ -2082,6 +2095,7 @@ void WaylandThread::_wl_pointer_on_frame(void *data, struct wl_pointer *wl_point
 				mb->set_meta_pressed(ss->meta_pressed);
 
 				mb->set_window_id(ws->id);
+				mb->set_timestamp_usec(ss->input_clock.to_ticks_usec(pd.button_time));
 				mb->set_position(pd.position * scale);
 				mb->set_global_position(pd.position * scale);
 
@@ -2347,7 +2361,8 @@ void WaylandThread::_wl_keyboard_on_key(void *data, struct wl_keyboard *wl_keybo
 		ss->repeating_keycode = XKB_KEYCODE_INVALID;
 	}
 
-	_seat_state_handle_xkb_keycode(ss, xkb_keycode, pressed);
+	ss->input_clock.add_sample(time, OS::get_singleton()->get_ticks_usec());
+	_seat_state_handle_xkb_keycode(ss, xkb_keycode, pressed, false, ss->input_clock.to_ticks_usec(time));
 }
 
 void WaylandThread::_wl_keyboard_on_modifiers(void *data, struct wl_keyboard *wl_keyboard, uint32_t serial, uint32_t mods_depressed, uint32_t mods_latched, uint32_t mods_locked, uint32_t group) {
@@ -2563,6 +2578,7 @@ void WaylandThread::_wp_relative_pointer_on_relative_motion(void *data, struct z
 	pd.relative_motion.y = wl_fixed_to_double(dy);
 
 	pd.relative_motion_time = uptime_lo;
+	ss->relative_motion_clock.add_sample(uptime_lo, OS::get_singleton()->get_ticks_usec());
 }
 
 void WaylandThread::_wp_pointer_gesture_pinch_on_begin(void *data, struct zwp_pointer_gesture_pinch_v1 *wp_pointer_gesture_pinch_v1, uint32_t serial, uint32_t time, struct wl_surface *surface, uint32_t fingers) {
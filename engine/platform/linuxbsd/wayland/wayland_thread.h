@@ -86,6 +86,7 @@
 #endif // SOWRAP_ENABLED
 #endif // LIBDECOR_ENABLED
 
+#include "core/input/input_timestamp_converter.h"
 #include "core/os/thread.h"
 #include "servers/display/display_server.h"
 
@@ -474,6 +475,11 @@ public:
 		PointerData pointer_data_buffer;
 		PointerData pointer_data;
 
+		// Converts the compositor time of input events, in milliseconds and in
+		// microseconds for relative motion.
+		InputTimestampConverter input_clock;
+		InputTimestampConverter relative_motion_clock = InputTimestampConverter(1);
+
 		// Keyboard.
 		struct wl_keyboard *wl_keyboard = nullptr;
 
@@ -1053,7 +1059,7 @@ private:
 	static Ref<InputEventKey> _seat_state_get_key_event(SeatState *p_ss, xkb_keycode_t p_keycode, bool p_pressed);
 	static Ref<InputEventKey> _seat_state_get_unstuck_key_event(SeatState *p_ss, xkb_keycode_t p_keycode, bool p_pressed, Key p_key);
 
-	static void _seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_t p_xkb_keycode, bool p_pressed, bool p_echo = false);
+	static void _seat_state_handle_xkb_keycode(SeatState *p_ss, xkb_keycode_t p_xkb_keycode, bool p_pressed, bool p_echo = false, int64_t p_timestamp_usec = -1);
 
 	static void _wayland_state_update_cursor();
 
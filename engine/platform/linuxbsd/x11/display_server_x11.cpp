@@ -3915,6 +3915,7 @@ void DisplayServerX11::_handle_key_event(WindowID p_window, XKeyEvent *p_event,
 				_get_key_modifier_state(xkeyevent->state, k);
 
 				k->set_window_id(p_window);
+				k->set_timestamp_usec(_get_event_timestamp_usec(xkeyevent->time));
 				k->set_pressed(keypress);
 
 				k->set_keycode(keycode);
@@ -3995,6 +3996,7 @@ void DisplayServerX11::_handle_key_event(WindowID p_window, XKeyEvent *p_event,
 					_get_key_modifier_state(xkeyevent->state, k);
 
 					k->set_window_id(p_window);
+					k->set_timestamp_usec(_get_event_timestamp_usec(xkeyevent->time));
 					k->set_pressed(keypress);
 
 					k->set_keycode(keycode);
@@ -4083,6 +4085,7 @@ void DisplayServerX11::_handle_key_event(WindowID p_window, XKeyEvent *p_event,
 	Ref<InputEventKey> k;
 	k.instantiate();
 	k->set_window_id(p_window);
+	k->set_timestamp_usec(_get_event_timestamp_usec(xkeyevent->time));
 
 	_get_key_modifier_state(xkeyevent->state, k);
 
@@ -4585,10 +4588,32 @@ void DisplayServerX11::_check_pending_events(LocalVector<XEvent> &r_events) {
 			continue;
 		}
 
+		switch (ev.type) {
+			case KeyPress:
+			case KeyRelease:
+				events_clock.add_sample(ev.xkey.time, OS::get_singleton()->get_ticks_usec());
+				break;
+			case ButtonPress:
+			case ButtonRelease:
+				events_clock.add_sample(ev.xbutton.time, OS::get_singleton()->get_ticks_usec());
+				break;
+			case MotionNotify:
+				events_clock.add_sample(ev.xmotion.time, OS::get_singleton()->get_ticks_usec());
+				break;
+			default:
+				break;
+		}
+
 		r_events.push_back(ev);
 	}
 }
 
+int64_t DisplayServerX11::_get_event_timestamp_usec(Time p_time) const {
+	const int64_t timestamp = processed_events_clock.to_ticks_usec(p_time);
+	// The server clock can't be ahead of events that were already received.
+	return timestamp >= 0 ? MIN(timestamp, int64_t(OS::get_singleton()->get_ticks_usec())) : -1;
+}
+
 DisplayServer::WindowID DisplayServerX11::window_get_active_popup() const {
 	const List<WindowID>::Element *E = popup_list.back();
 	if (E) {
@@ -4796,6 +4821,7 @@ void DisplayServerX11::process_events() {
 		MutexLock mutex_lock(events_mutex);
 		events = polled_events;
 		polled_events.clear();
+		processed_events_clock = events_clock;
 	}
 
 	for (uint32_t event_index = 0; event_index < events.size(); ++event_index) {
@@ -5207,6 +5233,7 @@ void DisplayServerX11::process_events() {
 				mb.instantiate();
 
 				mb->set_window_id(window_id);
+				mb->set_timestamp_usec(_get_event_timestamp_usec(event.xbutton.time));
 				_get_key_modifier_state(event.xbutton.state, mb);
 				mb->set_button_index((MouseButton)event.xbutton.button);
 				if (mb->get_button_index() == MouseButton::RIGHT) {
@@ -5407,6 +5434,7 @@ void DisplayServerX11::process_events() {
 				mm.instantiate();
 
 				mm->set_window_id(window_id);
+				mm->set_timestamp_usec(_get_event_timestamp_usec(event.xmotion.time));
 				if (xi.pressure_supported) {
 					mm->set_pressure(xi.pressure);
 				} else {
@@ -33,6 +33,7 @@
 #ifdef X11_ENABLED
 
 #include "core/input/input.h"
+#include "core/input/input_timestamp_converter.h"
 #include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
@@ -378,6 +379,10 @@ class DisplayServerX11 : public DisplayServer {
 	Thread events_thread;
 	SafeFlag events_thread_done;
 	LocalVector<XEvent> polled_events;
+	// Converts the X server time of input events, sampled as they're polled and copied along with them.
+	InputTimestampConverter events_clock;
+	InputTimestampConverter processed_events_clock;
+	int64_t _get_event_timestamp_usec(Time p_time) const;
 	static void _poll_events_thread(void *ud);
 	bool _wait_for_events(int timeout_seconds = 1, int timeout_microseconds = 0) const;
 	void _poll_events();
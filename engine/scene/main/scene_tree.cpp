@@ -347,6 +347,35 @@ void SceneTree::_update_group_order(Group &g) {
 	g.changed = false;
 }
 
+// Resolves the class method called on the nodes of a group once per class, instead of looking
+// it up in ClassDB for every node. Groups usually hold nodes of one or a few classes.
+// Scripts look up their own functions, the class method is used when they don't define it.
+struct GroupCallMethodCache {
+	static constexpr int SIZE = 4;
+
+	const StringName &method;
+	StringName classes[SIZE];
+	MethodBind *method_binds[SIZE] = {};
+	int next = 0;
+
+	_FORCE_INLINE_ void call(Node *p_node, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+		const StringName &class_name = p_node->get_class_name();
+		for (int i = 0; i < SIZE; i++) {
+			if (classes[i] == class_name) {
+				p_node->callp_resolved(method, method_binds[i], p_args, p_argcount, r_error);
+				return;
+			}
+		}
+		classes[next] = class_name;
+		method_binds[next] = ClassDB::get_method(class_name, method);
+		p_node->callp_resolved(method, method_binds[next], p_args, p_argcount, r_error);
+		next = (next + 1) % SIZE;
+	}
+
+	GroupCallMethodCache(const StringName &p_method) :
+			method(p_method) {}
+};
+
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
 	Vector<Node *> nodes_copy;
 
@@ -386,9 +415,12 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_copy = g.nodes;
 	}
 
-	Node **gr_nodes = nodes_copy.ptrw();
+	// Not written to, so the group's nodes are only copied if they change during the call.
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
+	GroupCallMethodCache method_cache(p_function);
+
 	{
 		_THREAD_SAFE_METHOD_
 		nodes_removed_on_group_call_lock++;
@@ -403,7 +435,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
+				method_cache.call(node, p_args, p_argcount, ce);
 				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
@@ -421,7 +453,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
+				method_cache.call(node, p_args, p_argcount, ce);
 				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
@@ -458,7 +490,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 		nodes_copy = g.nodes;
 	}
 
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -520,7 +552,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 
 		nodes_copy = g.nodes;
 	}
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -723,6 +755,10 @@ bool SceneTree::process(double p_time) {
 	// This should happen last because any processing that deletes something beforehand might expect the object to be removed in the same frame.
 	_flush_delete_queue();
 
+	if (process_sampler.is_enabled()) {
+		process_sampler.prune_freed_nodes();
+	}
+
 	_flush_accessibility_changes();
 
 	_call_idle_callbacks();
@@ -1173,6 +1209,7 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 
 	// Make a copy, so if nodes are added/removed from process, this does not break
 	Vector<Node *> nodes_copy = nodes;
+	const bool sampling = process_sampler.is_enabled();
 
 	uint32_t node_count = nodes_copy.size();
 	Node **nodes_ptr = (Node **)nodes_copy.ptr(); // Force cast, pointer will not change.
@@ -1189,6 +1226,8 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			continue;
 		}
 
+		const uint64_t begin_usec = sampling ? OS::get_singleton()->get_ticks_usec() : 0;
+
 		if (p_physics) {
 			if (n->is_physics_processing_internal()) {
 				n->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
@@ -1204,11 +1243,35 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 				n->notification(Node::NOTIFICATION_PROCESS);
 			}
 		}
+
+		if (sampling && !nodes_removed_on_group_call.has(n)) {
+			process_sampler.add_sample(n, p_physics ? SceneTreeProcessSampler::PROCESS_PHYSICS : SceneTreeProcessSampler::PROCESS_IDLE, OS::get_singleton()->get_ticks_usec() - begin_usec);
+		}
 	}
 
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
 }
 
+void SceneTree::set_process_sampling_enabled(bool p_enabled) {
+	process_sampler.set_enabled(p_enabled);
+}
+
+bool SceneTree::is_process_sampling_enabled() const {
+	return process_sampler.is_enabled();
+}
+
+Dictionary SceneTree::get_process_sampling_report() const {
+	return process_sampler.get_report();
+}
+
+Error SceneTree::save_process_sampling_report(const String &p_path) const {
+	return process_sampler.save_report(p_path);
+}
+
+void SceneTree::clear_process_samples() {
+	process_sampler.clear();
+}
+
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
 	Node::current_process_thread_group = local_process_group_cache[p_index]->owner;
 	_process_group(local_process_group_cache[p_index], p_physics);
@@ -1423,7 +1486,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_cal
 	}
 
 	int gr_node_count = nodes_copy.size();
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 
 	{
 		_THREAD_SAFE_METHOD_
@@ -1939,6 +2002,12 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_multiplayer_poll_enabled", "enabled"), &SceneTree::set_multiplayer_poll_enabled);
 	ClassDB::bind_method(D_METHOD("is_multiplayer_poll_enabled"), &SceneTree::is_multiplayer_poll_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_process_sampling_enabled", "enabled"), &SceneTree::set_process_sampling_enabled);
+	ClassDB::bind_method(D_METHOD("is_process_sampling_enabled"), &SceneTree::is_process_sampling_enabled);
+	ClassDB::bind_method(D_METHOD("get_process_sampling_report"), &SceneTree::get_process_sampling_report);
+	ClassDB::bind_method(D_METHOD("save_process_sampling_report", "path"), &SceneTree::save_process_sampling_report);
+	ClassDB::bind_method(D_METHOD("clear_process_samples"), &SceneTree::clear_process_samples);
+
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_accept_quit"), "set_auto_accept_quit", "is_auto_accept_quit");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quit_on_go_back"), "set_quit_on_go_back", "is_quit_on_go_back");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "debug_collisions_hint"), "set_debug_collisions_hint", "is_debugging_collisions_hint");
@@ -1949,6 +2018,7 @@ void SceneTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "current_scene", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "set_current_scene", "get_current_scene");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_root");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multiplayer_poll"), "set_multiplayer_poll_enabled", "is_multiplayer_poll_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "process_sampling_enabled"), "set_process_sampling_enabled", "is_process_sampling_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "physics_interpolation"), "set_physics_interpolation_enabled", "is_physics_interpolation_enabled");
 
 	ADD_SIGNAL(MethodInfo("tree_changed"));
@@ -2034,6 +2104,9 @@ SceneTree::SceneTree() {
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
 
+	process_sampler.set_window_size(GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/process_sampling/window_size", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"), SceneTreeProcessSampler::DEFAULT_WINDOW_SIZE));
+	process_sampler.set_enabled(GLOBAL_DEF("debug/settings/process_sampling/enabled", false));
+
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
 
@@ -35,6 +35,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/self_list.h"
 #include "scene/main/scene_tree_fti.h"
+#include "scene/main/scene_tree_process_sampler.h"
 
 #include <cstdlib>
 
@@ -118,6 +119,7 @@ private:
 	ProcessGroup default_process_group;
 
 	bool node_threading_disabled = false;
+	SceneTreeProcessSampler process_sampler;
 
 	struct Group {
 		Vector<Node *> nodes;
@@ -469,6 +471,13 @@ public:
 #endif
 
 	SceneTreeFTI &get_scene_tree_fti() { return scene_tree_fti; }
+	SceneTreeProcessSampler &get_process_sampler() { return process_sampler; }
+
+	void set_process_sampling_enabled(bool p_enabled);
+	bool is_process_sampling_enabled() const;
+	Dictionary get_process_sampling_report() const;
+	Error save_process_sampling_report(const String &p_path) const;
+	void clear_process_samples();
 
 	SceneTree();
 	~SceneTree();
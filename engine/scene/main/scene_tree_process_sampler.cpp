@@ -0,0 +1,233 @@
+/**************************************************************************/
+/*  scene_tree_process_sampler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_tree_process_sampler.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/object/script_language.h"
+#include "scene/main/node.h"
+
+void SceneTreeProcessSampler::Window::add(uint64_t p_usec, uint32_t p_window_size) {
+	const uint32_t usec = uint32_t(MIN(p_usec, uint64_t(UINT32_MAX)));
+	if (samples.size() < p_window_size) {
+		samples.push_back(usec);
+	} else {
+		samples[next] = usec;
+		next = (next + 1) % p_window_size;
+	}
+	calls++;
+	total_usec += p_usec;
+	peak_usec = MAX(peak_usec, p_usec);
+}
+
+SceneTreeProcessSampler::Stats SceneTreeProcessSampler::Window::get_stats() const {
+	Stats stats;
+	stats.calls = calls;
+	stats.total_usec = total_usec;
+	stats.peak_usec = peak_usec;
+	if (samples.is_empty()) {
+		return stats;
+	}
+
+	LocalVector<uint32_t> sorted = samples;
+	sorted.sort();
+
+	uint64_t sum = 0;
+	for (uint32_t sample : sorted) {
+		sum += sample;
+	}
+	stats.mean_usec = double(sum) / sorted.size();
+	// Nearest-rank percentile.
+	stats.p99_usec = sorted[MAX(1u, (sorted.size() * 99 + 99) / 100) - 1];
+	stats.max_usec = sorted[sorted.size() - 1];
+	return stats;
+}
+
+void SceneTreeProcessSampler::set_enabled(bool p_enabled) {
+	enabled = p_enabled;
+}
+
+void SceneTreeProcessSampler::set_window_size(uint32_t p_size) {
+	ERR_FAIL_COND(p_size == 0);
+	MutexLock lock(mutex);
+	window_size = p_size;
+	// The ring buffers assume a fixed size, so start over.
+	nodes.clear();
+	scripts.clear();
+}
+
+String SceneTreeProcessSampler::_get_script_key(const Node *p_node) {
+	Ref<Script> script = p_node->get_script();
+	if (script.is_null()) {
+		return p_node->get_class();
+	}
+	return script->get_path().is_empty() ? script->get_class() : script->get_path();
+}
+
+void SceneTreeProcessSampler::add_sample(Node *p_node, ProcessType p_type, uint64_t p_usec) {
+	ERR_FAIL_INDEX(p_type, PROCESS_MAX);
+	MutexLock lock(mutex);
+
+	NodeEntry *entry = nodes.getptr(p_node->get_instance_id());
+	if (!entry) {
+		entry = &nodes.insert(p_node->get_instance_id(), NodeEntry())->value;
+		entry->path = String(p_node->get_path());
+		entry->script = _get_script_key(p_node);
+		entry->script_entry = &scripts[entry->script];
+	}
+
+	entry->windows[p_type].add(p_usec, window_size);
+	entry->script_entry->windows[p_type].add(p_usec, window_size);
+}
+
+void SceneTreeProcessSampler::prune_freed_nodes() {
+	MutexLock lock(mutex);
+	if (nodes.size() <= MAX_NODES) {
+		return;
+	}
+
+	LocalVector<ObjectID> freed;
+	for (const KeyValue<ObjectID, NodeEntry> &E : nodes) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed.push_back(E.key);
+		}
+	}
+	for (const ObjectID &id : freed) {
+		nodes.erase(id);
+	}
+}
+
+void SceneTreeProcessSampler::clear() {
+	MutexLock lock(mutex);
+	nodes.clear();
+	scripts.clear();
+}
+
+bool SceneTreeProcessSampler::get_node_stats(ObjectID p_node, ProcessType p_type, Stats &r_stats) const {
+	ERR_FAIL_INDEX_V(p_type, PROCESS_MAX, false);
+	MutexLock lock(mutex);
+	const NodeEntry *entry = nodes.getptr(p_node);
+	if (!entry) {
+		return false;
+	}
+	r_stats = entry->windows[p_type].get_stats();
+	return true;
+}
+
+bool SceneTreeProcessSampler::get_script_stats(const String &p_script, ProcessType p_type, Stats &r_stats) const {
+	ERR_FAIL_INDEX_V(p_type, PROCESS_MAX, false);
+	MutexLock lock(mutex);
+	const ScriptEntry *entry = scripts.getptr(p_script);
+	if (!entry) {
+		return false;
+	}
+	r_stats = entry->windows[p_type].get_stats();
+	return true;
+}
+
+Dictionary SceneTreeProcessSampler::_windows_to_dict(const Window *p_windows) {
+	static const char *names[PROCESS_MAX] = { "process", "physics_process" };
+	Dictionary dict;
+	for (int i = 0; i < PROCESS_MAX; i++) {
+		const Stats stats = p_windows[i].get_stats();
+		if (stats.calls == 0) {
+			continue;
+		}
+		Dictionary d;
+		d["calls"] = stats.calls;
+		d["total_usec"] = stats.total_usec;
+		d["peak_usec"] = stats.peak_usec;
+		d["mean_usec"] = stats.mean_usec;
+		d["p99_usec"] = stats.p99_usec;
+		d["max_usec"] = stats.max_usec;
+		dict[names[i]] = d;
+	}
+	return dict;
+}
+
+Dictionary SceneTreeProcessSampler::get_report() const {
+	struct Item {
+		uint64_t total_usec = 0;
+		Dictionary dict;
+	};
+	struct ItemSort {
+		bool operator()(const Item &p_a, const Item &p_b) const {
+			return p_a.total_usec > p_b.total_usec;
+		}
+	};
+
+	LocalVector<Item> node_items;
+	LocalVector<Item> script_items;
+	{
+		MutexLock lock(mutex);
+		for (const KeyValue<ObjectID, NodeEntry> &E : nodes) {
+			Item item;
+			item.total_usec = E.value.windows[PROCESS_IDLE].total_usec + E.value.windows[PROCESS_PHYSICS].total_usec;
+			item.dict = _windows_to_dict(E.value.windows);
+			item.dict["path"] = E.value.path;
+			item.dict["script"] = E.value.script;
+			node_items.push_back(item);
+		}
+		for (const KeyValue<String, ScriptEntry> &E : scripts) {
+			Item item;
+			item.total_usec = E.value.windows[PROCESS_IDLE].total_usec + E.value.windows[PROCESS_PHYSICS].total_usec;
+			item.dict = _windows_to_dict(E.value.windows);
+			item.dict["script"] = E.key;
+			script_items.push_back(item);
+		}
+	}
+
+	// Most expensive first.
+	node_items.sort_custom<ItemSort>();
+	script_items.sort_custom<ItemSort>();
+
+	Array node_array;
+	for (const Item &item : node_items) {
+		node_array.push_back(item.dict);
+	}
+	Array script_array;
+	for (const Item &item : script_items) {
+		script_array.push_back(item.dict);
+	}
+
+	Dictionary report;
+	report["window_size"] = window_size;
+	report["nodes"] = node_array;
+	report["scripts"] = script_array;
+	return report;
+}
+
+Error SceneTreeProcessSampler::save_report(const String &p_path) const {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_WRITE, vformat("Can't write process sampling report to \"%s\".", p_path));
+	f->store_string(JSON::stringify(get_report(), "\t", false));
+	return OK;
+}
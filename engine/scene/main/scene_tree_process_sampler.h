@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  scene_tree_process_sampler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object_id.h"
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+
+class Node;
+
+// Attributes `_process` and `_physics_process` time to individual nodes and to their scripts.
+// Each keeps a ring buffer of its most recent samples, and the statistics are only computed
+// when queried, so sampling costs two clock reads and a short lock per processed node.
+
+class SceneTreeProcessSampler {
+public:
+	enum ProcessType {
+		PROCESS_IDLE,
+		PROCESS_PHYSICS,
+		PROCESS_MAX,
+	};
+
+	static constexpr uint32_t DEFAULT_WINDOW_SIZE = 120;
+	// Once more than this many nodes are tracked, entries of freed nodes are dropped at the end
+	// of the frame. Their time is still accounted for in the per-script statistics.
+	static constexpr uint32_t MAX_NODES = 4096;
+
+	struct Stats {
+		uint64_t calls = 0;
+		uint64_t total_usec = 0;
+		uint64_t peak_usec = 0;
+		// Over the samples currently in the ring buffer.
+		double mean_usec = 0.0;
+		uint32_t p99_usec = 0;
+		uint32_t max_usec = 0;
+	};
+
+private:
+	struct Window {
+		LocalVector<uint32_t> samples;
+		uint32_t next = 0;
+		uint64_t calls = 0;
+		uint64_t total_usec = 0;
+		uint64_t peak_usec = 0;
+
+		void add(uint64_t p_usec, uint32_t p_window_size);
+		Stats get_stats() const;
+	};
+
+	struct ScriptEntry {
+		Window windows[PROCESS_MAX];
+	};
+
+	struct NodeEntry {
+		String path;
+		String script;
+		ScriptEntry *script_entry = nullptr; // HashMap elements don't move, and both maps are cleared together.
+		Window windows[PROCESS_MAX];
+	};
+
+	bool enabled = false;
+	uint32_t window_size = DEFAULT_WINDOW_SIZE;
+
+	mutable BinaryMutex mutex;
+	HashMap<ObjectID, NodeEntry> nodes;
+	HashMap<String, ScriptEntry> scripts;
+
+	static String _get_script_key(const Node *p_node);
+	static Dictionary _windows_to_dict(const Window *p_windows);
+
+public:
+	void set_enabled(bool p_enabled);
+	bool is_enabled() const { return enabled; }
+
+	void set_window_size(uint32_t p_size);
+	uint32_t get_window_size() const { return window_size; }
+
+	void add_sample(Node *p_node, ProcessType p_type, uint64_t p_usec);
+	// Called by the SceneTree once per frame, a scan of the tracked nodes when there are too many.
+	void prune_freed_nodes();
+	void clear();
+
+	bool get_node_stats(ObjectID p_node, ProcessType p_type, Stats &r_stats) const;
+	bool get_script_stats(const String &p_script, ProcessType p_type, Stats &r_stats) const;
+
+	Dictionary get_report() const;
+	Error save_report(const String &p_path) const;
+};
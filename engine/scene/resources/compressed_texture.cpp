@@ -38,7 +38,7 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
 
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	Ref<FileAccess> f = ResourceLoader::open_pipelined(p_path);
 	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, vformat("Unable to open file: %s.", p_path));
 
 	uint8_t header[4];
@@ -141,14 +141,17 @@ Error CompressedTexture2D::load(const String &p_path) {
 		return err;
 	}
 
-	if (texture.is_valid()) {
-		RID new_texture = RS::get_singleton()->texture_2d_create(image);
-		RS::get_singleton()->texture_replace(texture, new_texture);
-	} else {
-		texture = RS::get_singleton()->texture_2d_create(image);
-	}
-	if (lw || lh) {
-		RS::get_singleton()->texture_set_size_override(texture, lw, lh);
+	{
+		ResourceLoader::PipelineStageScope stage_scope(ResourceLoader::PIPELINE_STAGE_UPLOAD);
+		if (texture.is_valid()) {
+			RID new_texture = RS::get_singleton()->texture_2d_create(image);
+			RS::get_singleton()->texture_replace(texture, new_texture);
+		} else {
+			texture = RS::get_singleton()->texture_2d_create(image);
+		}
+		if (lw || lh) {
+			RS::get_singleton()->texture_set_size_override(texture, lw, lh);
+		}
 	}
 
 	w = lw;
@@ -464,6 +467,7 @@ CompressedTexture2D::~CompressedTexture2D() {
 }
 
 Ref<Resource> ResourceFormatLoaderCompressedTexture2D::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
+	ResourceLoader::PipelineStageScope stage_scope(ResourceLoader::PIPELINE_STAGE_PARSE);
 	Ref<CompressedTexture2D> st;
 	st.instantiate();
 	Error err = st->load(p_path);
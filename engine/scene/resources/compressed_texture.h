@@ -118,6 +118,7 @@ public:
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
 	virtual bool handles_type(const String &p_type) const override;
 	virtual String get_resource_type(const String &p_path) const override;
+	virtual bool uses_pipelined_io() const override { return true; }
 };
 
 class CompressedTextureLayered : public TextureLayered {
@@ -150,6 +150,122 @@ static Node *_find_node_by_id(Node *p_owner, Node *p_node, int32_t p_id) {
 	return nullptr;
 }
 
+void SceneState::_invalidate_instantiation_plan() {
+	MutexLock lock(plan_mutex);
+	plan_dirty = true;
+}
+
+void SceneState::_update_instantiation_plan() const {
+	if (!plan_dirty) {
+		return;
+	}
+	plan_dirty = false;
+
+	plan.nodes.clear();
+	plan.properties.clear();
+	plan.recyclable = false;
+
+	int nc = nodes.size();
+	if (nc == 0) {
+		return;
+	}
+
+	const int sname_count = names.size();
+	const int prop_count = variants.size();
+	bool recyclable = true;
+
+	plan.nodes.resize(nc);
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodeStep &step = plan.nodes[i];
+		step.first_property = plan.properties.size();
+		plan.properties.resize(step.first_property + n.properties.size());
+
+		// Only nodes created by this scene can use the plan, instances and inherited nodes come from other scenes.
+		bool own_node = n.instance < 0 && n.type != TYPE_INSTANTIATED && !(i == 0 && base_scene_idx >= 0);
+		if (own_node && n.type >= 0 && n.type < sname_count && ClassDB::is_parent_class(names[n.type], SNAME("Node"))) {
+			step.creation_func = ClassDB::get_native_creation_func(names[n.type]);
+		}
+		if (!step.creation_func) {
+			recyclable = false;
+			continue;
+		}
+		if (i > 0 && ((n.parent & FLAG_ID_IS_PATH) || (n.owner >= 0 && (n.owner & FLAG_ID_IS_PATH)))) {
+			recyclable = false;
+		}
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			if (prop.name & FLAG_PATH_PROPERTY_IS_NODE) {
+				// Resolved against the other nodes once they all exist.
+				recyclable = false;
+				continue;
+			}
+			if (prop.name < 0 || prop.name >= sname_count || prop.value < 0 || prop.value >= prop_count) {
+				// Reported by `instantiate()`.
+				recyclable = false;
+				continue;
+			}
+
+			const StringName &prop_name = names[prop.name];
+			if (prop_name == CoreStringName(script)) {
+				continue;
+			}
+
+			InstantiationPlan::PropertyKind kind = InstantiationPlan::PROPERTY_VALUE;
+			const Variant &value = variants[prop.value];
+			if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				// Typed collections are converted to the type of the current value.
+				kind = InstantiationPlan::PROPERTY_GENERIC;
+				recyclable = false;
+			} else if (value.get_type() == Variant::OBJECT && value.get_validated_object()) {
+				Resource *res = Object::cast_to<Resource>(value.get_validated_object());
+				if (res && !Object::cast_to<MissingResource>(res)) {
+					kind = InstantiationPlan::PROPERTY_RESOURCE;
+				} else {
+					kind = InstantiationPlan::PROPERTY_GENERIC;
+				}
+			}
+
+			if (kind == InstantiationPlan::PROPERTY_GENERIC) {
+				continue;
+			}
+
+			InstantiationPlan::PropertyStep &prop_step = plan.properties[step.first_property + j];
+			prop_step.setter = ClassDB::get_property_setter_bind(names[n.type], prop_name, &prop_step.index);
+			prop_step.kind = kind;
+		}
+	}
+
+	plan.recyclable = recyclable;
+}
+
+void SceneState::_set_planned_property(Node *p_node, const InstantiationPlan::PropertyStep &p_step, const Variant &p_value) {
+	// Same as `ClassDB::set_property()`, with the setter already resolved.
+	Callable::CallError ce;
+	if (p_step.index >= 0) {
+		const Variant index = p_step.index;
+		const Variant *args[2] = { &index, &p_value };
+		p_step.setter->call(p_node, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		p_step.setter->call(p_node, args, 1, ce);
+	}
+}
+
+bool SceneState::_can_use_planned_setter(const Node *p_node, const InstantiationPlan::PropertyStep &p_step, const Variant &p_value) {
+	if (!p_step.setter || p_node->get_script_instance()) {
+		// Scripts may override the property.
+		return false;
+	}
+	if (p_step.kind == InstantiationPlan::PROPERTY_RESOURCE) {
+		// Resources local to scene are duplicated per instance.
+		const Resource *res = Object::cast_to<Resource>(p_value.get_validated_object());
+		return res && !res->is_local_to_scene();
+	}
+	return p_step.kind == InstantiationPlan::PROPERTY_VALUE;
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
@@ -197,8 +313,17 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	bool deep_search_warned = false;
 
+	// The editor needs every property to go through `Object::set()`, so only runtime instantiation uses the plan.
+	const InstantiationPlan *active_plan = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		MutexLock lock(plan_mutex);
+		_update_instantiation_plan();
+		active_plan = &plan;
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
+		const InstantiationPlan::NodeStep *node_plan = (active_plan && active_plan->nodes[i].creation_func) ? &active_plan->nodes[i] : nullptr;
 
 		Node *parent = nullptr;
 		String old_parent_path;
@@ -313,7 +438,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			}
 		} else {
 			// Node belongs to this scene and must be created.
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+			Object *obj = node_plan ? node_plan->creation_func(true) : ClassDB::instantiate(snames[n.type]);
 
 			node = Object::cast_to<Node>(obj);
 
@@ -371,6 +496,14 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].value, prop_count, nullptr);
 
+					if (node_plan) {
+						const InstantiationPlan::PropertyStep &prop_step = active_plan->properties[node_plan->first_property + j];
+						if (_can_use_planned_setter(node, prop_step, props[nprops[j].value])) {
+							_set_planned_property(node, prop_step, props[nprops[j].value]);
+							continue;
+						}
+					}
+
 					if (nprops[j].name & FLAG_PATH_PROPERTY_IS_NODE) {
 						if (!Engine::get_singleton()->is_editor_hint() && node->get_scene_instance_load_placeholder()) {
 							// We cannot know if the referenced nodes exist yet, so instead of deferring, we write the NodePaths directly.
@@ -698,6 +831,93 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::reset_instance(Node *p_root) const {
+	ERR_FAIL_NULL_V(p_root, false);
+
+	{
+		MutexLock lock(plan_mutex);
+		_update_instantiation_plan();
+		if (!plan.recyclable) {
+			return false;
+		}
+	}
+
+	int nc = nodes.size();
+	const NodeData *nd = nodes.ptr();
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+
+	// Map the instance back to the scene nodes, and make sure nothing was added, removed or replaced.
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+	int *child_counts = (int *)alloca(sizeof(int) * nc);
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nd[i];
+		Node *node = p_root;
+		if (i > 0) {
+			ERR_FAIL_INDEX_V(n.parent, i, false);
+			node = ret_nodes[n.parent]->_get_child_by_name(snames[n.name]);
+			if (!node) {
+				return false;
+			}
+			child_counts[n.parent]++;
+			if (n.owner >= 0 && node->get_owner() != ret_nodes[n.owner]) {
+				return false;
+			}
+		}
+		if (node->get_class_name() != snames[n.type]) {
+			return false;
+		}
+		ret_nodes[i] = node;
+		child_counts[i] = 0;
+	}
+	for (int i = 0; i < nc; i++) {
+		if (ret_nodes[i]->get_child_count(false) != child_counts[i]) {
+			return false;
+		}
+	}
+
+	p_root->_set_name_nocheck(snames[nd[0].name]);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nd[i];
+		Node *node = ret_nodes[i];
+		const InstantiationPlan::NodeStep &node_plan = plan.nodes[i];
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			const StringName &prop_name = snames[prop.name];
+			const Variant &value = props[prop.value];
+			if (prop_name == CoreStringName(script)) {
+				// Keep the script instance, resetting its state is up to the script.
+				continue;
+			}
+
+			const InstantiationPlan::PropertyStep &prop_step = plan.properties[node_plan.first_property + j];
+			if (_can_use_planned_setter(node, prop_step, value)) {
+				_set_planned_property(node, prop_step, value);
+				continue;
+			}
+
+			if (value.get_type() == Variant::OBJECT) {
+				const Resource *res = Object::cast_to<Resource>(value.get_validated_object());
+				if (res && (res->is_local_to_scene() || Object::cast_to<MissingResource>(res))) {
+					// The instance keeps its own copy.
+					continue;
+				}
+			}
+			node->set(prop_name, value);
+		}
+
+		for (int j = 0; j < n.groups.size(); j++) {
+			node->add_to_group(snames[n.groups[j]], true);
+		}
+
+		node->request_ready();
+	}
+
+	return true;
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &p_resources_local_to_scenes, Node *p_node, const StringName p_sname, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1443,6 +1663,7 @@ void SceneState::clear() {
 	ids.clear();
 	id_paths.clear();
 	base_scene_idx = -1;
+	_invalidate_instantiation_plan();
 }
 
 Error SceneState::copy_from(const Ref<SceneState> &p_scene_state) {
@@ -1675,6 +1896,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	const Vector<int> sconns = p_dictionary["conns"];
 	ERR_FAIL_COND(sconns.size() < conn_count);
 
+	_invalidate_instantiation_plan();
+
 	Vector<String> snames = p_dictionary["names"];
 	if (snames.size()) {
 		int namecount = snames.size();
@@ -2296,11 +2519,13 @@ Vector<Ref<Resource>> SceneState::get_sub_resources() {
 
 int SceneState::add_name(const StringName &p_name) {
 	names.push_back(p_name);
+	_invalidate_instantiation_plan();
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
 	variants.push_back(p_value);
+	_invalidate_instantiation_plan();
 	return variants.size() - 1;
 }
 
@@ -2322,6 +2547,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nodes.push_back(nd);
 
 	ids.push_back(p_unique_id);
+	_invalidate_instantiation_plan();
 
 	return nodes.size() - 1;
 }
@@ -2338,6 +2564,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_instantiation_plan();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -2349,6 +2576,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_invalidate_instantiation_plan();
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, int p_unbinds, const Vector<int> &p_binds) {
@@ -2461,6 +2689,7 @@ SceneState::SceneState() {
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
+	clear_recycle_pool();
 	state->set_bundled_scene(p_scene);
 }
 
@@ -2469,10 +2698,12 @@ Dictionary PackedScene::_get_bundled_scene() const {
 }
 
 Error PackedScene::pack(Node *p_scene) {
+	clear_recycle_pool();
 	return state->pack(p_scene);
 }
 
 void PackedScene::clear() {
+	clear_recycle_pool();
 	state->clear();
 }
 
@@ -2495,6 +2726,7 @@ void PackedScene::reload_from_file() {
 	// This has a side-effect to clear s->state
 	copy_from(s);
 	// Then, we copy the backed-up loaded_state to state
+	clear_recycle_pool();
 	state->copy_from(loaded_state);
 }
 
@@ -2507,6 +2739,22 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	ERR_FAIL_COND_V_MSG(p_edit_state != GEN_EDIT_STATE_DISABLED, nullptr, "Edit state is only for editors, does not work without tools compiled.");
 #endif
 
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED) {
+		Node *recycled = nullptr;
+		{
+			MutexLock lock(recycle_mutex);
+			while (!recycled && !recycle_pool.is_empty()) {
+				recycled = ObjectDB::get_instance<Node>(recycle_pool[recycle_pool.size() - 1]);
+				recycle_pool.remove_at(recycle_pool.size() - 1);
+			}
+		}
+		if (recycled) {
+			// Already reset by `recycle()`.
+			recycled->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
+			return recycled;
+		}
+	}
+
 	Node *s = state->instantiate((SceneState::GenEditState)p_edit_state);
 	if (!s) {
 		return nullptr;
@@ -2525,7 +2773,84 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+void PackedScene::set_recycle_pool_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+	recycle_pool_size = p_size;
+
+	LocalVector<ObjectID> excess;
+	{
+		MutexLock lock(recycle_mutex);
+		while ((int)recycle_pool.size() > recycle_pool_size) {
+			excess.push_back(recycle_pool[recycle_pool.size() - 1]);
+			recycle_pool.remove_at(recycle_pool.size() - 1);
+		}
+	}
+	for (const ObjectID &E : excess) {
+		Node *node = ObjectDB::get_instance<Node>(E);
+		if (node) {
+			memdelete(node);
+		}
+	}
+}
+
+int PackedScene::get_recycle_pool_size() const {
+	return recycle_pool_size;
+}
+
+bool PackedScene::recycle(Node *p_node) {
+	ERR_FAIL_NULL_V(p_node, false);
+	ERR_FAIL_COND_V_MSG(p_node->get_parent(), false, "The node must be removed from its parent before it can be recycled.");
+
+	if (recycle_pool_size == 0 || p_node->is_queued_for_deletion()) {
+		return false;
+	}
+	if (p_node->get_scene_file_path() != (is_built_in() ? String() : get_path())) {
+		// Not an instance of this scene.
+		return false;
+	}
+
+	{
+		MutexLock lock(recycle_mutex);
+		ERR_FAIL_COND_V_MSG(recycle_pool.has(p_node->get_instance_id()), false, "The node was already recycled.");
+		if ((int)recycle_pool.size() >= recycle_pool_size) {
+			return false;
+		}
+	}
+
+	if (!state->reset_instance(p_node)) {
+		return false;
+	}
+
+	MutexLock lock(recycle_mutex);
+	if ((int)recycle_pool.size() >= recycle_pool_size) {
+		return false;
+	}
+	recycle_pool.push_back(p_node->get_instance_id());
+	return true;
+}
+
+int PackedScene::get_recycled_count() const {
+	MutexLock lock(recycle_mutex);
+	return recycle_pool.size();
+}
+
+void PackedScene::clear_recycle_pool() {
+	LocalVector<ObjectID> pool;
+	{
+		MutexLock lock(recycle_mutex);
+		pool = recycle_pool;
+		recycle_pool.clear();
+	}
+	for (const ObjectID &E : pool) {
+		Node *node = ObjectDB::get_instance<Node>(E);
+		if (node) {
+			memdelete(node);
+		}
+	}
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	clear_recycle_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2534,6 +2859,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	clear_recycle_pool();
 	state.instantiate();
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2615,6 +2941,11 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
+	ClassDB::bind_method(D_METHOD("set_recycle_pool_size", "size"), &PackedScene::set_recycle_pool_size);
+	ClassDB::bind_method(D_METHOD("get_recycle_pool_size"), &PackedScene::get_recycle_pool_size);
+	ClassDB::bind_method(D_METHOD("recycle", "node"), &PackedScene::recycle);
+	ClassDB::bind_method(D_METHOD("get_recycled_count"), &PackedScene::get_recycled_count);
+	ClassDB::bind_method(D_METHOD("clear_recycle_pool"), &PackedScene::clear_recycle_pool);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "_bundled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_INTERNAL), "_set_bundled_scene", "_get_bundled_scene");
 
@@ -2627,3 +2958,7 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state.instantiate();
 }
+
+PackedScene::~PackedScene() {
+	clear_recycle_pool();
+}
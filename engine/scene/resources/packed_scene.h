@@ -90,6 +90,41 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Construction plan compiled from `nodes` the first time the scene is instantiated.
+	// It resolves the constructors of built-in node classes and the setters of their
+	// stored properties, so instantiating a scene repeatedly skips the name lookups.
+	struct InstantiationPlan {
+		enum PropertyKind {
+			PROPERTY_GENERIC, // Goes through `Object::set()` and the usual special cases.
+			PROPERTY_VALUE, // Plain value, set directly through the resolved setter.
+			PROPERTY_RESOURCE, // Resource, set directly unless it is local to scene.
+		};
+
+		struct PropertyStep {
+			MethodBind *setter = nullptr;
+			int index = -1;
+			PropertyKind kind = PROPERTY_GENERIC;
+		};
+
+		struct NodeStep {
+			Object *(*creation_func)(bool) = nullptr; // `nullptr` if the node can't be created from the plan.
+			uint32_t first_property = 0;
+		};
+
+		LocalVector<NodeStep> nodes;
+		LocalVector<PropertyStep> properties;
+		bool recyclable = false; // Whether instances can be reset in place by `reset_instance()`.
+	};
+
+	mutable InstantiationPlan plan;
+	mutable bool plan_dirty = true;
+	mutable BinaryMutex plan_mutex;
+
+	void _update_instantiation_plan() const;
+	void _invalidate_instantiation_plan();
+	static bool _can_use_planned_setter(const Node *p_node, const InstantiationPlan::PropertyStep &p_step, const Variant &p_value);
+	static void _set_planned_property(Node *p_node, const InstantiationPlan::PropertyStep &p_step, const Variant &p_value);
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map, HashSet<int32_t> &ids_saved);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -159,6 +194,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
+	bool reset_instance(Node *p_root) const;
 
 	Array setup_resources_in_array(Array &array_to_scan, const SceneState::NodeData &n, HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &p_resources_local_to_scenes, Node *node, const StringName sname, int i, Node **ret_nodes, SceneState::GenEditState p_edit_state) const;
 	Dictionary setup_resources_in_dictionary(Dictionary &p_dictionary_to_scan, const SceneState::NodeData &p_n, HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &p_resources_local_to_scenes, Node *p_node, const StringName p_sname, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const;
@@ -247,6 +283,11 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	int recycle_pool_size = 0;
+	// Nodes can be freed by their owner while pooled, so they're checked before being reused.
+	mutable LocalVector<ObjectID> recycle_pool;
+	mutable BinaryMutex recycle_mutex;
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -270,6 +311,12 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	void set_recycle_pool_size(int p_size);
+	int get_recycle_pool_size() const;
+	bool recycle(Node *p_node);
+	int get_recycled_count() const;
+	void clear_recycle_pool();
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -289,6 +336,7 @@ public:
 	Ref<SceneState> get_state() const;
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -3571,6 +3571,9 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_render_loop_enabled", "enabled"), &RenderingServer::set_render_loop_enabled);
 
 	ClassDB::bind_method(D_METHOD("get_frame_setup_time_cpu"), &RenderingServer::get_frame_setup_time_cpu);
+	ClassDB::bind_method(D_METHOD("set_late_latch_source", "source", "global_parameter"), &RenderingServer::set_late_latch_source);
+	ClassDB::bind_method(D_METHOD("get_input_to_present_time"), &RenderingServer::get_input_to_present_time);
+	ClassDB::bind_method(D_METHOD("get_late_latch_to_present_time"), &RenderingServer::get_late_latch_to_present_time);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "render_loop_enabled"), "set_render_loop_enabled", "is_render_loop_enabled");
 
@@ -1838,6 +1838,10 @@ public:
 
 	virtual double get_frame_setup_time_cpu() const = 0;
 
+	virtual void set_late_latch_source(const Callable &p_source, const StringName &p_global_parameter) = 0;
+	virtual double get_input_to_present_time() const = 0;
+	virtual double get_late_latch_to_present_time() const = 0;
+
 	virtual void gi_set_use_half_resolution(bool p_enable) = 0;
 
 	/* TESTING */
@@ -30,6 +30,7 @@
 
 #include "rendering_server_default.h"
 
+#include "core/input/input.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
 #include "renderer_canvas_cull.h"
@@ -66,7 +67,7 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 	frame_drawn_callbacks.push_back(p_callable);
 }
 
-void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step, uint64_t p_input_ticks_usec) {
 	GodotProfileZoneGroupedFirst(_profile_zone, "rasterizer->begin_frame");
 	RSG::rasterizer->begin_frame(frame_step);
 
@@ -98,6 +99,15 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 	GodotProfileZoneGrouped(_profile_zone, "scene->render_probes");
 	RSG::scene->render_probes();
 
+	uint64_t late_latch_ticks_usec = 0;
+	if (late_latch_source.is_valid()) {
+		// Sample the time source as late as possible, right before the viewports record their commands.
+		GodotProfileZoneGrouped(_profile_zone, "late_latch");
+		late_latch_ticks_usec = OS::get_singleton()->get_ticks_usec();
+		RSG::material_storage->global_shader_parameter_set(late_latch_global_parameter, late_latch_source.call());
+		RSG::utilities->update_dirty_resources();
+	}
+
 	GodotProfileZoneGrouped(_profile_zone, "viewport->draw_viewports");
 	RSG::viewport->draw_viewports(p_swap_buffers);
 
@@ -107,6 +117,14 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 	GodotProfileZoneGrouped(_profile_zone, "rasterizer->end_frame");
 	RSG::rasterizer->end_frame(p_swap_buffers);
 
+	if (p_swap_buffers) {
+		uint64_t present_ticks_usec = OS::get_singleton()->get_ticks_usec();
+		if (p_input_ticks_usec != 0) {
+			input_to_present_time = double(present_ticks_usec - p_input_ticks_usec) / 1000.0;
+		}
+		late_latch_to_present_time = late_latch_ticks_usec != 0 ? double(present_ticks_usec - late_latch_ticks_usec) / 1000.0 : 0.0;
+	}
+
 #ifndef XR_DISABLED
 	if (xr_server != nullptr) {
 		GodotProfileZone("xr_server->end_frame");
@@ -226,6 +244,28 @@ double RenderingServerDefault::get_frame_setup_time_cpu() const {
 	return frame_setup_time;
 }
 
+void RenderingServerDefault::_set_late_latch_source(const Callable &p_source, const StringName &p_global_parameter) {
+	late_latch_source = p_source;
+	late_latch_global_parameter = p_global_parameter;
+}
+
+void RenderingServerDefault::set_late_latch_source(const Callable &p_source, const StringName &p_global_parameter) {
+	ERR_FAIL_COND_MSG(p_source.is_valid() && p_global_parameter == StringName(), "A global shader parameter name is required to use a late-latch source.");
+	if (create_thread) {
+		command_queue.push(this, &RenderingServerDefault::_set_late_latch_source, p_source, p_global_parameter);
+	} else {
+		_set_late_latch_source(p_source, p_global_parameter);
+	}
+}
+
+double RenderingServerDefault::get_input_to_present_time() const {
+	return input_to_present_time;
+}
+
+double RenderingServerDefault::get_late_latch_to_present_time() const {
+	return late_latch_to_present_time;
+}
+
 bool RenderingServerDefault::has_changed() const {
 	return changes > 0;
 }
@@ -438,10 +478,12 @@ void RenderingServerDefault::draw(bool p_present, double frame_step) {
 	// Needs to be done before changes is reset to 0, to not force the editor to redraw.
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 	changes = 0;
+	// Input is parsed on the main thread, so take the oldest event of this frame before handing the frame over.
+	uint64_t input_ticks_usec = Input::get_singleton() ? Input::get_singleton()->take_frame_input_ticks_usec() : 0;
 	if (create_thread) {
-		command_queue.push(this, &RenderingServerDefault::_draw, p_present, frame_step);
+		command_queue.push(this, &RenderingServerDefault::_draw, p_present, frame_step, input_ticks_usec);
 	} else {
-		_draw(p_present, frame_step);
+		_draw(p_present, frame_step, input_ticks_usec);
 	}
 }
 
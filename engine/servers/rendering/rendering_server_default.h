@@ -68,6 +68,11 @@ class RenderingServerDefault : public RenderingServer {
 
 	double frame_setup_time = 0;
 
+	Callable late_latch_source;
+	StringName late_latch_global_parameter;
+	double input_to_present_time = 0;
+	double late_latch_to_present_time = 0;
+
 	//for printing
 	bool print_gpu_profile = false;
 	HashMap<String, float> print_gpu_profile_task_time;
@@ -85,7 +90,8 @@ class RenderingServerDefault : public RenderingServer {
 	void _thread_exit();
 	void _thread_loop();
 
-	void _draw(bool p_swap_buffers, double frame_step);
+	void _draw(bool p_swap_buffers, double frame_step, uint64_t p_input_ticks_usec);
+	void _set_late_latch_source(const Callable &p_source, const StringName &p_global_parameter);
 	void _run_post_draw_steps();
 	void _init();
 	void _finish();
@@ -1190,6 +1196,10 @@ public:
 
 	virtual double get_frame_setup_time_cpu() const override;
 
+	virtual void set_late_latch_source(const Callable &p_source, const StringName &p_global_parameter) override;
+	virtual double get_input_to_present_time() const override;
+	virtual double get_late_latch_to_present_time() const override;
+
 	virtual Color get_default_clear_color() override;
 	virtual void set_default_clear_color(const Color &p_color) override;
 
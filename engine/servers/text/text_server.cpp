@@ -2385,6 +2385,8 @@ TextServer::TextServer() {
 	GLOBAL_DEF_RST("gui/theme/default_font_multichannel_signed_distance_field", false);
 	GLOBAL_DEF_RST("gui/theme/default_font_generate_mipmaps", false);
 
+	GLOBAL_DEF_RST("gui/theme/glyph_cache_path", "");
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "gui/theme/shaped_run_cache_size_kb", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 4096);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "gui/theme/lcd_subpixel_layout", PROPERTY_HINT_ENUM, "Disabled,Horizontal RGB,Horizontal BGR,Vertical RGB,Vertical BGR"), 1);
 	GLOBAL_DEF_BASIC("internationalization/locale/include_text_server_data", false);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::INT, "internationalization/locale/line_breaking_strictness", PROPERTY_HINT_ENUM, "Auto,Loose,Normal,Strict"), 0);
@@ -0,0 +1,261 @@
+/**************************************************************************/
+/*  benchmark_runner.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "benchmark_runner.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/string/print_string.h"
+#include "core/version.h"
+
+BenchmarkEnvironmentFunc BenchmarkRunner::scene_begin = nullptr;
+BenchmarkEnvironmentFunc BenchmarkRunner::scene_end = nullptr;
+
+String BenchmarkContext::get_argument(const String &p_option) const {
+	const List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == p_option && E->next()) {
+			return E->next()->get();
+		}
+	}
+	return String();
+}
+
+LocalVector<BenchmarkRunner::Benchmark> &BenchmarkRunner::_get_benchmarks() {
+	static LocalVector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+int BenchmarkRunner::register_benchmark(const String &p_name, BenchmarkFunc p_function) {
+	Benchmark benchmark;
+	benchmark.name = p_name;
+	benchmark.function = p_function;
+	_get_benchmarks().push_back(benchmark);
+	return 0;
+}
+
+void BenchmarkRunner::set_scene_environment(BenchmarkEnvironmentFunc p_begin, BenchmarkEnvironmentFunc p_end) {
+	scene_begin = p_begin;
+	scene_end = p_end;
+}
+
+double BenchmarkRunner::get_median(const LocalVector<double> &p_values) {
+	ERR_FAIL_COND_V(p_values.is_empty(), 0.0);
+	LocalVector<double> sorted = p_values;
+	sorted.sort();
+	const uint32_t mid = sorted.size() / 2;
+	return sorted.size() % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) * 0.5;
+}
+
+double BenchmarkRunner::get_median_absolute_deviation(const LocalVector<double> &p_values, double p_median) {
+	LocalVector<double> deviations;
+	deviations.resize(p_values.size());
+	for (uint32_t i = 0; i < p_values.size(); i++) {
+		deviations[i] = Math::abs(p_values[i] - p_median);
+	}
+	return get_median(deviations);
+}
+
+bool BenchmarkRunner::is_regression(const Dictionary &p_result, const Dictionary &p_baseline, double p_threshold) {
+	if (!p_result.has("median_nsec") || !p_baseline.has("median_nsec")) {
+		return false;
+	}
+	const double median = p_result["median_nsec"];
+	const double baseline_median = p_baseline["median_nsec"];
+	const double noise = MAX(double(p_result.get("mad_nsec", 0.0)), double(p_baseline.get("mad_nsec", 0.0)));
+	return median > baseline_median * (1.0 + p_threshold) && median - baseline_median > noise * 3.0;
+}
+
+static String _format_nsec(double p_nsec) {
+	if (p_nsec >= 1e6) {
+		return vformat("%.2f ms", p_nsec / 1e6);
+	} else if (p_nsec >= 1e3) {
+		return vformat("%.2f us", p_nsec / 1e3);
+	}
+	return vformat("%.1f ns", p_nsec);
+}
+
+int BenchmarkRunner::run(const List<String> &p_args) {
+	String filter;
+	String output_path;
+	String baseline_path;
+	double threshold = 0.1;
+	bool list_only = false;
+	BenchmarkContext defaults;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		const String &arg = E->get();
+		const String value = E->next() ? E->next()->get() : String();
+		if (arg == "--benchmark-list") {
+			list_only = true;
+		} else if (arg == "--benchmark-filter") {
+			filter = value;
+		} else if (arg == "--benchmark-output") {
+			output_path = value;
+		} else if (arg == "--benchmark-baseline") {
+			baseline_path = value;
+		} else if (arg == "--benchmark-threshold") {
+			threshold = value.to_float() / 100.0;
+		} else if (arg == "--benchmark-repetitions") {
+			defaults.repetitions = MAX(1, value.to_int());
+		} else if (arg == "--benchmark-warmup") {
+			defaults.warmup = MAX(0, value.to_int());
+		} else if (arg == "--benchmark-min-time") {
+			defaults.min_time_usec = MAX(1, value.to_int()) * 1000;
+		}
+	}
+
+	const LocalVector<Benchmark> &benchmarks = _get_benchmarks();
+	if (benchmarks.is_empty()) {
+		print_line("No benchmarks are registered.");
+		return EXIT_SUCCESS;
+	}
+
+	HashMap<String, Dictionary> baseline;
+	if (!baseline_path.is_empty()) {
+		const String json = FileAccess::get_file_as_string(baseline_path);
+		const Dictionary baseline_data = JSON::parse_string(json);
+		ERR_FAIL_COND_V_MSG(!baseline_data.has("benchmarks"), EXIT_FAILURE, vformat("Can't read benchmark baseline \"%s\".", baseline_path));
+		const Array baseline_results = baseline_data["benchmarks"];
+		for (const Variant &result : baseline_results) {
+			const Dictionary result_dict = result;
+			baseline[result_dict.get("name", String())] = result_dict;
+		}
+	}
+
+	Array results;
+	int regressions = 0;
+	int failures = 0;
+
+	for (const Benchmark &benchmark : benchmarks) {
+		if (!filter.is_empty() && !benchmark.name.contains(filter)) {
+			continue;
+		}
+		if (list_only) {
+			print_line(benchmark.name);
+			continue;
+		}
+
+		BenchmarkContext context;
+		context.warmup = defaults.warmup;
+		context.repetitions = defaults.repetitions;
+		context.min_time_usec = defaults.min_time_usec;
+		const bool needs_scene = benchmark.name.begins_with("scene/");
+		if (needs_scene && scene_begin) {
+			scene_begin();
+		}
+		benchmark.function(context);
+		if (needs_scene && scene_end) {
+			scene_end();
+		}
+
+		Dictionary result;
+		result["name"] = benchmark.name;
+		if (context.has_failed()) {
+			result["failed"] = context.failure;
+			results.push_back(result);
+			print_line(vformat("%-40s FAILED: %s", benchmark.name, context.failure));
+			failures++;
+			continue;
+		}
+		if (!context.skip_reason.is_empty() || context.times_nsec.is_empty()) {
+			const String reason = context.skip_reason.is_empty() ? String("Nothing was measured.") : context.skip_reason;
+			result["skipped"] = reason;
+			results.push_back(result);
+			print_line(vformat("%-40s skipped: %s", benchmark.name, reason));
+			continue;
+		}
+
+		const double median = get_median(context.times_nsec);
+		const double mad = get_median_absolute_deviation(context.times_nsec, median);
+		double min_nsec = context.times_nsec[0];
+		double max_nsec = context.times_nsec[0];
+		Array samples;
+		for (double time : context.times_nsec) {
+			min_nsec = MIN(min_nsec, time);
+			max_nsec = MAX(max_nsec, time);
+			samples.push_back(time);
+		}
+		result["iterations"] = context.iterations;
+		result["repetitions"] = context.times_nsec.size();
+		result["median_nsec"] = median;
+		result["mad_nsec"] = mad;
+		result["min_nsec"] = min_nsec;
+		result["max_nsec"] = max_nsec;
+		result["allocations"] = get_median(context.allocations);
+		result["samples_nsec"] = samples;
+
+		String comparison;
+		if (baseline.has(benchmark.name)) {
+			const Dictionary &base = baseline[benchmark.name];
+			if (base.has("median_nsec") && double(base["median_nsec"]) > 0.0) {
+				const double change = median / double(base["median_nsec"]) - 1.0;
+				result["baseline_change"] = change;
+				comparison = vformat("  %s%.1f%%", change >= 0.0 ? "+" : "", change * 100.0);
+				if (is_regression(result, base, threshold)) {
+					result["regression"] = true;
+					comparison += " REGRESSION";
+					regressions++;
+				}
+			}
+		}
+		results.push_back(result);
+
+		print_line(vformat("%-40s %12s +/- %-10s %8.1f allocs%s", benchmark.name, _format_nsec(median), _format_nsec(mad), double(result["allocations"]), comparison));
+	}
+
+	if (list_only) {
+		return EXIT_SUCCESS;
+	}
+
+	if (!output_path.is_empty()) {
+		Dictionary report;
+		report["version"] = GODOT_VERSION_FULL_BUILD;
+		report["warmup"] = defaults.warmup;
+		report["repetitions"] = defaults.repetitions;
+		report["min_time_usec"] = defaults.min_time_usec;
+		report["benchmarks"] = results;
+
+		Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE);
+		ERR_FAIL_COND_V_MSG(f.is_null(), EXIT_FAILURE, vformat("Can't write benchmark results to \"%s\".", output_path));
+		f->store_string(JSON::stringify(report, "\t", false));
+	}
+
+	if (failures > 0) {
+		print_line(vformat("%d benchmarks failed.", failures));
+	}
+	if (regressions > 0) {
+		print_line(vformat("%d benchmarks regressed by more than %.1f%% against the baseline.", regressions, threshold * 100.0));
+	}
+	if (failures > 0 || regressions > 0) {
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
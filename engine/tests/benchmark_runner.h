@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  benchmark_runner.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "tests/test_macros.h"
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+
+// Register benchmarks to be run with `godot --test --benchmark`.
+// For instance: REGISTER_BENCHMARK("core/json/parse", &benchmark_json_parse).
+//
+// A benchmark does its setup, then calls BenchmarkContext::measure() with the code to time.
+// The body is run in batches long enough to be timed reliably, and each repetition
+// reports the time and the number of allocations of a single iteration.
+//
+// Like test cases tagged [SceneTree], benchmarks named "scene/..." run with a SceneTree
+// and the servers it needs.
+
+class BenchmarkContext {
+	friend class BenchmarkRunner;
+
+	uint32_t warmup = 2;
+	uint32_t repetitions = 10;
+	uint64_t min_time_usec = 10000;
+
+	uint64_t iterations = 0;
+	LocalVector<double> times_nsec;
+	LocalVector<double> allocations;
+	String skip_reason;
+	String failure;
+
+public:
+	template <typename F>
+	void measure(F p_body) {
+		ERR_FAIL_COND_MSG(iterations != 0, "A benchmark can only be measured once.");
+
+		// Calibrate the batch size, which also warms up caches and lazy initialization.
+		iterations = 1;
+		while (true) {
+			const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (uint64_t i = 0; i < iterations; i++) {
+				p_body();
+			}
+			const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+			if (!failure.is_empty()) {
+				return;
+			}
+			if (elapsed_usec >= min_time_usec || iterations >= (1 << 30)) {
+				break;
+			}
+			iterations = elapsed_usec > 0 ? MAX(iterations * 2, iterations * min_time_usec / elapsed_usec) : iterations * 10;
+		}
+
+		for (uint32_t r = 0; r < warmup + repetitions; r++) {
+			const uint64_t begin_allocs = Memory::get_alloc_count();
+			const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (uint64_t i = 0; i < iterations; i++) {
+				p_body();
+			}
+			const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+			const uint64_t allocs = Memory::get_alloc_count() - begin_allocs;
+			if (!failure.is_empty()) {
+				return;
+			}
+			if (r >= warmup) {
+				times_nsec.push_back(elapsed_usec * 1000.0 / iterations);
+				allocations.push_back(allocs / (double)iterations);
+			}
+		}
+	}
+
+	// Marks the benchmark as skipped, for instance when it needs data that isn't available.
+	void skip(const String &p_reason) { skip_reason = p_reason; }
+
+	// Marks the benchmark as failed, for instance when the measured code returns an error.
+	// measure() stops after the current batch, and the run exits with an error.
+	void fail(const String &p_reason) {
+		if (failure.is_empty()) {
+			failure = p_reason;
+		}
+	}
+	bool has_failed() const { return !failure.is_empty(); }
+
+	// Returns the value passed after `p_option` on the command line, or an empty string.
+	String get_argument(const String &p_option) const;
+};
+
+typedef void (*BenchmarkFunc)(BenchmarkContext &p_context);
+typedef void (*BenchmarkEnvironmentFunc)();
+
+class BenchmarkRunner {
+	struct Benchmark {
+		String name;
+		BenchmarkFunc function = nullptr;
+	};
+
+	// Benchmarks register during static initialization, so the list is created on first use.
+	static LocalVector<Benchmark> &_get_benchmarks();
+	static BenchmarkEnvironmentFunc scene_begin;
+	static BenchmarkEnvironmentFunc scene_end;
+
+public:
+	static int register_benchmark(const String &p_name, BenchmarkFunc p_function);
+	// Set by the test runner, which owns the setup of the [SceneTree] test cases.
+	static void set_scene_environment(BenchmarkEnvironmentFunc p_begin, BenchmarkEnvironmentFunc p_end);
+
+	static double get_median(const LocalVector<double> &p_values);
+	static double get_median_absolute_deviation(const LocalVector<double> &p_values, double p_median);
+	// A result is a regression when its median is slower than the baseline by more than
+	// `p_threshold` (a fraction), and by more than three times the noise of both runs.
+	static bool is_regression(const Dictionary &p_result, const Dictionary &p_baseline, double p_threshold);
+
+	// Runs the benchmarks with the given command-line options and returns the exit code.
+	static int run(const List<String> &p_args);
+};
+
+#define REGISTER_BENCHMARK(m_name, m_function)                       \
+	DOCTEST_GLOBAL_NO_WARNINGS(DOCTEST_ANONYMOUS(DOCTEST_ANON_VAR_), \
+			BenchmarkRunner::register_benchmark(m_name, m_function))
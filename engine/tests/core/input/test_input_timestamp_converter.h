@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  test_input_timestamp_converter.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/input/input_timestamp_converter.h"
+
+#include "tests/test_macros.h"
+
+namespace TestInputTimestampConverter {
+
+// Simulates a server with a millisecond clock, whose events are received with a varying latency.
+struct SimulatedClock {
+	InputTimestampConverter converter;
+	uint32_t state = 12345;
+	uint64_t ticks_base = 5000000;
+	uint32_t raw_base = 0;
+	double rate = 1.0; // Source clock speed relative to the ticks clock.
+
+	uint32_t raw_at(uint64_t p_event_usec) const {
+		return raw_base + uint32_t(uint64_t(p_event_usec * rate) / 1000);
+	}
+
+	// Latency between 500 µs and 4.5 ms, the smallest one every 50 events.
+	uint64_t latency(int p_index) {
+		state = state * 1664525u + 1013904223u;
+		return p_index % 50 == 0 ? 500 : 500 + (state >> 8) % 4000;
+	}
+
+	// Sends events every `p_interval_usec` from `p_start_usec`, returns the time after the last one.
+	uint64_t send(uint64_t p_start_usec, int p_count, uint64_t p_interval_usec) {
+		for (int i = 0; i < p_count; i++) {
+			const uint64_t event_usec = p_start_usec + i * p_interval_usec;
+			converter.add_sample(raw_at(event_usec), ticks_base + event_usec + latency(i));
+		}
+		return p_start_usec + p_count * p_interval_usec;
+	}
+
+	int64_t error_at(uint64_t p_event_usec) const {
+		return converter.to_ticks_usec(raw_at(p_event_usec)) - int64_t(ticks_base + p_event_usec);
+	}
+};
+
+TEST_CASE("[InputTimestampConverter] Nothing to convert before the first sample") {
+	InputTimestampConverter converter;
+	CHECK_FALSE(converter.is_synced());
+	CHECK(converter.to_ticks_usec(1234) == -1);
+
+	converter.add_sample(1000, 2000000);
+	CHECK(converter.is_synced());
+	CHECK(converter.to_ticks_usec(1000) == 2000000);
+	CHECK(converter.to_ticks_usec(1010) == 2010000);
+	CHECK(converter.to_ticks_usec(990) == 1990000);
+
+	converter.reset();
+	CHECK_FALSE(converter.is_synced());
+}
+
+TEST_CASE("[InputTimestampConverter] Converts with the smallest latency seen") {
+	SimulatedClock clock;
+	clock.raw_base = 123456;
+	const uint64_t end = clock.send(0, 1000, 4000);
+
+	// Events are converted to when they happened, plus the smallest latency and the millisecond rounding.
+	for (uint64_t t = end - 100000; t < end; t += 1000) {
+		const int64_t error = clock.error_at(t);
+		CHECK(error >= 0);
+		CHECK(error <= 1500);
+	}
+
+	// Events received later don't move the estimate back.
+	clock.converter.add_sample(clock.raw_at(end), clock.ticks_base + end + 50000);
+	CHECK(clock.error_at(end) <= 1500);
+}
+
+TEST_CASE("[InputTimestampConverter] Follows the source clock wrapping around") {
+	SimulatedClock clock;
+	clock.raw_base = UINT32_MAX - 200;
+	const uint64_t end = clock.send(0, 100, 4000);
+	CHECK(clock.raw_at(end) < 500);
+
+	CHECK(clock.error_at(end - 4000) >= 0);
+	CHECK(clock.error_at(end - 4000) <= 1500);
+	// Timestamps from before the wrap-around are still in the past.
+	CHECK(clock.converter.to_ticks_usec(UINT32_MAX - 100) == clock.converter.to_ticks_usec(clock.raw_at(end)) - int64_t(clock.raw_at(end) + 101) * 1000);
+}
+
+TEST_CASE("[InputTimestampConverter] Follows clock drift") {
+	for (double rate : { 1.0 - 150e-6, 1.0 + 150e-6 }) {
+		SimulatedClock clock;
+		clock.rate = rate;
+		// 20 minutes of events, the clocks drift apart by 180 ms.
+		const uint64_t end = clock.send(0, 120000, 10000);
+
+		const int64_t error = clock.error_at(end - 10000);
+		CHECK(error >= -1000);
+		CHECK(error <= 2500);
+	}
+}
+
+TEST_CASE("[InputTimestampConverter] Resyncs when the source clock jumps") {
+	SimulatedClock clock;
+	clock.raw_base = 50000000;
+	uint64_t end = clock.send(0, 500, 4000);
+
+	// The server restarted, its clock went back 10 hours.
+	clock.raw_base -= 36000000;
+	end = clock.send(end, 100, 4000);
+	CHECK(clock.error_at(end - 4000) >= 0);
+	CHECK(clock.error_at(end - 4000) <= 1500);
+
+	// And forward again.
+	clock.raw_base += 72000000;
+	end = clock.send(end, 100, 4000);
+	CHECK(clock.error_at(end - 4000) >= 0);
+	CHECK(clock.error_at(end - 4000) <= 1500);
+}
+
+} // namespace TestInputTimestampConverter
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  benchmark_image.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/image.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkImage {
+
+static const int WIDTH = 3840;
+static const int HEIGHT = 2160;
+
+static Vector<uint8_t> create_noise_data() {
+	RandomPCG rng(5);
+	Vector<uint8_t> data;
+	data.resize(Image::get_image_data_size(WIDTH, HEIGHT, Image::FORMAT_RGBA8, false));
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = rng.rand() & 0xff;
+	}
+	return data;
+}
+
+// Runs `p_func` on a fresh 4K RGBA8 image each iteration. The image shares the source data,
+// so the only copy is the one the operation makes when it writes.
+static void measure_on_4k_image(BenchmarkContext &p_context, void (*p_func)(Ref<Image> &)) {
+	const Vector<uint8_t> data = create_noise_data();
+	Ref<Image> image;
+	image.instantiate();
+	p_context.measure([&]() {
+		image->set_data(WIDTH, HEIGHT, false, Image::FORMAT_RGBA8, data);
+		p_func(image);
+	});
+}
+
+static void benchmark_resize_bilinear_1080p(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->resize(1920, 1080, Image::INTERPOLATE_BILINEAR); });
+}
+
+static void benchmark_resize_lanczos_1080p(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->resize(1920, 1080, Image::INTERPOLATE_LANCZOS); });
+}
+
+static void benchmark_resize_bilinear_thumbnail(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->resize(512, 288, Image::INTERPOLATE_BILINEAR); });
+}
+
+static void benchmark_generate_mipmaps(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->generate_mipmaps(); });
+}
+
+static void benchmark_premultiply_alpha(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->premultiply_alpha(); });
+}
+
+static void benchmark_convert_rgb8(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->convert(Image::FORMAT_RGB8); });
+}
+
+static void benchmark_convert_l8(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->convert(Image::FORMAT_L8); });
+}
+
+static void benchmark_convert_la8(BenchmarkContext &p_context) {
+	measure_on_4k_image(p_context, [](Ref<Image> &p_image) { p_image->convert(Image::FORMAT_LA8); });
+}
+
+REGISTER_BENCHMARK("core/image/resize_bilinear_4k_to_1080p", &benchmark_resize_bilinear_1080p);
+REGISTER_BENCHMARK("core/image/resize_lanczos_4k_to_1080p", &benchmark_resize_lanczos_1080p);
+REGISTER_BENCHMARK("core/image/resize_bilinear_4k_to_512x288", &benchmark_resize_bilinear_thumbnail);
+REGISTER_BENCHMARK("core/image/generate_mipmaps_4k", &benchmark_generate_mipmaps);
+REGISTER_BENCHMARK("core/image/premultiply_alpha_4k", &benchmark_premultiply_alpha);
+REGISTER_BENCHMARK("core/image/convert_rgba8_to_rgb8_4k", &benchmark_convert_rgb8);
+REGISTER_BENCHMARK("core/image/convert_rgba8_to_l8_4k", &benchmark_convert_l8);
+REGISTER_BENCHMARK("core/image/convert_rgba8_to_la8_4k", &benchmark_convert_la8);
+
+} // namespace BenchmarkImage
@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  benchmark_json.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/json.h"
+
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkJSON {
+
+// A chart-like document: metadata plus a long array of small objects.
+static Dictionary create_document() {
+	Dictionary document;
+	document["title"] = "Benchmark";
+	document["version"] = 3;
+	Array points;
+	for (int i = 0; i < 2000; i++) {
+		Dictionary point;
+		point["time"] = i * 250;
+		point["position"] = Array({ i % 1920, (i * 7) % 1080 });
+		point["type"] = i % 4;
+		point["hold"] = (i % 16) == 0;
+		point["sound"] = "note_" + itos(i % 8);
+		points.push_back(point);
+	}
+	document["points"] = points;
+	return document;
+}
+
+static void benchmark_parse(BenchmarkContext &p_context) {
+	const String text = JSON::stringify(create_document());
+	p_context.measure([&]() {
+		JSON json;
+		if (json.parse(text) != OK) {
+			p_context.fail(json.get_error_message());
+		}
+	});
+}
+
+static void benchmark_stringify(BenchmarkContext &p_context) {
+	const Dictionary document = create_document();
+	p_context.measure([&]() {
+		if (JSON::stringify(document).is_empty()) {
+			p_context.fail("Stringifying the document returned nothing.");
+		}
+	});
+}
+
+// A large chart, formatted like the editor saves it.
+static PackedByteArray create_chart_bytes() {
+	String chart = "{\n\t\"title\": \"Benchmark\",\n\t\"layers\": [\n";
+	const int notes = 50000;
+	for (int i = 0; i < notes; i++) {
+		chart += vformat("\t\t{\n\t\t\t\"type\": \"Note\",\n\t\t\t\"time\": %d,\n\t\t\t\"position\": [%.3f, %.3f],\n\t\t\t\"note_type\": %d,\n\t\t\t\"hold\": %s,\n\t\t\t\"sound\": \"note\"\n\t\t}%s\n",
+				i * 250, 100.0 + (i % 17) * 31.25, 200.0 + (i % 13) * 17.5, i % 4, i % 3 == 0 ? "true" : "false", i == notes - 1 ? "" : ",");
+	}
+	chart += "\t],\n\t\"bpm_changes\": [120, 140, 160, 180]\n}\n";
+	return chart.to_utf8_buffer();
+}
+
+// What loading a .json file did before: decode the whole file, then parse.
+static void benchmark_parse_chart_string(BenchmarkContext &p_context) {
+	const PackedByteArray bytes = create_chart_bytes();
+	p_context.measure([&]() {
+		JSON json;
+		if (json.parse(String::utf8((const char *)bytes.ptr(), bytes.size())) != OK) {
+			p_context.fail(json.get_error_message());
+		}
+	});
+}
+
+static void benchmark_parse_chart_utf8(BenchmarkContext &p_context) {
+	const PackedByteArray bytes = create_chart_bytes();
+	p_context.measure([&]() {
+		JSON json;
+		if (json.parse_utf8(bytes) != OK) {
+			p_context.fail(json.get_error_message());
+		}
+	});
+}
+
+static void benchmark_parse_chart_utf8_typed_arrays(BenchmarkContext &p_context) {
+	const PackedByteArray bytes = create_chart_bytes();
+	p_context.measure([&]() {
+		JSON json;
+		if (json.parse_utf8(bytes, true) != OK) {
+			p_context.fail(json.get_error_message());
+		}
+	});
+}
+
+REGISTER_BENCHMARK("core/json/parse", &benchmark_parse);
+REGISTER_BENCHMARK("core/json/stringify", &benchmark_stringify);
+REGISTER_BENCHMARK("core/json/parse_chart_string", &benchmark_parse_chart_string);
+REGISTER_BENCHMARK("core/json/parse_chart_utf8", &benchmark_parse_chart_utf8);
+REGISTER_BENCHMARK("core/json/parse_chart_utf8_typed_arrays", &benchmark_parse_chart_utf8_typed_arrays);
+
+} // namespace BenchmarkJSON
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  benchmark_pck_packer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+
+#include "tests/benchmark_runner.h"
+#include "tests/test_utils.h"
+
+namespace BenchmarkPCKPacker {
+
+static const uint64_t CHUNK_SIZE = 64 * 1024 * 1024;
+static const uint64_t CHUNK_COUNT = 4;
+static const char *ENTRY_PATH = "res://large/blob.bin";
+
+// Sums every byte, so both ways touch all of the data.
+static uint64_t checksum(const uint8_t *p_data, uint64_t p_size) {
+	uint64_t sum = 0;
+	for (uint64_t i = 0; i < p_size; i++) {
+		sum += p_data[i];
+	}
+	return sum;
+}
+
+static Error create_pck(const String &p_blob_path, const String &p_pck_path) {
+	Vector<uint8_t> chunk;
+	chunk.resize(CHUNK_SIZE);
+	for (uint64_t i = 0; i < CHUNK_SIZE; i++) {
+		chunk.write[i] = uint8_t((i * 2654435761u) >> 24);
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(p_blob_path, FileAccess::WRITE);
+		ERR_FAIL_COND_V(f.is_null(), ERR_FILE_CANT_WRITE);
+		for (uint64_t i = 0; i < CHUNK_COUNT; i++) {
+			f->store_buffer(chunk);
+		}
+	}
+
+	PCKPacker pck_packer;
+	Error err = pck_packer.pck_start(p_pck_path);
+	if (err == OK) {
+		err = pck_packer.add_file(ENTRY_PATH, p_blob_path);
+	}
+	if (err == OK) {
+		err = pck_packer.flush();
+	}
+	return err;
+}
+
+// Reads a 256 MiB PCK entry, through a read-only mapping or copied into a buffer.
+static void measure_read(BenchmarkContext &p_context, bool p_mapped) {
+	const String blob_path = TestUtils::get_temp_path("benchmark_large_blob.bin");
+	const String pck_path = TestUtils::get_temp_path("benchmark_large.pck");
+	if (create_pck(blob_path, pck_path) != OK) {
+		p_context.fail("Can't create the PCK.");
+		return;
+	}
+
+	PackedData *owned_packed_data = nullptr;
+	if (!PackedData::get_singleton()) {
+		owned_packed_data = memnew(PackedData);
+	}
+	if (PackedData::get_singleton()->add_pack(pck_path, true, 0) != OK) {
+		p_context.fail("Can't load the PCK.");
+	} else {
+		p_context.measure([&]() {
+			Ref<FileAccess> f = FileAccess::open(ENTRY_PATH, FileAccess::READ);
+			if (f.is_null()) {
+				p_context.fail("Can't open the PCK entry.");
+				return;
+			}
+			uint64_t sum = 0;
+			if (p_mapped) {
+				const Span<uint8_t> span = f->map_read_only();
+				sum = checksum(span.ptr(), span.size());
+			} else {
+				const Vector<uint8_t> data = f->get_buffer(f->get_length());
+				sum = checksum(data.ptr(), data.size());
+			}
+			if (sum == 0) {
+				p_context.fail("The PCK entry is empty.");
+			}
+		});
+	}
+
+	if (owned_packed_data) {
+		memdelete(owned_packed_data);
+	} else {
+		PackedData::get_singleton()->remove_path(ENTRY_PATH);
+		PackedData::get_singleton()->release_mapped_packs();
+	}
+	DirAccess::remove_file_or_error(blob_path);
+	DirAccess::remove_file_or_error(pck_path);
+}
+
+static void benchmark_read_mapped(BenchmarkContext &p_context) {
+	measure_read(p_context, true);
+}
+
+static void benchmark_read_copied(BenchmarkContext &p_context) {
+	measure_read(p_context, false);
+}
+
+REGISTER_BENCHMARK("core/pck/read_256mb_entry_mapped", &benchmark_read_mapped);
+REGISTER_BENCHMARK("core/pck/read_256mb_entry_copied", &benchmark_read_copied);
+
+} // namespace BenchmarkPCKPacker
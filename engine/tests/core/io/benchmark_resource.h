@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  benchmark_resource.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/resource_loader.h"
+
+#include "tests/benchmark_runner.h"
+#include "tests/test_utils.h"
+// Shares the pipelined scene helpers with the tests.
+#include "tests/core/io/test_resource.h"
+
+namespace BenchmarkResource {
+
+static const int DEPENDENCY_COUNT = 32;
+static const int SUB_RESOURCE_COUNT = 128;
+
+// Loads a scene with 32 dependencies of 128 sub-resources each, like a song pack.
+static void measure_load(BenchmarkContext &p_context, bool p_pipelined) {
+	const String scene_path = TestResource::_save_pipeline_scene("pipelined_benchmark", DEPENDENCY_COUNT, SUB_RESOURCE_COUNT);
+	ResourceLoader::set_pipelined_loading(p_pipelined);
+
+	Ref<Resource> scene = ResourceLoader::load(scene_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP);
+	if (!TestResource::_is_pipeline_scene(scene, DEPENDENCY_COUNT, SUB_RESOURCE_COUNT)) {
+		p_context.fail("The scene doesn't load as saved.");
+	} else {
+		p_context.measure([&]() {
+			if (ResourceLoader::load(scene_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP).is_null()) {
+				p_context.fail("Can't load the scene.");
+			}
+		});
+	}
+
+	ResourceLoader::set_pipelined_loading(false);
+}
+
+static void benchmark_load_serial(BenchmarkContext &p_context) {
+	measure_load(p_context, false);
+}
+
+static void benchmark_load_pipelined(BenchmarkContext &p_context) {
+	measure_load(p_context, true);
+}
+
+REGISTER_BENCHMARK("core/resource/load_serial", &benchmark_load_serial);
+REGISTER_BENCHMARK("core/resource/load_pipelined", &benchmark_load_pipelined);
+
+} // namespace BenchmarkResource
@@ -248,4 +248,35 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Map read-only") {
+	const String file_path = TestUtils::get_temp_path("map_read_only.bin");
+	Vector<uint8_t> contents;
+	contents.resize(100000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = uint8_t(i * 7 + (i >> 8));
+	}
+
+	Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+	REQUIRE(fw.is_valid());
+	fw->store_buffer(contents);
+	// Files open for writing are never mapped.
+	CHECK(fw->map_read_only().is_empty());
+	fw->close();
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	const Span<uint8_t> span = f->map_read_only();
+#if defined(UNIX_ENABLED) || defined(WINDOWS_ENABLED)
+	REQUIRE(span.size() == uint64_t(contents.size()));
+	CHECK(memcmp(span.ptr(), contents.ptr(), contents.size()) == 0);
+	// Mapping twice returns the same memory, and reading keeps working.
+	CHECK(f->map_read_only().ptr() == span.ptr());
+	f->seek(5000);
+	CHECK(f->get_8() == contents[5000]);
+#endif
+	f->close();
+
+	DirAccess::remove_file_or_error(file_path);
+}
+
 } // namespace TestFileAccess
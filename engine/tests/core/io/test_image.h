@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/image.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -488,4 +490,152 @@ TEST_CASE("[Image] Convert image") {
 	CHECK_MESSAGE(image2->get_data() == image_data, "Image conversion to invalid type (Image::FORMAT_MAX + 1) should not alter image.");
 }
 
+static Ref<Image> _make_noise_image(int p_width, int p_height, Image::Format p_format, uint64_t p_seed) {
+	RandomPCG rng(p_seed);
+	Vector<uint8_t> data;
+	data.resize(Image::get_image_data_size(p_width, p_height, p_format, false));
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = rng.rand() & 0xff;
+	}
+	return Image::create_from_data(p_width, p_height, false, p_format, data);
+}
+
+static uint8_t _rec709_luminance(const uint8_t *p_rgb) {
+	return (13938U * p_rgb[0] + 46869U * p_rgb[1] + 4729U * p_rgb[2] + 32768U) >> 16U;
+}
+
+TEST_CASE("[Image] 8-bit conversions from and to RGBA8") {
+	// Odd sizes so the vectorized kernels also go through their scalar tails.
+	const int width = 37;
+	const int height = 9;
+	const int pixel_count = width * height;
+
+	Ref<Image> rgba = _make_noise_image(width, height, Image::FORMAT_RGBA8, 1);
+	const uint8_t *src = rgba->get_data().ptr();
+
+	Ref<Image> image = rgba->duplicate();
+	image->convert(Image::FORMAT_L8);
+	bool matches = true;
+	for (int i = 0; i < pixel_count; i++) {
+		matches = matches && image->get_data()[i] == _rec709_luminance(&src[i * 4]);
+	}
+	CHECK_MESSAGE(matches, "RGBA8 to L8 should store the REC.709 luminance.");
+
+	image = rgba->duplicate();
+	image->convert(Image::FORMAT_LA8);
+	matches = true;
+	for (int i = 0; i < pixel_count; i++) {
+		matches = matches && image->get_data()[i * 2 + 0] == _rec709_luminance(&src[i * 4]);
+		matches = matches && image->get_data()[i * 2 + 1] == src[i * 4 + 3];
+	}
+	CHECK_MESSAGE(matches, "RGBA8 to LA8 should store the REC.709 luminance and keep alpha.");
+
+	image = rgba->duplicate();
+	image->convert(Image::FORMAT_R8);
+	matches = true;
+	for (int i = 0; i < pixel_count; i++) {
+		matches = matches && image->get_data()[i] == src[i * 4];
+	}
+	CHECK_MESSAGE(matches, "RGBA8 to R8 should keep the red channel.");
+
+	image = rgba->duplicate();
+	image->convert(Image::FORMAT_RGB8);
+	matches = true;
+	for (int i = 0; i < pixel_count; i++) {
+		for (int c = 0; c < 3; c++) {
+			matches = matches && image->get_data()[i * 3 + c] == src[i * 4 + c];
+		}
+	}
+	CHECK_MESSAGE(matches, "RGBA8 to RGB8 should drop alpha.");
+
+	const Image::Format formats[] = { Image::FORMAT_L8, Image::FORMAT_LA8, Image::FORMAT_R8, Image::FORMAT_RGB8 };
+	for (Image::Format format : formats) {
+		Ref<Image> source = _make_noise_image(width, height, format, 2);
+		const uint8_t *s = source->get_data().ptr();
+		image = source->duplicate();
+		image->convert(Image::FORMAT_RGBA8);
+		const uint8_t *d = image->get_data().ptr();
+
+		matches = true;
+		for (int i = 0; i < pixel_count; i++) {
+			uint8_t expected[4];
+			switch (format) {
+				case Image::FORMAT_L8:
+					expected[0] = expected[1] = expected[2] = s[i];
+					expected[3] = 255;
+					break;
+				case Image::FORMAT_LA8:
+					expected[0] = expected[1] = expected[2] = s[i * 2];
+					expected[3] = s[i * 2 + 1];
+					break;
+				case Image::FORMAT_R8:
+					expected[0] = s[i];
+					expected[1] = expected[2] = 0;
+					expected[3] = 255;
+					break;
+				default:
+					expected[0] = s[i * 3 + 0];
+					expected[1] = s[i * 3 + 1];
+					expected[2] = s[i * 3 + 2];
+					expected[3] = 255;
+					break;
+			}
+			matches = matches && memcmp(expected, &d[i * 4], 4) == 0;
+		}
+		CHECK_MESSAGE(matches, vformat("Converting %s to RGBA8 should expand the channels.", Image::format_names[format]));
+	}
+}
+
+TEST_CASE("[Image] Premultiply alpha") {
+	Ref<Image> image = _make_noise_image(37, 9, Image::FORMAT_RGBA8, 3);
+	PackedByteArray expected = image->get_data();
+	uint8_t *e = expected.ptrw();
+	for (int i = 0; i < expected.size(); i += 4) {
+		for (int c = 0; c < 3; c++) {
+			e[i + c] = (uint16_t(e[i + c]) * uint16_t(e[i + 3]) + 255U) >> 8;
+		}
+	}
+
+	image->premultiply_alpha();
+	CHECK_MESSAGE(image->get_data() == expected, "Premultiplying should scale color channels by alpha and keep alpha.");
+}
+
+struct _ImageWorkerJob {
+	Ref<Image> image;
+	int width = 0;
+	int height = 0;
+	Image::Interpolation interpolation = Image::INTERPOLATE_BILINEAR;
+
+	static void run(void *p_userdata) {
+		_ImageWorkerJob *job = (_ImageWorkerJob *)p_userdata;
+		job->image->resize(job->width, job->height, job->interpolation);
+		job->image->generate_mipmaps();
+		job->image->convert(Image::FORMAT_RGB8);
+	}
+};
+
+TEST_CASE("[Image] Processing large images in strips matches processing them in one go") {
+	// Large enough to be split across WorkerThreadPool threads on the calling thread.
+	// Pool threads never split work, so running the same job in a task gives the single pass result.
+	Ref<Image> source = _make_noise_image(1024, 600, Image::FORMAT_RGBA8, 4);
+
+	const Image::Interpolation interpolations[] = { Image::INTERPOLATE_BILINEAR, Image::INTERPOLATE_CUBIC, Image::INTERPOLATE_LANCZOS };
+	for (Image::Interpolation interpolation : interpolations) {
+		_ImageWorkerJob split;
+		split.image = source->duplicate();
+		split.width = 700;
+		split.height = 333;
+		split.interpolation = interpolation;
+		_ImageWorkerJob::run(&split);
+
+		_ImageWorkerJob single = split;
+		single.image = source->duplicate();
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&_ImageWorkerJob::run, &single, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+		CHECK_MESSAGE(split.image->get_data() == single.image->get_data(), vformat("Resizing with interpolation %d should not depend on how the image is split.", interpolation));
+	}
+}
+
 } // namespace TestImage
@@ -423,4 +423,91 @@ TEST_CASE("[JSON] Serialization") {
 		}
 	}
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 matches parsing strings") {
+	// Long strings and indentation go through the vectorized scanning, short ones through the scalar tails.
+	const String documents[] = {
+		"null",
+		"  true\n",
+		"-12.5e3",
+		"\"Hello\"",
+		R"(["Hello", "world.", "This is",["a","json","array.",[]], "Empty arrays ahoy:", [[["Gotcha!"]]]])",
+		R"({"name": "Godot Engine", "is_free": true, "bugs": null, "apples": {"red": 500, "green": 0, "blue": -20}, "empty_object": {}})",
+		"{\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\"indented\": [\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t1, 2, 3\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t]\n}",
+		R"({"escapes": "tab\there, quote\" and backslash\\ in a string long enough to be scanned in chunks", "unicode": "\u00e9\u4e2d\ud83d\ude00"})",
+		U"[\"Non-ASCII text: héllo wörld, 日本語のテキスト, and an emoji 😀 somewhere in a long string\", \"ascii\"]",
+		"[1, 2, 3, 4.5, -6, 1e3, 9223372036854775807, 9223372036854775808]",
+	};
+
+	for (const String &document : documents) {
+		JSON from_string;
+		JSON from_utf8;
+		REQUIRE(from_string.parse(document) == OK);
+		CHECK_MESSAGE(from_utf8.parse_utf8(document.to_utf8_buffer()) == OK, vformat("Parsing `%s` from UTF-8 should succeed.", document));
+		CHECK_MESSAGE(from_utf8.get_data() == from_string.get_data(), vformat("Parsing `%s` from UTF-8 should give the same data.", document));
+	}
+
+	ERR_PRINT_OFF
+	const String invalid_documents[] = {
+		"",
+		"[1, 2",
+		"{\"key\" 1}",
+		"{\"key\": 1,\n\n\"other\": nope}",
+		"[1 2]",
+		"\"unterminated\n\nstring",
+		"\"\\x\"",
+		"\"\\ud800\"",
+		"[1, 2] 3",
+		"@",
+	};
+
+	for (const String &document : invalid_documents) {
+		JSON from_string;
+		JSON from_utf8;
+		const Error string_error = from_string.parse(document);
+		const Error utf8_error = from_utf8.parse_utf8(document.to_utf8_buffer());
+		CHECK_MESSAGE(utf8_error != OK, vformat("Parsing `%s` from UTF-8 should fail.", document));
+		CHECK_MESSAGE(utf8_error == string_error, vformat("Parsing `%s` from UTF-8 should fail with the same error.", document));
+		CHECK_MESSAGE(from_utf8.get_error_message() == from_string.get_error_message(), vformat("Parsing `%s` from UTF-8 should report the same error message.", document));
+		CHECK_MESSAGE(from_utf8.get_error_line() == from_string.get_error_line(), vformat("Parsing `%s` from UTF-8 should report the same error line.", document));
+	}
+	ERR_PRINT_ON
+
+	JSON json;
+	PackedByteArray with_bom = { 0xef, 0xbb, 0xbf, '[', '1', ']' };
+	CHECK_MESSAGE(json.parse_utf8(with_bom) == OK, "A leading byte order mark should be skipped.");
+}
+
+TEST_CASE("[JSON] Parsing UTF-8 with typed arrays") {
+	JSON json;
+
+	REQUIRE(json.parse_utf8(String("[1, -2, 3, 9223372036854775807, -9223372036854775808]").to_utf8_buffer(), true) == OK);
+	REQUIRE(json.get_data().get_type() == Variant::PACKED_INT64_ARRAY);
+	const PackedInt64Array ints = json.get_data();
+	CHECK(ints == PackedInt64Array({ 1, -2, 3, INT64_MAX, INT64_MIN }));
+
+	REQUIRE(json.parse_utf8(String("[1, 2.5, -3e2]").to_utf8_buffer(), true) == OK);
+	REQUIRE(json.get_data().get_type() == Variant::PACKED_FLOAT64_ARRAY);
+	CHECK(PackedFloat64Array(json.get_data()) == PackedFloat64Array({ 1.0, 2.5, -300.0 }));
+
+	REQUIRE(json.parse_utf8(String("[1, 9223372036854775808]").to_utf8_buffer(), true) == OK);
+	CHECK_MESSAGE(json.get_data().get_type() == Variant::PACKED_FLOAT64_ARRAY, "Integers out of 64-bit range should make the array a float array.");
+
+	REQUIRE(json.parse_utf8(String(R"([1, 2, "three", [4, 5], []])").to_utf8_buffer(), true) == OK);
+	REQUIRE(json.get_data().get_type() == Variant::ARRAY);
+	const Array mixed = json.get_data();
+	CHECK(mixed.size() == 5);
+	CHECK(mixed[0].get_type() == Variant::FLOAT);
+	CHECK(mixed[1] == Variant(2.0));
+	CHECK(mixed[2] == "three");
+	CHECK(mixed[3].get_type() == Variant::PACKED_INT64_ARRAY);
+	CHECK_MESSAGE(mixed[4].get_type() == Variant::ARRAY, "Empty arrays should stay untyped.");
+
+	REQUIRE(json.parse_utf8(String(R"({"times": [0.5, 1, 1.5]})").to_utf8_buffer(), true) == OK);
+	CHECK(Dictionary(json.get_data())["times"].get_type() == Variant::PACKED_FLOAT64_ARRAY);
+
+	REQUIRE(json.parse_utf8(String("[1, 2, 3]").to_utf8_buffer()) == OK);
+	CHECK_MESSAGE(json.get_data().get_type() == Variant::ARRAY, "Arrays should stay untyped unless requested.");
+}
+
 } // namespace TestJSON
@@ -30,8 +30,11 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/io/stream_peer.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -116,4 +119,420 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+// Loads a pack into PackedData, creating it if the test runner didn't.
+class PackedDataScope {
+	PackedData *owned = nullptr;
+	Vector<String> paths;
+
+public:
+	PackedDataScope(const String &p_pack_path, const Vector<String> &p_paths) {
+		if (!PackedData::get_singleton()) {
+			owned = memnew(PackedData);
+		}
+		paths = p_paths;
+		CHECK(PackedData::get_singleton()->add_pack(p_pack_path, true, 0) == OK);
+	}
+
+	~PackedDataScope() {
+		if (owned) {
+			memdelete(owned);
+		} else {
+			for (const String &path : paths) {
+				PackedData::get_singleton()->remove_path(path);
+			}
+			PackedData::get_singleton()->release_mapped_packs();
+		}
+	}
+};
+
+TEST_CASE("[PCKPacker] Map files from a PCK") {
+	const String blob_path = TestUtils::get_temp_path("mapped_blob.bin");
+	const String text_path = TestUtils::get_temp_path("mapped_text.txt");
+	Vector<uint8_t> blob;
+	blob.resize(200000);
+	for (int i = 0; i < blob.size(); i++) {
+		blob.write[i] = uint8_t((i * 2654435761u) >> 24);
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(blob_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(blob);
+		f = FileAccess::open(text_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("Mapped straight from the pack.");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_mapped.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://mapped/blob.bin", blob_path) == OK);
+	REQUIRE(pck_packer.add_file("res://mapped/text.txt", text_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		PackedDataScope scope(output_pck_path, { "res://mapped/blob.bin", "res://mapped/text.txt" });
+
+		Ref<FileAccess> f = FileAccess::open("res://mapped/blob.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		const Span<uint8_t> span = f->map_read_only();
+#if defined(UNIX_ENABLED) || defined(WINDOWS_ENABLED)
+		REQUIRE(span.size() == uint64_t(blob.size()));
+		CHECK(memcmp(span.ptr(), blob.ptr(), blob.size()) == 0);
+
+		// Files from the same pack share one mapping.
+		Ref<FileAccess> text = FileAccess::open("res://mapped/text.txt", FileAccess::READ);
+		REQUIRE(text.is_valid());
+		const Span<uint8_t> text_span = text->map_read_only();
+		CHECK(String::utf8((const char *)text_span.ptr(), text_span.size()) == "Mapped straight from the pack.");
+		CHECK(text_span.ptr() != span.ptr());
+		CHECK(uint64_t(Math::abs(text_span.ptr() - span.ptr())) < 1024 * 1024);
+#endif
+
+		Ref<StreamPeerBuffer> spb;
+		spb.instantiate();
+		CHECK(spb->set_data_file(f) == OK);
+		CHECK_EQ(spb->get_size(), blob.size());
+		spb->seek(12345);
+		CHECK_EQ(spb->get_u8(), blob[12345]);
+	}
+
+	DirAccess::remove_file_or_error(blob_path);
+	DirAccess::remove_file_or_error(text_path);
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+// Writes files that compress well, files that don't, and files in an already compressed format.
+Vector<String> _create_mixed_files(int p_count) {
+	Vector<String> paths;
+	for (int i = 0; i < p_count; i++) {
+		Vector<uint8_t> data;
+		data.resize(1000 + i * 3001);
+		uint8_t *w = data.ptrw();
+		for (int j = 0; j < data.size(); j++) {
+			switch (i % 3) {
+				case 0:
+					w[j] = "Repeated text compresses well. "[j % 31];
+					break;
+				case 1:
+					w[j] = uint8_t(((j + i) * 2654435761u) >> 24);
+					break;
+				default:
+					w[j] = uint8_t(j % 7);
+			}
+		}
+		if (i % 3 == 2) {
+			// Looks like a PNG, so it's stored as is.
+			memcpy(w, "\x89PNG", 4);
+		}
+
+		const String path = TestUtils::get_temp_path(vformat("mixed_%d.bin", i));
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+		paths.push_back(path);
+	}
+	return paths;
+}
+
+TEST_CASE("[PCKPacker] Threaded packing gives the same output as sequential packing") {
+	const Vector<String> paths = _create_mixed_files(48);
+
+	// The shared pool may have a single thread, which would take the sequential path.
+	WorkerThreadPool pool(false);
+	pool.init(4);
+
+	Vector<uint8_t> outputs[2];
+	for (int pass = 0; pass < 2; pass++) {
+		PCKPacker pck_packer;
+		pck_packer.set_use_threads(pass == 1);
+		pck_packer.set_thread_pool(&pool);
+		pck_packer.set_compression_enabled(true);
+
+		const String output_pck_path = TestUtils::get_temp_path(vformat("output_mixed_%d.pck", pass));
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		for (int i = 0; i < paths.size(); i++) {
+			REQUIRE(pck_packer.add_file(vformat("res://mixed/%d.bin", i), paths[i]) == OK);
+		}
+		REQUIRE(pck_packer.add_file_removal("res://mixed/removed.bin") == OK);
+		REQUIRE(pck_packer.flush() == OK);
+
+		outputs[pass] = FileAccess::get_file_as_bytes(output_pck_path);
+		DirAccess::remove_file_or_error(output_pck_path);
+	}
+
+	REQUIRE(outputs[0].size() > 0);
+	CHECK(outputs[0] == outputs[1]);
+
+	for (const String &path : paths) {
+		DirAccess::remove_file_or_error(path);
+	}
+}
+
+TEST_CASE("[PCKPacker] Read compressed files from a PCK") {
+	const Vector<String> paths = _create_mixed_files(3);
+	uint64_t total_size = 0;
+	for (const String &path : paths) {
+		total_size += FileAccess::get_file_as_bytes(path).size();
+	}
+
+	PCKPacker pck_packer;
+	pck_packer.set_compression_enabled(true);
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	for (int i = 0; i < paths.size(); i++) {
+		REQUIRE(pck_packer.add_file(vformat("res://compressed/%d.bin", i), paths[i]) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+
+	// The noise and the PNG lookalike are stored raw, the text compresses well.
+	CHECK(FileAccess::get_file_as_bytes(output_pck_path).size() < int64_t(total_size));
+
+	{
+		PackedDataScope scope(output_pck_path, { "res://compressed/0.bin", "res://compressed/1.bin", "res://compressed/2.bin" });
+
+		for (int i = 0; i < paths.size(); i++) {
+			const Vector<uint8_t> expected = FileAccess::get_file_as_bytes(paths[i]);
+			Ref<FileAccess> f = FileAccess::open(vformat("res://compressed/%d.bin", i), FileAccess::READ);
+			REQUIRE(f.is_valid());
+			CHECK(f->get_length() == uint64_t(expected.size()));
+			CHECK(f->get_buffer(f->get_length()) == expected);
+
+			f->seek(expected.size() / 2);
+			CHECK(f->get_8() == expected[expected.size() / 2]);
+		}
+
+		// Compressed files can't be mapped.
+		Ref<FileAccess> f = FileAccess::open("res://compressed/0.bin", FileAccess::READ);
+		CHECK(f->map_read_only().is_empty());
+	}
+
+	for (const String &path : paths) {
+		DirAccess::remove_file_or_error(path);
+	}
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+// Noise that doesn't compress, so pack sizes only depend on which chunks are stored.
+Vector<uint8_t> _create_noise(int p_size, uint32_t p_seed) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	uint32_t state = p_seed;
+	for (int i = 0; i < p_size; i++) {
+		state = state * 1664525u + 1013904223u;
+		w[i] = uint8_t(state >> 24);
+	}
+	return data;
+}
+
+void _check_pack_file(const String &p_path, const Vector<uint8_t> &p_expected) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == uint64_t(p_expected.size()));
+	CHECK(f->get_buffer(f->get_length()) == p_expected);
+
+	// Reads across chunk boundaries, backwards.
+	for (int ofs = p_expected.size() - 70000; ofs > 0; ofs -= 70000) {
+		f->seek(ofs);
+		Vector<uint8_t> part = f->get_buffer(1000);
+		REQUIRE(part.size() == 1000);
+		CHECK(memcmp(part.ptr(), p_expected.ptr() + ofs, 1000) == 0);
+	}
+}
+
+TEST_CASE("[PCKPacker] Read chunked files from a PCK") {
+	const String song_path = TestUtils::get_temp_path("chunked_song.bin");
+	const String text_path = TestUtils::get_temp_path("chunked_text.txt");
+	const Vector<uint8_t> song = _create_noise(600000, 1);
+	const Vector<uint8_t> text = String("Chunked text. ").repeat(1000).to_utf8_buffer();
+	{
+		Ref<FileAccess> f = FileAccess::open(song_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(song);
+		f = FileAccess::open(text_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(text);
+	}
+
+	PCKPacker pck_packer;
+	pck_packer.set_chunked(true);
+	const String output_pck_path = TestUtils::get_temp_path("output_chunked.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://chunked/song.bin", song_path) == OK);
+	REQUIRE(pck_packer.add_file("res://chunked/song_copy.bin", song_path) == OK);
+	REQUIRE(pck_packer.add_file("res://chunked/text.txt", text_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	// The copy only adds its chunk list, and the text is compressed.
+	CHECK(FileAccess::get_file_as_bytes(output_pck_path).size() < song.size() + 10000);
+
+	{
+		PackedDataScope scope(output_pck_path, { "res://chunked/song.bin", "res://chunked/song_copy.bin", "res://chunked/text.txt" });
+
+		_check_pack_file("res://chunked/song.bin", song);
+		_check_pack_file("res://chunked/song_copy.bin", song);
+		_check_pack_file("res://chunked/text.txt", text);
+
+		Ref<FileAccess> f = FileAccess::open("res://chunked/song.bin", FileAccess::READ);
+		CHECK(f->map_read_only().is_empty());
+	}
+
+	DirAccess::remove_file_or_error(song_path);
+	DirAccess::remove_file_or_error(text_path);
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] Corrupt chunks are detected when they're read") {
+	const String song_path = TestUtils::get_temp_path("chunked_corrupt_song.bin");
+	const Vector<uint8_t> song = _create_noise(300000, 2);
+	{
+		Ref<FileAccess> f = FileAccess::open(song_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(song);
+	}
+
+	PCKPacker pck_packer;
+	pck_packer.set_chunked(true);
+	const String output_pck_path = TestUtils::get_temp_path("output_chunked_corrupt.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://chunked/song.bin", song_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	// Noise is stored raw, flip a byte of the first chunk in the pack.
+	Vector<uint8_t> pck = FileAccess::get_file_as_bytes(output_pck_path);
+	int64_t song_offset = -1;
+	for (int64_t i = 0; i + 64 <= pck.size(); i++) {
+		if (memcmp(pck.ptr() + i, song.ptr(), 64) == 0) {
+			song_offset = i;
+			break;
+		}
+	}
+	REQUIRE(song_offset >= 0);
+	pck.write[song_offset + 1000] ^= 0xff;
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(pck);
+	}
+
+	{
+		PackedDataScope scope(output_pck_path, { "res://chunked/song.bin" });
+
+		Ref<FileAccess> f = FileAccess::open("res://chunked/song.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		Vector<uint8_t> data;
+		data.resize(1000);
+		ERR_PRINT_OFF;
+		CHECK(f->get_buffer(data.ptrw(), data.size()) == 0);
+		ERR_PRINT_ON;
+		CHECK(f->get_error() == ERR_FILE_CORRUPT);
+	}
+
+	DirAccess::remove_file_or_error(song_path);
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] Patch a chunked PCK") {
+	const String song_path = TestUtils::get_temp_path("patched_song.bin");
+	const String text_path = TestUtils::get_temp_path("patched_text.txt");
+	const Vector<uint8_t> song_v1 = _create_noise(1000000, 2);
+	const Vector<uint8_t> text = String("Unchanged text.").to_utf8_buffer();
+
+	// Version 2 changes a few bytes and inserts some more.
+	Vector<uint8_t> song_v2 = song_v1;
+	for (int i = 0; i < 64; i++) {
+		song_v2.write[200000 + i * 7] ^= 0xff;
+	}
+	const Vector<uint8_t> inserted = _create_noise(3000, 3);
+	song_v2.resize(song_v1.size() + inserted.size());
+	memcpy(song_v2.ptrw() + 700000, inserted.ptr(), inserted.size());
+	memcpy(song_v2.ptrw() + 700000 + inserted.size(), song_v1.ptr() + 700000, song_v1.size() - 700000);
+
+	const String base_pck_path = TestUtils::get_temp_path("output_base.pck");
+	const String patch_pck_path = TestUtils::get_temp_path("output_patch.pck");
+	for (int version = 1; version <= 2; version++) {
+		{
+			Ref<FileAccess> f = FileAccess::open(song_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(version == 1 ? song_v1 : song_v2);
+			f = FileAccess::open(text_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(text);
+		}
+
+		PCKPacker pck_packer;
+		pck_packer.set_chunked(true);
+		if (version == 2) {
+			REQUIRE(pck_packer.add_base_pack(base_pck_path) == OK);
+		}
+		REQUIRE(pck_packer.pck_start(version == 1 ? base_pck_path : patch_pck_path) == OK);
+		REQUIRE(pck_packer.add_file("res://patched/song.bin", song_path) == OK);
+		REQUIRE(pck_packer.add_file("res://patched/text.txt", text_path) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+	}
+
+	// Only the chunks around the changes are in the patch, the changed bytes as deltas.
+	const int64_t patch_size = FileAccess::get_file_as_bytes(patch_pck_path).size();
+	CHECK(patch_size < song_v2.size() / 4);
+
+	{
+		PackedDataScope scope(base_pck_path, { "res://patched/song.bin", "res://patched/text.txt" });
+		_check_pack_file("res://patched/song.bin", song_v1);
+
+		REQUIRE(PackedData::get_singleton()->add_pack(patch_pck_path, true, 0) == OK);
+		_check_pack_file("res://patched/song.bin", song_v2);
+		_check_pack_file("res://patched/text.txt", text);
+	}
+
+	DirAccess::remove_file_or_error(song_path);
+	DirAccess::remove_file_or_error(text_path);
+	DirAccess::remove_file_or_error(base_pck_path);
+	DirAccess::remove_file_or_error(patch_pck_path);
+}
+
+TEST_CASE("[PCKPacker] Patches keep delta chains readable") {
+	const String song_path = TestUtils::get_temp_path("generations_song.bin");
+	Vector<uint8_t> song = _create_noise(200000, 4);
+	const int generations = PackChunks::MAX_DELTA_DEPTH + 3;
+
+	// Every generation changes a few bytes of the same chunk, so it's a delta against the previous one.
+	Vector<String> pck_paths;
+	for (int generation = 0; generation < generations; generation++) {
+		if (generation > 0) {
+			for (int i = 0; i < 8; i++) {
+				song.write[100000 + generation * 16 + i] ^= 0xff;
+			}
+		}
+		{
+			Ref<FileAccess> f = FileAccess::open(song_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(song);
+		}
+
+		PCKPacker pck_packer;
+		pck_packer.set_chunked(true);
+		for (const String &base_pck_path : pck_paths) {
+			REQUIRE(pck_packer.add_base_pack(base_pck_path) == OK);
+		}
+		pck_paths.push_back(TestUtils::get_temp_path(vformat("output_generation_%d.pck", generation)));
+		REQUIRE(pck_packer.pck_start(pck_paths[generation]) == OK);
+		REQUIRE(pck_packer.add_file("res://generations/song.bin", song_path) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+	}
+
+	// Past the maximum depth, a chunk is stored in full again.
+	{
+		PackedDataScope scope(pck_paths[0], { "res://generations/song.bin" });
+		for (int generation = 1; generation < generations; generation++) {
+			REQUIRE(PackedData::get_singleton()->add_pack(pck_paths[generation], true, 0) == OK);
+		}
+		_check_pack_file("res://generations/song.bin", song);
+	}
+
+	DirAccess::remove_file_or_error(song_path);
+	for (const String &pck_path : pck_paths) {
+		DirAccess::remove_file_or_error(pck_path);
+	}
+}
+
 } // namespace TestPCKPacker
@@ -627,4 +627,112 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+static Ref<Resource> _make_pipeline_resource(const String &p_name, int p_sub_resources) {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name(p_name);
+	Array children;
+	for (int i = 0; i < p_sub_resources; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("%s/%d", p_name, i));
+		PackedFloat32Array values;
+		values.resize(16);
+		for (int j = 0; j < values.size(); j++) {
+			values.set(j, i * 16 + j);
+		}
+		child->set_meta("values", values);
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+	return resource;
+}
+
+static bool _is_pipeline_resource(const Ref<Resource> &p_resource, const String &p_name, int p_sub_resources) {
+	if (p_resource.is_null() || p_resource->get_name() != p_name) {
+		return false;
+	}
+	Array children = p_resource->get_meta("children", Array());
+	if (children.size() != p_sub_resources) {
+		return false;
+	}
+	for (int i = 0; i < p_sub_resources; i++) {
+		Ref<Resource> child = children[i];
+		if (child.is_null() || child->get_name() != vformat("%s/%d", p_name, i)) {
+			return false;
+		}
+		PackedFloat32Array values = child->get_meta("values", PackedFloat32Array());
+		if (values.size() != 16 || values[15] != i * 16 + 15) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Saves a scene with sub-resources of its own, referencing dependencies saved as separate files.
+static String _save_pipeline_scene(const String &p_prefix, int p_dependencies, int p_sub_resources) {
+	Ref<Resource> scene = _make_pipeline_resource("scene", p_sub_resources);
+	Array dependencies;
+	for (int i = 0; i < p_dependencies; i++) {
+		const String path = TestUtils::get_temp_path(vformat("%s_dependency_%d.res", p_prefix, i));
+		Ref<Resource> dependency = _make_pipeline_resource(vformat("dependency_%d", i), p_sub_resources);
+		ResourceSaver::save(dependency, path);
+		// Reference it by path without adding it to the cache, so it has to be loaded again.
+		dependency->set_path_cache(path);
+		dependencies.push_back(dependency);
+	}
+	scene->set_meta("dependencies", dependencies);
+	const String scene_path = TestUtils::get_temp_path(p_prefix + "_scene.res");
+	ResourceSaver::save(scene, scene_path);
+	return scene_path;
+}
+
+static bool _is_pipeline_scene(const Ref<Resource> &p_scene, int p_dependencies, int p_sub_resources) {
+	if (!_is_pipeline_resource(p_scene, "scene", p_sub_resources)) {
+		return false;
+	}
+	Array dependencies = p_scene->get_meta("dependencies", Array());
+	if (dependencies.size() != p_dependencies) {
+		return false;
+	}
+	for (int i = 0; i < p_dependencies; i++) {
+		if (!_is_pipeline_resource(dependencies[i], vformat("dependency_%d", i), p_sub_resources)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Resource] Pipelined loading") {
+	const String scene_path = _save_pipeline_scene("pipelined", 8, 16);
+
+	ResourceLoader::reset_pipeline_stats();
+	Ref<Resource> serial = ResourceLoader::load(scene_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP);
+	CHECK_MESSAGE(_is_pipeline_scene(serial, 8, 16), "The scene should load as saved.");
+	Dictionary stats = ResourceLoader::get_pipeline_stats();
+	CHECK_MESSAGE(int(stats["prefetch_hits"]) + int(stats["prefetch_misses"]) == 0, "Nothing should be read ahead unless pipelined loading is enabled.");
+	CHECK_MESSAGE(uint64_t(stats["parse_usec"]) > 0, "Parsing should be timed regardless.");
+
+	ResourceLoader::set_pipelined_loading(true);
+
+	SUBCASE("Loading from the current thread") {
+		ResourceLoader::reset_pipeline_stats();
+		Ref<Resource> pipelined = ResourceLoader::load(scene_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP);
+		stats = ResourceLoader::get_pipeline_stats();
+
+		CHECK_MESSAGE(_is_pipeline_scene(pipelined, 8, 16), "The scene should load the same as without pipelining.");
+		CHECK_MESSAGE(int(stats["prefetch_hits"]) == 8, "Every dependency should have been read ahead.");
+		CHECK_MESSAGE(int(stats["prefetch_misses"]) == 1, "Only the scene itself should have been read on demand.");
+		CHECK(int(stats["prefetch_dropped"]) == 0);
+		CHECK(uint64_t(stats["bytes_read"]) > 0);
+	}
+
+	SUBCASE("Loading with sub-threads") {
+		REQUIRE(ResourceLoader::load_threaded_request(scene_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP) == OK);
+		Ref<Resource> pipelined = ResourceLoader::load_threaded_get(scene_path);
+		CHECK_MESSAGE(_is_pipeline_scene(pipelined, 8, 16), "The scene should load the same as without pipelining.");
+	}
+
+	ResourceLoader::set_pipelined_loading(false);
+}
+
 } // namespace TestResource
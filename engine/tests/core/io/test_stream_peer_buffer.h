@@ -30,8 +30,10 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/stream_peer.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestStreamPeerBuffer {
 
@@ -179,4 +181,81 @@ TEST_CASE("[StreamPeerBuffer] Get data with invalid size returns an error") {
 	CHECK_EQ(spb->get_position(), 1);
 }
 
+TEST_CASE("[StreamPeerBuffer] Set data from a file") {
+	const String file_path = TestUtils::get_temp_path("stream_peer_buffer_data.bin");
+	Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+	REQUIRE(fw.is_valid());
+	for (uint32_t i = 0; i < 1024; i++) {
+		fw->store_32(i * 3);
+	}
+	fw->close();
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	Ref<StreamPeerBuffer> spb;
+	spb.instantiate();
+	CHECK(spb->set_data_file(f) == OK);
+	CHECK_EQ(spb->get_size(), 4096);
+	CHECK_EQ(spb->get_position(), 0);
+	spb->seek(400);
+	CHECK_EQ(spb->get_u32(), 300u);
+	CHECK_EQ(spb->get_available_bytes(), 4096 - 404);
+
+	Ref<StreamPeerBuffer> copy = spb->duplicate();
+	copy->seek(8);
+	CHECK_EQ(copy->get_u32(), 6u);
+
+	const Vector<uint8_t> data = spb->get_data_array();
+	CHECK_EQ(data.size(), 4096);
+	CHECK_EQ(data[4], 3);
+
+	// Writing works on a copy, the file and the duplicate are left alone.
+	spb->seek(4);
+	spb->put_u32(1234);
+	spb->seek(4);
+	CHECK_EQ(spb->get_u32(), 1234u);
+	CHECK_EQ(spb->get_size(), 4096);
+	copy->seek(4);
+	CHECK_EQ(copy->get_u32(), 3u);
+	f->seek(4);
+	CHECK_EQ(f->get_32(), 3u);
+
+	spb->clear();
+	copy->clear();
+	f->close();
+	DirAccess::remove_file_or_error(file_path);
+}
+
+TEST_CASE("[StreamPeerBuffer] Data from a file stays readable after the file is closed") {
+	const String file_path = TestUtils::get_temp_path("stream_peer_buffer_closed.bin");
+	Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+	REQUIRE(fw.is_valid());
+	for (uint32_t i = 0; i < 4096; i++) {
+		fw->store_32(i * 5);
+	}
+	fw->close();
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	Ref<StreamPeerBuffer> spb;
+	spb.instantiate();
+	CHECK(spb->set_data_file(f) == OK);
+	Ref<StreamPeerBuffer> copy = spb->duplicate();
+	f->close();
+	f.unref();
+
+	CHECK_EQ(spb->get_size(), 16384);
+	CHECK_EQ(spb->get_u8(), 0);
+	spb->seek(4 * 4095);
+	CHECK_EQ(spb->get_u32(), 4095u * 5);
+	copy->seek(40);
+	CHECK_EQ(copy->get_u32(), 50u);
+
+	spb->clear();
+	copy->clear();
+	DirAccess::remove_file_or_error(file_path);
+}
+
 } // namespace TestStreamPeerBuffer
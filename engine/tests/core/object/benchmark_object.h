@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  benchmark_object.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "tests/benchmark_runner.h"
+// Shares SignalCounter with the tests.
+#include "tests/core/object/test_object.h"
+
+namespace BenchmarkObject {
+
+// Emits a signal with one argument to `p_listener_count` connected callables.
+static void measure_emission(BenchmarkContext &p_context, int p_listener_count) {
+	Object source;
+	source.add_user_signal(MethodInfo("score_changed", PropertyInfo(Variant::INT, "score")));
+	LocalVector<TestObject::SignalCounter *> listeners;
+	for (int i = 0; i < p_listener_count; i++) {
+		TestObject::SignalCounter *listener = memnew(TestObject::SignalCounter);
+		source.connect("score_changed", callable_mp(listener, &TestObject::SignalCounter::callback1));
+		listeners.push_back(listener);
+	}
+
+	p_context.measure([&]() {
+		source.emit_signal(SNAME("score_changed"), 1);
+	});
+
+	for (TestObject::SignalCounter *listener : listeners) {
+		if (listener->count == 0) {
+			p_context.fail("A listener wasn't called.");
+		}
+		memdelete(listener);
+	}
+}
+
+static void benchmark_emit_1_listener(BenchmarkContext &p_context) {
+	measure_emission(p_context, 1);
+}
+
+static void benchmark_emit_16_listeners(BenchmarkContext &p_context) {
+	measure_emission(p_context, 16);
+}
+
+static void benchmark_emit_256_listeners(BenchmarkContext &p_context) {
+	measure_emission(p_context, 256);
+}
+
+REGISTER_BENCHMARK("core/object/emit_signal_1_listener", &benchmark_emit_1_listener);
+REGISTER_BENCHMARK("core/object/emit_signal_16_listeners", &benchmark_emit_16_listeners);
+REGISTER_BENCHMARK("core/object/emit_signal_256_listeners", &benchmark_emit_256_listeners);
+
+} // namespace BenchmarkObject
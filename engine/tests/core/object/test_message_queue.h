@@ -0,0 +1,251 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class Recorder : public Object {
+public:
+	LocalVector<int> values;
+	CallQueue *queue = nullptr;
+
+	void record(int p_value) {
+		values.push_back(p_value);
+	}
+
+	// Has another thread push the next value and waits for it, then pushes the one after.
+	void record_and_wait_for_thread(int p_value) {
+		values.push_back(p_value);
+		Thread thread;
+		thread.start(push_next_from_thread, this);
+		thread.wait_to_finish();
+		queue->push_callable(callable_mp(this, &Recorder::record), p_value + 2);
+	}
+
+	static void push_next_from_thread(void *p_userdata) {
+		Recorder *recorder = (Recorder *)p_userdata;
+		recorder->queue->push_callable(callable_mp(recorder, &Recorder::record), recorder->values[recorder->values.size() - 1] + 1);
+	}
+
+	void record_and_push(int p_value) {
+		values.push_back(p_value);
+		if (p_value < 3) {
+			queue->push_callable(callable_mp(this, &Recorder::record_and_push), p_value + 1);
+		}
+	}
+};
+
+struct PushThreadData {
+	CallQueue *queue = nullptr;
+	Recorder *recorder = nullptr;
+	int base = 0;
+	int count = 0;
+};
+
+static void push_from_thread(void *p_userdata) {
+	PushThreadData *data = (PushThreadData *)p_userdata;
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable_mp(data->recorder, &Recorder::record), data->base + i);
+	}
+}
+
+TEST_CASE("[CallQueue] Calls are flushed in posting order") {
+	CallQueue queue;
+	Recorder recorder;
+
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.get_max_buffer_usage() == 0);
+
+	// Enough calls to span several pages.
+	const int call_count = 1000;
+	for (int i = 0; i < call_count; i++) {
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), i);
+	}
+
+	CHECK(queue.has_messages());
+	CHECK(queue.get_page_high_water_mark() > 1);
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(recorder.values.size() == uint32_t(call_count));
+	for (int i = 0; i < call_count; i++) {
+		CHECK(recorder.values[i] == i);
+	}
+
+	CHECK(queue.get_push_count() == uint64_t(call_count));
+	CHECK(queue.get_flush_count() == 1);
+	CHECK(queue.get_max_buffer_usage() == int(queue.get_page_high_water_mark() * CallQueue::PAGE_SIZE_BYTES));
+}
+
+TEST_CASE("[CallQueue] Calls pushed while flushing are processed in the same flush") {
+	CallQueue queue;
+	Recorder recorder;
+
+	recorder.queue = &queue;
+	queue.push_callable(callable_mp(&recorder, &Recorder::record_and_push), 0);
+	CHECK(queue.flush() == OK);
+
+	REQUIRE(recorder.values.size() == 4);
+	for (int i = 0; i < 4; i++) {
+		CHECK(recorder.values[i] == i);
+	}
+	CHECK(queue.get_flush_count() == 1);
+}
+
+TEST_CASE("[CallQueue] Calls from several threads are merged in posting order") {
+	CallQueue queue;
+	Recorder recorder;
+
+	queue.push_callable(callable_mp(&recorder, &Recorder::record), 0);
+
+	PushThreadData data;
+	data.queue = &queue;
+	data.recorder = &recorder;
+	data.base = 1;
+	data.count = 1;
+	Thread thread;
+	thread.start(push_from_thread, &data);
+	thread.wait_to_finish();
+
+	queue.push_callable(callable_mp(&recorder, &Recorder::record), 2);
+
+	CHECK(queue.flush() == OK);
+	REQUIRE(recorder.values.size() == 3);
+	CHECK(recorder.values[0] == 0);
+	CHECK(recorder.values[1] == 1);
+	CHECK(recorder.values[2] == 2);
+}
+
+TEST_CASE("[CallQueue] Calls keep their posting order when a flushed call waits for another thread") {
+	CallQueue queue;
+	Recorder recorder;
+	recorder.queue = &queue;
+
+	// Only this thread's buffer has messages when the flush starts.
+	queue.push_callable(callable_mp(&recorder, &Recorder::record_and_wait_for_thread), 0);
+	CHECK(queue.flush() == OK);
+
+	REQUIRE(recorder.values.size() == 3);
+	CHECK(recorder.values[0] == 0);
+	CHECK_MESSAGE(recorder.values[1] == 1, "The call pushed by the other thread was posted first.");
+	CHECK(recorder.values[2] == 2);
+}
+
+TEST_CASE("[CallQueue] Buffers of exited threads are reclaimed") {
+	CallQueue queue;
+	Recorder recorder;
+
+	const int thread_count = 32;
+	PushThreadData data;
+	data.queue = &queue;
+	data.recorder = &recorder;
+	data.count = 1;
+	for (int i = 0; i < thread_count; i++) {
+		data.base = i;
+		Thread thread;
+		thread.start(push_from_thread, &data);
+		thread.wait_to_finish();
+		CHECK(queue.flush() == OK);
+	}
+
+	REQUIRE(recorder.values.size() == uint32_t(thread_count));
+	CHECK(recorder.values[thread_count - 1] == thread_count - 1);
+	CHECK_MESSAGE(queue.get_page_count() == 0, "The pages of threads that exited should be freed.");
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[CallQueue] Concurrent producers") {
+	CallQueue queue;
+	Recorder recorder;
+
+	const int thread_count = 4;
+	const int calls_per_thread = 5000;
+
+	PushThreadData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].queue = &queue;
+		data[i].recorder = &recorder;
+		data[i].base = i * calls_per_thread;
+		data[i].count = calls_per_thread;
+		threads[i].start(push_from_thread, &data[i]);
+	}
+
+	// Flush concurrently with the producers, then once more after they are done.
+	while (queue.get_push_count() < uint64_t(thread_count * calls_per_thread / 2)) {
+		queue.flush();
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	queue.flush();
+
+	REQUIRE(recorder.values.size() == uint32_t(thread_count * calls_per_thread));
+
+	// Calls made by the same thread must keep their relative order.
+	int last_seen[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		last_seen[i] = -1;
+	}
+	bool ordered = true;
+	for (int value : recorder.values) {
+		int thread_index = value / calls_per_thread;
+		int call_index = value % calls_per_thread;
+		if (call_index != last_seen[thread_index] + 1) {
+			ordered = false;
+		}
+		last_seen[thread_index] = call_index;
+	}
+	CHECK(ordered);
+	CHECK(queue.get_push_count() == uint64_t(thread_count * calls_per_thread));
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[CallQueue] Clear discards pending calls") {
+	CallQueue queue;
+	Recorder recorder;
+
+	for (int i = 0; i < 10; i++) {
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), i);
+	}
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+
+	CHECK(queue.flush() == OK);
+	CHECK(recorder.values.is_empty());
+}
+
+} // namespace TestMessageQueue
@@ -339,6 +339,41 @@ public:
 	}
 };
 
+class SignalCounter : public Object {
+	GDCLASS(SignalCounter, Object);
+
+public:
+	int count = 0;
+
+	void callback0() {
+		count++;
+	}
+
+	void callback1(int p_value) {
+		count += p_value;
+	}
+};
+
+class SignalConnectionModifier : public Object {
+	GDCLASS(SignalConnectionModifier, Object);
+
+public:
+	Object *source = nullptr;
+	Callable to_connect;
+	Callable to_disconnect;
+
+	void callback0() {
+		if (to_disconnect.is_valid()) {
+			source->disconnect("my_custom_signal", to_disconnect);
+			to_disconnect = Callable();
+		}
+		if (to_connect.is_valid()) {
+			source->connect("my_custom_signal", to_connect);
+			to_connect = Callable();
+		}
+	}
+};
+
 TEST_CASE("[Object] Signals") {
 	Object object;
 
@@ -479,6 +514,44 @@ TEST_CASE("[Object] Signals") {
 		CHECK(signal_connections.size() == 0);
 	}
 
+	SUBCASE("Changing connections during emission should only affect the next emission") {
+		SignalCounter disconnected;
+		SignalCounter connected;
+		SignalConnectionModifier modifier;
+		modifier.source = &object;
+		modifier.to_disconnect = callable_mp(&disconnected, &SignalCounter::callback0);
+		modifier.to_connect = callable_mp(&connected, &SignalCounter::callback0);
+
+		object.connect("my_custom_signal", callable_mp(&modifier, &SignalConnectionModifier::callback0));
+		object.connect("my_custom_signal", callable_mp(&disconnected, &SignalCounter::callback0));
+
+		object.emit_signal("my_custom_signal");
+		CHECK(disconnected.count == 1);
+		CHECK(connected.count == 0);
+
+		object.emit_signal("my_custom_signal");
+		CHECK(disconnected.count == 1);
+		CHECK(connected.count == 1);
+
+		object.disconnect("my_custom_signal", callable_mp(&modifier, &SignalConnectionModifier::callback0));
+		object.disconnect("my_custom_signal", callable_mp(&connected, &SignalCounter::callback0));
+	}
+
+	SUBCASE("One-shot connections should only be called once") {
+		SignalCounter one_shot;
+		SignalCounter persistent;
+		object.connect("my_custom_signal", callable_mp(&one_shot, &SignalCounter::callback0), Object::CONNECT_ONE_SHOT);
+		object.connect("my_custom_signal", callable_mp(&persistent, &SignalCounter::callback0));
+
+		object.emit_signal("my_custom_signal");
+		object.emit_signal("my_custom_signal");
+		CHECK(one_shot.count == 1);
+		CHECK(persistent.count == 2);
+		CHECK_FALSE(object.is_connected("my_custom_signal", callable_mp(&one_shot, &SignalCounter::callback0)));
+
+		object.disconnect("my_custom_signal", callable_mp(&persistent, &SignalCounter::callback0));
+	}
+
 	SUBCASE("Connecting with CONNECT_APPEND_SOURCE_OBJECT flag") {
 		SignalReceiver target;
 
@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  benchmark_string.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "core/string/ustring.h"
+
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkString {
+
+static const int TEXT_LENGTH = 4 * 1024 * 1024;
+
+// Mostly ASCII with the odd accented letter, like the metadata of a song list.
+static String create_ascii_heavy_text() {
+	RandomPCG rng(42);
+	String text;
+	text.resize_uninitialized(TEXT_LENGTH + 1);
+	char32_t *w = text.ptrw();
+	for (int i = 0; i < TEXT_LENGTH; i++) {
+		w[i] = i % 97 == 0 ? char32_t(U'\u00e0' + rng.rand() % 24) : char32_t(U'a' + rng.rand() % 26);
+	}
+	w[TEXT_LENGTH] = 0;
+	return text;
+}
+
+// Mostly CJK with ASCII spaces and punctuation.
+static String create_cjk_heavy_text() {
+	RandomPCG rng(42);
+	String text;
+	text.resize_uninitialized(TEXT_LENGTH + 1);
+	char32_t *w = text.ptrw();
+	for (int i = 0; i < TEXT_LENGTH; i++) {
+		w[i] = i % 23 == 0 ? U' ' : char32_t(U'\u4e00' + rng.rand() % 0x5000);
+	}
+	w[TEXT_LENGTH] = 0;
+	return text;
+}
+
+static void measure_decode(BenchmarkContext &p_context, const String &p_text) {
+	const CharString utf8 = p_text.utf8();
+	p_context.measure([&]() {
+		if (String::utf8(utf8.get_data(), utf8.length()).length() != TEXT_LENGTH) {
+			p_context.fail("The decoded text has the wrong length.");
+		}
+	});
+}
+
+static void measure_encode(BenchmarkContext &p_context, const String &p_text) {
+	p_context.measure([&]() {
+		if (p_text.utf8().length() < TEXT_LENGTH) {
+			p_context.fail("The encoded text is too short.");
+		}
+	});
+}
+
+static void benchmark_decode_ascii_heavy(BenchmarkContext &p_context) {
+	measure_decode(p_context, create_ascii_heavy_text());
+}
+
+static void benchmark_decode_cjk_heavy(BenchmarkContext &p_context) {
+	measure_decode(p_context, create_cjk_heavy_text());
+}
+
+static void benchmark_encode_ascii_heavy(BenchmarkContext &p_context) {
+	measure_encode(p_context, create_ascii_heavy_text());
+}
+
+static void benchmark_encode_cjk_heavy(BenchmarkContext &p_context) {
+	measure_encode(p_context, create_cjk_heavy_text());
+}
+
+REGISTER_BENCHMARK("core/string/utf8_decode_ascii_heavy", &benchmark_decode_ascii_heavy);
+REGISTER_BENCHMARK("core/string/utf8_decode_cjk_heavy", &benchmark_decode_cjk_heavy);
+REGISTER_BENCHMARK("core/string/utf8_encode_ascii_heavy", &benchmark_encode_ascii_heavy);
+REGISTER_BENCHMARK("core/string/utf8_encode_cjk_heavy", &benchmark_encode_cjk_heavy);
+
+} // namespace BenchmarkString
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -216,6 +218,110 @@ TEST_CASE("[String] Invalid UTF8 (truncated sequences)") {
 	ERR_PRINT_ON
 }
 
+// Text whose runs of ASCII, Cyrillic, CJK and emoji start and end at every offset of a 16-byte block.
+String _make_mixed_text(uint64_t p_seed, int p_runs) {
+	static const char32_t run_starts[] = { U'a', U'\u0430', U'\u4e00', U'\u3041', U'\U0001f600', U'\u00e0' };
+	RandomPCG rng(p_seed);
+	String text;
+	for (int i = 0; i < p_runs; i++) {
+		const char32_t start = run_starts[rng.rand() % std::size(run_starts)];
+		const int length = rng.rand() % 40;
+		for (int j = 0; j < length; j++) {
+			text += char32_t(start + rng.rand() % 24);
+		}
+	}
+	return text;
+}
+
+TEST_CASE("[String] UTF8 long mixed text") {
+	for (int seed = 0; seed < 64; seed++) {
+		const String text = _make_mixed_text(seed, 1 + seed);
+
+		// Reference encoding, one code point at a time.
+		Vector<uint8_t> expected;
+		Vector<uint8_t> expected_map;
+		for (int i = 0; i < text.length(); i++) {
+			const uint32_t c = text[i];
+			if (c <= 0x7f) {
+				expected.push_back(c);
+				expected_map.push_back(1);
+			} else if (c <= 0x7ff) {
+				expected.push_back(0xc0 | (c >> 6));
+				expected.push_back(0x80 | (c & 0x3f));
+				expected_map.push_back(2);
+			} else if (c <= 0xffff) {
+				expected.push_back(0xe0 | (c >> 12));
+				expected.push_back(0x80 | ((c >> 6) & 0x3f));
+				expected.push_back(0x80 | (c & 0x3f));
+				expected_map.push_back(3);
+			} else {
+				expected.push_back(0xf0 | (c >> 18));
+				expected.push_back(0x80 | ((c >> 12) & 0x3f));
+				expected.push_back(0x80 | ((c >> 6) & 0x3f));
+				expected.push_back(0x80 | (c & 0x3f));
+				expected_map.push_back(4);
+			}
+		}
+
+		Vector<uint8_t> map;
+		const CharString cs = text.utf8(&map);
+		REQUIRE(cs.length() == expected.size());
+		CHECK(memcmp(cs.get_data(), expected.ptr(), expected.size()) == 0);
+		CHECK(map == expected_map);
+
+		// Decode from every offset, so the bulk paths see every alignment and every cut sequence at the end.
+		for (int offset = 0; offset < 16 && offset < text.length(); offset++) {
+			const CharString tail = text.substr(offset).utf8();
+			String decoded;
+			CHECK(decoded.append_utf8(tail.get_data(), tail.length()) == OK);
+			CHECK(decoded == text.substr(offset));
+		}
+	}
+}
+
+TEST_CASE("[String] Invalid UTF8 inside long text") {
+	ERR_PRINT_OFF
+	// The ill-formed sequences from the tests above, each followed by ASCII so they decode the same anywhere.
+	static const uint8_t samples[][9] = {
+		{ 0xC0, 0xAF, 0xE0, 0x80, 0xBF, 0xF0, 0x81, 0x82, 0x41 },
+		{ 0xED, 0xA0, 0x80, 0xED, 0xBF, 0xBF, 0xED, 0xAF, 0x41 },
+		{ 0xF4, 0x91, 0x92, 0x93, 0xFF, 0x41, 0x80, 0xBF, 0x42 },
+		{ 0xE1, 0x80, 0xE2, 0xF0, 0x91, 0x92, 0xF1, 0xBF, 0x41 },
+	};
+
+	const CharString text = _make_mixed_text(7, 24).utf8();
+	for (const uint8_t *sample : samples) {
+		String expected_sample;
+		CHECK(expected_sample.append_utf8((const char *)sample, 9) == ERR_INVALID_DATA);
+
+		// Insert the sample at the start of each sequence of the text.
+		for (int at = 0; at < text.length(); at++) {
+			if ((uint8_t(text[at]) & 0xc0) == 0x80) {
+				continue;
+			}
+			Vector<uint8_t> bytes;
+			bytes.resize(text.length() + 9);
+			memcpy(bytes.ptrw(), text.get_data(), at);
+			memcpy(bytes.ptrw() + at, sample, 9);
+			memcpy(bytes.ptrw() + at + 9, text.get_data() + at, text.length() - at);
+
+			String s;
+			CHECK(s.append_utf8((const char *)bytes.ptr(), bytes.size()) == ERR_INVALID_DATA);
+			CHECK(s == String::utf8(text.get_data(), at) + expected_sample + String::utf8(text.get_data() + at, text.length() - at));
+		}
+	}
+	ERR_PRINT_ON
+
+	// A NUL byte ends decoding, wherever it is.
+	for (int at = 0; at < 40; at++) {
+		CharString ascii = String("0123456789").repeat(6).utf8();
+		ascii.set(at, 0);
+		String s;
+		CHECK(s.append_utf8(ascii.get_data(), ascii.length()) == OK);
+		CHECK(s.length() == at);
+	}
+}
+
 TEST_CASE("[String] Invalid UTF16 (non-standard)") {
 	ERR_PRINT_OFF
 	static const char16_t u16str[] = { 0x0045, 0x304A, 0x3088, 0x3046, 0xDFA4, 0 };
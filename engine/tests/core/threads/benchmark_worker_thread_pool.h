@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  benchmark_worker_thread_pool.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkWorkerThreadPool {
+
+static void native_task(void *p_userdata) {
+	SafeNumeric<uint32_t> *counter = (SafeNumeric<uint32_t> *)p_userdata;
+	counter->increment();
+}
+
+static void group_task(void *p_userdata, uint32_t p_index) {
+	float *values = (float *)p_userdata;
+	values[p_index] = Math::sqrt(float(p_index)) * 0.5f;
+}
+
+// Latency of a single task, from being added to being waited for.
+static void benchmark_native_task(BenchmarkContext &p_context) {
+	SafeNumeric<uint32_t> counter;
+	p_context.measure([&]() {
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&native_task, &counter);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	});
+}
+
+// Overhead of splitting a small workload in a group task.
+static void benchmark_group_task(BenchmarkContext &p_context) {
+	LocalVector<float> values;
+	values.resize(4096);
+	p_context.measure([&]() {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&group_task, values.ptr(), values.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	});
+}
+
+REGISTER_BENCHMARK("core/worker_thread_pool/native_task", &benchmark_native_task);
+REGISTER_BENCHMARK("core/worker_thread_pool/group_task", &benchmark_group_task);
+
+} // namespace BenchmarkWorkerThreadPool
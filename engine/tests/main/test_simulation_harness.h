@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_simulation_harness.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/input/input.h"
+#include "core/io/file_access.h"
+#include "main/simulation_harness.h"
+#include "scene/main/scene_tree.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestSimulationHarness {
+
+static String write_timeline(const String &p_json) {
+	const String path = TestUtils::get_temp_path("simulation_timeline.json");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_string(p_json);
+	return path;
+}
+
+// Runs frames until the harness asks to stop, returns how many ran.
+static uint64_t run(SimulationHarness &p_harness, uint64_t p_max_frames = 100000) {
+	uint64_t frames = 0;
+	while (frames < p_max_frames) {
+		p_harness.begin_frame();
+		frames++;
+		if (p_harness.end_frame(0)) {
+			break;
+		}
+	}
+	return frames;
+}
+
+static void stop_sampling() {
+	SceneTree::get_singleton()->get_process_sampler().set_enabled(false);
+	SceneTree::get_singleton()->get_process_sampler().clear();
+}
+
+static uint64_t step_time_usec = 0;
+static uint32_t step_count = 0;
+
+static void record_step(uint64_t p_time_usec) {
+	step_time_usec = p_time_usec;
+	step_count++;
+}
+
+TEST_CASE("[SceneTree][SimulationHarness] Invalid timelines are rejected") {
+	SimulationHarness harness;
+
+	ERR_PRINT_OFF;
+	harness.set_timeline_path(TestUtils::get_temp_path("missing_timeline.json"));
+	CHECK(harness.start(60) == ERR_FILE_CANT_OPEN);
+
+	harness.set_timeline_path(write_timeline("{ \"events\": [ "));
+	CHECK(harness.start(60) == ERR_PARSE_ERROR);
+
+	harness.set_timeline_path(write_timeline("[]"));
+	CHECK_MESSAGE(harness.start(60) == ERR_PARSE_ERROR, "The timeline must be an object.");
+
+	harness.set_timeline_path(write_timeline(R"({ "events": [ { "action": "jump" } ] })"));
+	CHECK_MESSAGE(harness.start(60) == ERR_PARSE_ERROR, "Events need a time.");
+
+	harness.set_timeline_path(write_timeline(R"({ "events": [ { "time": 1.0 } ] })"));
+	CHECK_MESSAGE(harness.start(60) == ERR_PARSE_ERROR, "Events need an input.");
+
+	harness.set_timeline_path(write_timeline(R"({ "events": [ { "time": 1.0, "key": "NotAKey" } ] })"));
+	CHECK(harness.start(60) == ERR_PARSE_ERROR);
+
+	harness.set_timeline_path(write_timeline(R"({ "events": [ { "time": 2.0, "action": "jump" }, { "time": 1.0, "action": "jump" } ] })"));
+	CHECK_MESSAGE(harness.start(60) == ERR_PARSE_ERROR, "Events must be sorted by time.");
+
+	harness.set_timeline_path(write_timeline(R"({ "events": [] })"));
+	CHECK(harness.start(0) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	CHECK_FALSE(harness.is_active());
+}
+
+TEST_CASE("[SceneTree][SimulationHarness] Runs for the duration on a fixed step") {
+	SimulationHarness harness;
+	harness.set_timeline_path(write_timeline(R"({ "duration": 2.0, "events": [] })"));
+	REQUIRE(harness.start(60) == OK);
+	CHECK(harness.is_active());
+
+	CHECK(run(harness) == 120);
+	CHECK(harness.get_frame_count() == 120);
+	CHECK(harness.get_time_usec() == 119 * 1000000 / 60);
+
+	// Without a duration, the run lasts two seconds past the last event.
+	SimulationHarness harness_without_duration;
+	harness_without_duration.set_timeline_path(write_timeline(R"({ "events": [ { "time": 1.0, "action": "jump" }, { "time": 1.0, "action": "jump", "pressed": false } ] })"));
+	REQUIRE(harness_without_duration.start(100) == OK);
+	CHECK(run(harness_without_duration) == 300);
+
+	stop_sampling();
+}
+
+TEST_CASE("[SceneTree][SimulationHarness] finish() ends the run after the current frame") {
+	SimulationHarness harness;
+	harness.set_timeline_path(write_timeline(R"({ "duration": 10.0, "events": [] })"));
+	REQUIRE(harness.start(60) == OK);
+
+	for (int i = 0; i < 10; i++) {
+		harness.begin_frame();
+		CHECK_FALSE(harness.end_frame(0));
+	}
+	harness.begin_frame();
+	harness.finish();
+	CHECK(harness.end_frame(0));
+	CHECK(harness.get_frame_count() == 11);
+
+	stop_sampling();
+}
+
+TEST_CASE("[SceneTree][SimulationHarness] Events are injected at the first frame that reaches their time") {
+	SimulationHarness harness;
+	// At 60 FPS, 0.5 s is the start of frame 30, and 0.52 s falls between frames 31 and 32.
+	harness.set_timeline_path(write_timeline(R"({ "duration": 1.0, "events": [ { "time": 0.5, "key": "A" }, { "time": 0.52, "key": "A", "pressed": false } ] })"));
+	REQUIRE(harness.start(60) == OK);
+	Input::get_singleton()->take_frame_input_ticks_usec();
+
+	for (int frame = 0; frame < 40; frame++) {
+		harness.begin_frame();
+		const uint64_t input_ticks_usec = Input::get_singleton()->take_frame_input_ticks_usec();
+		if (frame == 30 || frame == 32) {
+			// Stamped in the ticks clock, at the start of the frame that received them.
+			CHECK(input_ticks_usec == harness.get_frame_ticks_usec());
+		} else {
+			CHECK(input_ticks_usec == 0);
+		}
+		CHECK_MESSAGE(Input::get_singleton()->is_key_pressed(Key::A) == (frame == 30 || frame == 31), vformat("Frame %d.", frame));
+		harness.end_frame(0);
+	}
+
+	CHECK(int(harness.make_report()["injected_events"]) == 2);
+
+	stop_sampling();
+}
+
+TEST_CASE("[SceneTree][SimulationHarness] Step callbacks follow the simulated clock") {
+	SimulationHarness harness;
+	harness.set_timeline_path(write_timeline(R"({ "duration": 1.0, "events": [] })"));
+	REQUIRE(harness.start(50) == OK);
+
+	step_count = 0;
+	harness.add_step_callback(&record_step);
+	ERR_PRINT_OFF;
+	harness.add_step_callback(&record_step);
+	ERR_PRINT_ON;
+
+	for (int i = 0; i < 10; i++) {
+		harness.begin_frame();
+		CHECK(step_time_usec == uint64_t(i) * 20000);
+		harness.end_frame(0);
+	}
+	CHECK_MESSAGE(step_count == 10, "Adding a callback twice runs it once.");
+
+	harness.remove_step_callback(&record_step);
+	harness.begin_frame();
+	CHECK(step_count == 10);
+
+	stop_sampling();
+}
+
+} // namespace TestSimulationHarness
@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  benchmark_node.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/benchmark_runner.h"
+#include "tests/test_utils.h"
+// Shares TestGroupNode with the tests.
+#include "tests/scene/test_node.h"
+
+namespace BenchmarkNode {
+
+static const int NODE_COUNT = 10000;
+
+static void benchmark_call_group(BenchmarkContext &p_context) {
+	GDREGISTER_CLASS(TestNode::TestGroupNode);
+
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+	LocalVector<TestNode::TestGroupNode *> nodes;
+	for (int i = 0; i < NODE_COUNT; i++) {
+		TestNode::TestGroupNode *node = memnew(TestNode::TestGroupNode);
+		parent->add_child(node);
+		node->add_to_group("notes");
+		nodes.push_back(node);
+	}
+
+	int calls = 0;
+	p_context.measure([&]() {
+		SceneTree::get_singleton()->call_group("notes", "add_score", 1);
+		calls++;
+	});
+
+	for (const TestNode::TestGroupNode *node : nodes) {
+		if (node->score != calls) {
+			p_context.fail("A node missed a group call.");
+			break;
+		}
+	}
+	memdelete(parent);
+}
+
+REGISTER_BENCHMARK("scene/node/call_group_10000_nodes", &benchmark_call_group);
+
+} // namespace BenchmarkNode
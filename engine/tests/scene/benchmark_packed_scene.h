@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  benchmark_packed_scene.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/resources/packed_scene.h"
+
+#include "tests/benchmark_runner.h"
+// Shares _create_transformed_scene() with the tests.
+#include "tests/scene/test_packed_scene.h"
+
+namespace BenchmarkPackedScene {
+
+static const int NODE_COUNT = 20;
+
+static void benchmark_instantiate(BenchmarkContext &p_context) {
+	Node *scene = TestPackedScene::_create_transformed_scene(NODE_COUNT);
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+	memdelete(scene);
+
+	p_context.measure([&]() {
+		Node *instance = packed_scene.instantiate();
+		if (!instance) {
+			p_context.fail("Instantiation failed.");
+			return;
+		}
+		memdelete(instance);
+	});
+}
+
+static void benchmark_instantiate_recycled(BenchmarkContext &p_context) {
+	Node *scene = TestPackedScene::_create_transformed_scene(NODE_COUNT);
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+	memdelete(scene);
+	packed_scene.set_recycle_pool_size(1);
+
+	p_context.measure([&]() {
+		Node *instance = packed_scene.instantiate();
+		if (!instance) {
+			p_context.fail("Instantiation failed.");
+			return;
+		}
+		if (!packed_scene.recycle(instance)) {
+			memdelete(instance);
+		}
+	});
+}
+
+REGISTER_BENCHMARK("scene/packed_scene/instantiate_20_nodes", &benchmark_instantiate);
+REGISTER_BENCHMARK("scene/packed_scene/instantiate_20_nodes_recycled", &benchmark_instantiate_recycled);
+
+} // namespace BenchmarkPackedScene
@@ -502,6 +502,82 @@ TEST_CASE("[SceneTree][Node] Testing node operations with a more complex simple
 	memdelete(node2);
 }
 
+class TestGroupNode : public Node {
+	GDCLASS(TestGroupNode, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("add_score", "score"), &TestGroupNode::add_score);
+	}
+
+public:
+	int score = 0;
+	Vector<Node *> *callback_list = nullptr;
+	Node *remove_on_call = nullptr;
+
+	void add_score(int p_score) {
+		score += p_score;
+		if (callback_list) {
+			callback_list->push_back(this);
+		}
+		if (remove_on_call) {
+			remove_on_call->get_parent()->remove_child(remove_on_call);
+			remove_on_call = nullptr;
+		}
+	}
+};
+
+TEST_CASE("[SceneTree][Node] Calling a method on a group") {
+	GDREGISTER_CLASS(TestGroupNode);
+
+	Vector<Node *> call_order;
+	Node *root = SceneTree::get_singleton()->get_root();
+
+	TestGroupNode *note1 = memnew(TestGroupNode);
+	TestGroupNode *note2 = memnew(TestGroupNode);
+	TestGroupNode *note3 = memnew(TestGroupNode);
+	Node *plain = memnew(Node); // Doesn't have the method, should be skipped silently.
+	for (Node *node : { (Node *)note1, plain, (Node *)note2, (Node *)note3 }) {
+		root->add_child(node);
+		node->add_to_group("notes");
+	}
+	note1->callback_list = &call_order;
+	note2->callback_list = &call_order;
+	note3->callback_list = &call_order;
+
+	SUBCASE("Nodes are called in tree order") {
+		SceneTree::get_singleton()->call_group("notes", "add_score", 2);
+		CHECK_EQ(note1->score, 2);
+		CHECK_EQ(note2->score, 2);
+		CHECK_EQ(note3->score, 2);
+		CHECK(call_order == Vector<Node *>({ note1, note2, note3 }));
+
+		call_order.clear();
+		SceneTree::get_singleton()->call_group_flags(SceneTree::GROUP_CALL_REVERSE, "notes", "add_score", 1);
+		CHECK_EQ(note1->score, 3);
+		CHECK(call_order == Vector<Node *>({ note3, note2, note1 }));
+	}
+
+	SUBCASE("Nodes removed from the tree during the call are skipped") {
+		note1->remove_on_call = note2;
+		SceneTree::get_singleton()->call_group("notes", "add_score", 1);
+		CHECK_EQ(note1->score, 1);
+		CHECK_EQ(note2->score, 0);
+		CHECK_EQ(note3->score, 1);
+		CHECK_FALSE(note2->is_inside_tree());
+
+		SceneTree::get_singleton()->call_group("notes", "add_score", 1);
+		CHECK_EQ(note1->score, 2);
+		CHECK_EQ(note2->score, 0);
+		CHECK_EQ(note3->score, 2);
+	}
+
+	memdelete(note1);
+	memdelete(plain);
+	memdelete(note2);
+	memdelete(note3);
+}
+
 TEST_CASE("[SceneTree][Node] Duplicating node with internal children") {
 	GDREGISTER_CLASS(TestNode);
 
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -280,4 +281,147 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+// Builds a scene like the notes spawned during gameplay: a root with a few levels of transformed children.
+static Node *_create_transformed_scene(int p_node_count) {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Note");
+	root->set_position(Vector2(10, 20));
+	root->add_to_group("notes", true);
+
+	for (int i = 1; i < p_node_count; i++) {
+		Node2D *child = memnew(Node2D);
+		child->set_name(vformat("Part%d", i));
+		child->set_position(Vector2(i, -i));
+		child->set_rotation(0.1 * i);
+		child->set_z_index(i % 4);
+		Node *parent = i > 3 ? root->get_child((i - 1) % 3) : root;
+		parent->add_child(child);
+		child->set_owner(root);
+	}
+	root->get_child(0)->set_meta("lane", 2);
+	return root;
+}
+
+TEST_CASE("[PackedScene] Instantiate Packed Scene With Properties") {
+	Node *scene = _create_transformed_scene(8);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	Node2D *first = Object::cast_to<Node2D>(packed_scene.instantiate());
+	Node2D *second = Object::cast_to<Node2D>(packed_scene.instantiate());
+	REQUIRE(first != nullptr);
+	REQUIRE(second != nullptr);
+
+	CHECK(first->get_position() == Vector2(10, 20));
+	CHECK(first->is_in_group("notes"));
+	CHECK(first->get_child(0)->get_meta("lane") == Variant(2));
+
+	for (int i = 1; i < 8; i++) {
+		const Node2D *part = Object::cast_to<Node2D>(first->find_child(vformat("Part%d", i), true, false));
+		REQUIRE(part != nullptr);
+		CHECK(part->get_owner() == first);
+		CHECK(part->get_position() == Vector2(i, -i));
+		CHECK(part->get_rotation() == doctest::Approx(0.1 * i));
+		CHECK(part->get_z_index() == i % 4);
+	}
+
+	// Instances don't share state.
+	first->set_position(Vector2(-1, -1));
+	CHECK(second->get_position() == Vector2(10, 20));
+
+	memdelete(scene);
+	memdelete(first);
+	memdelete(second);
+}
+
+TEST_CASE("[PackedScene] Recycle Instances") {
+	Node *scene = _create_transformed_scene(4);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	Node2D *instance = Object::cast_to<Node2D>(packed_scene.instantiate());
+	REQUIRE(instance != nullptr);
+
+	SUBCASE("Recycling is disabled by default") {
+		CHECK_FALSE(packed_scene.recycle(instance));
+		CHECK(packed_scene.get_recycled_count() == 0);
+		memdelete(instance);
+	}
+
+	SUBCASE("Recycled instances are reset and reused") {
+		packed_scene.set_recycle_pool_size(2);
+
+		Node2D *part = Object::cast_to<Node2D>(instance->get_child(0));
+		instance->set_position(Vector2(500, 500));
+		instance->remove_from_group("notes");
+		part->set_z_index(10);
+
+		CHECK(packed_scene.recycle(instance));
+		CHECK(packed_scene.get_recycled_count() == 1);
+
+		Node2D *reused = Object::cast_to<Node2D>(packed_scene.instantiate());
+		CHECK(reused == instance);
+		CHECK(packed_scene.get_recycled_count() == 0);
+		CHECK(reused->get_position() == Vector2(10, 20));
+		CHECK(reused->is_in_group("notes"));
+		CHECK(part->get_z_index() == 1);
+
+		memdelete(reused);
+	}
+
+	SUBCASE("Modified instances are rejected") {
+		packed_scene.set_recycle_pool_size(2);
+
+		Node *extra = memnew(Node);
+		instance->add_child(extra);
+		CHECK_FALSE(packed_scene.recycle(instance));
+
+		memdelete(extra);
+		instance->get_child(0)->set_name("Renamed");
+		CHECK_FALSE(packed_scene.recycle(instance));
+		CHECK(packed_scene.get_recycled_count() == 0);
+
+		memdelete(instance);
+	}
+
+	SUBCASE("Instances of other scenes are rejected") {
+		packed_scene.set_recycle_pool_size(2);
+
+		PackedScene other_scene;
+		other_scene.set_path("res://other_note.tscn");
+		other_scene.pack(scene);
+		Node *other = other_scene.instantiate();
+
+		CHECK_FALSE(packed_scene.recycle(other));
+
+		memdelete(other);
+		memdelete(instance);
+	}
+
+	SUBCASE("Instances freed while pooled aren't reused") {
+		packed_scene.set_recycle_pool_size(2);
+		CHECK(packed_scene.recycle(instance));
+		memdelete(instance);
+
+		Node *fresh = packed_scene.instantiate();
+		REQUIRE(fresh != nullptr);
+		CHECK(fresh->get_child_count() == 3);
+		CHECK(packed_scene.get_recycled_count() == 0);
+
+		memdelete(fresh);
+	}
+
+	SUBCASE("Packing again frees the pool") {
+		packed_scene.set_recycle_pool_size(2);
+		CHECK(packed_scene.recycle(instance));
+
+		packed_scene.pack(scene);
+		CHECK(packed_scene.get_recycled_count() == 0);
+	}
+
+	memdelete(scene);
+}
+
 } // namespace TestPackedScene
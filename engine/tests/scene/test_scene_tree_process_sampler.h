@@ -0,0 +1,159 @@
+/**************************************************************************/
+/*  test_scene_tree_process_sampler.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneTreeProcessSampler {
+
+TEST_CASE("[SceneTreeProcessSampler][SceneTree] Ring buffer statistics") {
+	Node *node = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+
+	SceneTreeProcessSampler sampler;
+	sampler.set_window_size(100);
+	sampler.set_enabled(true);
+
+	// The first 50 samples are pushed out of the window by the next 100.
+	for (int i = 0; i < 50; i++) {
+		sampler.add_sample(node, SceneTreeProcessSampler::PROCESS_IDLE, 1000);
+	}
+	for (int i = 1; i <= 100; i++) {
+		sampler.add_sample(node, SceneTreeProcessSampler::PROCESS_IDLE, i);
+	}
+
+	SceneTreeProcessSampler::Stats stats;
+	REQUIRE(sampler.get_node_stats(node->get_instance_id(), SceneTreeProcessSampler::PROCESS_IDLE, stats));
+	CHECK(stats.calls == 150);
+	CHECK(stats.total_usec == 50 * 1000 + 5050);
+	CHECK(stats.peak_usec == 1000);
+	CHECK(stats.mean_usec == doctest::Approx(50.5));
+	CHECK(stats.p99_usec == 99);
+	CHECK(stats.max_usec == 100);
+
+	CHECK_FALSE(sampler.get_node_stats(node->get_instance_id(), SceneTreeProcessSampler::PROCESS_PHYSICS, stats));
+
+	// Nodes without a script are attributed to their class.
+	REQUIRE(sampler.get_script_stats("Node", SceneTreeProcessSampler::PROCESS_IDLE, stats));
+	CHECK(stats.calls == 150);
+
+	sampler.clear();
+	CHECK_FALSE(sampler.get_node_stats(node->get_instance_id(), SceneTreeProcessSampler::PROCESS_IDLE, stats));
+
+	memdelete(node);
+}
+
+TEST_CASE("[SceneTreeProcessSampler][SceneTree] Samples processed nodes") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *processed = memnew(Node);
+	Node *idle = memnew(Node);
+	tree->get_root()->add_child(processed);
+	tree->get_root()->add_child(idle);
+	processed->set_process(true);
+	processed->set_physics_process(true);
+
+	tree->set_process_sampling_enabled(true);
+	tree->process(0);
+	tree->process(0);
+	tree->physics_process(0);
+	tree->set_process_sampling_enabled(false);
+	tree->process(0);
+
+	SceneTreeProcessSampler::Stats stats;
+	REQUIRE(tree->get_process_sampler().get_node_stats(processed->get_instance_id(), SceneTreeProcessSampler::PROCESS_IDLE, stats));
+	CHECK(stats.calls == 2);
+	REQUIRE(tree->get_process_sampler().get_node_stats(processed->get_instance_id(), SceneTreeProcessSampler::PROCESS_PHYSICS, stats));
+	CHECK(stats.calls == 1);
+	CHECK_FALSE(tree->get_process_sampler().get_node_stats(idle->get_instance_id(), SceneTreeProcessSampler::PROCESS_IDLE, stats));
+
+	const Dictionary report = tree->get_process_sampling_report();
+	const Array nodes = report["nodes"];
+	bool found = false;
+	for (int i = 0; i < nodes.size(); i++) {
+		const Dictionary entry = nodes[i];
+		if (String(entry["path"]) == String(processed->get_path())) {
+			found = true;
+			CHECK(String(entry["script"]) == "Node");
+			CHECK(int(Dictionary(entry["process"])["calls"]) == 2);
+			CHECK(int(Dictionary(entry["physics_process"])["calls"]) == 1);
+		}
+	}
+	CHECK(found);
+
+	tree->clear_process_samples();
+	memdelete(processed);
+	memdelete(idle);
+}
+
+TEST_CASE("[SceneTreeProcessSampler][SceneTree] Freed nodes are dropped once too many are tracked") {
+	const uint32_t count = SceneTreeProcessSampler::MAX_NODES + 1;
+	SceneTreeProcessSampler sampler;
+	sampler.set_enabled(true);
+
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+	LocalVector<Node *> nodes;
+	for (uint32_t i = 0; i < count; i++) {
+		Node *node = memnew(Node);
+		parent->add_child(node);
+		sampler.add_sample(node, SceneTreeProcessSampler::PROCESS_IDLE, 1);
+		nodes.push_back(node);
+	}
+	Node *kept = nodes[0];
+	const ObjectID freed_id = nodes[1]->get_instance_id();
+	for (uint32_t i = 1; i < count; i++) {
+		memdelete(nodes[i]);
+	}
+
+	// Adding samples doesn't scan for freed nodes, that's done once per frame.
+	SceneTreeProcessSampler::Stats stats;
+	CHECK(sampler.get_node_stats(freed_id, SceneTreeProcessSampler::PROCESS_IDLE, stats));
+
+	sampler.prune_freed_nodes();
+	CHECK_FALSE(sampler.get_node_stats(freed_id, SceneTreeProcessSampler::PROCESS_IDLE, stats));
+	CHECK(sampler.get_node_stats(kept->get_instance_id(), SceneTreeProcessSampler::PROCESS_IDLE, stats));
+
+	// The time of the freed nodes is still in their script's statistics.
+	REQUIRE(sampler.get_script_stats("Node", SceneTreeProcessSampler::PROCESS_IDLE, stats));
+	CHECK(stats.calls == count);
+
+	// Below the limit, nothing is dropped.
+	const ObjectID kept_id = kept->get_instance_id();
+	memdelete(parent);
+	sampler.prune_freed_nodes();
+	CHECK(sampler.get_node_stats(kept_id, SceneTreeProcessSampler::PROCESS_IDLE, stats));
+}
+
+} // namespace TestSceneTreeProcessSampler
@@ -0,0 +1,79 @@
+/**************************************************************************/
+/*  test_benchmark_runner.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "tests/benchmark_runner.h"
+#include "tests/test_macros.h"
+
+namespace TestBenchmarkRunner {
+
+TEST_CASE("[BenchmarkRunner] Median and median absolute deviation") {
+	LocalVector<double> values = { 5.0, 1.0, 3.0 };
+	CHECK(BenchmarkRunner::get_median(values) == doctest::Approx(3.0));
+	CHECK(BenchmarkRunner::get_median_absolute_deviation(values, 3.0) == doctest::Approx(2.0));
+
+	values.push_back(100.0);
+	CHECK_MESSAGE(BenchmarkRunner::get_median(values) == doctest::Approx(4.0), "An even count should average the two middle values.");
+	CHECK_MESSAGE(BenchmarkRunner::get_median_absolute_deviation(values, 4.0) == doctest::Approx(2.0), "Outliers shouldn't affect the deviation much.");
+}
+
+TEST_CASE("[BenchmarkRunner] Regressions against a baseline") {
+	Dictionary baseline;
+	baseline["median_nsec"] = 1000.0;
+	baseline["mad_nsec"] = 10.0;
+
+	Dictionary result;
+	result["median_nsec"] = 1050.0;
+	result["mad_nsec"] = 10.0;
+	CHECK_MESSAGE(!BenchmarkRunner::is_regression(result, baseline, 0.1), "A change under the threshold isn't a regression.");
+
+	result["median_nsec"] = 1200.0;
+	CHECK(BenchmarkRunner::is_regression(result, baseline, 0.1));
+
+	result["mad_nsec"] = 100.0;
+	CHECK_MESSAGE(!BenchmarkRunner::is_regression(result, baseline, 0.1), "A change within the noise isn't a regression.");
+
+	result.erase("median_nsec");
+	CHECK_MESSAGE(!BenchmarkRunner::is_regression(result, baseline, 0.1), "Skipped benchmarks can't regress.");
+}
+
+TEST_CASE("[BenchmarkRunner] A failure stops the measurement") {
+	BenchmarkContext context;
+	int calls = 0;
+	context.measure([&]() {
+		calls++;
+		context.fail("The call failed.");
+	});
+	CHECK(context.has_failed());
+	CHECK_MESSAGE(calls == 1, "The first batch is a single call, nothing runs after it.");
+}
+
+} // namespace TestBenchmarkRunner
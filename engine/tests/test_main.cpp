@@ -43,7 +43,12 @@
 #include "tests/core/input/test_input_event.h"
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
+#include "tests/core/input/test_input_timestamp_converter.h"
 #include "tests/core/input/test_shortcut.h"
+#include "tests/core/io/benchmark_image.h"
+#include "tests/core/io/benchmark_json.h"
+#include "tests/core/io/benchmark_pck_packer.h"
+#include "tests/core/io/benchmark_resource.h"
 #include "tests/core/io/test_config_file.h"
 #include "tests/core/io/test_file_access.h"
 #include "tests/core/io/test_http_client.h"
@@ -88,11 +93,14 @@
 #include "tests/core/math/test_vector3i.h"
 #include "tests/core/math/test_vector4.h"
 #include "tests/core/math/test_vector4i.h"
+#include "tests/core/object/benchmark_object.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/string/benchmark_string.h"
 #include "tests/core/string/test_fuzzy_search.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
@@ -115,12 +123,16 @@
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
 #include "tests/core/test_time.h"
+#include "tests/core/threads/benchmark_worker_thread_pool.h"
 #include "tests/core/threads/test_worker_thread_pool.h"
 #include "tests/core/variant/test_array.h"
 #include "tests/core/variant/test_callable.h"
 #include "tests/core/variant/test_dictionary.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
+#include "tests/main/test_simulation_harness.h"
+#include "tests/scene/benchmark_node.h"
+#include "tests/scene/benchmark_packed_scene.h"
 #include "tests/scene/test_animation.h"
 #include "tests/scene/test_animation_blend_tree.h"
 #include "tests/scene/test_animation_player.h"
@@ -144,6 +156,7 @@
 #include "tests/scene/test_parallax_2d.h"
 #include "tests/scene/test_path_2d.h"
 #include "tests/scene/test_path_follow_2d.h"
+#include "tests/scene/test_scene_tree_process_sampler.h"
 #include "tests/scene/test_sprite_2d.h"
 #include "tests/scene/test_sprite_frames.h"
 #include "tests/scene/test_style_box_texture.h"
@@ -156,6 +169,7 @@
 #include "tests/servers/rendering/test_shader_preprocessor.h"
 #include "tests/servers/test_nav_heap.h"
 #include "tests/servers/test_text_server.h"
+#include "tests/test_benchmark_runner.h"
 #include "tests/test_validate_testing.h"
 
 #ifndef ADVANCED_GUI_DISABLED
@@ -209,6 +223,7 @@
 
 #include "modules/modules_tests.gen.h"
 
+#include "tests/benchmark_runner.h"
 #include "tests/display_server_mock.h"
 #include "tests/test_macros.h"
 
@@ -232,6 +247,9 @@
 
 #include "servers/rendering/rendering_server_default.h"
 
+static void _begin_scene_benchmark();
+static void _end_scene_benchmark();
+
 int test_main(int argc, char *argv[]) {
 	bool run_tests = true;
 
@@ -268,6 +286,13 @@ int test_main(int argc, char *argv[]) {
 			return 0;
 		}
 	}
+
+	// Benchmark runner.
+	if (args.find("--benchmark")) {
+		BenchmarkRunner::set_scene_environment(&_begin_scene_benchmark, &_end_scene_benchmark);
+		return BenchmarkRunner::run(args);
+	}
+
 	// Doctest runner.
 	doctest::Context test_context;
 	LocalVector<String> test_args;
@@ -551,3 +576,22 @@ private:
 };
 
 REGISTER_LISTENER("GodotTestCaseListener", 1, GodotTestCaseListener);
+
+// "scene/..." benchmarks run in the environment of a [SceneTree] test case.
+static GodotTestCaseListener *scene_benchmark_listener = nullptr;
+
+static void _begin_scene_benchmark() {
+	scene_benchmark_listener = new GodotTestCaseListener(doctest::ContextOptions());
+	scene_benchmark_listener->test_run_start();
+	doctest::TestCaseData test_case = {};
+	test_case.m_name = "[SceneTree] Benchmark";
+	test_case.m_test_suite = "";
+	scene_benchmark_listener->test_case_start(test_case);
+}
+
+static void _end_scene_benchmark() {
+	scene_benchmark_listener->test_case_end(doctest::CurrentTestCaseStats());
+	scene_benchmark_listener->test_run_end(doctest::TestRunStats());
+	delete scene_benchmark_listener;
+	scene_benchmark_listener = nullptr;
+}
@@ -0,0 +1,76 @@
+#ifndef BENCHMARK_VIDEO_DECODER_H
+#define BENCHMARK_VIDEO_DECODER_H
+
+#include "../video_decoder.h"
+
+#include "servers/rendering/rendering_server_default.h"
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkVideoDecoder {
+
+static const int FRAME_COUNT = 120;
+
+// Opens the video passed with `--benchmark-video <file>` and decodes its first frames,
+// returning them to the decoder as soon as they are available, like a playing video stream would.
+static void benchmark_decode(BenchmarkContext &p_context) {
+	const String path = p_context.get_argument("--benchmark-video");
+	if (path.is_empty()) {
+		p_context.skip("Pass a video file with --benchmark-video <file>.");
+		return;
+	}
+	if (!FileAccess::exists(path)) {
+		p_context.skip(vformat("Video file \"%s\" doesn't exist.", path));
+		return;
+	}
+
+	// The decoder uploads frames to textures, so it needs a RenderingServer.
+	const bool create_rendering_server = RenderingServer::get_singleton() == nullptr;
+	if (create_rendering_server) {
+		Error err = OK;
+		for (int i = 0; i < DisplayServer::get_create_function_count(); i++) {
+			if (String("mock") == DisplayServer::get_create_function_name(i)) {
+				DisplayServer::create(i, "", DisplayServer::WindowMode::WINDOW_MODE_MINIMIZED, DisplayServer::VSyncMode::VSYNC_ENABLED, 0, nullptr, Vector2i(0, 0), DisplayServer::SCREEN_PRIMARY, DisplayServer::CONTEXT_EDITOR, 0, err);
+				break;
+			}
+		}
+		memnew(RenderingServerDefault());
+		RenderingServerDefault::get_singleton()->init();
+		RenderingServerDefault::get_singleton()->set_render_loop_enabled(false);
+	}
+
+	p_context.measure([&]() {
+		Ref<VideoDecoder> decoder = memnew(VideoDecoder(FileAccess::open(path, FileAccess::READ)));
+		decoder->start_decoding();
+		int decoded = 0;
+		while (decoded < FRAME_COUNT) {
+			const VideoDecoder::DecoderState state = decoder->get_decoder_state();
+			if (state == VideoDecoder::FAULTED) {
+				p_context.fail("The decoder faulted.");
+				return;
+			}
+			const Vector<Ref<DecodedFrame>> frames = decoder->get_decoded_frames();
+			if (frames.is_empty()) {
+				if (state == VideoDecoder::END_OF_STREAM) {
+					break;
+				}
+				OS::get_singleton()->delay_usec(100);
+				continue;
+			}
+			decoded += frames.size();
+			decoder->return_frames(frames);
+		}
+	});
+
+	if (create_rendering_server) {
+		RenderingServer::get_singleton()->sync();
+		RenderingServer::get_singleton()->finish();
+		memdelete(RenderingServer::get_singleton());
+		memdelete(DisplayServer::get_singleton());
+	}
+}
+
+REGISTER_BENCHMARK("ffmpeg/video_decoder/decode", &benchmark_decode);
+
+} // namespace BenchmarkVideoDecoder
+
+#endif // BENCHMARK_VIDEO_DECODER_H
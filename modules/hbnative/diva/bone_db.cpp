@@ -1,6 +1,7 @@
 #include "bone_db.h"
 #include "core/io/file_access.h"
 #include "core/io/json.h"
+#include "core/profiling/profiling.h"
 #include "read_helpers.h"
 #include "scene/3d/skeleton_3d.h"
 
@@ -20,6 +21,7 @@ Ref<DIVASkeleton> DIVABoneDB::get_skeleton(const String &p_name) const {
 }
 
 void DIVABoneDB::read_classic(Ref<StreamPeerBuffer> p_stream) {
+	GodotModuleProfileZone("DIVABoneDB::read_classic");
 	uint32_t signature = p_stream->get_u32();
 
 	ERR_FAIL_COND_MSG(signature != 0x09102720, "Bone database magic number invalid!");
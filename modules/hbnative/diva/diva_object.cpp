@@ -1,4 +1,5 @@
 #include "diva_object.h"
+#include "core/profiling/profiling.h"
 void DIVAObjectSet::read_submesh_indices(DIVASubmesh *p_submesh, uint32_t p_index_count, Ref<StreamPeerBuffer> p_spb) {
 	bool tri_strip = p_submesh->primitive == OBJ_PRIMITIVE_TRIANGLE_STRIP;
 	p_submesh->index_array.resize(p_index_count);
@@ -391,6 +392,7 @@ void DIVAObjectSet::read_mesh(DIVAMesh *p_mesh, Ref<StreamPeerBuffer> p_spb, uin
 	//read_model_vertex_data(p_mesh, p_spb, p_base_offset, vertex_offsets, vertex_count, vertex_format);
 }
 void DIVAObjectSet::read_model(DIVAObject *p_obj, Ref<StreamPeerBuffer> p_spb, uint32_t p_base_offset) {
+	GodotModuleProfileZone("DIVAObjectSet::read_model");
 	const uint32_t mesh_size = 0xD8;
 
 	p_spb->seek(p_base_offset);
@@ -432,6 +434,7 @@ void DIVAObjectSet::_bind_methods() {
 }
 
 void DIVAObjectSet::read_classic(Ref<StreamPeerBuffer> p_spb) {
+	GodotModuleProfileZone("DIVAObjectSet::read_classic");
 	uint32_t version = p_spb->get_u32();
 
 	if (version != 0x05062500) {
@@ -1,6 +1,7 @@
 #include "item_table.h"
 #include "kv_table.h"
 #include "sprite_db.h"
+#include "core/profiling/profiling.h"
 
 DIVACharacter ModuleTable::get_character(const StringName &p_key) {
 	static HashMap<StringName, DIVACharacter> character_names;
@@ -24,6 +25,7 @@ DIVACharacter ModuleTable::get_character(const StringName &p_key) {
 }
 
 void ModuleTable::parse(const String &p_text, const Ref<DIVASpriteDB> &p_sprite_db) {
+	GodotModuleProfileZone("ModuleTable::parse");
 	KVTable table;
 	table.parse(p_text);
 
@@ -1,9 +1,11 @@
 #include "motion_db.h"
 #include "core/io/file_access.h"
 #include "core/io/json.h"
+#include "core/profiling/profiling.h"
 #include "read_helpers.h"
 
 void DIVAMotionDB::read(Ref<StreamPeerBuffer> p_stream) {
+	GodotModuleProfileZone("DIVAMotionDB::read");
 	ERR_FAIL_COND_MSG(p_stream->get_u32() != 0x1, "DIVA motion DB had incorrect magic number");
 	struct {
 		uint32_t motion_sets_offset;
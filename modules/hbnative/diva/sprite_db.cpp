@@ -1,8 +1,10 @@
 #include "sprite_db.h"
 
 #include "core/io/file_access.h"
+#include "core/profiling/profiling.h"
 
 void DIVASpriteDB::read_classic(Ref<StreamPeerBuffer> p_stream) {
+	GodotModuleProfileZone("DIVASpriteDB::read_classic");
 	uint32_t sprite_sets_count = p_stream->get_u32();
 	uint32_t sprite_sets_offset = p_stream->get_u32();
 	uint32_t sprites_count = p_stream->get_u32();
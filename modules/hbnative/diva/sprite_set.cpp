@@ -1,6 +1,7 @@
 #include "sprite_set.h"
 
 #include "core/io/file_access.h"
+#include "core/profiling/profiling.h"
 
 String DivaTXP::diva_texture_format_to_str(DIVATextureFormat p_tex_format) {
 	switch (p_tex_format) {
@@ -115,6 +116,7 @@ Vector<Ref<Image>> DivaTXP::get_texture_mipmaps(int p_idx) const {
 	return mipmaps;
 }
 void DivaTXP::read_classic(Ref<StreamPeerBuffer> p_spb) {
+	GodotModuleProfileZone("DivaTXP::read_classic");
 	uint32_t set_start = p_spb->get_position();
 	uint32_t signature = p_spb->get_u32();
 	ERR_FAIL_COND_MSG(signature != 0x03505854, "Texture set signature was wrong");
@@ -214,6 +216,7 @@ void DivaTXP::dump_json(String p_path) {
 }
 
 void DIVASpriteSet::read_classic(Ref<StreamPeerBuffer> p_spb) {
+	GodotModuleProfileZone("DIVASpriteSet::read_classic");
 	spb = p_spb;
 
 	DIVAReadHelpers::OffsetQueue queue{
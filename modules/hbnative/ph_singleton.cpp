@@ -181,6 +181,31 @@ String PHNative::get_sdl_device_guid(int p_joy_device_idx) {
 	return "";
 }
 
+void PHNative::inject_sdl_latency_probe() {
+#ifdef SDL_ENABLED
+	if (JoypadSDL *sdl = JoypadSDL::get_singleton(); sdl) {
+		sdl->inject_latency_probe();
+	}
+#endif
+}
+
+Dictionary PHNative::get_sdl_latency_stats() {
+#ifdef SDL_ENABLED
+	if (JoypadSDL *sdl = JoypadSDL::get_singleton(); sdl) {
+		return sdl->get_latency_stats();
+	}
+#endif
+	return Dictionary();
+}
+
+void PHNative::reset_sdl_latency_stats() {
+#ifdef SDL_ENABLED
+	if (JoypadSDL *sdl = JoypadSDL::get_singleton(); sdl) {
+		sdl->reset_latency_stats();
+	}
+#endif
+}
+
 void PHNative::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_process", "path", "arguments", "working_directory", "open_stdin"), &PHNative::create_process, DEFVAL(Vector<String>()), DEFVAL(""), DEFVAL(false));
 	ClassDB::bind_static_method("PHNative", D_METHOD("load_ogg_from_file", "path"), &PHNative::load_ogg_from_file);
@@ -189,6 +214,9 @@ void PHNative::_bind_methods() {
 	ClassDB::bind_static_method("PHNative", D_METHOD("is_sdl_device_game_controller"), &PHNative::is_sdl_device_game_controller);
 	ClassDB::bind_static_method("PHNative", D_METHOD("get_sdl_device_guid"), &PHNative::get_sdl_device_guid);
 	ClassDB::bind_static_method("PHNative", D_METHOD("get_clock_time_usec"), &PHNative::get_clock_time_usec);
+	ClassDB::bind_static_method("PHNative", D_METHOD("inject_sdl_latency_probe"), &PHNative::inject_sdl_latency_probe);
+	ClassDB::bind_static_method("PHNative", D_METHOD("get_sdl_latency_stats"), &PHNative::get_sdl_latency_stats);
+	ClassDB::bind_static_method("PHNative", D_METHOD("reset_sdl_latency_stats"), &PHNative::reset_sdl_latency_stats);
 
 	ClassDB::bind_method(D_METHOD("get_blur_controls_enabled"), &PHNative::get_blur_controls_enabled);
 	ClassDB::bind_method(D_METHOD("set_blur_controls_enabled", "blur_controls_enabled"), &PHNative::set_blur_controls_enabled);
@@ -35,6 +35,7 @@
 #include "ph_zip.h"
 
 #include "core/io/file_access.h"
+#include "core/profiling/profiling.h"
 
 extern "C" {
 
@@ -122,6 +123,7 @@ void PHZipArchive::close_handle(unzFile p_file) const {
 }
 
 unzFile PHZipArchive::get_file_handle(const String &p_file) const {
+	GodotModuleProfileZone("PHZipArchive::get_file_handle");
 	ERR_FAIL_COND_V_MSG(!file_exists(p_file), nullptr, vformat("File '%s' doesn't exist.", p_file));
 	File file = files[p_file];
 
@@ -160,6 +162,7 @@ unzFile PHZipArchive::get_file_handle(const String &p_file) const {
 }
 
 bool PHZipArchive::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset = 0) {
+	GodotModuleProfileZone("PHZipArchive::try_open_pack");
 	// load with offset feature only supported for PCK files
 	ERR_FAIL_COND_V_MSG(p_offset != 0, false, "Invalid PCK data. Note that loading files with a non-zero offset isn't supported with ZIP archives.");
 
@@ -286,6 +289,7 @@ bool FileAccessPHZip::eof_reached() const {
 }
 
 uint64_t FileAccessPHZip::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	GodotModuleProfileZone("FileAccessPHZip::get_buffer");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_NULL_V(zfile, -1);
 
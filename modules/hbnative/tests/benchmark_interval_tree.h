@@ -0,0 +1,51 @@
+#ifndef BENCHMARK_INTERVAL_TREE_H
+#define BENCHMARK_INTERVAL_TREE_H
+
+#include "../interval_tree.h"
+
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkIntervalTree {
+
+static const int NOTE_COUNT = 4000;
+
+// Notes of a long chart, each visible for a couple of seconds around its time.
+static void fill_tree(const Ref<HBIntervalTree> &p_tree, const Ref<RefCounted> &p_value) {
+	for (int i = 0; i < NOTE_COUNT; i++) {
+		const int64_t time = i * 75;
+		p_tree->insert(time - 1500, time + 500, p_value->get_instance_id());
+	}
+}
+
+static void benchmark_build(BenchmarkContext &p_context) {
+	Ref<RefCounted> value;
+	value.instantiate();
+	p_context.measure([&]() {
+		Ref<HBIntervalTree> tree;
+		tree.instantiate();
+		fill_tree(tree, value);
+	});
+}
+
+static void benchmark_query_point(BenchmarkContext &p_context) {
+	Ref<RefCounted> value;
+	value.instantiate();
+	Ref<HBIntervalTree> tree;
+	tree.instantiate();
+	fill_tree(tree, value);
+
+	int64_t time = 0;
+	p_context.measure([&]() {
+		if (tree->query_point(time).is_empty()) {
+			p_context.fail(vformat("No interval at %d.", time));
+		}
+		time = (time + 16) % (NOTE_COUNT * 75);
+	});
+}
+
+REGISTER_BENCHMARK("hbnative/interval_tree/build", &benchmark_build);
+REGISTER_BENCHMARK("hbnative/interval_tree/query_point", &benchmark_query_point);
+
+} // namespace BenchmarkIntervalTree
+
+#endif // BENCHMARK_INTERVAL_TREE_H
@@ -0,0 +1,120 @@
+#ifndef BENCHMARK_PH_ZIP_H
+#define BENCHMARK_PH_ZIP_H
+
+#include "../ph_zip.h"
+#include "../ph_zip_packer.h"
+
+#include "tests/benchmark_runner.h"
+#include "tests/test_utils.h"
+
+#ifdef MINIZIP_ENABLED
+
+namespace BenchmarkPHZip {
+
+static const int FILE_COUNT = 32;
+static const int FILE_SIZE = 256 * 1024;
+
+// An archive with song-sized files, half of them compressible.
+static String create_archive() {
+	const String path = TestUtils::get_temp_path("benchmark_ph_zip.zip");
+	if (FileAccess::exists(path)) {
+		return path;
+	}
+
+	Ref<PHZIPPacker> packer;
+	packer.instantiate();
+	ERR_FAIL_COND_V(packer->open(path, PHZIPPacker::APPEND_CREATE) != OK, String());
+	uint32_t seed = 12345;
+	for (int i = 0; i < FILE_COUNT; i++) {
+		Vector<uint8_t> data;
+		data.resize(FILE_SIZE);
+		uint8_t *w = data.ptrw();
+		for (int j = 0; j < FILE_SIZE; j++) {
+			seed = seed * 1664525u + 1013904223u;
+			w[j] = (i % 2) ? uint8_t(seed >> 24) : uint8_t(j / 64);
+		}
+		packer->start_file(vformat("songs/%d/audio.ogg", i));
+		packer->write_file(data);
+		packer->close_file();
+	}
+	packer->close();
+	return path;
+}
+
+static void benchmark_open_pack(BenchmarkContext &p_context) {
+	const String path = create_archive();
+	if (path.is_empty()) {
+		p_context.skip("Can't create the archive.");
+		return;
+	}
+	p_context.measure([&]() {
+		Ref<PHZipArchive> archive;
+		archive.instantiate();
+		if (!archive->try_open_pack(path, false, 0)) {
+			p_context.fail("Can't open the archive.");
+		}
+	});
+}
+
+static void benchmark_read_file(BenchmarkContext &p_context) {
+	const String path = create_archive();
+	if (path.is_empty()) {
+		p_context.skip("Can't create the archive.");
+		return;
+	}
+	Ref<PHZipArchive> archive;
+	archive.instantiate();
+	if (!archive->try_open_pack(path, false, 0)) {
+		p_context.fail("Can't open the archive.");
+		return;
+	}
+
+	LocalVector<uint8_t> buffer;
+	buffer.resize(FILE_SIZE);
+	int file_index = 0;
+	p_context.measure([&]() {
+		Ref<FileAccess> f = archive->get_file(vformat("songs/%d/audio.ogg", file_index));
+		if (f.is_null() || f->get_buffer(buffer.ptr(), FILE_SIZE) != FILE_SIZE) {
+			p_context.fail(vformat("Can't read \"songs/%d/audio.ogg\".", file_index));
+			return;
+		}
+		file_index = (file_index + 1) % FILE_COUNT;
+	});
+}
+
+// Small reads, like a decoder pulling packets from an open file.
+static void benchmark_read_chunks(BenchmarkContext &p_context) {
+	const String path = create_archive();
+	if (path.is_empty()) {
+		p_context.skip("Can't create the archive.");
+		return;
+	}
+	Ref<PHZipArchive> archive;
+	archive.instantiate();
+	if (!archive->try_open_pack(path, false, 0)) {
+		p_context.fail("Can't open the archive.");
+		return;
+	}
+
+	uint8_t chunk[4096];
+	Ref<FileAccess> f = archive->get_file("songs/1/audio.ogg");
+	if (f.is_null()) {
+		p_context.fail("Can't open \"songs/1/audio.ogg\".");
+		return;
+	}
+	p_context.measure([&]() {
+		if (f->get_buffer(chunk, sizeof(chunk)) < sizeof(chunk)) {
+			f->seek(0);
+		}
+	});
+}
+
+REGISTER_BENCHMARK("hbnative/ph_zip/open_pack", &benchmark_open_pack);
+REGISTER_BENCHMARK("hbnative/ph_zip/read_file", &benchmark_read_file);
+REGISTER_BENCHMARK("hbnative/ph_zip/read_chunks", &benchmark_read_chunks);
+
+} // namespace BenchmarkPHZip
+
+#endif // MINIZIP_ENABLED
+
+#endif // BENCHMARK_PH_ZIP_H
@@ -0,0 +1,39 @@
+#ifndef BENCHMARK_THREEN_H
+#define BENCHMARK_THREEN_H
+
+#include "../threen.h"
+
+#include "scene/resources/curve.h"
+#include "tests/benchmark_runner.h"
+
+namespace BenchmarkThreen {
+
+static const int TARGET_COUNT = 256;
+
+// Evaluates and applies many property interpolations at once, like the note animations of a busy chart.
+// The targets are resources so the benchmark doesn't need a SceneTree or a RenderingServer.
+static void benchmark_seek(BenchmarkContext &p_context) {
+	Threen *threen = memnew(Threen);
+	LocalVector<Ref<Curve>> targets;
+	for (int i = 0; i < TARGET_COUNT; i++) {
+		Ref<Curve> curve;
+		curve.instantiate();
+		targets.push_back(curve);
+		const Threen::TransitionType trans = Threen::TransitionType(i % Threen::TRANS_COUNT);
+		threen->interpolate_property(curve.ptr(), NodePath("max_value"), 1.0, 100.0, 1.0, trans, Threen::EASE_IN_OUT, (i % 8) * 0.05);
+	}
+
+	real_t time = 0.0;
+	p_context.measure([&]() {
+		threen->seek(time);
+		time = Math::fmod(time + 1.0f / 240.0f, real_t(1.5));
+	});
+
+	memdelete(threen);
+}
+
+REGISTER_BENCHMARK("hbnative/threen/seek", &benchmark_seek);
+
+} // namespace BenchmarkThreen
+
+#endif // BENCHMARK_THREEN_H
@@ -33,6 +33,7 @@
 #include "easing_equations.h"
 
 #include "core/object/class_db.h"
+#include "core/profiling/profiling.h"
 
 // Helpers to handle the difference between core Object::get_indexed and the bindings version,
 // and in this class we only care about subnames.
@@ -146,6 +147,7 @@ void Threen::_add_pending_command(StringName p_key, const Variant &p_arg1, const
 }
 
 void Threen::_process_pending_commands() {
+	GodotModuleProfileZone("Threen::_process_pending_commands");
 	// For each pending command...
 	for (List<PendingCommand>::Element *E = pending_commands.front(); E; E = E->next()) {
 		// Get the command
@@ -723,6 +725,7 @@ bool Threen::_apply_tween_value(InterpolateData &p_data, Variant &value) {
 }
 
 void Threen::_tween_process(float p_delta) {
+	GodotModuleProfileZone("Threen::_tween_process");
 	// Process all of the pending commands
 	_process_pending_commands();
 
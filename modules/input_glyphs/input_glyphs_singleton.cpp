@@ -33,6 +33,7 @@
 #include "core/input/input_map.h"
 #include "core/object/callable_method_pointer.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/profiling/profiling.h"
 #include "core/string/print_string.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
@@ -41,6 +42,7 @@
 InputGlyphsSingleton *InputGlyphsSingleton::singleton = nullptr;
 
 void InputGlyphsSingleton::_glyph_loaded_callback(GlyphLoadTask *p_task) {
+	GodotModuleProfileZone("InputGlyphs::glyph_loaded");
 	InputGlyphsSingleton *igs = InputGlyphsSingleton::get_singleton();
 	WorkerThreadPool::get_singleton()->wait_for_task_completion(p_task->task_id);
 	p_task->task_mutex.lock();
@@ -156,6 +158,7 @@ InputGlyphsConstants::InputType InputGlyphsSingleton::_get_input_type() const {
 }
 
 void InputGlyphsSingleton::_load_glyph_thread(void *p_userdata) {
+	GodotModuleProfileZone("InputGlyphs::load_glyph");
 	GlyphLoadTask *task = (GlyphLoadTask *)p_userdata;
 
 	task->task_mutex.lock();
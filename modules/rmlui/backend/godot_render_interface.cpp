@@ -3,6 +3,7 @@
 #include "core/io/image.h"
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
+#include "core/profiling/profiling.h"
 #include "core/string/print_string.h"
 #include "engine/core/io/resource_loader.h"
 #include "godot_conversion.h"
@@ -160,6 +161,7 @@ RD::FramebufferFormatID RenderInterface_Godot_RD::get_final_framebuffer_format()
 }
 
 void RenderInterface_Godot_RD::render() {
+    GodotModuleProfileZone("RmlUi::render");
     RD *rd = RD::get_singleton();
 
     flush_element_transforms_buffer();
@@ -351,6 +353,7 @@ void RenderInterface_Godot_RD::flush_element_transforms_buffer() {
 }
 
 void RenderInterface_Godot_RD::execute_command(const RenderGeometryCommand &p_command) {
+    GodotModuleProfileZone("RmlUi::RenderGeometry");
     _ensure_in_draw_pass(get_framebuffer());
     RD *rd = RD::get_singleton();
     Texture *texture = reinterpret_cast<Texture*>(p_command.texture);
@@ -437,6 +440,7 @@ void RenderInterface_Godot_RD::execute_command(const PopLayerCommand &p_command)
 }
 
 void RenderInterface_Godot_RD::execute_command(const SaveLayerAsTextureCommand &p_command) {
+	GodotModuleProfileZone("RmlUi::SaveLayerAsTexture");
 	end_draw_pass();
     int layer = layers.get_current_layer();
     DEV_ASSERT(layer != -1);
@@ -474,6 +478,7 @@ void RenderInterface_Godot_RD::execute_command(const SaveLayerAsTextureCommand &
 }
 
 void RenderInterface_Godot_RD::execute_command(const RenderToClipMaskCommand &p_command) {
+    GodotModuleProfileZone("RmlUi::RenderToClipMask");
     _ensure_in_draw_pass(get_framebuffer());
     RD *rd = RD::get_singleton();
 
@@ -517,6 +522,7 @@ void RenderInterface_Godot_RD::execute_command(const SetClipMaskEnabledCommand &
 }
 
 void RenderInterface_Godot_RD::execute_command(const CompositeLayersCommand &p_command) {
+    GodotModuleProfileZone("RmlUi::CompositeLayers");
     RD *rd = RD::get_singleton();
 
     int layer_to_read_from = layers.layer_get_idx(p_command.source);
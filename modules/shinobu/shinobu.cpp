@@ -21,6 +21,8 @@
 /* clang-format on */
 
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
+#include "main/simulation_harness.h"
 #include "miniaudio/extras/miniaudio_libvorbis.h"
 #include "shinobu_macros.h"
 
@@ -29,6 +31,11 @@ SafeNumeric<uint64_t> Shinobu::sound_source_uid;
 
 void Shinobu::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_group", "group_name", "parent_group"), &Shinobu::create_group);
+	ClassDB::bind_method(D_METHOD("create_voice_pool", "sound_source", "group", "voice_count"), &Shinobu::create_voice_pool);
+	ClassDB::bind_method(D_METHOD("play_oneshot", "sound_source", "group", "volume", "pitch_scale", "dsp_time_msec"), &Shinobu::play_oneshot, DEFVAL(1.0f), DEFVAL(1.0f), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("prepare_oneshot", "sound_source", "group"), &Shinobu::prepare_oneshot);
+	ClassDB::bind_method(D_METHOD("get_mix_stats"), &Shinobu::get_mix_stats);
+	ClassDB::bind_method(D_METHOD("reset_mix_stats"), &Shinobu::reset_mix_stats);
 	ClassDB::bind_method(D_METHOD("initialize"), &Shinobu::godot_initialize);
 	ClassDB::bind_method(D_METHOD("get_initialization_error"), &Shinobu::get_initialization_error);
 	ClassDB::bind_method(D_METHOD("register_sound_from_memory", "name_hint", "data"), &Shinobu::register_sound_from_memory);
@@ -42,12 +49,20 @@ void Shinobu::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_master_volume"), &Shinobu::get_master_volume);
 	ClassDB::bind_method(D_METHOD("set_dsp_time", "new_time"), &Shinobu::set_dsp_time);
 	ClassDB::bind_method(D_METHOD("get_dsp_time"), &Shinobu::get_dsp_time);
+	ClassDB::bind_method(D_METHOD("dsp_frame_to_ticks_usec", "frame"), &Shinobu::dsp_frame_to_ticks_usec);
+	ClassDB::bind_method(D_METHOD("ticks_usec_to_dsp_frame", "ticks_usec"), &Shinobu::ticks_usec_to_dsp_frame);
+	ClassDB::bind_method(D_METHOD("get_audible_dsp_time"), &Shinobu::get_audible_dsp_time);
+	ClassDB::bind_method(D_METHOD("get_clock_report"), &Shinobu::get_clock_report);
 	ClassDB::bind_method(D_METHOD("get_actual_buffer_size"), &Shinobu::get_actual_buffer_size);
 	ClassDB::bind_method(D_METHOD("get_current_backend_name"), &Shinobu::get_current_backend_name);
 	ClassDB::bind_method(D_METHOD("pause"), &Shinobu::pause);
 	ClassDB::bind_method(D_METHOD("resume"), &Shinobu::resume);
 }
 
+bool Shinobu::is_initialized() const {
+	return initialized;
+}
+
 String Shinobu::get_initialization_error() const {
 	return "";
 }
@@ -74,11 +89,16 @@ static ma_result ma_decoding_backend_init__libvorbis(void *pUserData, ma_read_pr
 	return MA_SUCCESS;
 }
 
+// Counts miniaudio allocations, reported in the mix stats.
+static SafeNumeric<uint64_t> ma_allocation_count;
+
 void *ma_malloc_godot(size_t p_size, void *p_user_data) {
+	ma_allocation_count.increment();
 	return Memory::alloc_static(p_size);
 }
 
 void *ma_realloc_godot(void *p, size_t p_size, void *p_user_data) {
+	ma_allocation_count.increment();
 	return Memory::realloc_static(p, p_size);
 }
 
@@ -195,6 +215,28 @@ Error Shinobu::initialize(ma_backend forced_backend) {
 
 	ma_result result;
 
+	// Setup libvorbis
+
+	ma_resource_manager_config resourceManagerConfig;
+
+	/*
+	Custom backend vtables
+	*/
+	ma_decoding_backend_vtable *pCustomBackendVTables[] = {
+		&g_ma_decoding_backend_vtable_libvorbis
+	};
+
+	/* Using custom decoding backends requires a resource manager. */
+	resourceManagerConfig = ma_resource_manager_config_init();
+	resourceManagerConfig.ppCustomDecodingBackendVTables = pCustomBackendVTables;
+	resourceManagerConfig.customDecodingBackendCount = sizeof(pCustomBackendVTables) / sizeof(pCustomBackendVTables[0]);
+	resourceManagerConfig.pCustomDecodingBackendUserData = NULL;
+	resourceManagerConfig.decodedFormat = ma_format_f32;
+
+	if (SimulationHarness::get_singleton() && SimulationHarness::get_singleton()->is_enabled()) {
+		return _initialize_offline(resourceManagerConfig);
+	}
+
 	ma_device_config device_config = ma_device_config_init(ma_device_type_playback);
 	device_config.pUserData = this;
 	device_config.dataCallback = ma_data_callback;
@@ -237,45 +279,94 @@ Error Shinobu::initialize(ma_backend forced_backend) {
 		engine_config.periodSizeInMilliseconds = desired_buffer_size_msec;
 	}
 
-	// Setup libvorbis
+	result = ma_resource_manager_init(&resourceManagerConfig, &resource_manager);
 
-	ma_resource_manager_config resourceManagerConfig;
+	MA_ERR_RET(result, "Resource manager init failed!");
 
-	/*
-	Custom backend vtables
-	*/
-	ma_decoding_backend_vtable *pCustomBackendVTables[] = {
-		&g_ma_decoding_backend_vtable_libvorbis
-	};
+	engine_config.pResourceManager = &resource_manager;
 
-	/* Using custom decoding backends requires a resource manager. */
-	resourceManagerConfig = ma_resource_manager_config_init();
-	resourceManagerConfig.ppCustomDecodingBackendVTables = pCustomBackendVTables;
-	resourceManagerConfig.customDecodingBackendCount = sizeof(pCustomBackendVTables) / sizeof(pCustomBackendVTables[0]);
-	resourceManagerConfig.pCustomDecodingBackendUserData = NULL;
-	resourceManagerConfig.decodedFormat = ma_format_f32;
+	result = ma_engine_init(&engine_config, &engine);
 
-	result = ma_resource_manager_init(&resourceManagerConfig, &resource_manager);
+	MA_ERR_RET(result, "Audio engine init failed!");
+
+	clock_correlation.set_sample_rate(ma_engine_get_sample_rate(&engine));
+	// Frames are heard once they've gone through the device buffer.
+	clock_correlation.set_output_latency_usec(device.playback.internalPeriodSizeInFrames * (uint64_t)device.playback.internalPeriods * 1000000 / device.playback.internalSampleRate);
+
+	initialized = true;
+
+	return OK;
+}
 
+Error Shinobu::_initialize_offline(ma_resource_manager_config &p_resource_manager_config) {
+	ma_result result = ma_resource_manager_init(&p_resource_manager_config, &resource_manager);
 	MA_ERR_RET(result, "Resource manager init failed!");
 
+	ma_engine_config engine_config = ma_engine_config_init();
+	engine_config.noDevice = MA_TRUE;
+	engine_config.channels = 2;
+	engine_config.sampleRate = 48000;
 	engine_config.pResourceManager = &resource_manager;
-
 	result = ma_engine_init(&engine_config, &engine);
-
 	MA_ERR_RET(result, "Audio engine init failed!");
 
+	offline = true;
+	offline_timeline = ShinobuOfflineTimeline();
+	SimulationHarness::get_singleton()->add_step_callback(&Shinobu::simulation_step);
+
 	initialized = true;
 
 	return OK;
 }
 
+void Shinobu::simulation_step(uint64_t p_time_usec) {
+	Shinobu *shinobu = singleton;
+	if (shinobu == nullptr || !shinobu->initialized || !shinobu->offline) {
+		return;
+	}
+
+	const uint32_t sample_rate = ma_engine_get_sample_rate(&shinobu->engine);
+	uint64_t remaining = shinobu->offline_timeline.advance(p_time_usec * sample_rate / 1000000);
+	// Same periods as a device would ask for, so effects and the clock see the usual mix sizes.
+	const uint32_t period_frames = MAX<uint64_t>(1, shinobu->desired_buffer_size_msec * sample_rate / 1000);
+	shinobu->offline_buffer.resize(period_frames * ma_engine_get_channels(&shinobu->engine));
+
+	while (remaining > 0) {
+		const uint32_t frame_count = MIN<uint64_t>(period_frames, remaining);
+		shinobu->_mix(shinobu->offline_buffer.ptr(), frame_count);
+		remaining -= frame_count;
+	}
+}
+
 void Shinobu::ma_data_callback(ma_device *pDevice, void *pOutput, const void *pInput, ma_uint32 frameCount) {
 	Shinobu *shinobu = (Shinobu *)pDevice->pUserData;
 	if (shinobu != NULL) {
-		ma_engine_read_pcm_frames(&shinobu->engine, pOutput, frameCount, NULL);
-		uint32_t sample_size_nsec = (frameCount * 1e+9) / ma_engine_get_sample_rate(&shinobu->engine);
-		shinobu->clock->measure(sample_size_nsec);
+		shinobu->_mix(pOutput, frameCount);
+	}
+}
+
+void Shinobu::_mix(void *p_output, uint32_t p_frame_count) {
+	GodotModuleProfileZone("Shinobu::mix");
+	const uint64_t callback_ticks_usec = OS::get_singleton()->get_ticks_usec();
+	command_queue.process();
+	const ma_uint64 frame = ma_engine_get_time(&engine);
+	ma_engine_read_pcm_frames(&engine, p_output, p_frame_count, NULL);
+	uint32_t sample_size_nsec = (p_frame_count * 1e+9) / ma_engine_get_sample_rate(&engine);
+	clock->measure(sample_size_nsec);
+	if (!offline) {
+		// Offline frames don't follow the ticks clock, get_audible_dsp_time() falls back to the DSP time.
+		clock_correlation.add_callback(frame, p_frame_count, callback_ticks_usec);
+	}
+
+	const uint64_t duration_usec = OS::get_singleton()->get_ticks_usec() - callback_ticks_usec;
+	const uint64_t period_usec = sample_size_nsec / 1000;
+	callback_count.increment();
+	callback_total_usec.add(duration_usec);
+	callback_last_usec.set(duration_usec);
+	callback_max_usec.exchange_if_greater(duration_usec);
+	callback_period_usec.set(period_usec);
+	if (duration_usec > period_usec) {
+		callback_overruns.increment();
 	}
 }
 
@@ -305,6 +396,59 @@ Ref<ShinobuGroup> Shinobu::create_group(String m_group_name, Ref<ShinobuGroup> m
 	return out_group;
 }
 
+Ref<ShinobuVoicePool> Shinobu::create_voice_pool(Ref<ShinobuSoundSource> m_sound_source, Ref<ShinobuGroup> m_group, int m_voice_count) {
+	ERR_FAIL_COND_V(m_sound_source.is_null(), Ref<ShinobuVoicePool>());
+	ERR_FAIL_COND_V(m_group.is_null(), Ref<ShinobuVoicePool>());
+	ERR_FAIL_COND_V(m_voice_count <= 0, Ref<ShinobuVoicePool>());
+	ERR_FAIL_COND_V(m_sound_source->predecode() != OK, Ref<ShinobuVoicePool>());
+	return memnew(ShinobuVoicePool(m_sound_source->get_pcm(), m_sound_source->get_pcm_channel_count(), m_group, m_voice_count));
+}
+
+int Shinobu::play_oneshot(const Ref<ShinobuSoundSource> &m_sound_source, const Ref<ShinobuGroup> &m_group, float m_volume, float m_pitch_scale, uint64_t m_dsp_time_msec) {
+	ERR_FAIL_COND_V(m_sound_source.is_null(), -1);
+	ShinobuVoicePool *pool = m_sound_source->get_oneshot_pool(m_group);
+	ERR_FAIL_NULL_V(pool, -1);
+	return pool->play(m_volume, m_pitch_scale, m_dsp_time_msec);
+}
+
+Error Shinobu::prepare_oneshot(const Ref<ShinobuSoundSource> &m_sound_source, const Ref<ShinobuGroup> &m_group) {
+	ERR_FAIL_COND_V(m_sound_source.is_null(), ERR_INVALID_PARAMETER);
+	return m_sound_source->get_oneshot_pool(m_group) ? OK : FAILED;
+}
+
+bool Shinobu::push_command(const ShinobuCommandQueue::Command &p_command) {
+	return command_queue.push(p_command);
+}
+
+void Shinobu::cancel_commands(SafeNumeric<uint32_t> &p_pending) {
+	if (p_pending.get() > 0) {
+		command_queue.cancel(&p_pending);
+	}
+}
+
+Dictionary Shinobu::get_mix_stats() const {
+	Dictionary stats;
+	const uint64_t count = callback_count.get();
+	stats["callbacks"] = count;
+	stats["overruns"] = callback_overruns.get();
+	stats["last_callback_usec"] = callback_last_usec.get();
+	stats["max_callback_usec"] = callback_max_usec.get();
+	stats["average_callback_usec"] = count > 0 ? callback_total_usec.get() / (double)count : 0.0;
+	stats["period_usec"] = callback_period_usec.get();
+	stats["processed_commands"] = command_queue.get_processed_count();
+	stats["dropped_commands"] = command_queue.get_dropped_count();
+	stats["allocations"] = ma_allocation_count.get();
+	return stats;
+}
+
+void Shinobu::reset_mix_stats() {
+	callback_count.set(0);
+	callback_overruns.set(0);
+	callback_total_usec.set(0);
+	callback_last_usec.set(0);
+	callback_max_usec.set(0);
+}
+
 Ref<ShinobuSpectrumAnalyzerEffect> Shinobu::instantiate_spectrum_analyzer_effect() {
 	return memnew(ShinobuSpectrumAnalyzerEffect(2));
 }
@@ -345,31 +489,78 @@ uint64_t Shinobu::get_dsp_time() const {
 Error Shinobu::set_dsp_time(uint64_t m_new_time_msec) {
 	ma_result result = ma_engine_set_time(&engine, m_new_time_msec * (float)(ma_engine_get_sample_rate(&engine) / 1000.0f));
 	MA_ERR_RET(result, "Error setting DSP time");
+	clock_correlation.reset();
 	return OK;
 }
 
+int64_t Shinobu::dsp_frame_to_ticks_usec(int64_t m_frame) const {
+	return clock_correlation.frame_to_ticks_usec(m_frame);
+}
+
+int64_t Shinobu::ticks_usec_to_dsp_frame(int64_t m_ticks_usec) const {
+	return clock_correlation.ticks_usec_to_frame(m_ticks_usec);
+}
+
+// DSP time in milliseconds of the frame leaving the speakers right now, meant to be sampled as late
+// as possible before rendering (see RenderingServer.set_late_latch_source).
+double Shinobu::get_audible_dsp_time() const {
+	int64_t frame = clock_correlation.ticks_usec_to_frame(OS::get_singleton()->get_ticks_usec());
+	if (frame < 0) {
+		return get_dsp_time();
+	}
+	return frame / (ma_engine_get_sample_rate(&engine) / 1000.0);
+}
+
+Dictionary Shinobu::get_clock_report() const {
+	return clock_correlation.get_report();
+}
+
 String Shinobu::get_current_backend_name() const {
+	if (offline) {
+		return "Offline";
+	}
 	return ma_get_backend_name(context.backend);
 }
 
 void Shinobu::pause() {
+	if (offline) {
+		if (!offline_timeline.paused) {
+			offline_timeline.paused = true;
+			clock_correlation.reset();
+		}
+		return;
+	}
 	if (ma_device_is_started(&device)) {
 		ma_device_stop(&device);
+		clock_correlation.reset();
 	}
 }
 
 void Shinobu::resume() {
+	if (offline) {
+		offline_timeline.paused = false;
+		return;
+	}
 	if (!ma_device_is_started(&device)) {
 		ma_device_start(&device);
 	}
 }
 
 uint64_t Shinobu::get_actual_buffer_size() const {
+	if (offline) {
+		return desired_buffer_size_msec;
+	}
 	return device.playback.internalPeriodSizeInFrames / (double)(device.playback.internalSampleRate / 1000.0);
 }
 
 Shinobu::~Shinobu() {
-	if (initialized) {
+	if (initialized && offline) {
+		if (SimulationHarness::get_singleton()) {
+			SimulationHarness::get_singleton()->remove_step_callback(&Shinobu::simulation_step);
+		}
+		ma_engine_uninit(&engine);
+		ma_resource_manager_uninit(&resource_manager);
+	} else if (initialized) {
 		ma_engine_uninit(&engine);
 		ma_resource_manager_uninit(&resource_manager);
 		ma_device_uninit(&device);
@@ -7,10 +7,33 @@
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
 #include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
 #include "miniaudio/miniaudio.h"
 #include "shinobu_clock.h"
+#include "shinobu_clock_correlation.h"
+#include "shinobu_command_queue.h"
 #include "shinobu_group.h"
 #include "shinobu_sound_source.h"
+#include "shinobu_voice_pool.h"
+
+// Simulated time of a Shinobu mixing without a device, in frames. The time that passes while
+// paused is skipped instead of mixed, so the DSP time doesn't jump forward on resume.
+struct ShinobuOfflineTimeline {
+	uint64_t frames = 0; // Simulated time that was mixed or skipped.
+	bool paused = false;
+
+	// Returns how many frames to mix to reach `p_time_frames`.
+	uint64_t advance(uint64_t p_time_frames) {
+		// Nothing is mixed while paused, and a new simulation starts over at an earlier time.
+		if (paused || p_time_frames < frames) {
+			frames = p_time_frames;
+			return 0;
+		}
+		const uint64_t count = p_time_frames - frames;
+		frames = p_time_frames;
+		return count;
+	}
+};
 
 class Shinobu : public Object {
 	GDCLASS(Shinobu, Object);
@@ -22,6 +45,16 @@ private:
 	static SafeNumeric<uint64_t> sound_source_uid;
 
 	Ref<ShinobuClock> clock;
+	ShinobuClockCorrelation clock_correlation;
+	ShinobuCommandQueue command_queue;
+
+	// Mix callback timing, a callback that takes longer than the period it mixes is an overrun.
+	SafeNumeric<uint64_t> callback_count;
+	SafeNumeric<uint64_t> callback_overruns;
+	SafeNumeric<uint64_t> callback_total_usec;
+	SafeNumeric<uint64_t> callback_last_usec;
+	SafeNumeric<uint64_t> callback_max_usec;
+	SafeNumeric<uint64_t> callback_period_usec;
 	static Shinobu *singleton;
 	static ma_backend string_to_backend(String str);
 	ma_engine engine;
@@ -34,6 +67,14 @@ private:
 	Vector<Ref<ShinobuGroup>> groups;
 
 	static void ma_data_callback(ma_device *pDevice, void *pOutput, const void *pInput, ma_uint32 frameCount);
+	void _mix(void *p_output, uint32_t p_frame_count);
+
+	// Without a device, while the engine is simulating: the frames are mixed from the main thread
+	// up to the simulated time of each frame, and discarded.
+	Error _initialize_offline(ma_resource_manager_config &p_resource_manager_config);
+	bool offline = false;
+	ShinobuOfflineTimeline offline_timeline;
+	LocalVector<float> offline_buffer;
 
 	float master_volume = 1.0f;
 	bool initialized = false;
@@ -45,6 +86,7 @@ public:
 	_FORCE_INLINE_ static Shinobu *get_singleton() { return singleton; }
 
 	String get_initialization_error() const;
+	bool is_initialized() const;
 
 	Ref<ShinobuClock> get_clock();
 	ma_engine *get_engine();
@@ -54,6 +96,22 @@ public:
 
 	Ref<ShinobuSoundSourceMemory> register_sound_from_memory(String m_name_hint, PackedByteArray m_data);
 	Ref<ShinobuGroup> create_group(String m_group_name, Ref<ShinobuGroup> m_parent_group = nullptr);
+	Ref<ShinobuVoicePool> create_voice_pool(Ref<ShinobuSoundSource> m_sound_source, Ref<ShinobuGroup> m_group, int m_voice_count);
+	// Plays `m_sound_source` on its one-shot voices for `m_group`, returns the voice index or -1.
+	int play_oneshot(const Ref<ShinobuSoundSource> &m_sound_source, const Ref<ShinobuGroup> &m_group, float m_volume = 1.0f, float m_pitch_scale = 1.0f, uint64_t m_dsp_time_msec = 0);
+	// Decodes the source and creates its one-shot voices ahead of the first hit.
+	Error prepare_oneshot(const Ref<ShinobuSoundSource> &m_sound_source, const Ref<ShinobuGroup> &m_group);
+
+	// Mixes up to `p_time_usec` when initialized without a device. It's a step callback of the
+	// SimulationHarness that was running at initialization, another harness can add it too.
+	static void simulation_step(uint64_t p_time_usec);
+
+	bool push_command(const ShinobuCommandQueue::Command &p_command);
+	// Cancels the commands counted by `p_pending` that weren't applied yet, before freeing the sound they control.
+	void cancel_commands(SafeNumeric<uint32_t> &p_pending);
+
+	Dictionary get_mix_stats() const;
+	void reset_mix_stats();
 
 	Ref<ShinobuSpectrumAnalyzerEffect> instantiate_spectrum_analyzer_effect();
 	Ref<ShinobuPitchShiftEffect> instantiate_pitch_shift();
@@ -68,6 +126,11 @@ public:
 	uint64_t get_dsp_time() const;
 	Error set_dsp_time(uint64_t m_new_time_msec);
 
+	int64_t dsp_frame_to_ticks_usec(int64_t m_frame) const;
+	int64_t ticks_usec_to_dsp_frame(int64_t m_ticks_usec) const;
+	double get_audible_dsp_time() const;
+	Dictionary get_clock_report() const;
+
 	uint64_t get_actual_buffer_size() const;
 	String get_current_backend_name() const;
 
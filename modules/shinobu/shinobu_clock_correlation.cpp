@@ -0,0 +1,173 @@
+#include "shinobu_clock_correlation.h"
+
+#include "core/math/math_funcs.h"
+#include "core/variant/variant.h"
+
+void ShinobuClockCorrelation::_restart(int64_t p_frame, int64_t p_ticks_usec) {
+	ref_frame = p_frame;
+	ref_ticks_usec = p_ticks_usec;
+	sum_w = 1.0;
+	sum_x = 0.0;
+	sum_y = 0.0;
+	sum_xx = 0.0;
+	sum_xy = 0.0;
+	intercept_usec = 0.0;
+	usec_per_frame = 1000000.0 / sample_rate;
+	callback_count = 1;
+	consecutive_outliers = 0;
+	jitter_variance = 0.0;
+	last_callback_ticks_usec = p_ticks_usec;
+}
+
+void ShinobuClockCorrelation::_fit() {
+	const double nominal = 1000000.0 / sample_rate;
+	const double mean_x = sum_x / sum_w;
+	const double mean_y = sum_y / sum_w;
+	const double variance_x = sum_xx / sum_w - mean_x * mean_x;
+	if (callback_count >= MIN_FIT_CALLBACKS && variance_x > 1.0) {
+		const double covariance = sum_xy / sum_w - mean_x * mean_y;
+		usec_per_frame = CLAMP(covariance / variance_x, nominal * (1.0 - MAX_DRIFT), nominal * (1.0 + MAX_DRIFT));
+	} else {
+		usec_per_frame = nominal;
+	}
+	intercept_usec = mean_y - usec_per_frame * mean_x;
+}
+
+void ShinobuClockCorrelation::set_sample_rate(uint32_t p_sample_rate) {
+	ERR_FAIL_COND(p_sample_rate == 0);
+	lock.lock();
+	sample_rate = p_sample_rate;
+	callback_count = 0;
+	lock.unlock();
+}
+
+void ShinobuClockCorrelation::set_output_latency_usec(int64_t p_latency_usec) {
+	lock.lock();
+	output_latency_usec = p_latency_usec;
+	lock.unlock();
+}
+
+void ShinobuClockCorrelation::add_callback(int64_t p_frame, uint32_t p_frame_count, int64_t p_ticks_usec) {
+	lock.lock();
+
+	period_usec = p_frame_count * 1000000.0 / sample_rate;
+	if (callback_count == 0) {
+		_restart(p_frame, p_ticks_usec);
+		lock.unlock();
+		return;
+	}
+
+	const double interval = double(p_ticks_usec - last_callback_ticks_usec);
+	callback_interval_usec = callback_interval_usec == 0.0 ? interval : Math::lerp(interval, callback_interval_usec, FORGET_FACTOR);
+	last_callback_ticks_usec = p_ticks_usec;
+
+	const double dx = double(p_frame - ref_frame);
+	const double dy = double(p_ticks_usec - ref_ticks_usec);
+	const double residual = dy - (intercept_usec + dx * usec_per_frame);
+
+	if (callback_count >= MIN_FIT_CALLBACKS) {
+		const double limit = MAX(MIN_OUTLIER_USEC, OUTLIER_SIGMA * Math::sqrt(jitter_variance));
+		if (Math::abs(residual) > limit) {
+			outlier_count++;
+			consecutive_outliers++;
+			if (consecutive_outliers > MAX_CONSECUTIVE_OUTLIERS) {
+				// The device stalled or the frame position jumped, the old fit doesn't apply anymore.
+				restart_count++;
+				_restart(p_frame, p_ticks_usec);
+			}
+			lock.unlock();
+			return;
+		}
+		jitter_variance = Math::lerp(residual * residual, jitter_variance, FORGET_FACTOR);
+		max_jitter_usec = MAX(max_jitter_usec, Math::abs(residual));
+	}
+	consecutive_outliers = 0;
+
+	// Move the origin to this callback, then add it with the older ones fading out.
+	sum_xx += sum_w * dx * dx - 2.0 * dx * sum_x;
+	sum_xy += sum_w * dx * dy - dx * sum_y - dy * sum_x;
+	sum_x -= sum_w * dx;
+	sum_y -= sum_w * dy;
+	ref_frame = p_frame;
+	ref_ticks_usec = p_ticks_usec;
+
+	sum_w = sum_w * FORGET_FACTOR + 1.0;
+	sum_x *= FORGET_FACTOR;
+	sum_y *= FORGET_FACTOR;
+	sum_xx *= FORGET_FACTOR;
+	sum_xy *= FORGET_FACTOR;
+
+	callback_count++;
+	_fit();
+
+	lock.unlock();
+}
+
+void ShinobuClockCorrelation::reset() {
+	lock.lock();
+	callback_count = 0;
+	outlier_count = 0;
+	restart_count = 0;
+	max_jitter_usec = 0.0;
+	callback_interval_usec = 0.0;
+	lock.unlock();
+}
+
+bool ShinobuClockCorrelation::is_ready() const {
+	lock.lock();
+	const bool ready = callback_count >= MIN_FIT_CALLBACKS;
+	lock.unlock();
+	return ready;
+}
+
+int64_t ShinobuClockCorrelation::frame_to_ticks_usec(int64_t p_frame) const {
+	lock.lock();
+	int64_t ticks = -1;
+	if (callback_count > 0) {
+		ticks = ref_ticks_usec + output_latency_usec + int64_t(Math::round(intercept_usec + double(p_frame - ref_frame) * usec_per_frame));
+	}
+	lock.unlock();
+	return ticks;
+}
+
+int64_t ShinobuClockCorrelation::ticks_usec_to_frame(int64_t p_ticks_usec) const {
+	lock.lock();
+	int64_t frame = -1;
+	if (callback_count > 0) {
+		frame = ref_frame + int64_t(Math::floor((double(p_ticks_usec - ref_ticks_usec - output_latency_usec) - intercept_usec) / usec_per_frame));
+	}
+	lock.unlock();
+	return frame;
+}
+
+double ShinobuClockCorrelation::get_drift_ppm() const {
+	lock.lock();
+	// Positive when the device plays faster than the system clock.
+	const double drift = (1000000.0 / sample_rate / usec_per_frame - 1.0) * 1000000.0;
+	lock.unlock();
+	return drift;
+}
+
+double ShinobuClockCorrelation::get_jitter_usec() const {
+	lock.lock();
+	const double jitter = Math::sqrt(jitter_variance);
+	lock.unlock();
+	return jitter;
+}
+
+Dictionary ShinobuClockCorrelation::get_report() const {
+	Dictionary report;
+	lock.lock();
+	report["fitted_callbacks"] = callback_count;
+	report["outlier_callbacks"] = outlier_count;
+	report["restarts"] = restart_count;
+	report["ready"] = callback_count >= MIN_FIT_CALLBACKS;
+	report["drift_ppm"] = (1000000.0 / sample_rate / usec_per_frame - 1.0) * 1000000.0;
+	report["jitter_usec"] = Math::sqrt(jitter_variance);
+	report["max_jitter_usec"] = max_jitter_usec;
+	report["callback_interval_usec"] = callback_interval_usec;
+	report["period_usec"] = period_usec;
+	report["output_latency_usec"] = output_latency_usec;
+	lock.unlock();
+	return report;
+}
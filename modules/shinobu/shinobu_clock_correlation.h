@@ -0,0 +1,78 @@
+#ifndef SHINOBU_CLOCK_CORRELATION_H
+#define SHINOBU_CLOCK_CORRELATION_H
+
+#include "core/os/spin_lock.h"
+#include "core/variant/dictionary.h"
+
+// Maps the DSP frame position onto the OS::get_ticks_usec() clock, so input event timestamps can be
+// compared with what was playing.
+// Every mix callback adds a (frame position, callback time) sample to an exponentially weighted linear
+// regression, which averages out the scheduling jitter and follows the drift between the device clock
+// and the system clock. Callbacks far off the line (preempted threads, device stalls) are left out of
+// the fit, and if they keep coming the regression starts over.
+class ShinobuClockCorrelation {
+public:
+	// About 200 callbacks (2 seconds with 10 ms periods) contribute to the fit.
+	static constexpr double FORGET_FACTOR = 0.995;
+	// The slope is fitted after this many callbacks, before that the nominal sample rate is used.
+	static constexpr uint64_t MIN_FIT_CALLBACKS = 8;
+	static constexpr double OUTLIER_SIGMA = 4.0;
+	static constexpr double MIN_OUTLIER_USEC = 500.0;
+	static constexpr uint64_t MAX_CONSECUTIVE_OUTLIERS = 16;
+	// Device clocks are within a few hundred ppm of the system clock, anything further off is noise.
+	static constexpr double MAX_DRIFT = 0.01;
+
+private:
+	mutable SpinLock lock;
+
+	uint32_t sample_rate = 48000;
+	int64_t output_latency_usec = 0;
+
+	// The regression is kept relative to the last accepted callback, so the sums stay small.
+	int64_t ref_frame = 0;
+	int64_t ref_ticks_usec = 0;
+	double sum_w = 0.0;
+	double sum_x = 0.0;
+	double sum_y = 0.0;
+	double sum_xx = 0.0;
+	double sum_xy = 0.0;
+
+	// Callback time at `ref_frame` relative to `ref_ticks_usec`, and the fitted time of a frame.
+	double intercept_usec = 0.0;
+	double usec_per_frame = 1000000.0 / 48000.0;
+
+	uint64_t callback_count = 0;
+	uint64_t outlier_count = 0;
+	uint64_t consecutive_outliers = 0;
+	uint64_t restart_count = 0;
+	double jitter_variance = 0.0;
+	double max_jitter_usec = 0.0;
+	double callback_interval_usec = 0.0;
+	double period_usec = 0.0;
+	int64_t last_callback_ticks_usec = 0;
+
+	void _restart(int64_t p_frame, int64_t p_ticks_usec);
+	void _fit();
+
+public:
+	void set_sample_rate(uint32_t p_sample_rate);
+	// Time from a frame being mixed to it being heard, added to the converted times.
+	void set_output_latency_usec(int64_t p_latency_usec);
+
+	// Called from the mix callback, with the DSP frame position at the start of the mixed block.
+	void add_callback(int64_t p_frame, uint32_t p_frame_count, int64_t p_ticks_usec);
+	// Clears the regression, for when the frame position or the device changes.
+	void reset();
+
+	bool is_ready() const;
+	// When `p_frame` is heard, -1 before the first callback.
+	int64_t frame_to_ticks_usec(int64_t p_frame) const;
+	// Which frame is heard at `p_ticks_usec`, -1 before the first callback.
+	int64_t ticks_usec_to_frame(int64_t p_ticks_usec) const;
+
+	double get_drift_ppm() const;
+	double get_jitter_usec() const;
+	Dictionary get_report() const;
+};
+
+#endif // SHINOBU_CLOCK_CORRELATION_H
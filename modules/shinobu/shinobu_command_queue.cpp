@@ -0,0 +1,111 @@
+#include "shinobu_command_queue.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+
+void ShinobuCommandQueue::_apply(const Command &p_command) {
+	ma_sound *sound = p_command.sound;
+	switch (p_command.type) {
+		case COMMAND_START: {
+			ma_sound_start(sound);
+		} break;
+		case COMMAND_STOP: {
+			ma_sound_stop(sound);
+		} break;
+		case COMMAND_SET_VOLUME: {
+			ma_sound_set_volume(sound, p_command.value_a);
+		} break;
+		case COMMAND_SET_PITCH: {
+			ma_sound_set_pitch(sound, p_command.value_a);
+		} break;
+		case COMMAND_SET_LOOPING: {
+			ma_sound_set_looping(sound, p_command.value_u64 != 0);
+		} break;
+		case COMMAND_SEEK: {
+			// Sound MUST be stopped before seeking or we crash
+			if (ma_sound_is_playing(sound) == MA_TRUE) {
+				ma_sound_stop(sound);
+			}
+			ma_sound_seek_to_pcm_frame(sound, p_command.value_u64);
+		} break;
+		case COMMAND_SCHEDULE_START: {
+			ma_sound_set_start_time_in_milliseconds(sound, p_command.value_u64);
+		} break;
+		case COMMAND_SCHEDULE_STOP: {
+			ma_sound_set_stop_time_in_milliseconds(sound, p_command.value_u64);
+		} break;
+		case COMMAND_FADE: {
+			ma_sound_set_fade_in_milliseconds(sound, p_command.value_a, p_command.value_b, p_command.value_u64);
+		} break;
+		case COMMAND_PLAY_VOICE: {
+			if (ma_sound_is_playing(sound) == MA_TRUE) {
+				ma_sound_stop(sound);
+			}
+			ma_sound_seek_to_pcm_frame(sound, 0);
+			ma_sound_set_volume(sound, p_command.value_a);
+			ma_sound_set_pitch(sound, p_command.value_b);
+			ma_sound_set_start_time_in_pcm_frames(sound, p_command.value_u64);
+			ma_sound_start(sound);
+		} break;
+		case COMMAND_CANCELED: {
+		} break;
+	}
+}
+
+bool ShinobuCommandQueue::push(const Command &p_command) {
+	MutexLock lock(push_mutex);
+	const uint32_t write = write_index.load(std::memory_order_relaxed);
+	if (write - read_index.load(std::memory_order_acquire) >= QUEUE_SIZE) {
+		dropped_commands.increment();
+		ERR_FAIL_V_MSG(false, "Shinobu command queue is full, the command was dropped.");
+	}
+	if (p_command.pending) {
+		p_command.pending->increment();
+	}
+	commands[write % QUEUE_SIZE] = p_command;
+	write_index.store(write + 1, std::memory_order_release);
+	return true;
+}
+
+void ShinobuCommandQueue::process() {
+	if (!process_mutex.try_lock()) {
+		return;
+	}
+	const uint32_t read = read_index.load(std::memory_order_relaxed);
+	const uint32_t write = write_index.load(std::memory_order_acquire);
+	for (uint32_t i = read; i != write; i++) {
+		const Command &command = commands[i % QUEUE_SIZE];
+		_apply(command);
+		if (command.pending) {
+			command.pending->decrement();
+		}
+	}
+	read_index.store(write, std::memory_order_release);
+	processed_commands.add(write - read);
+	process_mutex.unlock();
+}
+
+void ShinobuCommandQueue::cancel(SafeNumeric<uint32_t> *p_pending) {
+	ERR_FAIL_NULL(p_pending);
+	MutexLock lock(process_mutex);
+	// Commands pushed after this point aren't looked at, the owner of `p_pending` no longer pushes.
+	const uint32_t read = read_index.load(std::memory_order_relaxed);
+	const uint32_t write = write_index.load(std::memory_order_acquire);
+	for (uint32_t i = read; i != write && p_pending->get() > 0; i++) {
+		Command &command = commands[i % QUEUE_SIZE];
+		if (command.pending == p_pending) {
+			command.type = COMMAND_CANCELED;
+			command.sound = nullptr;
+			command.pending = nullptr;
+			p_pending->decrement();
+		}
+	}
+}
+
+ShinobuCommandQueue::ShinobuCommandQueue() {
+	commands = memnew_arr(Command, QUEUE_SIZE);
+}
+
+ShinobuCommandQueue::~ShinobuCommandQueue() {
+	memdelete_arr(commands);
+}
@@ -0,0 +1,74 @@
+#ifndef SHINOBU_COMMAND_QUEUE_H
+#define SHINOBU_COMMAND_QUEUE_H
+
+#include <atomic>
+
+#include "core/os/mutex.h"
+#include "core/templates/safe_refcount.h"
+#include "miniaudio/miniaudio.h"
+
+// Sound control from the game threads goes through this queue instead of calling miniaudio directly,
+// the mix callback applies it at the start of each period. Some ma_sound functions take spinlocks that
+// the mixer also needs, calling them while it mixes used to stall the callback past its deadline.
+// Pushing only locks against other pushing threads, the mix callback never waits.
+class ShinobuCommandQueue {
+public:
+	enum CommandType {
+		COMMAND_START,
+		COMMAND_STOP,
+		COMMAND_SET_VOLUME,
+		COMMAND_SET_PITCH,
+		COMMAND_SET_LOOPING,
+		COMMAND_SEEK,
+		COMMAND_SCHEDULE_START,
+		COMMAND_SCHEDULE_STOP,
+		COMMAND_FADE,
+		// Restarts a pooled voice from the beginning with `value_a` as the volume and `value_b` as the pitch,
+		// at the engine frame `value_u64` (0 for right away).
+		COMMAND_PLAY_VOICE,
+		// Left in place of a command whose sound is being freed.
+		COMMAND_CANCELED,
+	};
+
+	struct Command {
+		CommandType type = COMMAND_START;
+		ma_sound *sound = nullptr;
+		// Decremented once the command is applied or canceled, owners cancel the rest before freeing `sound`.
+		SafeNumeric<uint32_t> *pending = nullptr;
+		float value_a = 0.0f;
+		float value_b = 0.0f;
+		uint64_t value_u64 = 0;
+	};
+
+	static constexpr uint32_t QUEUE_SIZE = 4096;
+
+private:
+	Command *commands = nullptr;
+	std::atomic<uint32_t> read_index = 0;
+	std::atomic<uint32_t> write_index = 0;
+	BinaryMutex push_mutex;
+	// Held while applying commands. The mix callback only tries to take it, cancel() waits for it.
+	BinaryMutex process_mutex;
+
+	SafeNumeric<uint64_t> processed_commands;
+	SafeNumeric<uint64_t> dropped_commands;
+
+	static void _apply(const Command &p_command);
+
+public:
+	bool push(const Command &p_command);
+	// Applies the queued commands, from the mix callback or while the device is stopped.
+	// Does nothing if cancel() runs at the same time, the commands are applied next time.
+	void process();
+	// Cancels the queued commands counted by `p_pending`, so the sound they control can be freed
+	// right away. Waits for process() if it is applying commands.
+	void cancel(SafeNumeric<uint32_t> *p_pending);
+
+	uint64_t get_processed_count() const { return processed_commands.get(); }
+	uint64_t get_dropped_count() const { return dropped_commands.get(); }
+
+	ShinobuCommandQueue();
+	~ShinobuCommandQueue();
+};
+
+#endif // SHINOBU_COMMAND_QUEUE_H
@@ -28,34 +28,65 @@ void ShinobuSoundPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("fade", "fade_duration", "volume_begin", "volume_end"), &ShinobuSoundPlayer::fade);
 }
 
+Error ShinobuSoundPlayer::_push_command(ShinobuCommandQueue::CommandType p_type, float p_value_a, float p_value_b, uint64_t p_value_u64) {
+	ShinobuCommandQueue::Command command;
+	command.type = p_type;
+	command.sound = &sound;
+	if (p_type == ShinobuCommandQueue::COMMAND_START || p_type == ShinobuCommandQueue::COMMAND_STOP || p_type == ShinobuCommandQueue::COMMAND_SEEK) {
+		if (pending_transport_commands.get() == 0) {
+			// The last seek was applied, the sound reports its own position again.
+			seek_requested = false;
+		}
+		command.pending = &pending_transport_commands;
+	} else {
+		command.pending = &pending_commands;
+	}
+	command.value_a = p_value_a;
+	command.value_b = p_value_b;
+	command.value_u64 = p_value_u64;
+	return Shinobu::get_singleton()->push_command(command) ? OK : ERR_BUSY;
+}
+
 Error ShinobuSoundPlayer::start() {
-	MA_ERR_RET(ma_sound_start(&sound), "Error starting sound");
-	return OK;
+	const Error err = _push_command(ShinobuCommandQueue::COMMAND_START);
+	if (err == OK) {
+		playing_requested = true;
+	}
+	return err;
 }
 
 Error ShinobuSoundPlayer::stop() {
-	MA_ERR_RET(ma_sound_stop(&sound), "Error stopping sound");
-	return OK;
+	const Error err = _push_command(ShinobuCommandQueue::COMMAND_STOP);
+	if (err == OK) {
+		playing_requested = false;
+	}
+	return err;
 }
 
 void ShinobuSoundPlayer::set_pitch_scale(float m_pitch_scale) {
-	ma_sound_set_pitch(&sound, m_pitch_scale);
+	pitch_scale = m_pitch_scale;
+	_push_command(ShinobuCommandQueue::COMMAND_SET_PITCH, m_pitch_scale);
 }
 
 float ShinobuSoundPlayer::get_pitch_scale() {
-	return ma_sound_get_pitch(&sound);
+	return pitch_scale;
 }
 
 void ShinobuSoundPlayer::schedule_start_time(uint64_t m_global_time_msec) {
 	start_time_msec = m_global_time_msec;
-	ma_sound_set_start_time_in_milliseconds(&sound, m_global_time_msec);
+	_push_command(ShinobuCommandQueue::COMMAND_SCHEDULE_START, 0.0f, 0.0f, m_global_time_msec);
 }
 
 void ShinobuSoundPlayer::schedule_stop_time(uint64_t m_global_time_msec) {
-	ma_sound_set_stop_time_in_milliseconds(&sound, m_global_time_msec);
+	_push_command(ShinobuCommandQueue::COMMAND_SCHEDULE_STOP, 0.0f, 0.0f, m_global_time_msec);
 }
 
 int64_t ShinobuSoundPlayer::get_playback_position_nsec() {
+	if (seek_requested && pending_transport_commands.get() > 0) {
+		// The sound hasn't been seeked yet, report the position it is going to.
+		return seek_position_nsec;
+	}
+
 	Ref<ShinobuClock> clock = Shinobu::get_singleton()->get_clock();
 	ma_engine *engine = Shinobu::get_singleton()->get_engine();
 
@@ -82,7 +113,7 @@ int64_t ShinobuSoundPlayer::get_playback_position_nsec() {
 
 	if (is_playing()) {
 		int64_t engine_offset = clock->get_current_offset_nsec();
-		engine_offset = ma_sound_get_pitch(&sound) * engine_offset;
+		engine_offset = pitch_scale * engine_offset;
 		out_pos += engine_offset;
 	}
 
@@ -98,23 +129,28 @@ bool ShinobuSoundPlayer::is_at_stream_end() const {
 }
 
 bool ShinobuSoundPlayer::is_playing() const {
+	if (pending_transport_commands.get() > 0) {
+		return playing_requested;
+	}
 	return (bool)ma_sound_is_playing(&sound);
 }
 
 void ShinobuSoundPlayer::set_volume(float m_linear_volume) {
-	ma_sound_set_volume(&sound, m_linear_volume);
+	volume = m_linear_volume;
+	_push_command(ShinobuCommandQueue::COMMAND_SET_VOLUME, m_linear_volume);
 }
 
 float ShinobuSoundPlayer::get_volume() const {
-	return ma_sound_get_volume(&sound);
+	return volume;
 }
 
 void ShinobuSoundPlayer::set_looping_enabled(bool m_looping) {
-	ma_sound_set_looping(&sound, m_looping);
+	looping = m_looping;
+	_push_command(ShinobuCommandQueue::COMMAND_SET_LOOPING, 0.0f, 0.0f, m_looping);
 }
 
 bool ShinobuSoundPlayer::is_looping_enabled() const {
-	return (bool)ma_sound_is_looping(&sound);
+	return looping;
 }
 
 Error ShinobuSoundPlayer::connect_sound_to_effect(Ref<ShinobuEffect> m_effect) {
@@ -134,7 +170,7 @@ Error ShinobuSoundPlayer::connect_sound_to_group(Ref<ShinobuGroup> m_group) {
 }
 
 void ShinobuSoundPlayer::fade(int p_duration_ms, float p_volume_begin, float p_volume_end) {
-	ma_sound_set_fade_in_milliseconds(&sound, p_volume_begin, p_volume_end, p_duration_ms);
+	_push_command(ShinobuCommandQueue::COMMAND_FADE, p_volume_begin, p_volume_end, p_duration_ms);
 }
 
 void ShinobuSoundPlayer::_notification(int p_notification) {
@@ -142,27 +178,28 @@ void ShinobuSoundPlayer::_notification(int p_notification) {
 		case NOTIFICATION_PAUSED: {
 			if (!can_process()) {
 				was_playing_before_pause = is_playing();
-				ma_sound_stop(&sound);
+				stop();
 			}
 		} break;
 		case NOTIFICATION_UNPAUSED: {
 			if (was_playing_before_pause && !is_at_stream_end()) {
-				ma_sound_start(&sound);
+				start();
 			}
 		} break;
 	}
 }
 
 Error ShinobuSoundPlayer::seek(int64_t to_time_msec) {
-	// Sound MUST be stopped before seeking or we crash
-	if (ma_sound_is_playing(&sound) == MA_TRUE) {
-		ma_sound_stop(&sound);
-	}
 	uint32_t sample_rate;
-	ma_sound_get_data_format(&sound, NULL, NULL, &sample_rate, NULL, 0);
-	ma_result result = ma_sound_seek_to_pcm_frame(&sound, MAX(0.0f, to_time_msec * (float)(sample_rate / 1000.0f)));
-	MA_ERR_RET(result, "Error seeking sound");
-	return OK;
+	MA_ERR_RET(ma_sound_get_data_format(&sound, NULL, NULL, &sample_rate, NULL, 0), "Error seeking sound");
+	const Error err = _push_command(ShinobuCommandQueue::COMMAND_SEEK, 0.0f, 0.0f, MAX(0.0f, to_time_msec * (float)(sample_rate / 1000.0f)));
+	if (err == OK) {
+		// The sound is stopped before seeking in the mix callback.
+		playing_requested = false;
+		seek_requested = true;
+		seek_position_nsec = MAX(0, to_time_msec) * 1000000;
+	}
+	return err;
 }
 
 uint64_t ShinobuSoundPlayer::get_length_msec() {
@@ -184,8 +221,14 @@ uint64_t ShinobuSoundPlayer::get_length_msec() {
 ShinobuSoundPlayer::ShinobuSoundPlayer(Ref<ShinobuSoundSource> m_sound_source, Ref<ShinobuGroup> m_group, bool m_use_source_channel_count) {
 	m_sound_source->instantiate_sound(m_group, m_use_source_channel_count, &sound);
 	sound_source = m_sound_source;
+	volume = ma_sound_get_volume(&sound);
+	pitch_scale = ma_sound_get_pitch(&sound);
+	looping = ma_sound_is_looping(&sound);
 }
 
 ShinobuSoundPlayer::~ShinobuSoundPlayer() {
+	// The mix callback may still have commands for this sound, they no longer matter.
+	Shinobu::get_singleton()->cancel_commands(pending_commands);
+	Shinobu::get_singleton()->cancel_commands(pending_transport_commands);
 	ma_sound_uninit(&sound);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "miniaudio/miniaudio.h"
 #include "scene/main/node.h"
 #include "shinobu_clock.h"
+#include "shinobu_command_queue.h"
 #include "shinobu_effects.h"
 #include <memory>
 
@@ -21,6 +22,19 @@ class ShinobuSoundPlayer : public Node {
 	// HACK-ish way of dealing with tree pauses
 	bool was_playing_before_pause = false;
 
+	// Control goes through the Shinobu command queue, these keep what was asked for until it's applied.
+	SafeNumeric<uint32_t> pending_commands;
+	// Only the start, stop and seek commands, which change what is_playing() and the position report.
+	SafeNumeric<uint32_t> pending_transport_commands;
+	bool playing_requested = false;
+	bool seek_requested = false;
+	int64_t seek_position_nsec = 0;
+	float volume = 1.0f;
+	float pitch_scale = 1.0f;
+	bool looping = false;
+
+	Error _push_command(ShinobuCommandQueue::CommandType p_type, float p_value_a = 0.0f, float p_value_b = 0.0f, uint64_t p_value_u64 = 0);
+
 protected:
 	void _notification(int p_notification);
 	static void _bind_methods();
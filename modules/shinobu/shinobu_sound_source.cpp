@@ -8,6 +8,11 @@ void ShinobuSoundSource::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instantiate", "group", "use_source_channel_count"), &ShinobuSoundSource::instantiate, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_channel_count"), &ShinobuSoundSource::get_channel_count);
 	ClassDB::bind_method(D_METHOD("ebur128_get_loudness"), &ShinobuSoundSource::ebur128_get_loudness);
+	ClassDB::bind_method(D_METHOD("predecode"), &ShinobuSoundSource::predecode);
+	ClassDB::bind_method(D_METHOD("is_predecoded"), &ShinobuSoundSource::is_predecoded);
+	ClassDB::bind_method(D_METHOD("set_oneshot_voice_count", "voice_count"), &ShinobuSoundSource::set_oneshot_voice_count);
+	ClassDB::bind_method(D_METHOD("get_oneshot_voice_count"), &ShinobuSoundSource::get_oneshot_voice_count);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "oneshot_voice_count"), "set_oneshot_voice_count", "get_oneshot_voice_count");
 }
 
 ShinobuSoundSource::ShinobuSoundSource(String m_name) {
@@ -54,6 +59,87 @@ uint32_t ShinobuSoundSource::get_channel_count() const {
 	return channel_count;
 }
 
+Error ShinobuSoundSource::predecode() {
+	if (is_predecoded()) {
+		return OK;
+	}
+
+	ma_engine *engine = Shinobu::get_singleton()->get_engine();
+	ma_resource_manager_data_source source;
+	MA_ERR_RET(ma_resource_manager_data_source_init(ma_engine_get_resource_manager(engine), name.utf8().get_data(), 0, nullptr, &source), "Error initializing data source");
+
+	ma_format format;
+	uint32_t channel_count;
+	uint32_t sample_rate;
+	ma_resource_manager_data_source_get_data_format(&source, &format, &channel_count, &sample_rate, nullptr, 0);
+	if (format != ma_format_f32 || channel_count == 0) {
+		ma_resource_manager_data_source_uninit(&source);
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Sound sources must decode to 32-bit float samples.");
+	}
+
+	const uint64_t FRAMES_PER_CHUNK = 65536;
+	Vector<float> decoded;
+	uint64_t decoded_frames = 0;
+	while (true) {
+		decoded.resize((decoded_frames + FRAMES_PER_CHUNK) * channel_count);
+		ma_uint64 frames_read = 0;
+		ma_result read_result = ma_resource_manager_data_source_read_pcm_frames(&source, decoded.ptrw() + decoded_frames * channel_count, FRAMES_PER_CHUNK, &frames_read);
+		decoded_frames += frames_read;
+		if (read_result != MA_SUCCESS || frames_read == 0) {
+			break;
+		}
+	}
+	ma_resource_manager_data_source_uninit(&source);
+	decoded.resize(decoded_frames * channel_count);
+
+	// Resample once here, so the voices don't have to.
+	const uint32_t engine_sample_rate = ma_engine_get_sample_rate(engine);
+	if (sample_rate != engine_sample_rate) {
+		const uint64_t resampled_frames = ma_convert_frames(nullptr, 0, ma_format_f32, channel_count, engine_sample_rate, decoded.ptr(), decoded_frames, ma_format_f32, channel_count, sample_rate);
+		pcm.resize(resampled_frames * channel_count);
+		ma_convert_frames(pcm.ptrw(), resampled_frames, ma_format_f32, channel_count, engine_sample_rate, decoded.ptr(), decoded_frames, ma_format_f32, channel_count, sample_rate);
+	} else {
+		pcm = decoded;
+	}
+	pcm_channel_count = channel_count;
+	return OK;
+}
+
+bool ShinobuSoundSource::is_predecoded() const {
+	return pcm_channel_count > 0;
+}
+
+const Vector<float> &ShinobuSoundSource::get_pcm() const {
+	return pcm;
+}
+
+uint32_t ShinobuSoundSource::get_pcm_channel_count() const {
+	return pcm_channel_count;
+}
+
+void ShinobuSoundSource::set_oneshot_voice_count(int p_voice_count) {
+	ERR_FAIL_COND(p_voice_count <= 0);
+	ERR_FAIL_COND_MSG(!oneshot_pools.is_empty(), "The one-shot voice count can't be changed once they're created.");
+	oneshot_voice_count = p_voice_count;
+}
+
+int ShinobuSoundSource::get_oneshot_voice_count() const {
+	return oneshot_voice_count;
+}
+
+ShinobuVoicePool *ShinobuSoundSource::get_oneshot_pool(const Ref<ShinobuGroup> &p_group) {
+	ERR_FAIL_COND_V(p_group.is_null(), nullptr);
+	Ref<ShinobuVoicePool> *pool = oneshot_pools.getptr(p_group->get_instance_id());
+	if (pool) {
+		return pool->ptr();
+	}
+
+	ERR_FAIL_COND_V(predecode() != OK, nullptr);
+	Ref<ShinobuVoicePool> new_pool = memnew(ShinobuVoicePool(pcm, pcm_channel_count, p_group, oneshot_voice_count));
+	oneshot_pools.insert(p_group->get_instance_id(), new_pool);
+	return new_pool.ptr();
+}
+
 const String ShinobuSoundSource::get_name() const {
 	return name;
 }
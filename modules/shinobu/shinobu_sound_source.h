@@ -8,8 +8,10 @@
 #include <vector>
 
 #include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
 #include "shinobu_group.h"
 #include "shinobu_sound_player.h"
+#include "shinobu_voice_pool.h"
 
 class ShinobuSoundSource : public RefCounted {
 	GDCLASS(ShinobuSoundSource, RefCounted);
@@ -19,6 +21,13 @@ protected:
 	String name;
 	ma_result result;
 
+	// Decoded once in the engine sample rate, for one-shot voices.
+	Vector<float> pcm;
+	uint32_t pcm_channel_count = 0;
+	int oneshot_voice_count = 8;
+	// One-shot voices by group instance ID.
+	HashMap<ObjectID, Ref<ShinobuVoicePool>> oneshot_pools;
+
 	static void _bind_methods();
 
 public:
@@ -35,6 +44,16 @@ public:
 	uint32_t get_channel_count() const;
 	virtual Error instantiate_sound(Ref<ShinobuGroup> m_group, bool use_source_channel_count, ma_sound *p_sound) = 0;
 
+	Error predecode();
+	bool is_predecoded() const;
+	const Vector<float> &get_pcm() const;
+	uint32_t get_pcm_channel_count() const;
+
+	void set_oneshot_voice_count(int p_voice_count);
+	int get_oneshot_voice_count() const;
+	// Creates the one-shot voices for `p_group` on first use.
+	ShinobuVoicePool *get_oneshot_pool(const Ref<ShinobuGroup> &p_group);
+
 	virtual ~ShinobuSoundSource();
 };
 
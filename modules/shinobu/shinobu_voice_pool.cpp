@@ -0,0 +1,122 @@
+#include "shinobu_voice_pool.h"
+#include "shinobu.h"
+
+void ShinobuVoicePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("play", "volume", "pitch_scale", "dsp_time_msec"), &ShinobuVoicePool::play, DEFVAL(1.0f), DEFVAL(1.0f), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("stop_all"), &ShinobuVoicePool::stop_all);
+	ClassDB::bind_method(D_METHOD("get_voice_count"), &ShinobuVoicePool::get_voice_count);
+	ClassDB::bind_method(D_METHOD("get_playing_voice_count"), &ShinobuVoicePool::get_playing_voice_count);
+	ClassDB::bind_method(D_METHOD("get_play_count"), &ShinobuVoicePool::get_play_count);
+	ClassDB::bind_method(D_METHOD("get_stolen_voice_count"), &ShinobuVoicePool::get_stolen_voice_count);
+}
+
+bool ShinobuVoicePool::_is_voice_free(const Voice &p_voice) const {
+	return p_voice.pending_commands.get() == 0 && !ma_sound_is_playing(&p_voice.sound);
+}
+
+int ShinobuVoicePool::play(float p_volume, float p_pitch_scale, uint64_t p_dsp_time_msec) {
+	int index = -1;
+	for (uint32_t i = 0; i < voice_count; i++) {
+		const uint32_t candidate = (next_voice + i) % voice_count;
+		if (voices[candidate].initialized && _is_voice_free(voices[candidate])) {
+			index = candidate;
+			break;
+		}
+	}
+	if (index == -1) {
+		// Steal the voice that started first, it's the closest to its end.
+		for (uint32_t i = 0; i < voice_count; i++) {
+			if (voices[i].initialized && (index == -1 || voices[i].play_index < voices[index].play_index)) {
+				index = i;
+			}
+		}
+		ERR_FAIL_COND_V(index == -1, -1);
+		stolen_count++;
+	}
+
+	Voice &voice = voices[index];
+	ShinobuCommandQueue::Command command;
+	command.type = ShinobuCommandQueue::COMMAND_PLAY_VOICE;
+	command.sound = &voice.sound;
+	command.pending = &voice.pending_commands;
+	command.value_a = p_volume;
+	command.value_b = p_pitch_scale;
+	if (p_dsp_time_msec > 0) {
+		command.value_u64 = p_dsp_time_msec * ma_engine_get_sample_rate(Shinobu::get_singleton()->get_engine()) / 1000;
+	}
+	if (!Shinobu::get_singleton()->push_command(command)) {
+		return -1;
+	}
+
+	voice.play_index = ++play_count;
+	next_voice = (index + 1) % voice_count;
+	return index;
+}
+
+void ShinobuVoicePool::stop_all() {
+	for (uint32_t i = 0; i < voice_count; i++) {
+		if (!voices[i].initialized) {
+			continue;
+		}
+		ShinobuCommandQueue::Command command;
+		command.type = ShinobuCommandQueue::COMMAND_STOP;
+		command.sound = &voices[i].sound;
+		command.pending = &voices[i].pending_commands;
+		Shinobu::get_singleton()->push_command(command);
+	}
+}
+
+int ShinobuVoicePool::get_voice_count() const {
+	return voice_count;
+}
+
+int ShinobuVoicePool::get_playing_voice_count() const {
+	int count = 0;
+	for (uint32_t i = 0; i < voice_count; i++) {
+		if (voices[i].initialized && !_is_voice_free(voices[i])) {
+			count++;
+		}
+	}
+	return count;
+}
+
+uint64_t ShinobuVoicePool::get_play_count() const {
+	return play_count;
+}
+
+uint64_t ShinobuVoicePool::get_stolen_voice_count() const {
+	return stolen_count;
+}
+
+ShinobuVoicePool::ShinobuVoicePool(const Vector<float> &p_pcm, uint32_t p_channel_count, Ref<ShinobuGroup> p_group, uint32_t p_voice_count) {
+	pcm = p_pcm;
+	group = p_group;
+	voice_count = p_voice_count;
+	voices = memnew_arr(Voice, voice_count);
+
+	ERR_FAIL_COND(p_channel_count == 0);
+	ma_engine *engine = Shinobu::get_singleton()->get_engine();
+	for (uint32_t i = 0; i < voice_count; i++) {
+		Voice &voice = voices[i];
+		if (ma_audio_buffer_ref_init(ma_format_f32, p_channel_count, pcm.ptr(), pcm.size() / p_channel_count, &voice.buffer) != MA_SUCCESS) {
+			continue;
+		}
+		if (ma_sound_init_from_data_source(engine, &voice.buffer, MA_SOUND_FLAG_NO_SPATIALIZATION, group->get_group(), &voice.sound) != MA_SUCCESS) {
+			ma_audio_buffer_ref_uninit(&voice.buffer);
+			continue;
+		}
+		voice.initialized = true;
+	}
+}
+
+ShinobuVoicePool::~ShinobuVoicePool() {
+	for (uint32_t i = 0; i < voice_count; i++) {
+		Voice &voice = voices[i];
+		if (voice.initialized) {
+			Shinobu::get_singleton()->cancel_commands(voice.pending_commands);
+			ma_sound_uninit(&voice.sound);
+			ma_audio_buffer_ref_uninit(&voice.buffer);
+		}
+	}
+	memdelete_arr(voices);
+}
@@ -0,0 +1,50 @@
+#ifndef SHINOBU_VOICE_POOL_H
+#define SHINOBU_VOICE_POOL_H
+
+#include "core/object/ref_counted.h"
+#include "miniaudio/miniaudio.h"
+#include "shinobu_group.h"
+
+// Preallocated voices playing decoded PCM, for short sounds played often (hit sounds).
+// Playing one restarts a voice through the command queue, nothing is allocated or decoded per hit.
+// When every voice is busy, the one that started first is stolen.
+class ShinobuVoicePool : public RefCounted {
+	GDCLASS(ShinobuVoicePool, RefCounted);
+
+	struct Voice {
+		ma_audio_buffer_ref buffer;
+		ma_sound sound;
+		bool initialized = false;
+		uint64_t play_index = 0;
+		SafeNumeric<uint32_t> pending_commands;
+	};
+
+	// Shared with the sound source, it stays alive as long as the voices read it.
+	Vector<float> pcm;
+	Ref<ShinobuGroup> group;
+	Voice *voices = nullptr;
+	uint32_t voice_count = 0;
+	uint32_t next_voice = 0;
+	uint64_t play_count = 0;
+	uint64_t stolen_count = 0;
+
+	bool _is_voice_free(const Voice &p_voice) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Returns the voice that plays the sound. `p_dsp_time_msec` schedules it on the DSP clock, 0 plays it right away.
+	int play(float p_volume = 1.0f, float p_pitch_scale = 1.0f, uint64_t p_dsp_time_msec = 0);
+	void stop_all();
+
+	int get_voice_count() const;
+	int get_playing_voice_count() const;
+	uint64_t get_play_count() const;
+	uint64_t get_stolen_voice_count() const;
+
+	ShinobuVoicePool(const Vector<float> &p_pcm, uint32_t p_channel_count, Ref<ShinobuGroup> p_group, uint32_t p_voice_count);
+	~ShinobuVoicePool();
+};
+
+#endif // SHINOBU_VOICE_POOL_H
@@ -0,0 +1,136 @@
+#ifndef BENCHMARK_SHINOBU_ONESHOT_H
+#define BENCHMARK_SHINOBU_ONESHOT_H
+
+#include "../shinobu.h"
+
+#include "core/io/file_access.h"
+#include "main/simulation_harness.h"
+#include "tests/benchmark_runner.h"
+#include "tests/test_utils.h"
+// Shares create_wav() with the tests.
+#include "test_shinobu_oneshot.h"
+
+namespace BenchmarkShinobuOneshot {
+
+static const int HITS_PER_SECOND = 1000;
+static const int VOICE_COUNT = 32;
+
+// Each hit is followed by a simulated frame of 1 ms, in which Shinobu mixes on the calling thread
+// without a device. A hit is timed with the mixing of the voices it keeps busy, and commands can't
+// pile up in the queue like they would with a device mixing in real time.
+static bool begin_offline_mix(BenchmarkContext &p_context, SimulationHarness &p_harness) {
+	const String path = TestUtils::get_temp_path("benchmark_shinobu_timeline.json");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	if (f.is_null()) {
+		p_context.fail("Can't write the simulation timeline.");
+		return false;
+	}
+	f->store_string("{\"duration\": 600}");
+	f.unref();
+
+	p_harness.set_timeline_path(path);
+	if (p_harness.start(HITS_PER_SECOND) != OK) {
+		p_context.fail("Can't start the simulation.");
+		return false;
+	}
+
+	Shinobu *shinobu = Shinobu::get_singleton();
+	if (!shinobu->is_initialized()) {
+		if (shinobu->initialize(ma_backend_null) != OK) {
+			p_context.fail("Can't initialize Shinobu.");
+			return false;
+		}
+	} else if (shinobu->get_current_backend_name() == "Offline") {
+		// Initialized by an earlier benchmark, with a harness that's gone.
+		p_harness.add_step_callback(&Shinobu::simulation_step);
+	} else {
+		p_context.skip("Shinobu is already mixing on a device.");
+		return false;
+	}
+	return true;
+}
+
+static Ref<ShinobuSoundSourceMemory> create_source(const Ref<ShinobuGroup> &p_group) {
+	Shinobu *shinobu = Shinobu::get_singleton();
+	Ref<ShinobuSoundSourceMemory> source = shinobu->register_sound_from_memory("hit", TestShinobuOneshot::create_wav(48000, 4800));
+	source->set_oneshot_voice_count(VOICE_COUNT);
+	if (shinobu->prepare_oneshot(source, p_group) != OK) {
+		return Ref<ShinobuSoundSourceMemory>();
+	}
+	return source;
+}
+
+static void benchmark_play_oneshot(BenchmarkContext &p_context) {
+	SimulationHarness harness;
+	if (!begin_offline_mix(p_context, harness)) {
+		return;
+	}
+	Shinobu *shinobu = Shinobu::get_singleton();
+	Ref<ShinobuGroup> group = shinobu->create_group("hits");
+	Ref<ShinobuSoundSourceMemory> source = create_source(group);
+	if (source.is_null()) {
+		p_context.fail("Can't prepare the one-shot voices.");
+		return;
+	}
+
+	uint64_t hit = 0;
+	p_context.measure([&]() {
+		if (shinobu->play_oneshot(source, group, 1.0f, 1.0f + (hit % 8) * 0.05f) == -1) {
+			p_context.fail("A hit was dropped.");
+			return;
+		}
+		hit++;
+		harness.begin_frame();
+		harness.end_frame(0);
+	});
+
+	source->get_oneshot_pool(group)->stop_all();
+	harness.begin_frame();
+	harness.end_frame(0);
+}
+
+// What a hit used to cost: a new player per sound, freed when its slot comes around again.
+static void benchmark_play_sound_player(BenchmarkContext &p_context) {
+	SimulationHarness harness;
+	if (!begin_offline_mix(p_context, harness)) {
+		return;
+	}
+	Shinobu *shinobu = Shinobu::get_singleton();
+	Ref<ShinobuGroup> group = shinobu->create_group("hits");
+	Ref<ShinobuSoundSourceMemory> source = create_source(group);
+	if (source.is_null()) {
+		p_context.fail("Can't prepare the one-shot voices.");
+		return;
+	}
+
+	ShinobuSoundPlayer *players[VOICE_COUNT] = {};
+	uint64_t hit = 0;
+	p_context.measure([&]() {
+		ShinobuSoundPlayer *&player = players[hit % VOICE_COUNT];
+		if (player) {
+			memdelete(player);
+		}
+		player = source->instantiate(group);
+		player->set_pitch_scale(1.0f + (hit % 8) * 0.05f);
+		if (player->start() != OK) {
+			p_context.fail("A hit was dropped.");
+			return;
+		}
+		hit++;
+		harness.begin_frame();
+		harness.end_frame(0);
+	});
+
+	for (ShinobuSoundPlayer *player : players) {
+		if (player) {
+			memdelete(player);
+		}
+	}
+}
+
+REGISTER_BENCHMARK("shinobu/oneshot/play_oneshot_1000_hits_per_second", &benchmark_play_oneshot);
+REGISTER_BENCHMARK("shinobu/oneshot/sound_player_1000_hits_per_second", &benchmark_play_sound_player);
+
+} // namespace BenchmarkShinobuOneshot
+
+#endif // BENCHMARK_SHINOBU_ONESHOT_H
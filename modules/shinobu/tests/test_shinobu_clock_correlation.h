@@ -0,0 +1,115 @@
+#ifndef TEST_SHINOBU_CLOCK_CORRELATION_H
+#define TEST_SHINOBU_CLOCK_CORRELATION_H
+
+#include "../shinobu_clock_correlation.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShinobuClockCorrelation {
+
+// Simulates the null backend: a callback for every period of the device clock, woken up a bit late by the scheduler.
+struct SimulatedDevice {
+	ShinobuClockCorrelation correlation;
+	uint32_t sample_rate = 48000;
+	uint32_t period_frames = 480;
+	double drift_ppm = 0.0; // How much faster the device clock runs than the system clock.
+	int64_t start_ticks_usec = 3000000;
+	int64_t frame = 0;
+	uint32_t state = 4321;
+
+	SimulatedDevice() {
+		correlation.set_sample_rate(sample_rate);
+	}
+
+	// When `p_frame` is mixed, without the scheduling delay.
+	double frame_time_usec(int64_t p_frame) const {
+		return start_ticks_usec + p_frame * 1000000.0 / sample_rate / (1.0 + drift_ppm / 1000000.0);
+	}
+
+	// Wake-up delay between 100 and 300 µs, with a preempted callback every 100.
+	int64_t delay_usec(int p_index) {
+		state = state * 1664525u + 1013904223u;
+		return p_index % 100 == 99 ? 8000 : 100 + (state >> 8) % 200;
+	}
+
+	void run(int p_callbacks, int64_t p_stall_usec = 0) {
+		for (int i = 0; i < p_callbacks; i++) {
+			correlation.add_callback(frame, period_frames, int64_t(frame_time_usec(frame)) + p_stall_usec + delay_usec(i));
+			frame += period_frames;
+		}
+	}
+};
+
+TEST_CASE("[Shinobu][ClockCorrelation] Nothing to convert before the first callback") {
+	ShinobuClockCorrelation correlation;
+	CHECK_FALSE(correlation.is_ready());
+	CHECK(correlation.frame_to_ticks_usec(0) == -1);
+	CHECK(correlation.ticks_usec_to_frame(0) == -1);
+
+	correlation.set_sample_rate(48000);
+	correlation.add_callback(4800, 480, 1000000);
+	CHECK(correlation.frame_to_ticks_usec(4800) == 1000000);
+	CHECK(correlation.frame_to_ticks_usec(9600) == 1100000);
+	CHECK(correlation.ticks_usec_to_frame(1100000) == 9600);
+	CHECK_FALSE(correlation.is_ready());
+}
+
+TEST_CASE("[Shinobu][ClockCorrelation] Follows the device clock") {
+	for (double drift_ppm : { 0.0, 150.0, -150.0 }) {
+		SimulatedDevice device;
+		device.drift_ppm = drift_ppm;
+		// 30 seconds of 10 ms callbacks.
+		device.run(3000);
+		CHECK(device.correlation.is_ready());
+
+		// Converted to when the frame was mixed, plus the average scheduling delay.
+		for (int64_t frame = device.frame - 48000; frame <= device.frame + 48000; frame += 4800) {
+			const double error = device.correlation.frame_to_ticks_usec(frame) - device.frame_time_usec(frame);
+			CHECK(error >= 100.0);
+			CHECK(error <= 300.0);
+			CHECK(Math::abs(device.correlation.ticks_usec_to_frame(device.correlation.frame_to_ticks_usec(frame)) - frame) <= 1);
+		}
+
+		CHECK(Math::abs(device.correlation.get_drift_ppm() - drift_ppm) < 20.0);
+		CHECK(device.correlation.get_jitter_usec() < 100.0);
+
+		const Dictionary report = device.correlation.get_report();
+		CHECK(int(report["fitted_callbacks"]) == 2970);
+		CHECK(int(report["outlier_callbacks"]) == 30);
+		CHECK(int(report["restarts"]) == 0);
+		CHECK(double(report["period_usec"]) == doctest::Approx(10000.0));
+		CHECK(double(report["callback_interval_usec"]) == doctest::Approx(10000.0).epsilon(0.01));
+	}
+}
+
+TEST_CASE("[Shinobu][ClockCorrelation] Adds the output latency") {
+	SimulatedDevice device;
+	device.run(500);
+	const int64_t ticks = device.correlation.frame_to_ticks_usec(device.frame);
+
+	device.correlation.set_output_latency_usec(20000);
+	CHECK(device.correlation.frame_to_ticks_usec(device.frame) == ticks + 20000);
+	CHECK(device.correlation.ticks_usec_to_frame(ticks + 20000) == doctest::Approx(device.frame).epsilon(0.0001));
+	CHECK(int(device.correlation.get_report()["output_latency_usec"]) == 20000);
+}
+
+TEST_CASE("[Shinobu][ClockCorrelation] Starts over when the device stalls") {
+	SimulatedDevice device;
+	device.run(500);
+
+	// The device stops for half a second, then plays on from the same frame.
+	device.run(100, 500000);
+	CHECK(int(device.correlation.get_report()["restarts"]) == 1);
+
+	const double error = device.correlation.frame_to_ticks_usec(device.frame) - (device.frame_time_usec(device.frame) + 500000);
+	CHECK(error >= 100.0);
+	CHECK(error <= 300.0);
+
+	device.correlation.reset();
+	CHECK_FALSE(device.correlation.is_ready());
+	CHECK(device.correlation.frame_to_ticks_usec(device.frame) == -1);
+}
+
+} // namespace TestShinobuClockCorrelation
+
+#endif // TEST_SHINOBU_CLOCK_CORRELATION_H
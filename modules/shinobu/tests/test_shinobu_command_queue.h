@@ -0,0 +1,69 @@
+#ifndef TEST_SHINOBU_COMMAND_QUEUE_H
+#define TEST_SHINOBU_COMMAND_QUEUE_H
+
+#include "../shinobu_command_queue.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShinobuCommandQueue {
+
+// The sounds are never created, a command that reaches miniaudio would crash the test.
+ShinobuCommandQueue::Command make_command(ma_sound *p_sound, SafeNumeric<uint32_t> *p_pending) {
+	ShinobuCommandQueue::Command command;
+	command.type = ShinobuCommandQueue::COMMAND_START;
+	command.sound = p_sound;
+	command.pending = p_pending;
+	return command;
+}
+
+TEST_CASE("[Shinobu][CommandQueue] Canceled commands are not applied") {
+	ShinobuCommandQueue queue;
+	ma_sound sound_a;
+	ma_sound sound_b;
+	SafeNumeric<uint32_t> pending_a;
+	SafeNumeric<uint32_t> pending_b;
+
+	for (int i = 0; i < 3; i++) {
+		CHECK(queue.push(make_command(&sound_a, &pending_a)));
+		CHECK(queue.push(make_command(&sound_b, &pending_b)));
+	}
+	CHECK(pending_a.get() == 3);
+	CHECK(pending_b.get() == 3);
+
+	queue.cancel(&pending_a);
+	CHECK_MESSAGE(pending_a.get() == 0, "The owner can free its sound right away.");
+	CHECK(pending_b.get() == 3);
+
+	queue.cancel(&pending_b);
+	CHECK(pending_b.get() == 0);
+
+	queue.process();
+	CHECK(queue.get_processed_count() == 6);
+	CHECK(pending_a.get() == 0);
+	CHECK(pending_b.get() == 0);
+}
+
+TEST_CASE("[Shinobu][CommandQueue] Canceling leaves applied commands alone") {
+	ShinobuCommandQueue queue;
+	ma_sound sound;
+	SafeNumeric<uint32_t> pending;
+
+	queue.cancel(&pending);
+	CHECK(pending.get() == 0);
+
+	CHECK(queue.push(make_command(&sound, &pending)));
+	queue.cancel(&pending);
+	queue.process();
+	CHECK(pending.get() == 0);
+
+	// The applied command is still in the ring, canceling must only count the queued one.
+	CHECK(queue.push(make_command(&sound, &pending)));
+	queue.cancel(&pending);
+	CHECK(pending.get() == 0);
+	queue.process();
+	CHECK(queue.get_processed_count() == 2);
+}
+
+} // namespace TestShinobuCommandQueue
+
+#endif // TEST_SHINOBU_COMMAND_QUEUE_H
@@ -0,0 +1,41 @@
+#ifndef TEST_SHINOBU_OFFLINE_TIMELINE_H
+#define TEST_SHINOBU_OFFLINE_TIMELINE_H
+
+#include "../shinobu.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShinobuOfflineTimeline {
+
+TEST_CASE("[Shinobu] Offline mixing follows the simulated time") {
+	ShinobuOfflineTimeline timeline;
+	CHECK(timeline.advance(0) == 0);
+	CHECK(timeline.advance(480) == 480);
+	CHECK(timeline.advance(960) == 480);
+	CHECK(timeline.frames == 960);
+}
+
+TEST_CASE("[Shinobu] Offline mixing skips the time spent paused") {
+	ShinobuOfflineTimeline timeline;
+	CHECK(timeline.advance(4800) == 4800);
+
+	timeline.paused = true;
+	CHECK(timeline.advance(9600) == 0);
+	CHECK(timeline.advance(48000) == 0);
+	timeline.paused = false;
+
+	// Only the frame after resuming is mixed, not the second spent paused.
+	CHECK(timeline.advance(48480) == 480);
+	CHECK(timeline.frames == 48480);
+}
+
+TEST_CASE("[Shinobu] Offline mixing starts over with a new simulation") {
+	ShinobuOfflineTimeline timeline;
+	CHECK(timeline.advance(48000) == 48000);
+	CHECK(timeline.advance(0) == 0);
+	CHECK(timeline.advance(480) == 480);
+}
+
+} // namespace TestShinobuOfflineTimeline
+
+#endif // TEST_SHINOBU_OFFLINE_TIMELINE_H
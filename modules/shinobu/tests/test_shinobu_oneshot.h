@@ -0,0 +1,78 @@
+#ifndef TEST_SHINOBU_ONESHOT_H
+#define TEST_SHINOBU_ONESHOT_H
+
+#include "../shinobu.h"
+
+#include "core/io/marshalls.h"
+#include "tests/test_macros.h"
+
+namespace TestShinobuOneshot {
+
+// A 16-bit mono WAV file with a sine wave.
+static PackedByteArray create_wav(uint32_t p_sample_rate, uint32_t p_frames) {
+	PackedByteArray wav;
+	wav.resize(44 + p_frames * 2);
+	uint8_t *w = wav.ptrw();
+	const uint32_t data_size = p_frames * 2;
+	memcpy(w, "RIFF", 4);
+	encode_uint32(36 + data_size, w + 4);
+	memcpy(w + 8, "WAVEfmt ", 8);
+	encode_uint32(16, w + 16);
+	encode_uint16(1, w + 20); // PCM.
+	encode_uint16(1, w + 22); // Mono.
+	encode_uint32(p_sample_rate, w + 24);
+	encode_uint32(p_sample_rate * 2, w + 28);
+	encode_uint16(2, w + 32);
+	encode_uint16(16, w + 34);
+	memcpy(w + 36, "data", 4);
+	encode_uint32(data_size, w + 40);
+	for (uint32_t i = 0; i < p_frames; i++) {
+		encode_uint16(uint16_t(int16_t(Math::sin(i * Math::TAU * 440.0 / p_sample_rate) * 16000.0)), w + 44 + i * 2);
+	}
+	return wav;
+}
+
+static bool init_shinobu() {
+	Shinobu *shinobu = Shinobu::get_singleton();
+	return shinobu->is_initialized() || shinobu->initialize(ma_backend_null) == OK;
+}
+
+TEST_CASE("[Shinobu] One-shot voices are preallocated and stolen when they're all playing") {
+	REQUIRE(init_shinobu());
+	Shinobu *shinobu = Shinobu::get_singleton();
+	ma_engine *engine = shinobu->get_engine();
+
+	// Half a second, at a sample rate the engine doesn't use.
+	Ref<ShinobuSoundSourceMemory> source = shinobu->register_sound_from_memory("hit", create_wav(22050, 11025));
+	Ref<ShinobuGroup> group = shinobu->create_group("hits");
+	source->set_oneshot_voice_count(4);
+
+	CHECK_FALSE(source->is_predecoded());
+	CHECK(shinobu->prepare_oneshot(source, group) == OK);
+	CHECK(source->is_predecoded());
+	CHECK(source->get_pcm_channel_count() == 1);
+	// Resampled to the engine sample rate.
+	CHECK(source->get_pcm().size() == doctest::Approx(ma_engine_get_sample_rate(engine) / 2).epsilon(0.01));
+
+	const uint64_t allocations = shinobu->get_mix_stats()["allocations"];
+	for (int i = 0; i < 4; i++) {
+		CHECK(shinobu->play_oneshot(source, group, 0.5f, 1.0f) == i);
+	}
+	// Every voice is busy, the first ones to start are stolen.
+	CHECK(shinobu->play_oneshot(source, group) == 0);
+	CHECK(shinobu->play_oneshot(source, group) == 1);
+	CHECK(uint64_t(shinobu->get_mix_stats()["allocations"]) == allocations);
+
+	ShinobuVoicePool *pool = source->get_oneshot_pool(group);
+	REQUIRE(pool != nullptr);
+	CHECK(pool->get_voice_count() == 4);
+	CHECK(pool->get_play_count() == 6);
+	CHECK(pool->get_stolen_voice_count() == 2);
+	CHECK(pool->get_playing_voice_count() == 4);
+
+	pool->stop_all();
+}
+
+} // namespace TestShinobuOneshot
+
+#endif // TEST_SHINOBU_ONESHOT_H